@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef A_ARRAYSARITHMETIC_H__INCLUDED_
+#define A_ARRAYSARITHMETIC_H__INCLUDED_
+
+// Scalar element-wise arithmetic "a= OP(a,b)", used by C++ loops and by heads and tails of SIMD kernels.
+// Integer results without saturation wrap around modulo 2^n, like Java; absDiffXxx of signed integers
+// is |a-b| modulo 2^n, absDiffUxx is the exact difference of unsigned numbers. oppositeXxx ignore
+// the first argument: a= -b.
+
+#include <math.h> // fabs()
+
+#define ARITHMETIC_WRAPPING(SUFFIX,TYPE,UTYPE) \
+inline TYPE _add##SUFFIX(TYPE a, TYPE b)      {return (TYPE)(UTYPE)((UTYPE)a+(UTYPE)b);}\
+inline TYPE _sub##SUFFIX(TYPE a, TYPE b)      {return (TYPE)(UTYPE)((UTYPE)a-(UTYPE)b);}\
+inline TYPE _absDiff##SUFFIX(TYPE a, TYPE b)  {return a>b? _sub##SUFFIX(a,b): _sub##SUFFIX(b,a);}\
+inline TYPE _opposite##SUFFIX(TYPE, TYPE b)   {return (TYPE)(UTYPE)(0-(UTYPE)b);}\
+inline TYPE _absDiffU##SUFFIX(TYPE a, TYPE b) {return (UTYPE)a>(UTYPE)b? _sub##SUFFIX(a,b): _sub##SUFFIX(b,a);}\
+
+ARITHMETIC_WRAPPING(I8,jbyte,uint8_t)
+ARITHMETIC_WRAPPING(I16,jshort,uint16_t)
+ARITHMETIC_WRAPPING(I32,jint,uint32_t)
+ARITHMETIC_WRAPPING(I64,jlong,uint64_t)
+#undef ARITHMETIC_WRAPPING
+
+#define ARITHMETIC_SATURATING(SUFFIX,TYPE,MIN,MAX,UMAX) \
+inline TYPE _adds##SUFFIX(TYPE a, TYPE b)  {jint r= (jint)a+(jint)b; return (TYPE)(r<MIN? MIN: r>MAX? MAX: r);}\
+inline TYPE _subs##SUFFIX(TYPE a, TYPE b)  {jint r= (jint)a-(jint)b; return (TYPE)(r<MIN? MIN: r>MAX? MAX: r);}\
+inline TYPE _addus##SUFFIX(TYPE a, TYPE b) {jint r= (jint)(a&UMAX)+(jint)(b&UMAX); return (TYPE)(r>UMAX? UMAX: r);}\
+inline TYPE _subus##SUFFIX(TYPE a, TYPE b) {jint r= (jint)(a&UMAX)-(jint)(b&UMAX); return (TYPE)(r<0? 0: r);}\
+
+ARITHMETIC_SATURATING(I8,jbyte,-128,127,0xFF)
+ARITHMETIC_SATURATING(I16,jshort,-32768,32767,0xFFFF)
+#undef ARITHMETIC_SATURATING
+
+inline jfloat _addF(jfloat a, jfloat b)          {return a+b;}
+inline jfloat _subF(jfloat a, jfloat b)          {return a-b;}
+inline jfloat _absDiffF(jfloat a, jfloat b)      {return (jfloat)fabs(a-b);}
+inline jfloat _oppositeF(jfloat, jfloat b)       {return -b;}
+inline jdouble _addD(jdouble a, jdouble b)       {return a+b;}
+inline jdouble _subD(jdouble a, jdouble b)       {return a-b;}
+inline jdouble _absDiffD(jdouble a, jdouble b)   {return fabs(a-b);}
+inline jdouble _oppositeD(jdouble, jdouble b)    {return -b;}
+
+#endif //A_ARRAYSARITHMETIC_H__INCLUDED_
@@ -0,0 +1,765 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+// Standalone micro-benchmark of the ArraysNative kernels (not a part of the JNI library).
+// Sweeps kernel set, operation, element type, length (16 bytes .. several last level caches),
+// source/destination misalignment and overlap; prints GB/s and TSC cycles per element.
+//
+//   ArraysBench [-csv|-json] [-o file] [-kernels C++,SSE2,AVX2,AVX-512] [-ops copy,fill,min,...]
+//               [-maxlen bytes] [-time ms]
+//   ArraysBench -diff old.csv new.csv [-threshold percents]
+//
+// The diff mode compares two CSV results of this program and exits with code 1
+// if some case became slower than the threshold (5% by default).
+
+#include <jni.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "ArraysMacro.h"
+#include "ArraysFunctions.h"
+#include "ArraysKernels.h"
+#include "ArraysJavaMath.h"
+#include "ArraysArithmetic.h"
+#include "ArraysBits.h"
+#include "ArraysFilter3x3.h"
+#include "ArraysRank.h"
+#include "ArraysMorphology.h"
+#ifdef _MSC_VER
+	#include <intrin.h>
+	#include <windows.h>
+#elif defined(ARRAYS_KERNELS_X86)
+	#include <x86intrin.h>
+#endif
+
+// Scalar kernels: the same loops as in ArraysNative.cpp, used as the "C++" baseline
+template <class T> static void scalarFill(T *a, jlong len, T v, jlong) {
+	for (jlong k=0; k<len; k++) a[k]= v;
+}
+template <class T> static void scalarMin(T *a, const T *b, jlong len) {
+	for (jlong k=0; k<len; k++) if (a[k]>b[k]) a[k]= b[k];
+}
+template <class T> static void scalarMax(T *a, const T *b, jlong len) {
+	for (jlong k=0; k<len; k++) if (a[k]<b[k]) a[k]= b[k];
+}
+template <class T, class U> static void scalarMinU(T *a, const T *b, jlong len) {
+	scalarMin((U*)a,(const U*)b,len);
+}
+template <class T, class U> static void scalarMaxU(T *a, const T *b, jlong len) {
+	scalarMax((U*)a,(const U*)b,len);
+}
+template <class T, T (*MINMAX)(T,T)> static void scalarJavaMinMax(T *a, const T *b, jlong len) {
+	for (jlong k=0; k<len; k++) a[k]= MINMAX(a[k],b[k]);
+}
+template <class T, T (*OP)(T,T)> static void scalarPairOp(T *a, const T *b, jlong len) {
+	for (jlong k=0; k<len; k++) a[k]= OP(a[k],b[k]);
+}
+template <class T, class S> static void scalarRange(const T *a, jlong len, ArraysRange *r) {
+	r->sum= (jlong)_rangeLoop<T,S>(a,len,r);
+}
+template <int OP> static void scalarBits(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count) {
+	_bits<OP>(dest,destPos,src,srcPos,count,_bitsWords<OP>);
+}
+static jlong scalarCardinalityBits(const jlong *a, jlong pos, jlong count) {
+	return _cardinalityBits(a,pos,count,_bitCountWords);
+}
+static void scalarCopyBytes(jbyte *dest, const jbyte *src, jlong len, jlong) {
+	memmove(dest,src,(size_t)len);
+}
+
+static ArraysKernels scalarKernels() {
+	ArraysKernels k;
+	memset(&k,0,sizeof(k));
+	k.name= "C++";
+	k.copyBytes= scalarCopyBytes;
+	k.fillByte= scalarFill<jbyte>; k.fillShort= scalarFill<jshort>;
+	k.fillInt= scalarFill<jint>; k.fillLong= scalarFill<jlong>;
+	k.minByte= scalarMin<jbyte>; k.maxByte= scalarMax<jbyte>;
+	k.minuByte= scalarMinU<jbyte,uint8_t>; k.maxuByte= scalarMaxU<jbyte,uint8_t>;
+	k.minShort= scalarMin<jshort>; k.maxShort= scalarMax<jshort>;
+	k.minuShort= scalarMinU<jshort,uint16_t>; k.maxuShort= scalarMaxU<jshort,uint16_t>;
+	k.minInt= scalarMin<jint>; k.maxInt= scalarMax<jint>;
+	k.minuInt= scalarMinU<jint,uint32_t>; k.maxuInt= scalarMaxU<jint,uint32_t>;
+	k.minLong= scalarMin<jlong>; k.maxLong= scalarMax<jlong>;
+	k.minuLong= scalarMinU<jlong,uint64_t>; k.maxuLong= scalarMaxU<jlong,uint64_t>;
+	k.minFloat= scalarJavaMinMax<jfloat,_javaMinF>; k.maxFloat= scalarJavaMinMax<jfloat,_javaMaxF>;
+	k.minDouble= scalarJavaMinMax<jdouble,_javaMinD>; k.maxDouble= scalarJavaMinMax<jdouble,_javaMaxD>;
+	k.rangeByte= scalarRange<jbyte,uint64_t>; k.rangeChar= scalarRange<jchar,uint64_t>;
+	k.rangeShort= scalarRange<jshort,uint64_t>; k.rangeInt= scalarRange<jint,uint64_t>;
+	k.rangeLong= scalarRange<jlong,uint64_t>;
+	k.rangeFloat= scalarRange<jfloat,jdouble>; k.rangeDouble= scalarRange<jdouble,jdouble>;
+	k.addByte= scalarPairOp<jbyte,_addI8>; k.addShort= scalarPairOp<jshort,_addI16>;
+	k.addInt= scalarPairOp<jint,_addI32>; k.addLong= scalarPairOp<jlong,_addI64>;
+	k.addFloat= scalarPairOp<jfloat,_addF>; k.addDouble= scalarPairOp<jdouble,_addD>;
+	k.subByte= scalarPairOp<jbyte,_subI8>; k.subShort= scalarPairOp<jshort,_subI16>;
+	k.subInt= scalarPairOp<jint,_subI32>; k.subLong= scalarPairOp<jlong,_subI64>;
+	k.subFloat= scalarPairOp<jfloat,_subF>; k.subDouble= scalarPairOp<jdouble,_subD>;
+	k.addsByte= scalarPairOp<jbyte,_addsI8>; k.addsShort= scalarPairOp<jshort,_addsI16>;
+	k.subsByte= scalarPairOp<jbyte,_subsI8>; k.subsShort= scalarPairOp<jshort,_subsI16>;
+	k.addusByte= scalarPairOp<jbyte,_addusI8>; k.addusShort= scalarPairOp<jshort,_addusI16>;
+	k.subusByte= scalarPairOp<jbyte,_subusI8>; k.subusShort= scalarPairOp<jshort,_subusI16>;
+	k.absDiffByte= scalarPairOp<jbyte,_absDiffI8>; k.absDiffShort= scalarPairOp<jshort,_absDiffI16>;
+	k.absDiffInt= scalarPairOp<jint,_absDiffI32>; k.absDiffLong= scalarPairOp<jlong,_absDiffI64>;
+	k.absDiffFloat= scalarPairOp<jfloat,_absDiffF>; k.absDiffDouble= scalarPairOp<jdouble,_absDiffD>;
+	k.absDiffuByte= scalarPairOp<jbyte,_absDiffUI8>; k.absDiffuShort= scalarPairOp<jshort,_absDiffUI16>;
+	k.absDiffuInt= scalarPairOp<jint,_absDiffUI32>; k.absDiffuLong= scalarPairOp<jlong,_absDiffUI64>;
+	k.oppositeByte= scalarPairOp<jbyte,_oppositeI8>; k.oppositeShort= scalarPairOp<jshort,_oppositeI16>;
+	k.oppositeInt= scalarPairOp<jint,_oppositeI32>; k.oppositeLong= scalarPairOp<jlong,_oppositeI64>;
+	k.oppositeFloat= scalarPairOp<jfloat,_oppositeF>; k.oppositeDouble= scalarPairOp<jdouble,_oppositeD>;
+	k.copyBits= scalarBits<BITS_COPY>; k.andBits= scalarBits<BITS_AND>; k.orBits= scalarBits<BITS_OR>;
+	k.xorBits= scalarBits<BITS_XOR>; k.andNotBits= scalarBits<BITS_ANDNOT>; k.notBits= scalarBits<BITS_NOT>;
+	k.cardinalityBits= scalarCardinalityBits;
+	k.packBitsByte= _packBitsLoop<uint8_t>; k.packBitsChar= _packBitsLoop<jchar>;
+	k.packBitsInt= _packBitsLoop<jint>; k.packBitsLong= _packBitsLoop<jlong>;
+	k.packBitsFloat= _packBitsLoop<jfloat>; k.packBitsDouble= _packBitsLoop<jdouble>;
+	k.unpackBitsByte= _unpackBitsLoop<jbyte>; k.unpackBitsShort= _unpackBitsLoop<jshort>;
+	k.unpackBitsInt= _unpackBitsLoop<jint>; k.unpackBitsLong= _unpackBitsLoop<jlong>;
+	k.indexOfByte= _indexOfLoop<jbyte>; k.indexOfShort= _indexOfLoop<jshort>;
+	k.indexOfInt= _indexOfLoop<jint>; k.indexOfLong= _indexOfLoop<jlong>;
+	k.indexOfFloat= _indexOfLoop<jfloat>; k.indexOfDouble= _indexOfLoop<jdouble>;
+	k.lastIndexOfByte= _lastIndexOfLoop<jbyte>; k.lastIndexOfShort= _lastIndexOfLoop<jshort>;
+	k.lastIndexOfInt= _lastIndexOfLoop<jint>; k.lastIndexOfLong= _lastIndexOfLoop<jlong>;
+	k.lastIndexOfFloat= _lastIndexOfLoop<jfloat>; k.lastIndexOfDouble= _lastIndexOfLoop<jdouble>;
+	k.swapBytesShort= _swapBytesLoop<jshort>; k.swapBytesInt= _swapBytesLoop<jint>; k.swapBytesLong= _swapBytesLoop<jlong>;
+	k.filter3x3Byte= _filter3x3Loop<jbyte>; k.filter3x3Short= _filter3x3Loop<jshort>;
+	k.filter3x3Float= _filter3x3Loop<jfloat>;
+	k.rankByte= _rankLoop<jbyte>; k.rankShort= _rankLoop<jshort>;
+	return k;
+}
+
+static double _seconds() {
+#ifdef _WIN32
+	LARGE_INTEGER f, c;
+	QueryPerformanceFrequency(&f);
+	QueryPerformanceCounter(&c);
+	return (double)c.QuadPart/(double)f.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec+ts.tv_nsec*1e-9;
+#endif
+}
+
+static uint64_t _ticks() {
+#if defined(ARRAYS_KERNELS_X86)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+// One benchmarked operation: "a" is the destination (and the first operand), "b" is the source;
+// reductions (range) only read "a"
+struct BenchOp {
+	const char *op, *type;
+	int elementSize;
+	void (*run)(const ArraysKernels &k, void *a, const void *b, jlong len, jlong nonTemporalMinLen);
+	bool isPair; // reads the source
+};
+
+#define BENCH_FILL(NAME,T,KERNEL) \
+	static void NAME(const ArraysKernels &k, void *a, const void *, jlong len, jlong thr) { \
+		k.KERNEL((T*)a,len,(T)1,thr); \
+	}
+#define BENCH_PAIR(NAME,T,KERNEL) \
+	static void NAME(const ArraysKernels &k, void *a, const void *b, jlong len, jlong) { \
+		k.KERNEL((T*)a,(const T*)b,len); \
+	}
+#define BENCH_RANGE(NAME,T,KERNEL) \
+	static void NAME(const ArraysKernels &k, void *a, const void *, jlong len, jlong) { \
+		ArraysRange r; \
+		k.KERNEL((const T*)a,len,&r); \
+	}
+// Packed bits: "bits" (aligned source) and "bits+5" (the source starts at bit 5: funnel shifts);
+// lengths are in 64-bit words
+#define BENCH_BITS(NAME,KERNEL,SRCPOS) \
+	static void NAME(const ArraysKernels &k, void *a, const void *b, jlong len, jlong) { \
+		k.KERNEL((jlong*)a,0,(const jlong*)b,SRCPOS,(len<<6)-SRCPOS); \
+	}
+// The same choice as in ArraysNative.cpp: vpopcntq if the processor supports it
+static void benchCardinalityBits(const ArraysKernels &k, void *a, const void *, jlong len, jlong) {
+	if ((_cpuInfo()&CPU_AVX512POPCNT)!=0 && k.cardinalityBitsVpopcnt!=NULL) {
+		k.cardinalityBitsVpopcnt((const jlong*)a,0,len<<6);
+	} else {
+		k.cardinalityBits((const jlong*)a,0,len<<6);
+	}
+}
+// Threshold packing reads "a" (like reductions) and writes len bits into "b"
+#define BENCH_PACK_BITS(NAME,T,KERNEL) \
+	static void NAME(const ArraysKernels &k, void *a, const void *b, jlong len, jlong) { \
+		k.KERNEL((jlong*)b,0,(const T*)a,len,(T)0,PACK_GREATER); \
+	}
+// Bit unpacking writes len elements into "a" from the bits of "b"; "unpackUnitBits" changes only
+// the elements of 1 bits
+#define BENCH_UNPACK_BITS(NAME,T,KERNEL,MODE) \
+	static void NAME(const ArraysKernels &k, void *a, const void *b, jlong len, jlong) { \
+		k.KERNEL((T*)a,(const jlong*)b,0,len,(T)0,(T)1,MODE); \
+	}
+// Search scans all len elements: the bytes of "a" are (i*7) and never repeat in neighbouring bytes,
+// so a value of equal bytes is never found (byte elements are not benchmarked for this reason)
+#define BENCH_SEARCH(NAME,T,KERNEL) \
+	static void NAME(const ArraysKernels &k, void *a, const void *, jlong len, jlong) { \
+		T v; memset(&v,0x7F,sizeof(v)); \
+		k.KERNEL((const T*)a,len,v); \
+	}
+// Byte order reversal: "a" is the destination, like in copy
+#define BENCH_SWAP(NAME,T,KERNEL) \
+	static void NAME(const ArraysKernels &k, void *a, const void *b, jlong len, jlong thr) { \
+		k.KERNEL((T*)a,(const T*)b,len,thr); \
+	}
+// len elements as a matrix of rows of 1024 elements (or a single shorter row)
+#define BENCH_FILTER3X3(NAME,T,KERNEL,FILTER,PERCENTILE_INDEX) \
+	static void NAME(const ArraysKernels &k, void *a, const void *b, jlong len, jlong) { \
+		static std::vector<jbyte> work(FILTER3X3_WORK_BYTES(1024)); \
+		jlong dimX= len<1024? len: 1024; \
+		if (dimX>0) k.KERNEL((T*)a,(const T*)b,dimX,len/dimX,0,len/dimX,FILTER,PERCENTILE_INDEX,&work[0]); \
+	}
+// The same matrix; the median or the mean between the percentiles 25% and 75% by the square aperture
+#define BENCH_RANK(NAME,T,KERNEL,APERTURE,MODE) \
+	static void NAME(const ArraysKernels &k, void *a, const void *b, jlong len, jlong) { \
+		static std::vector<jbyte> work; \
+		jlong dimX= len<1024? len: 1024, n= (jlong)APERTURE*APERTURE; \
+		if (dimX==0) return; \
+		size_t workBytes= _rankWorkBytes<T>(dimX,APERTURE,APERTURE,MODE); \
+		if (work.size()<workBytes) work.resize(workBytes); \
+		k.KERNEL((T*)a,(const T*)b,dimX,len/dimX,0,dimX,APERTURE,APERTURE,MODE, \
+			MODE==RANK_PERCENTILE? n/2: n/4,MODE==RANK_PERCENTILE? 0: 3*n/4,&work[0]); \
+	}
+// The same matrix; erosion by the square aperture: the column pass by the pairwise KERNEL, then the row pass
+#define BENCH_MORPHOLOGY(NAME,T,KERNEL,APERTURE) \
+	static void NAME(const ArraysKernels &k, void *a, const void *b, jlong len, jlong) { \
+		static std::vector<jbyte> work; \
+		jlong dimX= len<1024? len: 1024, dimY= len/dimX; \
+		if (dimX==0) return; \
+		jlong ax= APERTURE<dimX? APERTURE: dimX, ay= APERTURE<dimY? APERTURE: dimY; \
+		size_t workBytes= _morphologyWorkBytes<T>(dimX,dimY,ax,ay); \
+		if (work.size()<workBytes) work.resize(workBytes); \
+		_morphologyColumns<T>(k.KERNEL,(T*)a,(const T*)b,dimX,dimY,0,dimX,ay,&work[0]); \
+		_morphologyRows<T>((T*)a,dimX,0,dimY,ax,false,&work[0]); \
+	}
+static void benchCopy(const ArraysKernels &k, void *a, const void *b, jlong len, jlong thr) {
+	k.copyBytes((jbyte*)a,(const jbyte*)b,len,thr);
+}
+BENCH_FILL(benchFillByte,jbyte,fillByte)
+BENCH_FILL(benchFillShort,jshort,fillShort)
+BENCH_FILL(benchFillInt,jint,fillInt)
+BENCH_FILL(benchFillLong,jlong,fillLong)
+BENCH_PAIR(benchMinByte,jbyte,minByte)
+BENCH_PAIR(benchMaxByte,jbyte,maxByte)
+BENCH_PAIR(benchMinuByte,jbyte,minuByte)
+BENCH_PAIR(benchMaxuByte,jbyte,maxuByte)
+BENCH_PAIR(benchMinShort,jshort,minShort)
+BENCH_PAIR(benchMaxShort,jshort,maxShort)
+BENCH_PAIR(benchMinuShort,jshort,minuShort)
+BENCH_PAIR(benchMaxuShort,jshort,maxuShort)
+BENCH_PAIR(benchMinInt,jint,minInt)
+BENCH_PAIR(benchMaxInt,jint,maxInt)
+BENCH_PAIR(benchMinuInt,jint,minuInt)
+BENCH_PAIR(benchMaxuInt,jint,maxuInt)
+BENCH_PAIR(benchMinLong,jlong,minLong)
+BENCH_PAIR(benchMaxLong,jlong,maxLong)
+BENCH_PAIR(benchMinuLong,jlong,minuLong)
+BENCH_PAIR(benchMaxuLong,jlong,maxuLong)
+BENCH_PAIR(benchMinFloat,jfloat,minFloat)
+BENCH_PAIR(benchMaxFloat,jfloat,maxFloat)
+BENCH_PAIR(benchMinDouble,jdouble,minDouble)
+BENCH_PAIR(benchMaxDouble,jdouble,maxDouble)
+BENCH_RANGE(benchRangeByte,jbyte,rangeByte)
+BENCH_RANGE(benchRangeChar,jchar,rangeChar)
+BENCH_RANGE(benchRangeShort,jshort,rangeShort)
+BENCH_RANGE(benchRangeInt,jint,rangeInt)
+BENCH_RANGE(benchRangeLong,jlong,rangeLong)
+BENCH_RANGE(benchRangeFloat,jfloat,rangeFloat)
+BENCH_RANGE(benchRangeDouble,jdouble,rangeDouble)
+BENCH_PAIR(benchAddByte,jbyte,addByte)
+BENCH_PAIR(benchAddShort,jshort,addShort)
+BENCH_PAIR(benchAddInt,jint,addInt)
+BENCH_PAIR(benchAddLong,jlong,addLong)
+BENCH_PAIR(benchAddFloat,jfloat,addFloat)
+BENCH_PAIR(benchAddDouble,jdouble,addDouble)
+BENCH_PAIR(benchSubByte,jbyte,subByte)
+BENCH_PAIR(benchSubShort,jshort,subShort)
+BENCH_PAIR(benchSubInt,jint,subInt)
+BENCH_PAIR(benchSubLong,jlong,subLong)
+BENCH_PAIR(benchSubFloat,jfloat,subFloat)
+BENCH_PAIR(benchSubDouble,jdouble,subDouble)
+BENCH_PAIR(benchAddsByte,jbyte,addsByte)
+BENCH_PAIR(benchAddsShort,jshort,addsShort)
+BENCH_PAIR(benchSubsByte,jbyte,subsByte)
+BENCH_PAIR(benchSubsShort,jshort,subsShort)
+BENCH_PAIR(benchAddusByte,jbyte,addusByte)
+BENCH_PAIR(benchAddusShort,jshort,addusShort)
+BENCH_PAIR(benchSubusByte,jbyte,subusByte)
+BENCH_PAIR(benchSubusShort,jshort,subusShort)
+BENCH_PAIR(benchAbsDiffByte,jbyte,absDiffByte)
+BENCH_PAIR(benchAbsDiffShort,jshort,absDiffShort)
+BENCH_PAIR(benchAbsDiffInt,jint,absDiffInt)
+BENCH_PAIR(benchAbsDiffLong,jlong,absDiffLong)
+BENCH_PAIR(benchAbsDiffFloat,jfloat,absDiffFloat)
+BENCH_PAIR(benchAbsDiffDouble,jdouble,absDiffDouble)
+BENCH_PAIR(benchAbsDiffuByte,jbyte,absDiffuByte)
+BENCH_PAIR(benchAbsDiffuShort,jshort,absDiffuShort)
+BENCH_PAIR(benchAbsDiffuInt,jint,absDiffuInt)
+BENCH_PAIR(benchAbsDiffuLong,jlong,absDiffuLong)
+BENCH_PAIR(benchOppositeByte,jbyte,oppositeByte)
+BENCH_PAIR(benchOppositeShort,jshort,oppositeShort)
+BENCH_PAIR(benchOppositeInt,jint,oppositeInt)
+BENCH_PAIR(benchOppositeLong,jlong,oppositeLong)
+BENCH_PAIR(benchOppositeFloat,jfloat,oppositeFloat)
+BENCH_PAIR(benchOppositeDouble,jdouble,oppositeDouble)
+BENCH_BITS(benchCopyBits,copyBits,0)
+BENCH_BITS(benchCopyBitsShifted,copyBits,5)
+BENCH_BITS(benchAndBits,andBits,0)
+BENCH_BITS(benchAndBitsShifted,andBits,5)
+BENCH_BITS(benchOrBits,orBits,0)
+BENCH_BITS(benchOrBitsShifted,orBits,5)
+BENCH_BITS(benchXorBits,xorBits,0)
+BENCH_BITS(benchXorBitsShifted,xorBits,5)
+BENCH_BITS(benchAndNotBits,andNotBits,0)
+BENCH_BITS(benchAndNotBitsShifted,andNotBits,5)
+BENCH_BITS(benchNotBits,notBits,0)
+BENCH_BITS(benchNotBitsShifted,notBits,5)
+BENCH_PACK_BITS(benchPackBitsByte,uint8_t,packBitsByte)
+BENCH_PACK_BITS(benchPackBitsChar,jchar,packBitsChar)
+BENCH_PACK_BITS(benchPackBitsInt,jint,packBitsInt)
+BENCH_PACK_BITS(benchPackBitsLong,jlong,packBitsLong)
+BENCH_PACK_BITS(benchPackBitsFloat,jfloat,packBitsFloat)
+BENCH_PACK_BITS(benchPackBitsDouble,jdouble,packBitsDouble)
+BENCH_UNPACK_BITS(benchUnpackBitsByte,jbyte,unpackBitsByte,UNPACK_ALL)
+BENCH_UNPACK_BITS(benchUnpackBitsShort,jshort,unpackBitsShort,UNPACK_ALL)
+BENCH_UNPACK_BITS(benchUnpackBitsInt,jint,unpackBitsInt,UNPACK_ALL)
+BENCH_UNPACK_BITS(benchUnpackBitsLong,jlong,unpackBitsLong,UNPACK_ALL)
+BENCH_UNPACK_BITS(benchUnpackUnitBitsByte,jbyte,unpackBitsByte,UNPACK_UNITS)
+BENCH_UNPACK_BITS(benchUnpackUnitBitsInt,jint,unpackBitsInt,UNPACK_UNITS)
+BENCH_SEARCH(benchIndexOfShort,jshort,indexOfShort)
+BENCH_SEARCH(benchIndexOfInt,jint,indexOfInt)
+BENCH_SEARCH(benchIndexOfLong,jlong,indexOfLong)
+BENCH_SEARCH(benchIndexOfFloat,jfloat,indexOfFloat)
+BENCH_SEARCH(benchIndexOfDouble,jdouble,indexOfDouble)
+BENCH_SEARCH(benchLastIndexOfInt,jint,lastIndexOfInt)
+BENCH_SWAP(benchSwapBytesShort,jshort,swapBytesShort)
+BENCH_SWAP(benchSwapBytesInt,jint,swapBytesInt)
+BENCH_SWAP(benchSwapBytesLong,jlong,swapBytesLong)
+BENCH_FILTER3X3(benchErosion3x3Byte,jbyte,filter3x3Byte,FILTER3X3_EROSION_BY_SQUARE,0)
+BENCH_FILTER3X3(benchDilationCross3x3Byte,jbyte,filter3x3Byte,FILTER3X3_DILATION_BY_CROSS,0)
+BENCH_FILTER3X3(benchAverage3x3Byte,jbyte,filter3x3Byte,FILTER3X3_AVERAGE_BY_SQUARE,0)
+BENCH_FILTER3X3(benchMedian3x3Byte,jbyte,filter3x3Byte,FILTER3X3_PERCENTILE_BY_SQUARE,4)
+BENCH_FILTER3X3(benchGradient3x3Byte,jbyte,filter3x3Byte,FILTER3X3_QUICK_GRADIENT_BY_CROSS,0)
+BENCH_FILTER3X3(benchErosion3x3Short,jshort,filter3x3Short,FILTER3X3_EROSION_BY_SQUARE,0)
+BENCH_FILTER3X3(benchAverage3x3Short,jshort,filter3x3Short,FILTER3X3_AVERAGE_BY_SQUARE,0)
+BENCH_FILTER3X3(benchMedian3x3Short,jshort,filter3x3Short,FILTER3X3_PERCENTILE_BY_SQUARE,4)
+BENCH_FILTER3X3(benchErosion3x3Float,jfloat,filter3x3Float,FILTER3X3_EROSION_BY_SQUARE,0)
+BENCH_FILTER3X3(benchAverage3x3Float,jfloat,filter3x3Float,FILTER3X3_AVERAGE_BY_SQUARE,0)
+BENCH_FILTER3X3(benchMedian3x3Float,jfloat,filter3x3Float,FILTER3X3_PERCENTILE_BY_SQUARE,4)
+BENCH_FILTER3X3(benchGradient3x3Float,jfloat,filter3x3Float,FILTER3X3_QUICK_GRADIENT_BY_CROSS,0)
+BENCH_RANK(benchMedian31Byte,jbyte,rankByte,31,RANK_PERCENTILE)
+BENCH_RANK(benchMedian63Byte,jbyte,rankByte,63,RANK_PERCENTILE)
+BENCH_RANK(benchMean31Byte,jbyte,rankByte,31,RANK_MEAN_BETWEEN_PERCENTILES)
+BENCH_RANK(benchMedian31Short,jshort,rankShort,31,RANK_PERCENTILE)
+BENCH_RANK(benchMedian63Short,jshort,rankShort,63,RANK_PERCENTILE)
+BENCH_RANK(benchMean31Short,jshort,rankShort,31,RANK_MEAN_BETWEEN_PERCENTILES)
+BENCH_MORPHOLOGY(benchErosion31Byte,jbyte,minuByte,31)
+BENCH_MORPHOLOGY(benchErosion255Byte,jbyte,minuByte,255)
+BENCH_MORPHOLOGY(benchErosion31Short,jshort,minuShort,31)
+BENCH_MORPHOLOGY(benchErosion31Int,jint,minInt,31)
+BENCH_MORPHOLOGY(benchErosion31Long,jlong,minLong,31)
+BENCH_MORPHOLOGY(benchErosion31Float,jfloat,minFloat,31)
+BENCH_MORPHOLOGY(benchErosion255Float,jfloat,minFloat,255)
+BENCH_MORPHOLOGY(benchErosion31Double,jdouble,minDouble,31)
+
+static const BenchOp benchOps[]= {
+	{"copy","byte",1,benchCopy,true},
+	{"fill","byte",1,benchFillByte,false},
+	{"fill","short",2,benchFillShort,false},
+	{"fill","int",4,benchFillInt,false},
+	{"fill","long",8,benchFillLong,false},
+	{"min","byte",1,benchMinByte,true},
+	{"max","byte",1,benchMaxByte,true},
+	{"minu","byte",1,benchMinuByte,true},
+	{"maxu","byte",1,benchMaxuByte,true},
+	{"min","short",2,benchMinShort,true},
+	{"max","short",2,benchMaxShort,true},
+	{"minu","short",2,benchMinuShort,true},
+	{"maxu","short",2,benchMaxuShort,true},
+	{"min","int",4,benchMinInt,true},
+	{"max","int",4,benchMaxInt,true},
+	{"minu","int",4,benchMinuInt,true},
+	{"maxu","int",4,benchMaxuInt,true},
+	{"min","long",8,benchMinLong,true},
+	{"max","long",8,benchMaxLong,true},
+	{"minu","long",8,benchMinuLong,true},
+	{"maxu","long",8,benchMaxuLong,true},
+	{"min","float",4,benchMinFloat,true},
+	{"max","float",4,benchMaxFloat,true},
+	{"min","double",8,benchMinDouble,true},
+	{"max","double",8,benchMaxDouble,true},
+	{"range","byte",1,benchRangeByte,false},
+	{"range","char",2,benchRangeChar,false},
+	{"range","short",2,benchRangeShort,false},
+	{"range","int",4,benchRangeInt,false},
+	{"range","long",8,benchRangeLong,false},
+	{"range","float",4,benchRangeFloat,false},
+	{"range","double",8,benchRangeDouble,false},
+	{"add","byte",1,benchAddByte,true},
+	{"add","short",2,benchAddShort,true},
+	{"add","int",4,benchAddInt,true},
+	{"add","long",8,benchAddLong,true},
+	{"add","float",4,benchAddFloat,true},
+	{"add","double",8,benchAddDouble,true},
+	{"sub","byte",1,benchSubByte,true},
+	{"sub","short",2,benchSubShort,true},
+	{"sub","int",4,benchSubInt,true},
+	{"sub","long",8,benchSubLong,true},
+	{"sub","float",4,benchSubFloat,true},
+	{"sub","double",8,benchSubDouble,true},
+	{"adds","byte",1,benchAddsByte,true},
+	{"adds","short",2,benchAddsShort,true},
+	{"subs","byte",1,benchSubsByte,true},
+	{"subs","short",2,benchSubsShort,true},
+	{"addus","byte",1,benchAddusByte,true},
+	{"addus","short",2,benchAddusShort,true},
+	{"subus","byte",1,benchSubusByte,true},
+	{"subus","short",2,benchSubusShort,true},
+	{"absDiff","byte",1,benchAbsDiffByte,true},
+	{"absDiff","short",2,benchAbsDiffShort,true},
+	{"absDiff","int",4,benchAbsDiffInt,true},
+	{"absDiff","long",8,benchAbsDiffLong,true},
+	{"absDiff","float",4,benchAbsDiffFloat,true},
+	{"absDiff","double",8,benchAbsDiffDouble,true},
+	{"absDiffu","byte",1,benchAbsDiffuByte,true},
+	{"absDiffu","short",2,benchAbsDiffuShort,true},
+	{"absDiffu","int",4,benchAbsDiffuInt,true},
+	{"absDiffu","long",8,benchAbsDiffuLong,true},
+	{"opposite","byte",1,benchOppositeByte,true},
+	{"opposite","short",2,benchOppositeShort,true},
+	{"opposite","int",4,benchOppositeInt,true},
+	{"opposite","long",8,benchOppositeLong,true},
+	{"opposite","float",4,benchOppositeFloat,true},
+	{"opposite","double",8,benchOppositeDouble,true},
+	{"copyBits","bits",8,benchCopyBits,true},
+	{"copyBits","bits+5",8,benchCopyBitsShifted,true},
+	{"andBits","bits",8,benchAndBits,true},
+	{"andBits","bits+5",8,benchAndBitsShifted,true},
+	{"orBits","bits",8,benchOrBits,true},
+	{"orBits","bits+5",8,benchOrBitsShifted,true},
+	{"xorBits","bits",8,benchXorBits,true},
+	{"xorBits","bits+5",8,benchXorBitsShifted,true},
+	{"andNotBits","bits",8,benchAndNotBits,true},
+	{"andNotBits","bits+5",8,benchAndNotBitsShifted,true},
+	{"notBits","bits",8,benchNotBits,true},
+	{"notBits","bits+5",8,benchNotBitsShifted,true},
+	{"cardinality","bits",8,benchCardinalityBits,false},
+	{"packBits","byte",1,benchPackBitsByte,false},
+	{"packBits","char",2,benchPackBitsChar,false},
+	{"packBits","int",4,benchPackBitsInt,false},
+	{"packBits","long",8,benchPackBitsLong,false},
+	{"packBits","float",4,benchPackBitsFloat,false},
+	{"packBits","double",8,benchPackBitsDouble,false},
+	{"unpackBits","byte",1,benchUnpackBitsByte,false},
+	{"unpackBits","short",2,benchUnpackBitsShort,false},
+	{"unpackBits","int",4,benchUnpackBitsInt,false},
+	{"unpackBits","long",8,benchUnpackBitsLong,false},
+	{"unpackUnitBits","byte",1,benchUnpackUnitBitsByte,false},
+	{"unpackUnitBits","int",4,benchUnpackUnitBitsInt,false},
+	{"indexOf","short",2,benchIndexOfShort,false},
+	{"indexOf","int",4,benchIndexOfInt,false},
+	{"indexOf","long",8,benchIndexOfLong,false},
+	{"indexOf","float",4,benchIndexOfFloat,false},
+	{"indexOf","double",8,benchIndexOfDouble,false},
+	{"lastIndexOf","int",4,benchLastIndexOfInt,false},
+	{"swapBytes","short",2,benchSwapBytesShort,true},
+	{"swapBytes","int",4,benchSwapBytesInt,true},
+	{"swapBytes","long",8,benchSwapBytesLong,true},
+	{"erosion3x3","byte",1,benchErosion3x3Byte,true},
+	{"dilationCross3x3","byte",1,benchDilationCross3x3Byte,true},
+	{"average3x3","byte",1,benchAverage3x3Byte,true},
+	{"median3x3","byte",1,benchMedian3x3Byte,true},
+	{"gradient3x3","byte",1,benchGradient3x3Byte,true},
+	{"erosion3x3","short",2,benchErosion3x3Short,true},
+	{"average3x3","short",2,benchAverage3x3Short,true},
+	{"median3x3","short",2,benchMedian3x3Short,true},
+	{"erosion3x3","float",4,benchErosion3x3Float,true},
+	{"average3x3","float",4,benchAverage3x3Float,true},
+	{"median3x3","float",4,benchMedian3x3Float,true},
+	{"gradient3x3","float",4,benchGradient3x3Float,true},
+	{"median31x31","byte",1,benchMedian31Byte,true},
+	{"median63x63","byte",1,benchMedian63Byte,true},
+	{"mean31x31","byte",1,benchMean31Byte,true},
+	{"median31x31","short",2,benchMedian31Short,true},
+	{"median63x63","short",2,benchMedian63Short,true},
+	{"mean31x31","short",2,benchMean31Short,true},
+	{"erosion31x31","byte",1,benchErosion31Byte,true},
+	{"erosion255x255","byte",1,benchErosion255Byte,true},
+	{"erosion31x31","short",2,benchErosion31Short,true},
+	{"erosion31x31","int",4,benchErosion31Int,true},
+	{"erosion31x31","long",8,benchErosion31Long,true},
+	{"erosion31x31","float",4,benchErosion31Float,true},
+	{"erosion255x255","float",4,benchErosion255Float,true},
+	{"erosion31x31","double",8,benchErosion31Double,true},
+};
+
+// Source/destination placement: offsets in elements from 4096-aligned buffers
+struct BenchLayout {
+	const char *name;
+	int dstOfs, srcOfs;
+	int overlap; // 0: separate buffers, 1: dest after src (backward copy), -1: dest before src
+};
+
+static const BenchLayout benchLayouts[]= {
+	{"aligned",0,0,0},
+	{"dst+1",1,0,0},
+	{"src+1",0,1,0},
+	{"overlap-forward",0,1,-1},
+	{"overlap-backward",1,0,1},
+};
+
+struct BenchResult {
+	std::string kernels, op, type, layout;
+	jlong bytes;
+	double gbps, cyclesPerElement;
+	std::string key() const {
+		char s[32];
+		sprintf(s,"%lld",(long long)bytes);
+		return kernels+","+op+","+type+","+s+","+layout;
+	}
+};
+
+static bool _listed(const char *list, const char *name) {
+	if (list==NULL) return true;
+	size_t n= strlen(name);
+	for (const char *p= list; (p= strstr(p,name))!=NULL; p+= n) {
+		if ((p==list || p[-1]==',') && (p[n]==0 || p[n]==',')) return true;
+	}
+	return false;
+}
+
+static void *_alignedAlloc(size_t size) {
+	char *p= (char*)malloc(size+8192);
+	if (p==NULL) return NULL;
+	char *result= p+4096-((size_t)p&4095)+4096;
+	((char**)result)[-1]= p;
+	return result;
+}
+static void _alignedFree(void *p) {
+	if (p!=NULL) free(((char**)p)[-1]);
+}
+
+static BenchResult runCase(const ArraysKernels &k, const BenchOp &op, const BenchLayout &layout,
+	jlong bytes, char *bufA, char *bufB, double minSeconds, jlong nonTemporalMinLen)
+{
+	jlong len= bytes/op.elementSize;
+	char *src= (layout.overlap? bufA: bufB)+(jlong)layout.srcOfs*op.elementSize;
+	char *dest= bufA+(jlong)layout.dstOfs*op.elementSize;
+	// Calibrating the number of iterations for one trial, then taking the best of 5 trials
+	jlong iterations= 1;
+	for (;;) {
+		double t= _seconds();
+		for (jlong i=0; i<iterations; i++) op.run(k,dest,src,len,nonTemporalMinLen);
+		t= _seconds()-t;
+		if (t>=minSeconds/5 || iterations>=((jlong)1<<40)) break;
+		iterations*= t<minSeconds/500? 10: 2;
+	}
+	double best= 1e100;
+	uint64_t bestTicks= 0;
+	for (int trial=0; trial<5; trial++) {
+		double t= _seconds();
+		uint64_t ticks= _ticks();
+		for (jlong i=0; i<iterations; i++) op.run(k,dest,src,len,nonTemporalMinLen);
+		ticks= _ticks()-ticks;
+		t= _seconds()-t;
+		if (t<best) { best= t; bestTicks= ticks; }
+	}
+	BenchResult r;
+	r.kernels= k.name; r.op= op.op; r.type= op.type; r.layout= layout.name;
+	r.bytes= bytes;
+	// Bytes moved through the memory: read+write for copy and pair operations, write for fill
+	double traffic= (double)bytes*(op.isPair? 2: 1)*iterations;
+	r.gbps= best>0? traffic/best/1e9: 0.0;
+	r.cyclesPerElement= (double)bestTicks/((double)iterations*len);
+	return r;
+}
+
+static void printResult(FILE *f, const BenchResult &r, bool json, bool first) {
+	if (json) {
+		fprintf(f,"%s\n  {\"kernels\":\"%s\",\"op\":\"%s\",\"type\":\"%s\",\"bytes\":%lld,"
+			"\"layout\":\"%s\",\"gbps\":%.3f,\"cyclesPerElement\":%.4f}",
+			first? "": ",",r.kernels.c_str(),r.op.c_str(),r.type.c_str(),(long long)r.bytes,
+			r.layout.c_str(),r.gbps,r.cyclesPerElement);
+	} else {
+		fprintf(f,"%s,%s,%s,%lld,%s,%.3f,%.4f\n",r.kernels.c_str(),r.op.c_str(),r.type.c_str(),
+			(long long)r.bytes,r.layout.c_str(),r.gbps,r.cyclesPerElement);
+	}
+	fflush(f);
+}
+
+static bool readCsv(const char *fileName, std::map<std::string,BenchResult> &results) {
+	FILE *f= fopen(fileName,"r");
+	if (f==NULL) {
+		fprintf(stderr,"Cannot open %s\n",fileName);
+		return false;
+	}
+	char line[1024];
+	while (fgets(line,sizeof(line),f)!=NULL) {
+		char kernels[64], op[64], type[64], layout[64];
+		long long bytes;
+		double gbps, cycles;
+		if (sscanf(line,"%63[^,],%63[^,],%63[^,],%lld,%63[^,],%lf,%lf",
+			kernels,op,type,&bytes,layout,&gbps,&cycles)!=7) continue; // header or garbage
+		BenchResult r;
+		r.kernels= kernels; r.op= op; r.type= type; r.layout= layout;
+		r.bytes= bytes; r.gbps= gbps; r.cyclesPerElement= cycles;
+		results[r.key()]= r;
+	}
+	fclose(f);
+	return true;
+}
+
+static int diff(const char *oldFile, const char *newFile, double thresholdPercents) {
+	std::map<std::string,BenchResult> oldResults, newResults;
+	if (!readCsv(oldFile,oldResults) || !readCsv(newFile,newResults)) return 2;
+	int regressions= 0, improvements= 0, compared= 0;
+	for (std::map<std::string,BenchResult>::const_iterator it= newResults.begin(); it!=newResults.end(); ++it) {
+		std::map<std::string,BenchResult>::const_iterator old= oldResults.find(it->first);
+		if (old==oldResults.end() || old->second.gbps<=0) continue;
+		compared++;
+		double change= (it->second.gbps/old->second.gbps-1.0)*100.0;
+		if (change< -thresholdPercents) regressions++;
+		else if (change>thresholdPercents) improvements++;
+		else continue;
+		printf("%s %s: %.3f -> %.3f GB/s (%+.1f%%)\n",change<0? "REGRESSION": "improvement",
+			it->first.c_str(),old->second.gbps,it->second.gbps,change);
+	}
+	printf("%d cases compared, %d regressions, %d improvements (threshold %.1f%%)\n",
+		compared,regressions,improvements,thresholdPercents);
+	return regressions>0? 1: 0;
+}
+
+// Distinct operations (or element types) of benchOps, in the table order
+static std::string _benchOpsList(bool types) {
+	std::string result;
+	for (size_t k=0; k<sizeof(benchOps)/sizeof(benchOps[0]); k++) {
+		const char *name= types? benchOps[k].type: benchOps[k].op;
+		if (!result.empty() && _listed(result.c_str(),name)) continue;
+		if (!result.empty()) result+= ",";
+		result+= name;
+	}
+	return result;
+}
+
+static void usage() {
+	fprintf(stderr,
+		"Usage:\n"
+		"    ArraysBench [-csv|-json] [-o file] [-kernels C++,SSE2,AVX2,AVX-512]\n"
+		"                [-ops %s]\n"
+		"                [-types %s]\n"
+		"                [-maxlen bytes] [-time ms]\n"
+		"    ArraysBench -diff old.csv new.csv [-threshold percents]\n",
+		_benchOpsList(false).c_str(),_benchOpsList(true).c_str());
+}
+
+int main(int argc, char *argv[]) {
+	bool json= false;
+	const char *outFile= NULL, *kernelsList= NULL, *opsList= NULL, *typesList= NULL;
+	jlong maxLen= 0;
+	double minSeconds= 0.05, threshold= 5.0;
+	const char *diffOld= NULL, *diffNew= NULL;
+	for (int i=1; i<argc; i++) {
+		const char *a= argv[i];
+		bool hasValue= i+1<argc;
+		if (!strcmp(a,"-csv")) json= false;
+		else if (!strcmp(a,"-json")) json= true;
+		else if (!strcmp(a,"-o") && hasValue) outFile= argv[++i];
+		else if (!strcmp(a,"-kernels") && hasValue) kernelsList= argv[++i];
+		else if (!strcmp(a,"-ops") && hasValue) opsList= argv[++i];
+		else if (!strcmp(a,"-types") && hasValue) typesList= argv[++i];
+		else if (!strcmp(a,"-maxlen") && hasValue) maxLen= atoll(argv[++i]);
+		else if (!strcmp(a,"-time") && hasValue) minSeconds= atof(argv[++i])/1000.0;
+		else if (!strcmp(a,"-threshold") && hasValue) threshold= atof(argv[++i]);
+		else if (!strcmp(a,"-diff") && i+2<argc) { diffOld= argv[++i]; diffNew= argv[++i]; }
+		else { usage(); return 2; }
+	}
+	if (diffOld!=NULL) return diff(diffOld,diffNew,threshold);
+
+	const CpuDescriptor &cpu= _cpuDescriptor();
+	jlong cpuInfo= _cpuInfo();
+	jlong nonTemporalMinLen= _nonTemporalMinLen(cpuInfo);
+	if (maxLen<=0) maxLen= 4*cpu.lastLevelCacheSize();
+	if (maxLen<(1<<20)) maxLen= 1<<20;
+
+	std::vector<ArraysKernels> kernels;
+	kernels.push_back(scalarKernels());
+#ifdef ARRAYS_KERNELS_X86
+	if (cpuInfo & CPU_SSE2) kernels.push_back(kernelsSse2);
+	if (cpuInfo & CPU_AVX2) kernels.push_back(kernelsAvx2);
+	if (cpuInfo & CPU_AVX512) kernels.push_back(kernelsAvx512);
+#endif
+
+	char *bufA= (char*)_alignedAlloc((size_t)maxLen+4096);
+	char *bufB= (char*)_alignedAlloc((size_t)maxLen+4096);
+	if (bufA==NULL || bufB==NULL) {
+		fprintf(stderr,"Cannot allocate 2 x %lld bytes\n",(long long)maxLen);
+		return 2;
+	}
+	for (jlong i=0; i<maxLen+4096; i++) { bufA[i]= (char)(i*7); bufB[i]= (char)(i*13+5); }
+
+	FILE *f= outFile!=NULL? fopen(outFile,"w"): stdout;
+	if (f==NULL) {
+		fprintf(stderr,"Cannot create %s\n",outFile);
+		return 2;
+	}
+	fprintf(stderr,"CPU vendor %d family %d model %d, L1d %lld, L2 %lld, L3 %lld bytes, "
+		"%d logical processors; non-temporal stores from %lld bytes\n",
+		cpu.vendor,cpu.family,cpu.model,(long long)cpu.l1DataSize,(long long)cpu.l2Size,(long long)cpu.l3Size,
+		cpu.logicalProcessors,(long long)nonTemporalMinLen);
+	if (json) fprintf(f,"[");
+	else fprintf(f,"kernels,op,type,bytes,layout,gbps,cyclesPerElement\n");
+	bool first= true;
+	for (size_t ki=0; ki<kernels.size(); ki++) {
+		if (!_listed(kernelsList,kernels[ki].name)) continue;
+		for (size_t oi=0; oi<sizeof(benchOps)/sizeof(benchOps[0]); oi++) {
+			const BenchOp &op= benchOps[oi];
+			if (!_listed(opsList,op.op) || !_listed(typesList,op.type)) continue;
+			for (size_t li=0; li<sizeof(benchLayouts)/sizeof(benchLayouts[0]); li++) {
+				const BenchLayout &layout= benchLayouts[li];
+				if (layout.overlap!=0 && strcmp(op.op,"copy")) continue; // overlap is legal for copying only
+				if (layout.srcOfs!=0 && !op.isPair) continue;
+				for (jlong bytes=16; bytes<=maxLen; bytes*=4) {
+					BenchResult r= runCase(kernels[ki],op,layout,bytes,bufA,bufB,minSeconds,nonTemporalMinLen);
+					printResult(f,r,json,first);
+					first= false;
+				}
+			}
+		}
+	}
+	if (json) fprintf(f,"\n]\n");
+	if (f!=stdout) fclose(f);
+	_alignedFree(bufA);
+	_alignedFree(bufB);
+	return 0;
+}
@@ -0,0 +1,322 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef A_ARRAYSBITS_H__INCLUDED_
+#define A_ARRAYSBITS_H__INCLUDED_
+
+// Packed bits: bit k of a jlong array is (a[k>>6]>>(k&63))&1, like in java.util.BitSet.toLongArray().
+// Operations "dest[destPos+k]= OP(dest[destPos+k],src[srcPos+k])", k<count, at any bit offsets:
+// partial destination words are processed by masks, full ones get 64 source bits by a funnel shift
+// of 2 neighbouring source words. Overlapping areas of the same memory are processed like memmove().
+// Source words after the word containing the last source bit are never read.
+
+#define BITS_COPY 0
+#define BITS_AND 1
+#define BITS_OR 2
+#define BITS_XOR 3
+#define BITS_ANDNOT 4 // dest&= ~src
+#define BITS_NOT 5 // dest= ~src
+
+template <int OP> inline uint64_t _bitsOp(uint64_t d, uint64_t s) {
+	switch (OP) {
+		case BITS_AND: return d&s;
+		case BITS_OR: return d|s;
+		case BITS_XOR: return d^s;
+		case BITS_ANDNOT: return d&~s;
+		case BITS_NOT: return ~s;
+		default: return s;
+	}
+}
+
+// 64 source bits from the bit POS; the bits after LASTWORD are zero
+inline uint64_t _getBits64(const jlong *src, jlong pos, jlong lastWord) {
+	jlong w= pos>>6;
+	int sh= (int)(pos&63);
+	uint64_t v= (uint64_t)src[w]>>sh;
+	if (sh!=0 && w<lastWord) v|= (uint64_t)src[w+1]<<(64-sh);
+	return v;
+}
+
+// N<64 destination bits inside one word
+template <int OP> inline void _bitsPartial(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, int n, jlong lastWord) {
+	int sh= (int)(destPos&63);
+	uint64_t mask= (((uint64_t)1<<n)-1)<<sh;
+	uint64_t d= (uint64_t)dest[destPos>>6];
+	dest[destPos>>6]= (jlong)((d&~mask)|(_bitsOp<OP>(d,_getBits64(src,srcPos,lastWord)<<sh)&mask));
+}
+
+// Full destination words d[0..n-1] from the source bits starting at SRCPOS
+typedef void (*BitsWordsFunction)(jlong *d, const jlong *src, jlong srcPos, jlong n, jlong lastWord, bool backward);
+
+template <int OP> void _bitsWords(jlong *d, const jlong *src, jlong srcPos, jlong n, jlong lastWord, bool backward) {
+	if (backward) {
+		for (jlong k= n-1; k>=0; k--) d[k]= (jlong)_bitsOp<OP>((uint64_t)d[k],_getBits64(src,srcPos+(k<<6),lastWord));
+	} else {
+		for (jlong k= 0; k<n; k++) d[k]= (jlong)_bitsOp<OP>((uint64_t)d[k],_getBits64(src,srcPos+(k<<6),lastWord));
+	}
+}
+
+// Whether the destination starts inside the source area (of the same memory): then the bits are
+// processed from the end, so every source bit is read before it is overwritten
+inline bool _bitsBackward(const jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count) {
+	const jlong *dw= dest+(destPos>>6), *sw= src+(srcPos>>6), *swEnd= src+((srcPos+count-1)>>6);
+	if (dw<sw || dw>swEnd) return false;
+	return dw>sw || (destPos&63)>(srcPos&63);
+}
+
+// Heads and tails of all bit kernels and C++ loops; WORDS processes the full destination words
+template <int OP> inline void _bits(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count,
+	BitsWordsFunction words)
+{
+	if (count<=0) return;
+	jlong lastWord= (srcPos+count-1)>>6;
+	jlong destEnd= destPos+count;
+	jlong w0= (destPos+63)>>6, w1= destEnd>>6; // full destination words are w0..w1-1
+	if (w0>w1) { // all bits inside one destination word
+		_bitsPartial<OP>(dest,destPos,src,srcPos,(int)count,lastWord);
+		return;
+	}
+	int head= (int)((w0<<6)-destPos), tail= (int)(destEnd&63);
+	bool backward= _bitsBackward(dest,destPos,src,srcPos,count);
+	if (backward) {
+		if (tail>0) _bitsPartial<OP>(dest,w1<<6,src,srcPos+count-tail,tail,lastWord);
+		words(dest+w0,src,srcPos+head,w1-w0,lastWord,true);
+		if (head>0) _bitsPartial<OP>(dest,destPos,src,srcPos,head,lastWord);
+	} else {
+		if (head>0) _bitsPartial<OP>(dest,destPos,src,srcPos,head,lastWord);
+		words(dest+w0,src,srcPos+head,w1-w0,lastWord,false);
+		if (tail>0) _bitsPartial<OP>(dest,w1<<6,src,srcPos+count-tail,tail,lastWord);
+	}
+}
+
+// Bit counting and searching without special instructions: C++ loops, heads and tails of SSE2 kernels
+inline int _bitCount64(uint64_t v) {
+	v-= (v>>1)&0x5555555555555555ULL;
+	v= (v&0x3333333333333333ULL)+((v>>2)&0x3333333333333333ULL);
+	v= (v+(v>>4))&0x0F0F0F0F0F0F0F0FULL;
+	return (int)((v*0x0101010101010101ULL)>>56);
+}
+
+// Index of the lowest (highest) set bit of V!=0
+inline int _lowestBit64(uint64_t v) {
+#if defined(__GNUC__)
+	return __builtin_ctzll(v);
+#else
+	int k= 0;
+	if ((uint32_t)v==0) {v>>= 32; k= 32;}
+	while ((v&1)==0) {v>>= 1; k++;}
+	return k;
+#endif
+}
+
+inline int _highestBit64(uint64_t v) {
+#if defined(__GNUC__)
+	return 63-__builtin_clzll(v);
+#else
+	int k= 63;
+	if ((v>>32)==0) {v<<= 32; k= 31;}
+	while ((int64_t)v>=0) {v<<= 1; k--;}
+	return k;
+#endif
+}
+
+// Cardinality of full words a[0..n-1]
+typedef jlong (*BitsCountFunction)(const jlong *a, jlong n);
+
+inline jlong _bitCountWords(const jlong *a, jlong n) {
+	jlong result= 0;
+	for (jlong k= 0; k<n; k++) result+= _bitCount64((uint64_t)a[k]);
+	return result;
+}
+
+// Number of set bits among the bits POS..POS+COUNT-1
+inline jlong _cardinalityBits(const jlong *a, jlong pos, jlong count, BitsCountFunction words) {
+	if (count<=0) return 0;
+	jlong end= pos+count;
+	jlong w0= pos>>6, w1= (end-1)>>6;
+	uint64_t headMask= ~(uint64_t)0<<(pos&63), tailMask= ~(uint64_t)0>>(63-((end-1)&63));
+	if (w0==w1) return _bitCount64((uint64_t)a[w0]&headMask&tailMask);
+	return _bitCount64((uint64_t)a[w0]&headMask)+words(a+w0+1,w1-w0-1)+_bitCount64((uint64_t)a[w1]&tailMask);
+}
+
+// Index of the first (last) word of a[0..n-1], which is not equal to SKIP, or n (-1) if there is no such word
+typedef jlong (*BitsSearchFunction)(const jlong *a, jlong n, jlong skip);
+
+inline jlong _indexOfWord(const jlong *a, jlong n, jlong skip) {
+	jlong k= 0;
+	for (; k<n; k++) if (a[k]!=skip) break;
+	return k;
+}
+
+inline jlong _lastIndexOfWord(const jlong *a, jlong n, jlong skip) {
+	jlong k= n-1;
+	for (; k>=0; k--) if (a[k]!=skip) break;
+	return k;
+}
+
+// Index of the first (last) bit, equal to VALUE, among the bits LOW..HIGH-1, or -1 if there is no such bit.
+// The found words are inverted for VALUE=false, so the searched bit is always 1.
+inline jlong _indexOfBit(const jlong *a, jlong low, jlong high, bool value, BitsSearchFunction words) {
+	if (low>=high) return -1;
+	uint64_t inv= value? 0: ~(uint64_t)0;
+	jlong w0= low>>6, w1= (high-1)>>6;
+	uint64_t headMask= ~(uint64_t)0<<(low&63), tailMask= ~(uint64_t)0>>(63-((high-1)&63));
+	uint64_t v= ((uint64_t)a[w0]^inv)&headMask;
+	if (w0==w1) v&= tailMask;
+	if (v!=0) return (w0<<6)+_lowestBit64(v);
+	if (w0==w1) return -1;
+	jlong k= w0+1+words(a+w0+1,w1-w0-1,(jlong)inv);
+	if (k<w1) return (k<<6)+_lowestBit64((uint64_t)a[k]^inv);
+	v= ((uint64_t)a[w1]^inv)&tailMask;
+	return v!=0? (w1<<6)+_lowestBit64(v): -1;
+}
+
+inline jlong _lastIndexOfBit(const jlong *a, jlong low, jlong high, bool value, BitsSearchFunction words) {
+	if (low>=high) return -1;
+	uint64_t inv= value? 0: ~(uint64_t)0;
+	jlong w0= low>>6, w1= (high-1)>>6;
+	uint64_t headMask= ~(uint64_t)0<<(low&63), tailMask= ~(uint64_t)0>>(63-((high-1)&63));
+	uint64_t v= ((uint64_t)a[w1]^inv)&tailMask;
+	if (w0==w1) v&= headMask;
+	if (v!=0) return (w1<<6)+_highestBit64(v);
+	if (w0==w1) return -1;
+	jlong k= w0+1+words(a+w0+1,w1-w0-1,(jlong)inv);
+	if (k>w0) return (k<<6)+_highestBit64((uint64_t)a[k]^inv);
+	v= ((uint64_t)a[w0]^inv)&headMask;
+	return v!=0? (w0<<6)+_highestBit64(v): -1;
+}
+
+// Threshold packing: bit destPos+k is set if src[k] CMP threshold, k<count, at any destination bit offset.
+// Floating-point compares are false for NaN, like in Java.
+#define PACK_GREATER 0
+#define PACK_LESS 1
+#define PACK_GREATER_OR_EQUAL 2
+#define PACK_LESS_OR_EQUAL 3
+
+template <int CMP, class T> inline bool _packCmp(T v, T threshold) {
+	switch (CMP) {
+		case PACK_GREATER: return v>threshold;
+		case PACK_LESS: return v<threshold;
+		case PACK_GREATER_OR_EQUAL: return v>=threshold;
+		default: return v<=threshold;
+	}
+}
+
+// N<=64 bits from src[0..n-1]
+template <int CMP, class T> inline uint64_t _packBits64(const T *src, int n, T threshold) {
+	uint64_t v= 0;
+	for (int j= 0; j<n; j++) v|= (uint64_t)_packCmp<CMP>(src[j],threshold)<<j;
+	return v;
+}
+
+// N<64 destination bits inside one word
+template <int CMP, class T> inline void _packBitsPartial(jlong *dest, jlong destPos, const T *src, int n, T threshold) {
+	int sh= (int)(destPos&63);
+	uint64_t mask= (((uint64_t)1<<n)-1)<<sh;
+	dest[destPos>>6]= (jlong)(((uint64_t)dest[destPos>>6]&~mask)|(_packBits64<CMP>(src,n,threshold)<<sh));
+}
+
+// Full destination words d[0..n-1] from src[0..64*n-1]
+template <int CMP, class T> void _packBitsWords(jlong *d, const T *src, jlong n, T threshold) {
+	for (jlong k= 0; k<n; k++) d[k]= (jlong)_packBits64<CMP>(src+(k<<6),64,threshold);
+}
+
+// Heads and tails of all packing kernels and C++ loops; WORDS processes the full destination words
+template <int CMP, class T> inline void _packBits(jlong *dest, jlong destPos, const T *src, jlong count, T threshold,
+	void (*words)(jlong *d, const T *src, jlong n, T threshold))
+{
+	if (count<=0) return;
+	jlong destEnd= destPos+count;
+	jlong w0= (destPos+63)>>6, w1= destEnd>>6; // full destination words are w0..w1-1
+	if (w0>w1) { // all bits inside one destination word
+		_packBitsPartial<CMP>(dest,destPos,src,(int)count,threshold);
+		return;
+	}
+	int head= (int)((w0<<6)-destPos), tail= (int)(destEnd&63);
+	if (head>0) _packBitsPartial<CMP>(dest,destPos,src,head,threshold);
+	words(dest+w0,src+head,w1-w0,threshold);
+	if (tail>0) _packBitsPartial<CMP>(dest,w1<<6,src+count-tail,tail,threshold);
+}
+
+template <class T> void _packBitsLoop(jlong *dest, jlong destPos, const T *src, jlong count, T threshold, jint cmp) {
+	switch (cmp) {
+		case PACK_GREATER:
+			_packBits<PACK_GREATER,T>(dest,destPos,src,count,threshold,_packBitsWords<PACK_GREATER,T>); break;
+		case PACK_LESS:
+			_packBits<PACK_LESS,T>(dest,destPos,src,count,threshold,_packBitsWords<PACK_LESS,T>); break;
+		case PACK_GREATER_OR_EQUAL:
+			_packBits<PACK_GREATER_OR_EQUAL,T>(dest,destPos,src,count,threshold,_packBitsWords<PACK_GREATER_OR_EQUAL,T>); break;
+		case PACK_LESS_OR_EQUAL:
+			_packBits<PACK_LESS_OR_EQUAL,T>(dest,destPos,src,count,threshold,_packBitsWords<PACK_LESS_OR_EQUAL,T>); break;
+	}
+}
+
+// Bit unpacking: dest[k]= (bit srcPos+k)? value1: value0, k<count. UNPACK_UNITS changes only the elements
+// of 1 bits (to value1), UNPACK_ZEROS only the elements of 0 bits (to value0).
+#define UNPACK_ALL 0
+#define UNPACK_UNITS 1
+#define UNPACK_ZEROS 2
+
+// N<=64 elements from the bits V
+template <int MODE, class T> inline void _unpackBits64(T *dest, uint64_t v, int n, T value0, T value1) {
+	for (int j= 0; j<n; j++, v>>= 1) {
+		switch (MODE) {
+			case UNPACK_UNITS: if (v&1) dest[j]= value1; break;
+			case UNPACK_ZEROS: if (!(v&1)) dest[j]= value0; break;
+			default: dest[j]= (v&1)? value1: value0; break;
+		}
+	}
+}
+
+// Full blocks of 64 elements dest[0..64*n-1] from the source bits starting at SRCPOS
+template <int MODE, class T> void _unpackBitsWords(T *dest, const jlong *src, jlong srcPos, jlong n, jlong lastWord,
+	T value0, T value1)
+{
+	for (jlong k= 0; k<n; k++) _unpackBits64<MODE>(dest+(k<<6),_getBits64(src,srcPos+(k<<6),lastWord),64,value0,value1);
+}
+
+// The tail of all unpacking kernels and C++ loops; WORDS processes the full blocks
+template <int MODE, class T> inline void _unpackBits(T *dest, const jlong *src, jlong srcPos, jlong count, T value0, T value1,
+	void (*words)(T *dest, const jlong *src, jlong srcPos, jlong n, jlong lastWord, T value0, T value1))
+{
+	if (count<=0) return;
+	jlong lastWord= (srcPos+count-1)>>6;
+	jlong n= count>>6;
+	int tail= (int)(count&63);
+	words(dest,src,srcPos,n,lastWord,value0,value1);
+	if (tail>0) _unpackBits64<MODE>(dest+(n<<6),_getBits64(src,srcPos+(n<<6),lastWord),tail,value0,value1);
+}
+
+template <class T> void _unpackBitsLoop(T *dest, const jlong *src, jlong srcPos, jlong count, T value0, T value1, jint mode) {
+	switch (mode) {
+		case UNPACK_ALL:
+			_unpackBits<UNPACK_ALL,T>(dest,src,srcPos,count,value0,value1,_unpackBitsWords<UNPACK_ALL,T>); break;
+		case UNPACK_UNITS:
+			_unpackBits<UNPACK_UNITS,T>(dest,src,srcPos,count,value0,value1,_unpackBitsWords<UNPACK_UNITS,T>); break;
+		case UNPACK_ZEROS:
+			_unpackBits<UNPACK_ZEROS,T>(dest,src,srcPos,count,value0,value1,_unpackBitsWords<UNPACK_ZEROS,T>); break;
+	}
+}
+
+#endif //A_ARRAYSBITS_H__INCLUDED_
@@ -0,0 +1,170 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef A_ARRAYSCOUNTERS_H__INCLUDED_
+#define A_ARRAYSCOUNTERS_H__INCLUDED_
+
+// Hot-path counters of ArraysNative JNI functions: number of calls, processed bytes,
+// TSC cycles and calls per code path (C++ loop or kernels level), see ArraysKernels::level.
+// Every thread updates its own block without atomic read-modify-write operations;
+// getCountersInternal() sums all blocks. Blocks of finished threads are reused by new threads.
+
+#include <atomic>
+#include <string.h>
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+	#define COUNTERS_TSC() ((jlong)__rdtsc())
+#else
+	#define COUNTERS_TSC() ((jlong)0)
+#endif
+
+// The list of counted JNI functions; new functions must be added to the end
+#define ARRAYS_COUNTERS(C) \
+	C(copyBytes) \
+	C(fillChar) C(fillByte) C(fillShort) C(fillInt) C(fillLong) C(fillFloat) C(fillDouble) C(fillObject) \
+	C(minByte) C(maxByte) C(minByteBuffer) C(maxByteBuffer) \
+	C(minShort) C(maxShort) C(minInt) C(maxInt) C(minLong) C(maxLong) \
+	C(minFloat) C(maxFloat) C(minDouble) C(maxDouble) \
+	C(minuByte) C(maxuByte) C(minuByteBuffer) C(maxuByteBuffer) C(minuShort) C(maxuShort) \
+	C(copyMemory) C(fillMemory) C(minmaxMemory) \
+	C(copyBuffer) C(minmaxBuffer) C(minuLong) C(maxuLong) \
+	C(minChar) C(maxChar) C(minuInt) C(maxuInt) \
+	C(rangeByte) C(rangeChar) C(rangeShort) C(rangeInt) C(rangeLong) C(rangeFloat) C(rangeDouble) \
+	C(add) C(sub) C(adds) C(subs) C(addus) C(subus) C(absDiff) C(absDiffu) C(opposite) \
+	C(copyBits) C(andBits) C(orBits) C(xorBits) C(andNotBits) C(notBits) \
+	C(cardinalityBits) C(indexOfBit) C(lastIndexOfBit) \
+	C(packBitsByte) C(packBitsChar) C(packBitsShort) C(packBitsInt) C(packBitsLong) C(packBitsFloat) C(packBitsDouble) \
+	C(unpackBitsByte) C(unpackBitsChar) C(unpackBitsShort) C(unpackBitsInt) C(unpackBitsLong) C(unpackBitsFloat) \
+	C(unpackBitsDouble) \
+	C(indexOfByte) C(indexOfChar) C(indexOfShort) C(indexOfInt) C(indexOfLong) C(indexOfFloat) C(indexOfDouble) \
+	C(lastIndexOfByte) C(lastIndexOfChar) C(lastIndexOfShort) C(lastIndexOfInt) C(lastIndexOfLong) C(lastIndexOfFloat) \
+	C(lastIndexOfDouble) \
+	C(copyAndSwapShorts) C(copyAndSwapInts) C(copyAndSwapLongs) \
+	C(histogramByte) C(histogramChar) C(histogramShort) C(histogramInt) \
+	C(filter3x3Byte) C(filter3x3Short) C(filter3x3Float) \
+	C(rankByte) C(rankShort) \
+	C(morphologyByte) C(morphologyShort) C(morphologyInt) C(morphologyLong) C(morphologyFloat) C(morphologyDouble) \
+
+#define COUNTER_ENUM_ITEM(NAME) COUNTER_##NAME,
+enum ArraysCounterId {
+	ARRAYS_COUNTERS(COUNTER_ENUM_ITEM)
+	COUNTER_COUNT
+};
+#undef COUNTER_ENUM_ITEM
+
+#define COUNTER_PATHS 4 // C++, SSE2, AVX2, AVX-512
+// Layout of one counter in the snapshot returned to Java
+#define COUNTER_CALLS 0
+#define COUNTER_BYTES 1
+#define COUNTER_CYCLES 2
+#define COUNTER_PATH_CALLS 3
+#define COUNTER_FIELDS (COUNTER_PATH_CALLS+COUNTER_PATHS)
+
+struct ArraysCounterBlock {
+	std::atomic<jlong> values[COUNTER_COUNT][COUNTER_FIELDS];
+	std::atomic<bool> inUse;
+	ArraysCounterBlock *next;
+};
+
+inline std::atomic<bool> &_countersEnabled() {
+	static std::atomic<bool> enabled(true);
+	return enabled;
+}
+
+inline std::atomic<ArraysCounterBlock*> &_counterBlocks() {
+	static std::atomic<ArraysCounterBlock*> head(NULL);
+	return head;
+}
+
+// Values subtracted from the sums: resetting doesn't touch blocks owned by other threads
+inline jlong (&_countersBaseline())[COUNTER_COUNT][COUNTER_FIELDS] {
+	static jlong baseline[COUNTER_COUNT][COUNTER_FIELDS];
+	return baseline;
+}
+
+inline ArraysCounterBlock *_acquireCounterBlock() {
+	for (ArraysCounterBlock *p= _counterBlocks().load(std::memory_order_acquire); p!=NULL; p= p->next) {
+		bool expected= false;
+		if (p->inUse.compare_exchange_strong(expected,true)) return p;
+	}
+	ArraysCounterBlock *p= new ArraysCounterBlock;
+	for (int k=0; k<COUNTER_COUNT; k++)
+		for (int j=0; j<COUNTER_FIELDS; j++) p->values[k][j].store(0,std::memory_order_relaxed);
+	p->inUse.store(true);
+	p->next= _counterBlocks().load(std::memory_order_relaxed);
+	while (!_counterBlocks().compare_exchange_weak(p->next,p,std::memory_order_release,std::memory_order_relaxed)) {
+	}
+	return p;
+}
+
+struct ArraysThreadCounters {
+	ArraysCounterBlock *block;
+	ArraysThreadCounters(): block(_acquireCounterBlock()) {}
+	~ArraysThreadCounters() {block->inUse.store(false);}
+};
+
+inline ArraysCounterBlock *_threadCounters() {
+	static thread_local ArraysThreadCounters counters;
+	return counters.block;
+}
+
+inline void _addCounter(std::atomic<jlong> &counter, jlong increment) {
+	// Only the owner thread writes: load+store is enough and much cheaper than fetch_add
+	counter.store(counter.load(std::memory_order_relaxed)+increment,std::memory_order_relaxed);
+}
+
+// Counts one call of the JNI function from construction until destruction (end of the scope)
+class ArraysCounterScope {
+	ArraysCounterId id;
+	int path;
+	jlong bytes, start;
+public:
+	ArraysCounterScope(ArraysCounterId id, int path, jlong bytes): id(id), path(path), bytes(bytes),
+		start(_countersEnabled().load(std::memory_order_relaxed)? COUNTERS_TSC(): -1) {}
+	~ArraysCounterScope() {
+		if (start==-1) return;
+		jlong cycles= COUNTERS_TSC()-start;
+		std::atomic<jlong> *v= _threadCounters()->values[id];
+		_addCounter(v[COUNTER_CALLS],1);
+		_addCounter(v[COUNTER_BYTES],bytes);
+		_addCounter(v[COUNTER_CYCLES],cycles);
+		_addCounter(v[COUNTER_PATH_CALLS+path],1);
+	}
+};
+
+#define COUNTED(NAME,PATH,BYTES) ArraysCounterScope _counterScope(COUNTER_##NAME,PATH,BYTES);
+
+inline void _countersSum(jlong result[COUNTER_COUNT][COUNTER_FIELDS]) {
+	memset(result,0,sizeof(jlong)*COUNTER_COUNT*COUNTER_FIELDS);
+	for (ArraysCounterBlock *p= _counterBlocks().load(std::memory_order_acquire); p!=NULL; p= p->next)
+		for (int k=0; k<COUNTER_COUNT; k++)
+			for (int j=0; j<COUNTER_FIELDS; j++) result[k][j]+= p->values[k][j].load(std::memory_order_relaxed);
+}
+
+#endif //A_ARRAYSCOUNTERS_H__INCLUDED_
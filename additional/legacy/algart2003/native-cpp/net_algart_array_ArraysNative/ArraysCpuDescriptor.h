@@ -0,0 +1,352 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef A_ARRAYSCPUDESCRIPTOR_H__INCLUDED_
+#define A_ARRAYSCPUDESCRIPTOR_H__INCLUDED_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define CPUID_SUPPORTED
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <unistd.h>
+#endif
+
+// Executes CPUID with the given leaf (EAX) and subleaf (ECX) and stores EAX, EBX, ECX, EDX into regs
+inline void _cpuid(uint32_t regs[4], uint32_t leaf, uint32_t subleaf) {
+#if defined(CPUID_SUPPORTED) && defined(_MSC_VER)
+	__cpuidex((int*)regs,(int)leaf,(int)subleaf);
+#elif defined(CPUID_SUPPORTED)
+	__cpuid_count(leaf,subleaf,regs[0],regs[1],regs[2],regs[3]);
+#else
+	regs[0]= regs[1]= regs[2]= regs[3]= 0;
+#endif
+}
+
+// Returns XCR0: the set of register states (XMM, YMM, ZMM) saved by the OS on context switches
+inline uint64_t _xgetbv0() {
+#if defined(CPUID_SUPPORTED) && defined(_MSC_VER)
+	return _xgetbv(0);
+#elif defined(CPUID_SUPPORTED)
+	uint32_t eax, edx;
+	__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((uint64_t)edx<<32)|eax;
+#else
+	return 0;
+#endif
+}
+
+#define CPU_VENDOR_UNKNOWN 0
+#define CPU_VENDOR_INTEL 1
+#define CPU_VENDOR_AMD 2
+
+// Feature bits of CpuDescriptor::features (not CpuInfo!); AVX-based ones are set only if the OS supports them
+#define CPU_FEATURE_SSE3 ((jlong)1<<0)
+#define CPU_FEATURE_SSSE3 ((jlong)1<<1)
+#define CPU_FEATURE_SSE41 ((jlong)1<<2)
+#define CPU_FEATURE_SSE42 ((jlong)1<<3)
+#define CPU_FEATURE_POPCNT ((jlong)1<<4)
+#define CPU_FEATURE_AVX ((jlong)1<<5)
+#define CPU_FEATURE_FMA ((jlong)1<<6)
+#define CPU_FEATURE_AVX2 ((jlong)1<<7)
+#define CPU_FEATURE_BMI1 ((jlong)1<<8)
+#define CPU_FEATURE_BMI2 ((jlong)1<<9)
+#define CPU_FEATURE_LZCNT ((jlong)1<<10)
+#define CPU_FEATURE_ERMSB ((jlong)1<<11)
+#define CPU_FEATURE_FSRM ((jlong)1<<12)
+#define CPU_FEATURE_AVX512F ((jlong)1<<13)
+#define CPU_FEATURE_AVX512DQ ((jlong)1<<14)
+#define CPU_FEATURE_AVX512CD ((jlong)1<<15)
+#define CPU_FEATURE_AVX512BW ((jlong)1<<16)
+#define CPU_FEATURE_AVX512VL ((jlong)1<<17)
+#define CPU_FEATURE_AVX512VBMI ((jlong)1<<18)
+#define CPU_FEATURE_AVX512VBMI2 ((jlong)1<<19)
+#define CPU_FEATURE_AVX512BITALG ((jlong)1<<20)
+#define CPU_FEATURE_AVX512VPOPCNTDQ ((jlong)1<<21)
+#define CPU_FEATURE_RDTSCP ((jlong)1<<22)
+#define CPU_FEATURE_INVARIANT_TSC ((jlong)1<<23)
+
+// Layout of the long[] returned by ArraysNative.getCpuDescriptorInternal()
+#define CPU_DESCRIPTOR_VENDOR 0
+#define CPU_DESCRIPTOR_FAMILY 1
+#define CPU_DESCRIPTOR_MODEL 2
+#define CPU_DESCRIPTOR_STEPPING 3
+#define CPU_DESCRIPTOR_FEATURES 4
+#define CPU_DESCRIPTOR_L1DATASIZE 5
+#define CPU_DESCRIPTOR_L1INSTRUCTIONSIZE 6
+#define CPU_DESCRIPTOR_L2SIZE 7
+#define CPU_DESCRIPTOR_L3SIZE 8
+#define CPU_DESCRIPTOR_CACHELINESIZE 9
+#define CPU_DESCRIPTOR_L2SHAREDBY 10
+#define CPU_DESCRIPTOR_L3SHAREDBY 11
+#define CPU_DESCRIPTOR_LOGICALPROCESSORS 12
+#define CPU_DESCRIPTOR_PHYSICALCORES 13
+#define CPU_DESCRIPTOR_PACKAGES 14
+#define CPU_DESCRIPTOR_NUMANODES 15
+#define CPU_DESCRIPTOR_NUMANODEMAP 16 // followed by the NUMA node of every logical processor
+
+#define CPU_MAX_LOGICAL_PROCESSORS 4096
+
+struct CpuDescriptor {
+	jint vendor, family, model, stepping;
+	jlong features;
+	jlong l1DataSize, l1InstructionSize, l2Size, l3Size; // in bytes, 0 if unknown or absent
+	jint cacheLineSize;
+	jint l2SharedBy, l3SharedBy; // logical processors sharing one cache (upper bound reported by CPUID)
+	jint logicalProcessors, physicalCores, packages, numaNodes;
+	jint numaNode[CPU_MAX_LOGICAL_PROCESSORS]; // NUMA node of every logical processor
+
+	jlong lastLevelCacheSize() const {
+		return l3Size>0? l3Size: l2Size>0? l2Size: l1DataSize;
+	}
+	// Part of the last level cache available to one core when all cores are working
+	jlong lastLevelCacheSizePerCore() const {
+		jint sharedBy= l3Size>0? l3SharedBy: l2SharedBy;
+		jint threadsPerCore= physicalCores>0 && logicalProcessors>physicalCores? logicalProcessors/physicalCores: 1;
+		jint coresSharing= sharedBy/threadsPerCore;
+		return lastLevelCacheSize()/(coresSharing>1? coresSharing: 1);
+	}
+};
+
+// Deterministic cache parameters: CPUID leaf 4 (Intel) or 0x8000001D (AMD with topology extensions)
+static void _cpuDescriptorCaches(CpuDescriptor &d, uint32_t leaf) {
+	uint32_t regs[4];
+	for (uint32_t subleaf=0; subleaf<32; subleaf++) {
+		_cpuid(regs,leaf,subleaf);
+		uint32_t type= regs[0]&31;
+		if (type==0) break;
+		int level= (regs[0]>>5)&7;
+		jint sharedBy= (jint)((regs[0]>>14)&0xFFF)+1;
+		jlong ways= ((regs[1]>>22)&0x3FF)+1, partitions= ((regs[1]>>12)&0x3FF)+1;
+		jlong lineSize= (regs[1]&0xFFF)+1, sets= (jlong)regs[2]+1;
+		jlong size= ways*partitions*lineSize*sets;
+		if (level==1 && type==1) {d.l1DataSize= size; d.cacheLineSize= (jint)lineSize;}
+		else if (level==1 && type==2) d.l1InstructionSize= size;
+		else if (level==2) {d.l2Size= size; d.l2SharedBy= sharedBy;}
+		else if (level==3) {d.l3Size= size; d.l3SharedBy= sharedBy;}
+	}
+}
+
+// Parses sysfs lists like "0-3,8-11"; calls f(k) for every listed number
+template <class F> static void _parseCpuList(const char *s, F f) {
+	while (*s) {
+		char *end;
+		long from= strtol(s,&end,10);
+		if (end==s) break;
+		long to= from;
+		if (*end=='-') {s= end+1; to= strtol(s,&end,10);}
+		for (long k=from; k<=to; k++) f(k);
+		s= end;
+		if (*s==',') s++; else break;
+	}
+}
+
+static void _cpuDescriptorTopology(CpuDescriptor &d) {
+	d.logicalProcessors= d.physicalCores= d.packages= d.numaNodes= 1;
+#ifdef _WIN32
+	DWORD len= 0;
+	GetLogicalProcessorInformation(NULL,&len);
+	SYSTEM_LOGICAL_PROCESSOR_INFORMATION *info= (SYSTEM_LOGICAL_PROCESSOR_INFORMATION*)malloc(len);
+	if (info!=NULL && GetLogicalProcessorInformation(info,&len)) {
+		int logical= 0, cores= 0, packages= 0, nodes= 0;
+		for (DWORD k=0; k<len/sizeof(*info); k++) {
+			ULONG_PTR mask= info[k].ProcessorMask;
+			switch (info[k].Relationship) {
+			case RelationProcessorCore:
+				cores++;
+				for (; mask!=0; mask&= mask-1) logical++;
+				break;
+			case RelationProcessorPackage:
+				packages++;
+				break;
+			case RelationNumaNode:
+				nodes++;
+				for (int j=0; j<(int)(8*sizeof(mask)) && j<CPU_MAX_LOGICAL_PROCESSORS; j++)
+					if (mask&((ULONG_PTR)1<<j)) d.numaNode[j]= info[k].NumaNode.NodeNumber;
+				break;
+			default:
+				break;
+			}
+		}
+		if (cores>0) {d.logicalProcessors= logical; d.physicalCores= cores;}
+		if (packages>0) d.packages= packages;
+		if (nodes>0) d.numaNodes= nodes;
+	}
+	free(info);
+#else
+	char path[128], line[4096];
+	static jint packageOfCore[CPU_MAX_LOGICAL_PROCESSORS], idOfCore[CPU_MAX_LOGICAL_PROCESSORS];
+	jint logical= 0, cores= 0, packages= 0, maxPackage= -1;
+	long confCpus= sysconf(_SC_NPROCESSORS_CONF);
+	for (long cpu=0; cpu<confCpus && cpu<CPU_MAX_LOGICAL_PROCESSORS; cpu++) {
+		int package= -1, core= -1;
+		sprintf(path,"/sys/devices/system/cpu/cpu%ld/topology/physical_package_id",cpu);
+		FILE *f= fopen(path,"r");
+		if (f==NULL) continue; // offline or no sysfs
+		if (fscanf(f,"%d",&package)!=1) package= 0;
+		fclose(f);
+		sprintf(path,"/sys/devices/system/cpu/cpu%ld/topology/core_id",cpu);
+		f= fopen(path,"r");
+		if (f!=NULL) {
+			if (fscanf(f,"%d",&core)!=1) core= -1;
+			fclose(f);
+		}
+		logical++;
+		bool found= false;
+		for (jint j=0; j<cores; j++) if (packageOfCore[j]==package && idOfCore[j]==core) {found= true; break;}
+		if (!found) {packageOfCore[cores]= package; idOfCore[cores]= core; cores++;}
+		if (package>maxPackage) {maxPackage= package; packages++;}
+	}
+	if (logical>0) {
+		d.logicalProcessors= logical;
+		d.physicalCores= cores;
+		d.packages= packages>0? packages: 1;
+	} else if (sysconf(_SC_NPROCESSORS_ONLN)>0) {
+		d.logicalProcessors= d.physicalCores= (jint)sysconf(_SC_NPROCESSORS_ONLN);
+	}
+	jint nodes= 0;
+	for (int node=0; node<CPU_MAX_LOGICAL_PROCESSORS; node++) {
+		sprintf(path,"/sys/devices/system/node/node%d/cpulist",node);
+		FILE *f= fopen(path,"r");
+		if (f==NULL) {
+			if (node>=64) break; // node numbers may be sparse, but not so much
+			continue;
+		}
+		if (fgets(line,sizeof(line),f)!=NULL) {
+			_parseCpuList(line,[&](long cpu) {
+				if (cpu>=0 && cpu<CPU_MAX_LOGICAL_PROCESSORS) d.numaNode[cpu]= node;
+			});
+		}
+		fclose(f);
+		nodes++;
+	}
+	if (nodes>0) d.numaNodes= nodes;
+#endif
+}
+
+static CpuDescriptor _detectCpuDescriptor() {
+	CpuDescriptor d;
+	memset(&d,0,sizeof(d));
+#ifdef CPUID_SUPPORTED
+	uint32_t regs[4];
+	_cpuid(regs,0,0);
+	uint32_t maxLeaf= regs[0];
+	char vendor[13];
+	memcpy(vendor,&regs[1],4); memcpy(vendor+4,&regs[3],4); memcpy(vendor+8,&regs[2],4); vendor[12]= 0;
+	d.vendor= strcmp(vendor,"GenuineIntel")==0? CPU_VENDOR_INTEL:
+		strcmp(vendor,"AuthenticAMD")==0 || strcmp(vendor,"HygonGenuine")==0? CPU_VENDOR_AMD:
+		CPU_VENDOR_UNKNOWN;
+	_cpuid(regs,0x80000000,0);
+	uint32_t maxExtLeaf= regs[0];
+
+	if (maxLeaf>=1) {
+		_cpuid(regs,1,0);
+		uint32_t eax= regs[0], ecx= regs[2];
+		d.stepping= eax&15;
+		d.family= (eax>>8)&15;
+		d.model= (eax>>4)&15;
+		if (d.family==15) d.family+= (eax>>20)&0xFF;
+		if (d.family>=6) d.model+= ((eax>>16)&15)<<4;
+		if (ecx&(1<<0)) d.features|= CPU_FEATURE_SSE3;
+		if (ecx&(1<<9)) d.features|= CPU_FEATURE_SSSE3;
+		if (ecx&(1<<19)) d.features|= CPU_FEATURE_SSE41;
+		if (ecx&(1<<20)) d.features|= CPU_FEATURE_SSE42;
+		if (ecx&(1<<23)) d.features|= CPU_FEATURE_POPCNT;
+		uint64_t xcr0= (ecx&(1<<27))? _xgetbv0(): 0;
+		bool osAvx= (xcr0&0x6)==0x6, osAvx512= (xcr0&0xE6)==0xE6;
+		if (osAvx && (ecx&(1<<28))) d.features|= CPU_FEATURE_AVX;
+		if (osAvx && (ecx&(1<<12))) d.features|= CPU_FEATURE_FMA;
+		if (maxLeaf>=7) {
+			_cpuid(regs,7,0);
+			uint32_t ebx7= regs[1], ecx7= regs[2], edx7= regs[3];
+			if (ebx7&(1<<3)) d.features|= CPU_FEATURE_BMI1;
+			if (ebx7&(1<<8)) d.features|= CPU_FEATURE_BMI2;
+			if (ebx7&(1<<9)) d.features|= CPU_FEATURE_ERMSB;
+			if (edx7&(1<<4)) d.features|= CPU_FEATURE_FSRM;
+			if (osAvx && (ebx7&(1<<5))) d.features|= CPU_FEATURE_AVX2;
+			if (osAvx512) {
+				if (ebx7&(1u<<16)) d.features|= CPU_FEATURE_AVX512F;
+				if (ebx7&(1u<<17)) d.features|= CPU_FEATURE_AVX512DQ;
+				if (ebx7&(1u<<28)) d.features|= CPU_FEATURE_AVX512CD;
+				if (ebx7&(1u<<30)) d.features|= CPU_FEATURE_AVX512BW;
+				if (ebx7&(1u<<31)) d.features|= CPU_FEATURE_AVX512VL;
+				if (ecx7&(1u<<1)) d.features|= CPU_FEATURE_AVX512VBMI;
+				if (ecx7&(1u<<6)) d.features|= CPU_FEATURE_AVX512VBMI2;
+				if (ecx7&(1u<<12)) d.features|= CPU_FEATURE_AVX512BITALG;
+				if (ecx7&(1u<<14)) d.features|= CPU_FEATURE_AVX512VPOPCNTDQ;
+			}
+		}
+	}
+	if (maxExtLeaf>=0x80000001) {
+		_cpuid(regs,0x80000001,0);
+		if (regs[2]&(1<<5)) d.features|= CPU_FEATURE_LZCNT;
+		if (regs[3]&(1<<27)) d.features|= CPU_FEATURE_RDTSCP;
+	}
+	if (maxExtLeaf>=0x80000007) {
+		_cpuid(regs,0x80000007,0);
+		if (regs[3]&(1<<8)) d.features|= CPU_FEATURE_INVARIANT_TSC;
+	}
+
+	if (d.vendor==CPU_VENDOR_INTEL && maxLeaf>=4) {
+		_cpuDescriptorCaches(d,4);
+	} else if (d.vendor==CPU_VENDOR_AMD && maxExtLeaf>=0x8000001D) {
+		_cpuid(regs,0x80000001,0);
+		if (regs[2]&(1<<22)) _cpuDescriptorCaches(d,0x8000001D); // topology extensions
+	}
+	if (d.l1DataSize==0 && maxExtLeaf>=0x80000005) { // old AMD processors
+		_cpuid(regs,0x80000005,0);
+		d.l1DataSize= (jlong)(regs[2]>>24)*1024;
+		d.l1InstructionSize= (jlong)(regs[3]>>24)*1024;
+		d.cacheLineSize= regs[2]&0xFF;
+		if (maxExtLeaf>=0x80000006) {
+			_cpuid(regs,0x80000006,0);
+			d.l2Size= (jlong)(regs[2]>>16)*1024;
+			d.l3Size= (jlong)(regs[3]>>18)*512*1024;
+		}
+	}
+#endif //CPUID_SUPPORTED
+	if (d.cacheLineSize==0) d.cacheLineSize= 64;
+	_cpuDescriptorTopology(d);
+	if (d.l2SharedBy==0) d.l2SharedBy= 1;
+	if (d.l3SharedBy==0) d.l3SharedBy= d.logicalProcessors;
+	return d;
+}
+
+inline const CpuDescriptor &_cpuDescriptor() {
+	static const CpuDescriptor descriptor= _detectCpuDescriptor();
+	return descriptor;
+}
+
+#endif //A_ARRAYSCPUDESCRIPTOR_H__INCLUDED_
@@ -0,0 +1,212 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef A_ARRAYSFILTER3X3_H__INCLUDED_
+#define A_ARRAYSFILTER3X3_H__INCLUDED_
+
+// 3x3 filters of a dimX x dimY matrix, stored row by row: every result element is calculated from
+// the 3x3 square (or cross) around the same source element. Like in net.algart.matrices.filters3x3,
+// the matrix is continued pseudo-cyclically: the left neighbour of the first column is the last column
+// of the same row, the upper neighbour of the first row is the last row, and so on.
+// jbyte and jshort elements are unsigned (0..255, 0..65535); Java char is filtered as jshort.
+// jfloat minimum and maximum are Java Math.min/max: -0.0 is less than +0.0, and NaN is contagious,
+// so erosions, dilations and percentiles of every 3x3 square (cross) containing NaN are NaN.
+// jfloat averages and gradients are calculated in jdouble and rounded to jfloat once (see Filter3x3Elem),
+// like the double arithmetic of net.algart.matrices.filters3x3; the average sums 3 vertical sums.
+#define FILTER3X3_EROSION_BY_SQUARE 0
+#define FILTER3X3_DILATION_BY_SQUARE 1
+#define FILTER3X3_EROSION_BY_CROSS 2
+#define FILTER3X3_DILATION_BY_CROSS 3
+#define FILTER3X3_AVERAGE_BY_SQUARE 4       // (sum+4)/9; jfloat: sum/9 in double
+#define FILTER3X3_PERCENTILE_BY_SQUARE 5    // the element #percentileIndex (0..8) of 9 sorted ones, 4: median
+#define FILTER3X3_QUICK_GRADIENT_BY_CROSS 6 // (|right-left|+|down-up|)/2; integers are rounded down
+
+// Work memory of one kernel call: 3 rows of sorted columns (percentiles) or 1 row of double sums
+#define FILTER3X3_WORK_BYTES(dimX) (12*(size_t)(dimX))
+
+#include <stdlib.h> // abs()
+#include <math.h> // fabs()
+#include "ArraysJavaMath.h"
+
+// Scalar elements: V is the type of values (unsigned integers are extended to jint),
+// Sum is the type of vertical sums of 3 values; float minimum and maximum are Java Math.min/max
+template <class T> struct Filter3x3Elem;
+template <> struct Filter3x3Elem<jbyte> {
+	typedef jint V;
+	typedef jint Sum;
+	static inline V get(jbyte v)                        {return (uint8_t)v;}
+	static inline jbyte set(V v)                        {return (jbyte)v;}
+	static inline V min(V a, V b)                       {return a<b? a: b;}
+	static inline V max(V a, V b)                       {return a>b? a: b;}
+	static inline Sum sum(V a, V b, V c)                {return a+b+c;}
+	static inline jbyte average(Sum s)                  {return (jbyte)((s+4)/9);}
+	static inline jbyte gradient(V l, V r, V u, V d)    {return (jbyte)((abs(r-l)+abs(d-u))>>1);}
+};
+template <> struct Filter3x3Elem<jshort> {
+	typedef jint V;
+	typedef jint Sum;
+	static inline V get(jshort v)                       {return (uint16_t)v;}
+	static inline jshort set(V v)                       {return (jshort)v;}
+	static inline V min(V a, V b)                       {return a<b? a: b;}
+	static inline V max(V a, V b)                       {return a>b? a: b;}
+	static inline Sum sum(V a, V b, V c)                {return a+b+c;}
+	static inline jshort average(Sum s)                 {return (jshort)((s+4)/9);}
+	static inline jshort gradient(V l, V r, V u, V d)   {return (jshort)((abs(r-l)+abs(d-u))>>1);}
+};
+template <> struct Filter3x3Elem<jfloat> {
+	typedef jfloat V;
+	typedef jdouble Sum;
+	static inline V get(jfloat v)                       {return v;}
+	static inline jfloat set(V v)                       {return v;}
+	static inline V min(V a, V b)                       {return _javaMinF(a,b);}
+	static inline V max(V a, V b)                       {return _javaMaxF(a,b);}
+	static inline Sum sum(V a, V b, V c)                {return ((jdouble)a+b)+c;}
+	static inline jfloat average(Sum s)                 {return (jfloat)(s/9);}
+	static inline jfloat gradient(V l, V r, V u, V d) {
+		return (jfloat)((fabs((jdouble)r-l)+fabs((jdouble)d-u))*0.5);
+	}
+};
+
+// The following functions are used both for scalar values (O is Filter3x3Elem) and for vectors
+// (O has the same V, min and max): sorting networks of min/max without branches.
+template <class O> inline void _sort3(typename O::V &a, typename O::V &b, typename O::V &c) {
+	typename O::V t= O::min(a,b); b= O::max(a,b); a= t;
+	t= O::min(b,c); c= O::max(b,c); b= t;
+	t= O::min(a,b); b= O::max(a,b); a= t;
+}
+
+// The element #K of 9 sorted values, given as 3 columns sorted vertically: lo, mid and hi of the columns
+// 0, 1, 2 (the vertical sorts are made once per source column and reused by 3 results). After sorting
+// also the rows lo, mid and hi, m[i][j] increases along both i and j, and the element #K is the minimum
+// of max(D) over all "staircase" subsets D of K+1 elements (m[i][j] in D means that all m[i'][j'],
+// i'<=i, j'<=j are in D). Unused min/max are removed by the compiler for every K.
+template <int K, class O> inline typename O::V _percentile9(
+	typename O::V l0, typename O::V l1, typename O::V l2,
+	typename O::V m0, typename O::V m1, typename O::V m2,
+	typename O::V h0, typename O::V h1, typename O::V h2)
+{
+	_sort3<O>(l0,l1,l2);
+	_sort3<O>(m0,m1,m2);
+	_sort3<O>(h0,h1,h2);
+	switch (K) {
+		case 0: return l0;
+		case 1: return O::min(l1,m0);
+		case 2: return O::min(O::min(l2,h0),O::max(l1,m0));
+		case 3: return O::min(O::min(O::max(l2,m0),m1),O::max(l1,h0));
+		case 4: return O::max(O::min(l2,m1),O::min(O::max(l2,m1),h0)); // median of l2, m1, h0
+		case 5: return O::max(O::max(O::min(h0,m2),m1),O::min(h1,l2));
+		case 6: return O::max(O::max(h0,l2),O::min(h1,m2));
+		case 7: return O::max(h1,m2);
+		default: return h2;
+	}
+}
+
+// Pointers to the rows y-1, y, y+1 (cyclically)
+template <class T> inline void _filter3x3Lines(const T *src, jlong dimX, jlong dimY, jlong y,
+	const T *&up, const T *&middle, const T *&down)
+{
+	up= src+(y>0? y-1: dimY-1)*dimX;
+	middle= src+y*dimX;
+	down= src+(y<dimY-1? y+1: 0)*dimX;
+}
+
+template <int K, class T> inline void _percentile3x3Columns(T *dest, const T *up, const T *middle, const T *down,
+	jlong dimX, jlong from, jlong to)
+{
+	typedef Filter3x3Elem<T> E;
+	for (jlong x= from; x<to; x++) {
+		jlong xl= x>0? x-1: dimX-1, xr= x<dimX-1? x+1: 0;
+		typename E::V l0= E::get(up[xl]), m0= E::get(middle[xl]), h0= E::get(down[xl]);
+		typename E::V l1= E::get(up[x]), m1= E::get(middle[x]), h1= E::get(down[x]);
+		typename E::V l2= E::get(up[xr]), m2= E::get(middle[xr]), h2= E::get(down[xr]);
+		_sort3<E>(l0,m0,h0);
+		_sort3<E>(l1,m1,h1);
+		_sort3<E>(l2,m2,h2);
+		dest[x]= E::set(_percentile9<K,E>(l0,l1,l2,m0,m1,m2,h0,h1,h2));
+	}
+}
+
+// The results dest[from..to-1] of one row from the source rows up, middle and down (C++ loop; SIMD
+// kernels use it for the first and the last columns)
+template <class T> inline void _filter3x3Columns(T *dest, const T *up, const T *middle, const T *down,
+	jlong dimX, jint filter, jint percentileIndex, jlong from, jlong to)
+{
+	typedef Filter3x3Elem<T> E;
+	if (filter==FILTER3X3_PERCENTILE_BY_SQUARE) {
+		switch (percentileIndex) {
+			case 0: _percentile3x3Columns<0>(dest,up,middle,down,dimX,from,to); break;
+			case 1: _percentile3x3Columns<1>(dest,up,middle,down,dimX,from,to); break;
+			case 2: _percentile3x3Columns<2>(dest,up,middle,down,dimX,from,to); break;
+			case 3: _percentile3x3Columns<3>(dest,up,middle,down,dimX,from,to); break;
+			case 4: _percentile3x3Columns<4>(dest,up,middle,down,dimX,from,to); break;
+			case 5: _percentile3x3Columns<5>(dest,up,middle,down,dimX,from,to); break;
+			case 6: _percentile3x3Columns<6>(dest,up,middle,down,dimX,from,to); break;
+			case 7: _percentile3x3Columns<7>(dest,up,middle,down,dimX,from,to); break;
+			case 8: _percentile3x3Columns<8>(dest,up,middle,down,dimX,from,to); break;
+		}
+		return;
+	}
+	for (jlong x= from; x<to; x++) {
+		jlong xl= x>0? x-1: dimX-1, xr= x<dimX-1? x+1: 0;
+		typename E::V u= E::get(up[x]), l= E::get(middle[xl]), m= E::get(middle[x]), r= E::get(middle[xr]);
+		typename E::V d= E::get(down[x]);
+		switch (filter) {
+			case FILTER3X3_EROSION_BY_SQUARE:
+				dest[x]= E::set(E::min(E::min(E::min(E::get(up[xl]),E::get(down[xl])),E::min(u,d)),
+					E::min(E::min(E::get(up[xr]),E::get(down[xr])),E::min(E::min(l,m),r))));
+				break;
+			case FILTER3X3_DILATION_BY_SQUARE:
+				dest[x]= E::set(E::max(E::max(E::max(E::get(up[xl]),E::get(down[xl])),E::max(u,d)),
+					E::max(E::max(E::get(up[xr]),E::get(down[xr])),E::max(E::max(l,m),r))));
+				break;
+			case FILTER3X3_EROSION_BY_CROSS:
+				dest[x]= E::set(E::min(E::min(u,d),E::min(E::min(l,m),r)));
+				break;
+			case FILTER3X3_DILATION_BY_CROSS:
+				dest[x]= E::set(E::max(E::max(u,d),E::max(E::max(l,m),r)));
+				break;
+			case FILTER3X3_AVERAGE_BY_SQUARE:
+				dest[x]= E::average((E::sum(E::get(up[xl]),l,E::get(down[xl]))+E::sum(u,m,d))
+					+E::sum(E::get(up[xr]),r,E::get(down[xr])));
+				break;
+			case FILTER3X3_QUICK_GRADIENT_BY_CROSS:
+				dest[x]= E::gradient(l,r,u,d);
+				break;
+		}
+	}
+}
+
+// C++ loop: the rows fromY..toY-1 of the result (see ArraysKernels::filter3x3Byte)
+template <class T> void _filter3x3Loop(T *dest, const T *src, jlong dimX, jlong dimY, jlong fromY, jlong toY,
+	jint filter, jint percentileIndex, void *)
+{
+	for (jlong y= fromY; y<toY; y++) {
+		const T *up, *middle, *down;
+		_filter3x3Lines(src,dimX,dimY,y,up,middle,down);
+		_filter3x3Columns(dest+y*dimX,up,middle,down,dimX,filter,percentileIndex,0,dimX);
+	}
+}
+
+#endif //A_ARRAYSFILTER3X3_H__INCLUDED_
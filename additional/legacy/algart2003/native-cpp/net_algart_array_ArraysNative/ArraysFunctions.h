@@ -22,108 +22,81 @@
  * SOFTWARE.
  */
 
+
 #ifndef A_ARRAYSFUNCTIONS_H__INCLUDED_
 #define A_ARRAYSFUNCTIONS_H__INCLUDED_
 
-#pragma warning(disable: 4731)
-__int64 _cpuInfo() {
+#include "ArraysCpuDescriptor.h"
+
+jlong _cpuInfo() {
 	static bool cpuInfoCalculated= false;
-	static __int64 cpuInfoLast= 0;
+	static jlong cpuInfoLast= 0;
 	if (cpuInfoCalculated) return cpuInfoLast;
 	cpuInfoCalculated= true;
-	static __int32 maxArgForCpuId;
-	unsigned __int32 cpuid1regEAX;
-	unsigned __int32 amdFeatures= 0;
-	unsigned __int32 l1d= 0, l2= 0; // in KB
-	signed __int32 cpuid2regs[4];
-	unsigned __int8 *cpuid2info= (unsigned __int8*)cpuid2regs;
-	try {
-		__asm {
-			pushad;
-			xor eax,eax;
-			_emit 0Fh;
-			_emit 0A2h; //cpuid;
-			or eax,eax;
-			jz _Exit;
-			mov maxArgForCpuId,eax;
-
-			mov eax,1;
-			_emit 0Fh;
-			_emit 0A2h; //cpuid;
-			mov cpuid1regEAX,eax;
-			test edx,CPU_FPU;
-			jnz _FPU_Ok;
-				and edx,~CPU_CMOV;
-_FPU_Ok:
-			test edx,CPU_MMX;
-			jnz _MMX_Ok;
-				and edx,~(CPU_SSE|CPU_SSE2)
-_MMX_Ok:
-			test edx,CPU_SSE;
-			jnz _SSE_Ok;
-				and edx,~CPU_SSE2
-_SSE_Ok:
-			mov dword ptr cpuInfoLast,edx;
+#ifdef CPUID_SUPPORTED
+	uint32_t regs[4];
+	uint32_t amdFeatures= 0;
+	uint32_t l1d= 0, l2= 0; // in KB
+	int32_t cpuid2regs[4];
+	uint8_t *cpuid2info= (uint8_t*)cpuid2regs;
 
-			mov eax,0x80000000;
-			_emit 0Fh;
-			_emit 0A2h; //cpuid;
-			cmp eax,0x80000005;
-			jb _NoAMD_K6IIIPLUS;
-			
-			push eax;
-			mov eax,0x80000001;
-			_emit 0Fh;
-			_emit 0A2h; //cpuid;
-			or edx,CPU_AMD_L;
-			test edx,CPU_3DNOW_L;
-			jnz _3DNOW_Ok;
-				and edx,~CPU_3DNOWEX_L;
-_3DNOW_Ok:
-			mov amdFeatures,edx;
-			mov eax,0x80000005;
-			_emit 0Fh;
-			_emit 0A2h; //cpuid;
-			shr ecx,24;
-			mov l1d,ecx;
-			pop eax;
+	_cpuid(regs,0,0);
+	uint32_t maxArgForCpuId= regs[0];
+	if (maxArgForCpuId==0) return cpuInfoLast= 0;
 
-			cmp eax,0x80000006;
-			jb _Exit;
-			mov eax,0x80000006;
-			_emit 0Fh;
-			_emit 0A2h; //cpuid;
-			shr ecx,16;
-			mov l2,ecx;
-			jmp _Exit;
+	_cpuid(regs,1,0);
+	uint32_t cpuid1regEAX= regs[0];
+	uint32_t cpuid1regECX= regs[2];
+	uint32_t edx= regs[3];
+	if (!(edx&CPU_FPU)) edx&= ~CPU_CMOV;
+	if (!(edx&CPU_MMX)) edx&= ~(CPU_SSE|CPU_SSE2);
+	if (!(edx&CPU_SSE)) edx&= ~CPU_SSE2;
+	cpuInfoLast= edx;
 
-_NoAMD_K6IIIPLUS:
+	// AVX2 and AVX-512 kernels are used only if the OS saves YMM/ZMM registers (OSXSAVE + XCR0)
+	if ((edx&CPU_SSE2) && (cpuid1regECX&(1<<27)) && maxArgForCpuId>=7) {
+		uint64_t xcr0= _xgetbv0();
+		_cpuid(regs,7,0);
+		uint32_t ebx7= regs[1];
+		bool avx= (cpuid1regECX&(1<<28))!=0 && (xcr0&0x6)==0x6;
+		bool popcnt= (cpuid1regECX&(1<<23))!=0;
+		bool bmi1= (ebx7&(1<<3))!=0, avx2= (ebx7&(1<<5))!=0, bmi2= (ebx7&(1<<8))!=0;
+		if (avx && avx2 && bmi1 && bmi2 && popcnt) {
+			cpuInfoLast|= CPU_AVX2;
+			const uint32_t avx512fdqbwvl= (1u<<16)|(1u<<17)|(1u<<30)|(1u<<31);
+			if ((ebx7&avx512fdqbwvl)==avx512fdqbwvl && (xcr0&0xE6)==0xE6) {
+				cpuInfoLast|= CPU_AVX512;
+				if (regs[2]&(1u<<14)) cpuInfoLast|= CPU_AVX512POPCNT; // AVX512_VPOPCNTDQ
+			}
+		}
+	}
 
-			cmp maxArgForCpuId,2;
-			jb _Exit;
-			mov eax,2;
-			_emit 0Fh;
-			_emit 0A2h; //cpuid;
-			mov cpuid2regs[0],eax;
-			mov cpuid2regs[4],ebx;
-			mov cpuid2regs[8],ecx;
-			mov cpuid2regs[12],edx;
-_Exit:
-			popad;
+	_cpuid(regs,0x80000000,0);
+	uint32_t maxExtArgForCpuId= regs[0];
+	if (maxExtArgForCpuId>=0x80000005) {
+		_cpuid(regs,0x80000001,0);
+		amdFeatures= regs[3]|CPU_AMD_L;
+		if (!(amdFeatures&CPU_3DNOW_L)) amdFeatures&= ~CPU_3DNOWEX_L;
+		_cpuid(regs,0x80000005,0);
+		l1d= regs[2]>>24;
+		if (maxExtArgForCpuId>=0x80000006) {
+			_cpuid(regs,0x80000006,0);
+			l2= regs[2]>>16;
 		}
-	} catch (...) {
-		return cpuInfoLast= 0;
+	} else if (maxArgForCpuId>=2) {
+		_cpuid((uint32_t*)cpuid2regs,2,0);
 	}
+
 	if (cpuInfoLast&CPU_SSE) cpuInfoLast|=CPU_MMXEX;
 		// Under construction: checking AMD Athlon should be added here
 	int cpuFamily= (cpuid1regEAX>>8)&15;
 	if (cpuFamily==15) cpuFamily= (cpuid1regEAX>>20)&15; //Pentium 4+
-	cpuInfoLast|= (__int64)(cpuFamily&CPU_FAMILY)<<CPU_FAMILY_SHIFT;
-	cpuInfoLast|= (__int64)(amdFeatures&(CPU_AMD_L|CPU_3DNOW_L|CPU_3DNOWEX_L))<<32;
+	cpuInfoLast|= (jlong)(cpuFamily&CPU_FAMILY)<<CPU_FAMILY_SHIFT;
+	cpuInfoLast|= (jlong)(amdFeatures&(CPU_AMD_L|CPU_3DNOW_L|CPU_3DNOWEX_L))<<32;
 	if (amdFeatures==0 && maxArgForCpuId>=2) {
 		for (int j=0; j<4; j++) if (cpuid2regs[j]<0) cpuid2regs[j]= 0;
 		for (int k=1 /*skipping AL*/; k<16; k++) {
-			unsigned __int8 v= cpuid2info[k];
+			uint8_t v= cpuid2info[k];
 			int vl= v&0xF;
 			switch(v>>4) {
 			case 0:
@@ -146,12 +119,30 @@ _Exit:
 			}
 		}
 	}
+	const CpuDescriptor &descriptor= _cpuDescriptor(); // CPUID leaf 4: more reliable than leaf 2 descriptors
+	if (descriptor.l1DataSize>0) l1d= (uint32_t)(descriptor.l1DataSize/1024);
+	if (descriptor.l2Size>0) l2= (uint32_t)(descriptor.l2Size/1024);
 	l1d/= CPU_L1DATASIZE_UNIT/1024;
 	l2/= CPU_L2SIZE_UNIT/1024;
-	cpuInfoLast|= ((__int64)(l1d&CPU_L1DATASIZE))<<CPU_L1DATASIZE_SHIFT;
-	cpuInfoLast|= ((__int64)(l2&CPU_L2SIZE))<<CPU_L2SIZE_SHIFT;
+	if (l1d>CPU_L1DATASIZE) l1d= CPU_L1DATASIZE;
+	if (l2>CPU_L2SIZE) l2= CPU_L2SIZE;
+	cpuInfoLast|= ((jlong)(l1d&CPU_L1DATASIZE))<<CPU_L1DATASIZE_SHIFT;
+	cpuInfoLast|= ((jlong)(l2&CPU_L2SIZE))<<CPU_L2SIZE_SHIFT;
+#endif //CPUID_SUPPORTED
 	return cpuInfoLast;
 }
-#pragma warning(default: 4731)
+
+// L2 cache size in bytes, as packed into CpuInfo by _cpuInfo(); at least 64 KB
+inline jlong _l2CacheSize(jlong cpuInfo) {
+	jlong cacheSize= ((cpuInfo>>CPU_L2SIZE_SHIFT)&CPU_L2SIZE)*CPU_L2SIZE_UNIT;
+	return cacheSize<65536? 65536: cacheSize;
+}
+
+// Minimal size of the written area (in bytes), from which it's better to write bypassing the caches:
+// the last level cache size, if known, else L2 size from CpuInfo
+inline jlong _nonTemporalMinLen(jlong cpuInfo) {
+	jlong cacheSize= _cpuDescriptor().lastLevelCacheSize();
+	return cacheSize>0? cacheSize: _l2CacheSize(cpuInfo);
+}
 
 #endif //A_ARRAYSFUNCTIONS_H__INCLUDED_
@@ -0,0 +1,150 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef A_ARRAYSHISTOGRAM_H__INCLUDED_
+#define A_ARRAYSHISTOGRAM_H__INCLUDED_
+
+// Histograms: bars[v>>shift]++ for every element v, where jbyte, jchar and jshort elements are unsigned
+// (0..255, 0..65535) and jint elements are signed; elements with v>>shift out of 0..barsLen-1 are skipped.
+// Neighbouring elements of images are often equal: incrementing one counter, every increment would wait
+// for the previous store (store-to-load forwarding). Several interleaved sub-histograms (element k goes to
+// the sub-histogram k%SUBS, SUBS=8, 4 or 2) break this dependency; they have 32-bit counters and are added to the 64-bit
+// bars at the end of every block. Large arrays are split between the pool threads.
+
+#include <vector>
+
+#define HISTOGRAM_BLOCK_LEN ((jlong)1<<30) // less than 2^32 increments of one 32-bit counter
+// Sub-histograms should stay in L1 (8 x 256 bars, 8 KB) or L2 (4 x 4096 bars, 64 KB) cache
+#define HISTOGRAM_L1_BARS 256
+#define HISTOGRAM_L2_BARS 4096
+
+inline uint32_t _histogramBin(jbyte v, jint shift)  {return (uint32_t)(uint8_t)v>>shift;}
+inline uint32_t _histogramBin(jchar v, jint shift)  {return (uint32_t)v>>shift;}
+inline uint32_t _histogramBin(jshort v, jint shift) {return (uint32_t)(uint16_t)v>>shift;}
+inline uint32_t _histogramBin(jint v, jint shift)   {return (uint32_t)(v>>shift);} // negative v: skipped
+
+// The maximal bin of the type: if it is less than barsLen, no element is skipped
+template <class T> inline uint32_t _histogramMaxBin(jint shift) {
+	return sizeof(T)==4? 0xFFFFFFFFu: (uint32_t)((((jlong)1<<(8*sizeof(T)))-1)>>shift);
+}
+
+// sub: SUBS*barsLen zero counters, left zero after the call. The loop is unrolled by 8 elements; element k+j
+// goes to the sub-histogram j%SUBS. Separate pointers (not an array of pointers) let the compiler keep them
+// in registers.
+#define HISTOGRAM_INC(J) {\
+		uint32_t bin= _histogramBin(a[k+J],shift);\
+		if (!CHECK || bin<barsLen) s##J[bin]++;\
+	}
+template <int SUBS, bool CHECK, class T> inline void _histogramBlock(jlong *bars, uint32_t barsLen,
+	const T *a, jlong len, jint shift, uint32_t *sub)
+{
+	uint32_t *s0= sub, *s1= sub+(1%SUBS)*barsLen, *s2= sub+(2%SUBS)*barsLen, *s3= sub+(3%SUBS)*barsLen;
+	uint32_t *s4= sub+(4%SUBS)*barsLen, *s5= sub+(5%SUBS)*barsLen, *s6= sub+(6%SUBS)*barsLen, *s7= sub+(7%SUBS)*barsLen;
+	jlong k= 0;
+	for (; k+8<=len; k+= 8) {
+		HISTOGRAM_INC(0) HISTOGRAM_INC(1) HISTOGRAM_INC(2) HISTOGRAM_INC(3)
+		HISTOGRAM_INC(4) HISTOGRAM_INC(5) HISTOGRAM_INC(6) HISTOGRAM_INC(7)
+	}
+	for (; k<len; k++) HISTOGRAM_INC(0)
+	for (uint32_t b= 0; b<barsLen; b++) {
+		jlong sum= 0;
+		for (int j= 0; j<SUBS; j++) {
+			sum+= sub[j*barsLen+b];
+			sub[j*barsLen+b]= 0;
+		}
+		bars[b]+= sum;
+	}
+}
+#undef HISTOGRAM_INC
+
+template <int SUBS, class T> inline void _histogramSubs(jlong *bars, jint barsLen, const T *a, jlong len, jint shift) {
+	std::vector<uint32_t> sub((size_t)SUBS*barsLen);
+	bool check= _histogramMaxBin<T>(shift)>=(uint32_t)barsLen;
+	for (jlong k= 0; k<len; k+= HISTOGRAM_BLOCK_LEN) {
+		jlong n= len-k<HISTOGRAM_BLOCK_LEN? len-k: HISTOGRAM_BLOCK_LEN;
+		if (check) {
+			_histogramBlock<SUBS,true>(bars,(uint32_t)barsLen,a+k,n,shift,&sub[0]);
+		} else {
+			_histogramBlock<SUBS,false>(bars,(uint32_t)barsLen,a+k,n,shift,&sub[0]);
+		}
+	}
+}
+
+// Adds the histogram of a[0..len-1] to bars[0..barsLen-1] in the calling thread
+template <class T> inline void _histogram(jlong *bars, jint barsLen, const T *a, jlong len, jint shift) {
+	if (barsLen<=0 || len<=0) return;
+	if (barsLen<=HISTOGRAM_L1_BARS) {
+		_histogramSubs<8>(bars,barsLen,a,len,shift);
+	} else if (barsLen<=HISTOGRAM_L2_BARS) {
+		_histogramSubs<4>(bars,barsLen,a,len,shift);
+	} else {
+		_histogramSubs<2>(bars,barsLen,a,len,shift);
+	}
+}
+
+// Minimal length (in elements), from which the histogram is split between threads: every thread
+// builds and merges its own bars, so the array must be much longer than the bars
+inline jlong _parallelHistogramMinLen(jint barsLen) {
+	jlong result= 64*(jlong)barsLen;
+	return result<(1<<20)? (1<<20): result;
+}
+
+template <class T> struct ParallelHistogram {
+	const T *a;
+	jlong len, chunk;
+	jint barsLen, shift;
+	jlong *partialBars; // barsLen counters for every task
+};
+
+template <class T> static void _parallelHistogramTask(void *arg, jlong k) {
+	const ParallelHistogram<T> &p= *(const ParallelHistogram<T>*)arg;
+	jlong from= k*p.chunk, to= from+p.chunk<p.len? from+p.chunk: p.len;
+	if (from<to) _histogram(p.partialBars+k*p.barsLen,p.barsLen,p.a+from,to-from,p.shift);
+}
+
+// Adds the histogram of a[0..len-1] to bars[0..barsLen-1], using the pool threads for large arrays
+template <class T> inline void _parallelHistogram(jlong *bars, jint barsLen, const T *a, jlong len, jint shift) {
+	int n= _threadPool().threads();
+	if (n<=1 || len<_parallelHistogramMinLen(barsLen)) {
+		_histogram(bars,barsLen,a,len,shift);
+		return;
+	}
+	std::vector<jlong> partial((size_t)n*barsLen);
+	ParallelHistogram<T> p;
+	p.a= a;
+	p.len= len;
+	p.chunk= (len+n-1)/n;
+	p.barsLen= barsLen;
+	p.shift= shift;
+	p.partialBars= &partial[0];
+	_threadPool().run(_parallelHistogramTask<T>,&p,n);
+	for (int k= 0; k<n; k++) {
+		const jlong *q= &partial[(size_t)k*barsLen];
+		for (jint b= 0; b<barsLen; b++) bars[b]+= q[b];
+	}
+}
+
+#endif //A_ARRAYSHISTOGRAM_H__INCLUDED_
@@ -0,0 +1,70 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef A_ARRAYSJAVAMATH_H__INCLUDED_
+#define A_ARRAYSJAVAMATH_H__INCLUDED_
+
+// Scalar min/max with the semantics of java.lang.Math.min/max: the result is NaN if any argument
+// is NaN, and -0.0 is less than +0.0. Used by C++ loops and by heads and tails of SIMD kernels.
+
+#include <string.h> // memcpy()
+
+inline jfloat _javaMinF(jfloat a, jfloat b) {
+	if (a<b) return a;
+	if (b<a) return b;
+	if (a!=a) return a;
+	if (b!=b) return b;
+	jint x, y; memcpy(&x,&a,sizeof(x)); memcpy(&y,&b,sizeof(y)); x|= y; // equal: -0.0 if any is -0.0
+	memcpy(&a,&x,sizeof(a)); return a;
+}
+
+inline jfloat _javaMaxF(jfloat a, jfloat b) {
+	if (a>b) return a;
+	if (b>a) return b;
+	if (a!=a) return a;
+	if (b!=b) return b;
+	jint x, y; memcpy(&x,&a,sizeof(x)); memcpy(&y,&b,sizeof(y)); x&= y; // equal: +0.0 if any is +0.0
+	memcpy(&a,&x,sizeof(a)); return a;
+}
+
+inline jdouble _javaMinD(jdouble a, jdouble b) {
+	if (a<b) return a;
+	if (b<a) return b;
+	if (a!=a) return a;
+	if (b!=b) return b;
+	jlong x, y; memcpy(&x,&a,sizeof(x)); memcpy(&y,&b,sizeof(y)); x|= y;
+	memcpy(&a,&x,sizeof(a)); return a;
+}
+
+inline jdouble _javaMaxD(jdouble a, jdouble b) {
+	if (a>b) return a;
+	if (b>a) return b;
+	if (a!=a) return a;
+	if (b!=b) return b;
+	jlong x, y; memcpy(&x,&a,sizeof(x)); memcpy(&y,&b,sizeof(y)); x&= y;
+	memcpy(&a,&x,sizeof(a)); return a;
+}
+
+#endif //A_ARRAYSJAVAMATH_H__INCLUDED_
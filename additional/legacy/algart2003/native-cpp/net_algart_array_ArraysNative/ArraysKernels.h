@@ -0,0 +1,240 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef A_ARRAYSKERNELS_H__INCLUDED_
+#define A_ARRAYSKERNELS_H__INCLUDED_
+
+// Table of SIMD kernels. The same kernel sources (ArraysKernelsImpl.h) are compiled once per
+// instruction set level: ArraysKernels_sse2.cpp, ArraysKernels_avx2.cpp, ArraysKernels_avx512.cpp;
+// every such file must be compiled with the corresponding compiler switches (see Makefile).
+// All lengths are in elements, excepting copyBytes and xxxBits (in bits); nonTemporalMinLen is in bytes.
+
+// Result of the rangeXxx reductions: the indexes of the first minimal and the first maximal element
+// (-1 if there are no elements, or only NaN ones), and the sum (integer sums wrap like Java long)
+struct ArraysRange {
+	jlong minIndex, maxIndex;
+	jlong sum;
+	jdouble doubleSum;
+};
+
+struct ArraysKernels {
+	const char *name;
+	int level; // 1: SSE2, 2: AVX2, 3: AVX-512 (0 is reserved for C++ loops)
+	void (*copyBytes)(jbyte *dest, const jbyte *src, jlong len, jlong nonTemporalMinLen);
+	// Copying with reversing the byte order of every element; dest==src means swapping in place,
+	// other overlapping areas are not allowed
+	void (*swapBytesShort)(jshort *dest, const jshort *src, jlong len, jlong nonTemporalMinLen);
+	void (*swapBytesInt)(jint *dest, const jint *src, jlong len, jlong nonTemporalMinLen);
+	void (*swapBytesLong)(jlong *dest, const jlong *src, jlong len, jlong nonTemporalMinLen);
+	void (*fillByte)(jbyte *a, jlong len, jbyte v, jlong nonTemporalMinLen);
+	void (*fillShort)(jshort *a, jlong len, jshort v, jlong nonTemporalMinLen);
+	void (*fillInt)(jint *a, jlong len, jint v, jlong nonTemporalMinLen);
+	void (*fillLong)(jlong *a, jlong len, jlong v, jlong nonTemporalMinLen);
+	void (*minByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*maxByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*minuByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*maxuByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*minShort)(jshort *a, const jshort *b, jlong len);
+	void (*maxShort)(jshort *a, const jshort *b, jlong len);
+	void (*minuShort)(jshort *a, const jshort *b, jlong len);
+	void (*maxuShort)(jshort *a, const jshort *b, jlong len);
+	void (*minInt)(jint *a, const jint *b, jlong len);
+	void (*maxInt)(jint *a, const jint *b, jlong len);
+	void (*minuInt)(jint *a, const jint *b, jlong len);
+	void (*maxuInt)(jint *a, const jint *b, jlong len);
+	void (*minLong)(jlong *a, const jlong *b, jlong len);
+	void (*maxLong)(jlong *a, const jlong *b, jlong len);
+	void (*minuLong)(jlong *a, const jlong *b, jlong len);
+	void (*maxuLong)(jlong *a, const jlong *b, jlong len);
+	void (*minFloat)(jfloat *a, const jfloat *b, jlong len);
+	void (*maxFloat)(jfloat *a, const jfloat *b, jlong len);
+	void (*minDouble)(jdouble *a, const jdouble *b, jlong len);
+	void (*maxDouble)(jdouble *a, const jdouble *b, jlong len);
+	void (*rangeByte)(const jbyte *a, jlong len, ArraysRange *r);
+	void (*rangeChar)(const jchar *a, jlong len, ArraysRange *r);
+	void (*rangeShort)(const jshort *a, jlong len, ArraysRange *r);
+	void (*rangeInt)(const jint *a, jlong len, ArraysRange *r);
+	void (*rangeLong)(const jlong *a, jlong len, ArraysRange *r);
+	void (*rangeFloat)(const jfloat *a, jlong len, ArraysRange *r);
+	void (*rangeDouble)(const jdouble *a, jlong len, ArraysRange *r);
+	void (*addByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*addShort)(jshort *a, const jshort *b, jlong len);
+	void (*addInt)(jint *a, const jint *b, jlong len);
+	void (*addLong)(jlong *a, const jlong *b, jlong len);
+	void (*addFloat)(jfloat *a, const jfloat *b, jlong len);
+	void (*addDouble)(jdouble *a, const jdouble *b, jlong len);
+	void (*subByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*subShort)(jshort *a, const jshort *b, jlong len);
+	void (*subInt)(jint *a, const jint *b, jlong len);
+	void (*subLong)(jlong *a, const jlong *b, jlong len);
+	void (*subFloat)(jfloat *a, const jfloat *b, jlong len);
+	void (*subDouble)(jdouble *a, const jdouble *b, jlong len);
+	void (*addsByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*addsShort)(jshort *a, const jshort *b, jlong len);
+	void (*subsByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*subsShort)(jshort *a, const jshort *b, jlong len);
+	void (*addusByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*addusShort)(jshort *a, const jshort *b, jlong len);
+	void (*subusByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*subusShort)(jshort *a, const jshort *b, jlong len);
+	void (*absDiffByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*absDiffShort)(jshort *a, const jshort *b, jlong len);
+	void (*absDiffInt)(jint *a, const jint *b, jlong len);
+	void (*absDiffLong)(jlong *a, const jlong *b, jlong len);
+	void (*absDiffFloat)(jfloat *a, const jfloat *b, jlong len);
+	void (*absDiffDouble)(jdouble *a, const jdouble *b, jlong len);
+	void (*absDiffuByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*absDiffuShort)(jshort *a, const jshort *b, jlong len);
+	void (*absDiffuInt)(jint *a, const jint *b, jlong len);
+	void (*absDiffuLong)(jlong *a, const jlong *b, jlong len);
+	void (*oppositeByte)(jbyte *a, const jbyte *b, jlong len);
+	void (*oppositeShort)(jshort *a, const jshort *b, jlong len);
+	void (*oppositeInt)(jint *a, const jint *b, jlong len);
+	void (*oppositeLong)(jlong *a, const jlong *b, jlong len);
+	void (*oppositeFloat)(jfloat *a, const jfloat *b, jlong len);
+	void (*oppositeDouble)(jdouble *a, const jdouble *b, jlong len);
+	void (*copyBits)(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count);
+	void (*andBits)(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count);
+	void (*orBits)(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count);
+	void (*xorBits)(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count);
+	void (*andNotBits)(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count);
+	void (*notBits)(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count);
+	jlong (*cardinalityBits)(const jlong *a, jlong pos, jlong count);
+	jlong (*cardinalityBitsVpopcnt)(const jlong *a, jlong pos, jlong count); // AVX-512 only, see CPU_AVX512POPCNT
+	jlong (*indexOfBit)(const jlong *a, jlong lowIndex, jlong highIndex, jboolean value);
+	jlong (*lastIndexOfBit)(const jlong *a, jlong lowIndex, jlong highIndex, jboolean value);
+	// byte and short elements are packed as unsigned (like in PackedBitArrays): short uses packBitsChar
+	void (*packBitsByte)(jlong *dest, jlong destPos, const uint8_t *src, jlong count, uint8_t threshold, jint cmp);
+	void (*packBitsChar)(jlong *dest, jlong destPos, const jchar *src, jlong count, jchar threshold, jint cmp);
+	void (*packBitsInt)(jlong *dest, jlong destPos, const jint *src, jlong count, jint threshold, jint cmp);
+	void (*packBitsLong)(jlong *dest, jlong destPos, const jlong *src, jlong count, jlong threshold, jint cmp);
+	void (*packBitsFloat)(jlong *dest, jlong destPos, const jfloat *src, jlong count, jfloat threshold, jint cmp);
+	void (*packBitsDouble)(jlong *dest, jlong destPos, const jdouble *src, jlong count, jdouble threshold, jint cmp);
+	// char, float and double are unpacked as jshort, jint and jlong
+	void (*unpackBitsByte)(jbyte *dest, const jlong *src, jlong srcPos, jlong count, jbyte value0, jbyte value1, jint mode);
+	void (*unpackBitsShort)(jshort *dest, const jlong *src, jlong srcPos, jlong count, jshort value0, jshort value1, jint mode);
+	void (*unpackBitsInt)(jint *dest, const jlong *src, jlong srcPos, jlong count, jint value0, jint value1, jint mode);
+	void (*unpackBitsLong)(jlong *dest, const jlong *src, jlong srcPos, jlong count, jlong value0, jlong value1, jint mode);
+	// Search: the first (last) index k<len, where a[k]==v (any NaN for NaN v), or -1; char is searched as jshort
+	jlong (*indexOfByte)(const jbyte *a, jlong len, jbyte v);
+	jlong (*indexOfShort)(const jshort *a, jlong len, jshort v);
+	jlong (*indexOfInt)(const jint *a, jlong len, jint v);
+	jlong (*indexOfLong)(const jlong *a, jlong len, jlong v);
+	jlong (*indexOfFloat)(const jfloat *a, jlong len, jfloat v);
+	jlong (*indexOfDouble)(const jdouble *a, jlong len, jdouble v);
+	jlong (*lastIndexOfByte)(const jbyte *a, jlong len, jbyte v);
+	jlong (*lastIndexOfShort)(const jshort *a, jlong len, jshort v);
+	jlong (*lastIndexOfInt)(const jint *a, jlong len, jint v);
+	jlong (*lastIndexOfLong)(const jlong *a, jlong len, jlong v);
+	jlong (*lastIndexOfFloat)(const jfloat *a, jlong len, jfloat v);
+	jlong (*lastIndexOfDouble)(const jdouble *a, jlong len, jdouble v);
+	// 3x3 filters (see ArraysFilter3x3.h): the rows fromY..toY-1 of the dimX x dimY result; dest must not
+	// overlap src; work: FILTER3X3_WORK_BYTES(dimX) bytes; char is filtered as jshort
+	void (*filter3x3Byte)(jbyte *dest, const jbyte *src, jlong dimX, jlong dimY, jlong fromY, jlong toY,
+		jint filter, jint percentileIndex, void *work);
+	void (*filter3x3Short)(jshort *dest, const jshort *src, jlong dimX, jlong dimY, jlong fromY, jlong toY,
+		jint filter, jint percentileIndex, void *work);
+	void (*filter3x3Float)(jfloat *dest, const jfloat *src, jlong dimX, jlong dimY, jlong fromY, jlong toY,
+		jint filter, jint percentileIndex, void *work);
+	// Rank filters by rectangles (see ArraysRank.h): the columns fromX..toX-1 of the dimX x dimY result;
+	// dest must not overlap src; work: _rankWorkBytes<T>(dimX,apertureDimX,apertureDimY,mode) bytes;
+	// char is filtered as jshort
+	void (*rankByte)(jbyte *dest, const jbyte *src, jlong dimX, jlong dimY, jlong fromX, jlong toX,
+		jint apertureDimX, jint apertureDimY, jint mode, jlong fromIndex, jlong toIndex, void *work);
+	void (*rankShort)(jshort *dest, const jshort *src, jlong dimX, jlong dimY, jlong fromX, jlong toX,
+		jint apertureDimX, jint apertureDimY, jint mode, jlong fromIndex, jlong toIndex, void *work);
+};
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define ARRAYS_KERNELS_X86
+extern const ArraysKernels kernelsSse2;
+extern const ArraysKernels kernelsAvx2;
+extern const ArraysKernels kernelsAvx512;
+#endif
+
+// Returns the best kernels allowed by CpuInfo, or NULL if only C++ loops can be used
+inline const ArraysKernels *_kernels(jlong cpuInfo) {
+#ifdef ARRAYS_KERNELS_X86
+	if (cpuInfo & CPU_AVX512) return &kernelsAvx512;
+	if (cpuInfo & CPU_AVX2) return &kernelsAvx2;
+	if (cpuInfo & CPU_SSE2) return &kernelsSse2;
+#endif
+	return NULL;
+}
+
+// C++ loop for rangeXxx (see ArraysRange): returns the sum, accumulated in S
+template <class T, class S> inline S _rangeLoop(const T *a, jlong len, ArraysRange *r) {
+	jlong minIndex= -1, maxIndex= -1;
+	S sum= 0;
+	for (jlong k= 0; k<len; k++) {
+		T v= a[k];
+		sum+= v;
+		if (v!=v) continue; // NaN
+		if (minIndex<0 || v<a[minIndex]) minIndex= k;
+		if (maxIndex<0 || v>a[maxIndex]) maxIndex= k;
+	}
+	r->minIndex= minIndex;
+	r->maxIndex= maxIndex;
+	return sum;
+}
+
+// C++ byte order reversal (compilers generate bswap/rol for these expressions)
+inline jshort _swapBytes(jshort v) {
+	return (jshort)(((uint16_t)v<<8)|((uint16_t)v>>8));
+}
+inline jint _swapBytes(jint v) {
+	uint32_t x= (uint32_t)v;
+	return (jint)((x<<24)|((x&0xFF00)<<8)|((x>>8)&0xFF00)|(x>>24));
+}
+inline jlong _swapBytes(jlong v) {
+	uint64_t x= (uint64_t)v;
+	return (jlong)(((uint64_t)(uint32_t)_swapBytes((jint)x)<<32)|(uint32_t)_swapBytes((jint)(x>>32)));
+}
+
+template <class T> inline void _swapBytesLoop(T *dest, const T *src, jlong len, jlong) {
+	for (jlong k= 0; k<len; k++) dest[k]= _swapBytes(src[k]);
+}
+
+// C++ loops for indexOfXxx/lastIndexOfXxx: floating-point values are compared by ==, like in Java,
+// but NaN v means any NaN
+template <class T> inline jlong _indexOfLoop(const T *a, jlong len, T v) {
+	if (v!=v) {
+		for (jlong k= 0; k<len; k++) if (a[k]!=a[k]) return k;
+		return -1;
+	}
+	for (jlong k= 0; k<len; k++) if (a[k]==v) return k;
+	return -1;
+}
+
+template <class T> inline jlong _lastIndexOfLoop(const T *a, jlong len, T v) {
+	if (v!=v) {
+		for (jlong k= len-1; k>=0; k--) if (a[k]!=a[k]) return k;
+		return -1;
+	}
+	for (jlong k= len-1; k>=0; k--) if (a[k]==v) return k;
+	return -1;
+}
+
+#endif //A_ARRAYSKERNELS_H__INCLUDED_
@@ -0,0 +1,1493 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+// Kernels for one instruction set level: included by ArraysKernels_sse2.cpp, ArraysKernels_avx2.cpp
+// and ArraysKernels_avx512.cpp, which define ARRAYS_KERNELS_xxx and KERNELS_TABLE before including.
+
+#include <jni.h>
+#include <math.h> // HUGE_VAL
+#include <string.h> // memmove()
+#include "ArraysMacro.h"
+#include "ArraysKernels.h"
+#include "ArraysJavaMath.h"
+#include "ArraysArithmetic.h"
+#include "ArraysBits.h"
+#include "ArraysFilter3x3.h"
+#include "ArraysRank.h"
+#include "ArraysSimd.h"
+
+// memmove() semantics: overlapping areas are copied correctly. The first and the last (unaligned)
+// vectors are loaded before all stores and stored after the main loop; the main loop uses aligned
+// destination addresses and goes forward if dest<=src (or no overlap) and backward otherwise,
+// so every source vector is loaded before any store into it.
+static void copyBytes(jbyte *pa, const jbyte *pb, jlong len, jlong nonTemporalMinLen) {
+	if (len<2*VEC_BYTES) {
+		memmove(pa,pb,(size_t)len);
+		return;
+	}
+	if (pa==pb) return;
+	bool overlap= pa<pb+len && pb<pa+len;
+	VInt head= vLoad(pb), tail= vLoad(pb+len-VEC_BYTES);
+	jbyte *paEnd= pa+len;
+	if (!overlap || pa<pb) {
+		jlong lenStart= VEC_BYTES-((size_t)pa&(VEC_BYTES-1));
+		jbyte *p= pa+lenStart;
+		const jbyte *q= pb+lenStart;
+		jlong n= len-lenStart;
+		if (!overlap && n>=nonTemporalMinLen) {
+			for (; n>=4*VEC_BYTES; n-=4*VEC_BYTES,p+=4*VEC_BYTES,q+=4*VEC_BYTES) {
+				VInt v0= vLoad(q), v1= vLoad(q+VEC_BYTES), v2= vLoad(q+2*VEC_BYTES), v3= vLoad(q+3*VEC_BYTES);
+				vStream(p,v0);
+				vStream(p+VEC_BYTES,v1);
+				vStream(p+2*VEC_BYTES,v2);
+				vStream(p+3*VEC_BYTES,v3);
+			}
+			vFence();
+		}
+		for (; n>=4*VEC_BYTES; n-=4*VEC_BYTES,p+=4*VEC_BYTES,q+=4*VEC_BYTES) {
+			VInt v0= vLoad(q), v1= vLoad(q+VEC_BYTES), v2= vLoad(q+2*VEC_BYTES), v3= vLoad(q+3*VEC_BYTES);
+			vStore(p,v0);
+			vStore(p+VEC_BYTES,v1);
+			vStore(p+2*VEC_BYTES,v2);
+			vStore(p+3*VEC_BYTES,v3);
+		}
+		for (; n>=VEC_BYTES; n-=VEC_BYTES,p+=VEC_BYTES,q+=VEC_BYTES) vStore(p,vLoad(q));
+		// the rest (less than a vector) is covered by the tail
+	} else {
+		// Overlapping, dest>src: backward from the aligned end of the destination
+		jbyte *p= paEnd-((size_t)paEnd&(VEC_BYTES-1));
+		const jbyte *q= pb+(p-pa);
+		jlong n= p-pa;
+		for (; n>=4*VEC_BYTES; n-=4*VEC_BYTES) {
+			p-=4*VEC_BYTES; q-=4*VEC_BYTES;
+			VInt v0= vLoad(q), v1= vLoad(q+VEC_BYTES), v2= vLoad(q+2*VEC_BYTES), v3= vLoad(q+3*VEC_BYTES);
+			vStore(p+3*VEC_BYTES,v3);
+			vStore(p+2*VEC_BYTES,v2);
+			vStore(p+VEC_BYTES,v1);
+			vStore(p,v0);
+		}
+		for (; n>=VEC_BYTES; n-=VEC_BYTES) {
+			p-=VEC_BYTES; q-=VEC_BYTES;
+			vStore(p,vLoad(q));
+		}
+		// the rest (less than a vector) is covered by the head
+	}
+	vStore(pa,head);
+	vStore(paEnd-VEC_BYTES,tail);
+}
+
+static void fillByte(jbyte *pa, jlong len, jbyte v, jlong nonTemporalMinLen) {
+#define TYPE jbyte
+#define VSET1 vSet1I8
+#include "Arrays_fill.h"
+}
+
+static void fillShort(jshort *pa, jlong len, jshort v, jlong nonTemporalMinLen) {
+#define TYPE jshort
+#define VSET1 vSet1I16
+#include "Arrays_fill.h"
+}
+
+static void fillInt(jint *pa, jlong len, jint v, jlong nonTemporalMinLen) {
+#define TYPE jint
+#define VSET1 vSet1I32
+#include "Arrays_fill.h"
+}
+
+static void fillLong(jlong *pa, jlong len, jlong v, jlong nonTemporalMinLen) {
+#define TYPE jlong
+#define VSET1 vSet1I64
+#include "Arrays_fill.h"
+}
+
+static void minByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define CMP >
+#define MINMAX vMinI8
+#include "Arrays_minmax_int.h"
+}
+
+static void maxByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define CMP <
+#define MINMAX vMaxI8
+#include "Arrays_minmax_int.h"
+}
+
+static void minuByte(jbyte *a, const jbyte *b, jlong len) {
+	uint8_t *pa= (uint8_t*)a; const uint8_t *pb= (const uint8_t*)b;
+#include "Arrays_pminub.h"
+}
+
+static void maxuByte(jbyte *a, const jbyte *b, jlong len) {
+	uint8_t *pa= (uint8_t*)a; const uint8_t *pb= (const uint8_t*)b;
+#include "Arrays_pmaxub.h"
+}
+
+static void minShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define CMP >
+#define MINMAX vMinI16
+#include "Arrays_minmax_int.h"
+}
+
+static void maxShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define CMP <
+#define MINMAX vMaxI16
+#include "Arrays_minmax_int.h"
+}
+
+static void minuShort(jshort *a, const jshort *b, jlong len) {
+	uint16_t *pa= (uint16_t*)a; const uint16_t *pb= (const uint16_t*)b;
+#define TYPE uint16_t
+#define CMP >
+#define MINMAX vMinU16
+#include "Arrays_minmax_int.h"
+}
+
+static void maxuShort(jshort *a, const jshort *b, jlong len) {
+	uint16_t *pa= (uint16_t*)a; const uint16_t *pb= (const uint16_t*)b;
+#define TYPE uint16_t
+#define CMP <
+#define MINMAX vMaxU16
+#include "Arrays_minmax_int.h"
+}
+
+static void minInt(jint *pa, const jint *pb, jlong len) {
+#define TYPE jint
+#define CMP >
+#define MINMAX vMinI32
+#include "Arrays_minmax_int.h"
+}
+
+static void maxInt(jint *pa, const jint *pb, jlong len) {
+#define TYPE jint
+#define CMP <
+#define MINMAX vMaxI32
+#include "Arrays_minmax_int.h"
+}
+
+static void minuInt(jint *a, const jint *b, jlong len) {
+	uint32_t *pa= (uint32_t*)a; const uint32_t *pb= (const uint32_t*)b;
+#define TYPE uint32_t
+#define CMP >
+#define MINMAX vMinU32
+#include "Arrays_minmax_int.h"
+}
+
+static void maxuInt(jint *a, const jint *b, jlong len) {
+	uint32_t *pa= (uint32_t*)a; const uint32_t *pb= (const uint32_t*)b;
+#define TYPE uint32_t
+#define CMP <
+#define MINMAX vMaxU32
+#include "Arrays_minmax_int.h"
+}
+
+static void minLong(jlong *pa, const jlong *pb, jlong len) {
+#define TYPE jlong
+#define CMP >
+#define MINMAX vMinI64
+#include "Arrays_minmax_int.h"
+}
+
+static void maxLong(jlong *pa, const jlong *pb, jlong len) {
+#define TYPE jlong
+#define CMP <
+#define MINMAX vMaxI64
+#include "Arrays_minmax_int.h"
+}
+
+static void minuLong(jlong *a, const jlong *b, jlong len) {
+	uint64_t *pa= (uint64_t*)a; const uint64_t *pb= (const uint64_t*)b;
+#define TYPE uint64_t
+#define CMP >
+#define MINMAX vMinU64
+#include "Arrays_minmax_int.h"
+}
+
+static void maxuLong(jlong *a, const jlong *b, jlong len) {
+	uint64_t *pa= (uint64_t*)a; const uint64_t *pb= (const uint64_t*)b;
+#define TYPE uint64_t
+#define CMP <
+#define MINMAX vMaxU64
+#include "Arrays_minmax_int.h"
+}
+
+static void minFloat(jfloat *pa, const jfloat *pb, jlong len) {
+#define SMINMAX _javaMinF
+#define MINMAX vMinF
+#include "Arrays_minmax_float.h"
+}
+
+static void maxFloat(jfloat *pa, const jfloat *pb, jlong len) {
+#define SMINMAX _javaMaxF
+#define MINMAX vMaxF
+#include "Arrays_minmax_float.h"
+}
+
+static void minDouble(jdouble *pa, const jdouble *pb, jlong len) {
+#define SMINMAX _javaMinD
+#define MINMAX vMinD
+#include "Arrays_minmax_double.h"
+}
+
+static void maxDouble(jdouble *pa, const jdouble *pb, jlong len) {
+#define SMINMAX _javaMaxD
+#define MINMAX vMaxD
+#include "Arrays_minmax_double.h"
+}
+
+static void addByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _addI8
+#define VOP vAddI8
+#include "Arrays_pairop.h"
+}
+
+static void addShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _addI16
+#define VOP vAddI16
+#include "Arrays_pairop.h"
+}
+
+static void addInt(jint *pa, const jint *pb, jlong len) {
+#define TYPE jint
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _addI32
+#define VOP vAddI32
+#include "Arrays_pairop.h"
+}
+
+static void addLong(jlong *pa, const jlong *pb, jlong len) {
+#define TYPE jlong
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _addI64
+#define VOP vAddI64
+#include "Arrays_pairop.h"
+}
+
+static void addFloat(jfloat *pa, const jfloat *pb, jlong len) {
+#define TYPE jfloat
+#define VTYPE VFloat
+#define VLOAD vLoadF
+#define VSTORE vStoreF
+#define SOP _addF
+#define VOP vAddF
+#include "Arrays_pairop.h"
+}
+
+static void addDouble(jdouble *pa, const jdouble *pb, jlong len) {
+#define TYPE jdouble
+#define VTYPE VDouble
+#define VLOAD vLoadD
+#define VSTORE vStoreD
+#define SOP _addD
+#define VOP vAddD
+#include "Arrays_pairop.h"
+}
+
+static void subByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _subI8
+#define VOP vSubI8
+#include "Arrays_pairop.h"
+}
+
+static void subShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _subI16
+#define VOP vSubI16
+#include "Arrays_pairop.h"
+}
+
+static void subInt(jint *pa, const jint *pb, jlong len) {
+#define TYPE jint
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _subI32
+#define VOP vSubI32
+#include "Arrays_pairop.h"
+}
+
+static void subLong(jlong *pa, const jlong *pb, jlong len) {
+#define TYPE jlong
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _subI64
+#define VOP vSubI64
+#include "Arrays_pairop.h"
+}
+
+static void subFloat(jfloat *pa, const jfloat *pb, jlong len) {
+#define TYPE jfloat
+#define VTYPE VFloat
+#define VLOAD vLoadF
+#define VSTORE vStoreF
+#define SOP _subF
+#define VOP vSubF
+#include "Arrays_pairop.h"
+}
+
+static void subDouble(jdouble *pa, const jdouble *pb, jlong len) {
+#define TYPE jdouble
+#define VTYPE VDouble
+#define VLOAD vLoadD
+#define VSTORE vStoreD
+#define SOP _subD
+#define VOP vSubD
+#include "Arrays_pairop.h"
+}
+
+static void addsByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _addsI8
+#define VOP vAddsI8
+#include "Arrays_pairop.h"
+}
+
+static void addsShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _addsI16
+#define VOP vAddsI16
+#include "Arrays_pairop.h"
+}
+
+static void subsByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _subsI8
+#define VOP vSubsI8
+#include "Arrays_pairop.h"
+}
+
+static void subsShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _subsI16
+#define VOP vSubsI16
+#include "Arrays_pairop.h"
+}
+
+static void addusByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _addusI8
+#define VOP vAddsU8
+#include "Arrays_pairop.h"
+}
+
+static void addusShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _addusI16
+#define VOP vAddsU16
+#include "Arrays_pairop.h"
+}
+
+static void subusByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _subusI8
+#define VOP vSubsU8
+#include "Arrays_pairop.h"
+}
+
+static void subusShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _subusI16
+#define VOP vSubsU16
+#include "Arrays_pairop.h"
+}
+
+static void absDiffByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _absDiffI8
+#define VOP vAbsDiffI8
+#include "Arrays_pairop.h"
+}
+
+static void absDiffShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _absDiffI16
+#define VOP vAbsDiffI16
+#include "Arrays_pairop.h"
+}
+
+static void absDiffInt(jint *pa, const jint *pb, jlong len) {
+#define TYPE jint
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _absDiffI32
+#define VOP vAbsDiffI32
+#include "Arrays_pairop.h"
+}
+
+static void absDiffLong(jlong *pa, const jlong *pb, jlong len) {
+#define TYPE jlong
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _absDiffI64
+#define VOP vAbsDiffI64
+#include "Arrays_pairop.h"
+}
+
+static void absDiffFloat(jfloat *pa, const jfloat *pb, jlong len) {
+#define TYPE jfloat
+#define VTYPE VFloat
+#define VLOAD vLoadF
+#define VSTORE vStoreF
+#define SOP _absDiffF
+#define VOP vAbsDiffF
+#include "Arrays_pairop.h"
+}
+
+static void absDiffDouble(jdouble *pa, const jdouble *pb, jlong len) {
+#define TYPE jdouble
+#define VTYPE VDouble
+#define VLOAD vLoadD
+#define VSTORE vStoreD
+#define SOP _absDiffD
+#define VOP vAbsDiffD
+#include "Arrays_pairop.h"
+}
+
+static void absDiffuByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _absDiffUI8
+#define VOP vAbsDiffU8
+#include "Arrays_pairop.h"
+}
+
+static void absDiffuShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _absDiffUI16
+#define VOP vAbsDiffU16
+#include "Arrays_pairop.h"
+}
+
+static void absDiffuInt(jint *pa, const jint *pb, jlong len) {
+#define TYPE jint
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _absDiffUI32
+#define VOP vAbsDiffU32
+#include "Arrays_pairop.h"
+}
+
+static void absDiffuLong(jlong *pa, const jlong *pb, jlong len) {
+#define TYPE jlong
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _absDiffUI64
+#define VOP vAbsDiffU64
+#include "Arrays_pairop.h"
+}
+
+static void oppositeByte(jbyte *pa, const jbyte *pb, jlong len) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _oppositeI8
+#define VOP vOppositeI8
+#include "Arrays_pairop.h"
+}
+
+static void oppositeShort(jshort *pa, const jshort *pb, jlong len) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _oppositeI16
+#define VOP vOppositeI16
+#include "Arrays_pairop.h"
+}
+
+static void oppositeInt(jint *pa, const jint *pb, jlong len) {
+#define TYPE jint
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _oppositeI32
+#define VOP vOppositeI32
+#include "Arrays_pairop.h"
+}
+
+static void oppositeLong(jlong *pa, const jlong *pb, jlong len) {
+#define TYPE jlong
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define SOP _oppositeI64
+#define VOP vOppositeI64
+#include "Arrays_pairop.h"
+}
+
+static void oppositeFloat(jfloat *pa, const jfloat *pb, jlong len) {
+#define TYPE jfloat
+#define VTYPE VFloat
+#define VLOAD vLoadF
+#define VSTORE vStoreF
+#define SOP _oppositeF
+#define VOP vOppositeF
+#include "Arrays_pairop.h"
+}
+
+static void oppositeDouble(jdouble *pa, const jdouble *pb, jlong len) {
+#define TYPE jdouble
+#define VTYPE VDouble
+#define VLOAD vLoadD
+#define VSTORE vStoreD
+#define SOP _oppositeD
+#define VOP vOppositeD
+#include "Arrays_pairop.h"
+}
+
+// Block length of rangeXxx kernels (in elements): only 1 or 2 blocks are read again to find the indexes
+#define RANGE_BLOCK_LEN 16384
+
+static void rangeByte(const jbyte *pa, jlong len, ArraysRange *r) {
+#define TYPE jbyte
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define VSET1 vSet1I8
+#define VMIN vMinI8
+#define VMAX vMaxI8
+#define MIN_INIT ((jbyte)0x7F)
+#define MAX_INIT ((jbyte)0x80)
+#define SUM_TYPE uint64_t
+#define VACC VInt
+#define VACC_ZERO vZero()
+#define VACC_STORE vStore
+#define VSUM vSumI8
+#define SUM_BIAS 128
+#define SUM_FIELD sum
+#include "Arrays_range.h"
+}
+
+static void rangeChar(const jchar *pa, jlong len, ArraysRange *r) {
+#define TYPE jchar
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define VSET1(v) vSet1I16((jshort)(v))
+#define VMIN vMinU16
+#define VMAX vMaxU16
+#define MIN_INIT ((jchar)0xFFFF)
+#define MAX_INIT ((jchar)0)
+#define SUM_TYPE uint64_t
+#define VACC VInt
+#define VACC_ZERO vZero()
+#define VACC_STORE vStore
+#define VSUM vSumU16
+#define SUM_BIAS 0
+#define SUM_FIELD sum
+#include "Arrays_range.h"
+}
+
+static void rangeShort(const jshort *pa, jlong len, ArraysRange *r) {
+#define TYPE jshort
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define VSET1 vSet1I16
+#define VMIN vMinI16
+#define VMAX vMaxI16
+#define MIN_INIT ((jshort)0x7FFF)
+#define MAX_INIT ((jshort)0x8000)
+#define SUM_TYPE uint64_t
+#define VACC VInt
+#define VACC_ZERO vZero()
+#define VACC_STORE vStore
+#define VSUM vSumI16
+#define SUM_BIAS 0
+#define SUM_FIELD sum
+#include "Arrays_range.h"
+}
+
+static void rangeInt(const jint *pa, jlong len, ArraysRange *r) {
+#define TYPE jint
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define VSET1 vSet1I32
+#define VMIN vMinI32
+#define VMAX vMaxI32
+#define MIN_INIT ((jint)0x7FFFFFFF)
+#define MAX_INIT ((jint)0x80000000)
+#define SUM_TYPE uint64_t
+#define VACC VInt
+#define VACC_ZERO vZero()
+#define VACC_STORE vStore
+#define VSUM vSumI32
+#define SUM_BIAS 0
+#define SUM_FIELD sum
+#include "Arrays_range.h"
+}
+
+static void rangeLong(const jlong *pa, jlong len, ArraysRange *r) {
+#define TYPE jlong
+#define VTYPE VInt
+#define VLOAD vLoad
+#define VSTORE vStore
+#define VSET1 vSet1I64
+#define VMIN vMinI64
+#define VMAX vMaxI64
+#define MIN_INIT ((jlong)0x7FFFFFFFFFFFFFFFLL)
+#define MAX_INIT ((jlong)0x8000000000000000ULL)
+#define SUM_TYPE uint64_t
+#define VACC VInt
+#define VACC_ZERO vZero()
+#define VACC_STORE vStore
+#define VSUM vSumI64
+#define SUM_BIAS 0
+#define SUM_FIELD sum
+#include "Arrays_range.h"
+}
+
+static void rangeFloat(const jfloat *pa, jlong len, ArraysRange *r) {
+#define TYPE jfloat
+#define VTYPE VFloat
+#define VLOAD vLoadF
+#define VSTORE vStoreF
+#define VSET1 vSet1F
+#define VMIN vMinNumF
+#define VMAX vMaxNumF
+#define MIN_INIT ((jfloat)HUGE_VAL)
+#define MAX_INIT ((jfloat)-HUGE_VAL)
+#define SUM_TYPE jdouble
+#define VACC VDouble
+#define VACC_ZERO vZeroD()
+#define VACC_STORE vStoreD
+#define VSUM vSumF
+#define SUM_BIAS 0
+#define SUM_FIELD doubleSum
+#include "Arrays_range.h"
+}
+
+static void rangeDouble(const jdouble *pa, jlong len, ArraysRange *r) {
+#define TYPE jdouble
+#define VTYPE VDouble
+#define VLOAD vLoadD
+#define VSTORE vStoreD
+#define VSET1 vSet1D
+#define VMIN vMinNumD
+#define VMAX vMaxNumD
+#define MIN_INIT HUGE_VAL
+#define MAX_INIT (-HUGE_VAL)
+#define SUM_TYPE jdouble
+#define VACC VDouble
+#define VACC_ZERO vZeroD()
+#define VACC_STORE vStoreD
+#define VSUM vSumD
+#define SUM_BIAS 0
+#define SUM_FIELD doubleSum
+#include "Arrays_range.h"
+}
+
+template <int OP> static inline VInt vBitsOp(VInt d, VInt s) {
+	switch (OP) {
+		case BITS_AND: return vAnd(d,s);
+		case BITS_OR: return vOr(d,s);
+		case BITS_XOR: return vXor(d,s);
+		case BITS_ANDNOT: return vAndNot(s,d);
+		case BITS_NOT: return vXor(s,vSet1I64(-1));
+		default: return s;
+	}
+}
+
+// Full destination words of the packed bit kernels (see ArraysBits.h). A vector of destination words
+// d[k..k+step-1] needs source words s[k..k+step] (only s[k..k+step-1] without a shift); the rest
+// of the words, whose source vectors would cross LASTWORD, are processed by the scalar loop.
+template <int OP, bool SHIFTED> static void bitsWordsSimd(jlong *d, const jlong *src, jlong srcPos, jlong n,
+	jlong lastWord, bool backward)
+{
+	const jlong step= VEC_BYTES/sizeof(jlong);
+	const jlong *s= src+(srcPos>>6);
+	const int sh= (int)(srcPos&63);
+	jlong limit= SHIFTED? lastWord-(srcPos>>6): n;
+	if (limit>n) limit= n;
+	jlong nv= limit>=step? limit-limit%step: 0;
+#define BITS_SOURCE(k) (SHIFTED? vOr(vSrlI64(vLoad(s+(k)),sh),vSllI64(vLoad(s+(k)+1),64-sh)): vLoad(s+(k)))
+	if (backward) {
+		_bitsWords<OP>(d+nv,src,srcPos+(nv<<6),n-nv,lastWord,true);
+		for (jlong k= nv-step; k>=0; k-=step) {
+			VInt x= BITS_SOURCE(k);
+			vStore(d+k,vBitsOp<OP>(vLoad(d+k),x));
+		}
+	} else {
+		jlong k= 0;
+		for (; k+2*step<=nv; k+=2*step) {
+			VInt x0= BITS_SOURCE(k), x1= BITS_SOURCE(k+step);
+			vStore(d+k,vBitsOp<OP>(vLoad(d+k),x0));
+			vStore(d+k+step,vBitsOp<OP>(vLoad(d+k+step),x1));
+		}
+		for (; k<nv; k+=step) {
+			VInt x= BITS_SOURCE(k);
+			vStore(d+k,vBitsOp<OP>(vLoad(d+k),x));
+		}
+		_bitsWords<OP>(d+nv,src,srcPos+(nv<<6),n-nv,lastWord,false);
+	}
+#undef BITS_SOURCE
+}
+
+template <int OP> static void bitsWords(jlong *d, const jlong *src, jlong srcPos, jlong n, jlong lastWord, bool backward) {
+	if (srcPos&63) {
+		bitsWordsSimd<OP,true>(d,src,srcPos,n,lastWord,backward);
+	} else {
+		bitsWordsSimd<OP,false>(d,src,srcPos,n,lastWord,backward);
+	}
+}
+
+static void copyBits(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count) {
+	_bits<BITS_COPY>(dest,destPos,src,srcPos,count,bitsWords<BITS_COPY>);
+}
+
+static void andBits(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count) {
+	_bits<BITS_AND>(dest,destPos,src,srcPos,count,bitsWords<BITS_AND>);
+}
+
+static void orBits(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count) {
+	_bits<BITS_OR>(dest,destPos,src,srcPos,count,bitsWords<BITS_OR>);
+}
+
+static void xorBits(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count) {
+	_bits<BITS_XOR>(dest,destPos,src,srcPos,count,bitsWords<BITS_XOR>);
+}
+
+static void andNotBits(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count) {
+	_bits<BITS_ANDNOT>(dest,destPos,src,srcPos,count,bitsWords<BITS_ANDNOT>);
+}
+
+static void notBits(jlong *dest, jlong destPos, const jlong *src, jlong srcPos, jlong count) {
+	_bits<BITS_NOT>(dest,destPos,src,srcPos,count,bitsWords<BITS_NOT>);
+}
+
+// Harley-Seal population count: carry-save adders (CSA) reduce 16 vectors to 1 vector of "sixteens"
+// and to the running "ones", "twos", "fours" and "eights", so vPopcnt64 is called once per 16 vectors
+#define BITS_CSA(H,L,A,B,C) {VInt u= vXor(A,B); H= vOr(vAnd(A,B),vAnd(u,C)); L= vXor(u,C);}
+
+static jlong bitCountWords(const jlong *a, jlong n) {
+	const jlong step= VEC_BYTES/sizeof(jlong);
+	VInt total= vZero(), ones= vZero(), twos= vZero(), fours= vZero(), eights= vZero();
+	VInt twosA, twosB, foursA, foursB, eightsA, eightsB, sixteens;
+	jlong k= 0;
+	for (; k+16*step<=n; k+=16*step) {
+		const jlong *p= a+k;
+		BITS_CSA(twosA,ones,ones,vLoad(p),vLoad(p+step));
+		BITS_CSA(twosB,ones,ones,vLoad(p+2*step),vLoad(p+3*step));
+		BITS_CSA(foursA,twos,twos,twosA,twosB);
+		BITS_CSA(twosA,ones,ones,vLoad(p+4*step),vLoad(p+5*step));
+		BITS_CSA(twosB,ones,ones,vLoad(p+6*step),vLoad(p+7*step));
+		BITS_CSA(foursB,twos,twos,twosA,twosB);
+		BITS_CSA(eightsA,fours,fours,foursA,foursB);
+		BITS_CSA(twosA,ones,ones,vLoad(p+8*step),vLoad(p+9*step));
+		BITS_CSA(twosB,ones,ones,vLoad(p+10*step),vLoad(p+11*step));
+		BITS_CSA(foursA,twos,twos,twosA,twosB);
+		BITS_CSA(twosA,ones,ones,vLoad(p+12*step),vLoad(p+13*step));
+		BITS_CSA(twosB,ones,ones,vLoad(p+14*step),vLoad(p+15*step));
+		BITS_CSA(foursB,twos,twos,twosA,twosB);
+		BITS_CSA(eightsB,fours,fours,foursA,foursB);
+		BITS_CSA(sixteens,eights,eights,eightsA,eightsB);
+		total= vAddI64(total,vPopcnt64(sixteens));
+	}
+	total= vSllI64(total,4);
+	total= vAddI64(total,vSllI64(vPopcnt64(eights),3));
+	total= vAddI64(total,vSllI64(vPopcnt64(fours),2));
+	total= vAddI64(total,vSllI64(vPopcnt64(twos),1));
+	total= vAddI64(total,vPopcnt64(ones));
+	for (; k+step<=n; k+=step) total= vAddI64(total,vPopcnt64(vLoad(a+k)));
+	jlong sums[VEC_BYTES/sizeof(jlong)];
+	vStore(sums,total);
+	jlong result= 0;
+	for (jlong j= 0; j<step; j++) result+= sums[j];
+	return result+_bitCountWords(a+k,n-k);
+}
+#undef BITS_CSA
+
+static jlong cardinalityBits(const jlong *a, jlong pos, jlong count) {
+	return _cardinalityBits(a,pos,count,bitCountWords);
+}
+
+#if defined(ARRAYS_KERNELS_AVX512)
+// vpopcntq (AVX512_VPOPCNTDQ) is not required by this level: the function is compiled for it separately
+// and is called only if CpuInfo contains CPU_AVX512POPCNT
+	#if defined(__GNUC__)
+		#define VPOPCNTDQ_TARGET __attribute__((target("avx512vpopcntdq")))
+	#else
+		#define VPOPCNTDQ_TARGET
+	#endif
+static VPOPCNTDQ_TARGET jlong bitCountWordsVpopcnt(const jlong *a, jlong n) {
+	const jlong step= VEC_BYTES/sizeof(jlong);
+	__m512i s0= _mm512_setzero_si512(), s1= _mm512_setzero_si512();
+	__m512i s2= _mm512_setzero_si512(), s3= _mm512_setzero_si512();
+	jlong k= 0;
+	for (; k+4*step<=n; k+=4*step) {
+		s0= _mm512_add_epi64(s0,_mm512_popcnt_epi64(_mm512_loadu_si512(a+k)));
+		s1= _mm512_add_epi64(s1,_mm512_popcnt_epi64(_mm512_loadu_si512(a+k+step)));
+		s2= _mm512_add_epi64(s2,_mm512_popcnt_epi64(_mm512_loadu_si512(a+k+2*step)));
+		s3= _mm512_add_epi64(s3,_mm512_popcnt_epi64(_mm512_loadu_si512(a+k+3*step)));
+	}
+	for (; k+step<=n; k+=step) s0= _mm512_add_epi64(s0,_mm512_popcnt_epi64(_mm512_loadu_si512(a+k)));
+	jlong sums[VEC_BYTES/sizeof(jlong)];
+	_mm512_storeu_si512(sums,_mm512_add_epi64(_mm512_add_epi64(s0,s1),_mm512_add_epi64(s2,s3)));
+	jlong result= 0;
+	for (jlong j= 0; j<step; j++) result+= sums[j];
+	return result+_bitCountWords(a+k,n-k);
+}
+	#undef VPOPCNTDQ_TARGET
+
+static jlong cardinalityBitsVpopcnt(const jlong *a, jlong pos, jlong count) {
+	return _cardinalityBits(a,pos,count,bitCountWordsVpopcnt);
+}
+#endif
+
+// 4 vectors are checked at once; the found block is then scanned by the scalar loop
+static jlong indexOfWord(const jlong *a, jlong n, jlong skip) {
+	const jlong step= VEC_BYTES/sizeof(jlong);
+	const VInt s= vSet1I64(skip);
+	jlong k= 0;
+	for (; k+4*step<=n; k+=4*step) {
+		const jlong *p= a+k;
+		VInt x= vOr(vOr(vXor(vLoad(p),s),vXor(vLoad(p+step),s)),vOr(vXor(vLoad(p+2*step),s),vXor(vLoad(p+3*step),s)));
+		if (!vIsZero(x)) break;
+	}
+	return k+_indexOfWord(a+k,n-k,skip);
+}
+
+static jlong lastIndexOfWord(const jlong *a, jlong n, jlong skip) {
+	const jlong step= VEC_BYTES/sizeof(jlong);
+	const VInt s= vSet1I64(skip);
+	jlong k= n;
+	for (; k>=4*step; k-=4*step) {
+		const jlong *p= a+k-4*step;
+		VInt x= vOr(vOr(vXor(vLoad(p),s),vXor(vLoad(p+step),s)),vOr(vXor(vLoad(p+2*step),s),vXor(vLoad(p+3*step),s)));
+		if (!vIsZero(x)) break;
+	}
+	return _lastIndexOfWord(a,k,skip);
+}
+
+static jlong indexOfBit(const jlong *a, jlong lowIndex, jlong highIndex, jboolean value) {
+	return _indexOfBit(a,lowIndex,highIndex,value!=0,indexOfWord);
+}
+
+static jlong lastIndexOfBit(const jlong *a, jlong lowIndex, jlong highIndex, jboolean value) {
+	return _lastIndexOfBit(a,lowIndex,highIndex,value!=0,lastIndexOfWord);
+}
+
+// Threshold packing (see ArraysBits.h): the compare masks of 64/LANES vectors form one destination word.
+// Integer ">=" is "not <": the inversion is limited by LANES_MASK, so the other mask bits stay 0.
+template <class T> struct PackVec;
+#define PACK_VEC(TYPE,V,LOAD,SET1,GT,GE) \
+template <> struct PackVec<TYPE> {\
+	typedef V Vec;\
+	static const int LANES= VEC_BYTES/sizeof(TYPE);\
+	static const uint64_t LANES_MASK= LANES==64? ~(uint64_t)0: ((uint64_t)1<<(LANES&63))-1;\
+	static inline V load(const TYPE *p) {return LOAD(p);}\
+	static inline V set1(TYPE v) {return SET1;}\
+	static inline uint64_t gt(V a, V b) {return GT(a,b);}\
+	static inline uint64_t ge(V a, V b) {return GE;}\
+};
+PACK_VEC(uint8_t,VInt,vLoad,vSet1I8((jbyte)v),vGtMaskU8,~vGtMaskU8(b,a)&LANES_MASK)
+PACK_VEC(jchar,VInt,vLoad,vSet1I16((jshort)v),vGtMaskU16,~vGtMaskU16(b,a)&LANES_MASK)
+PACK_VEC(jint,VInt,vLoad,vSet1I32(v),vGtMaskI32,~vGtMaskI32(b,a)&LANES_MASK)
+PACK_VEC(jlong,VInt,vLoad,vSet1I64(v),vGtMaskI64,~vGtMaskI64(b,a)&LANES_MASK)
+PACK_VEC(jfloat,VFloat,vLoadF,vSet1F(v),vGtMaskF,vGeMaskF(a,b))
+PACK_VEC(jdouble,VDouble,vLoadD,vSet1D(v),vGtMaskD,vGeMaskD(a,b))
+#undef PACK_VEC
+
+template <int CMP, class T> static void packBitsWords(jlong *d, const T *src, jlong n, T threshold) {
+	typedef PackVec<T> P;
+	const typename P::Vec t= P::set1(threshold);
+	for (jlong k= 0; k<n; k++, src+= 64) {
+		uint64_t v= 0;
+		for (int j= 0; j<64; j+= P::LANES) {
+			typename P::Vec a= P::load(src+j);
+			switch (CMP) {
+				case PACK_GREATER: v|= P::gt(a,t)<<j; break;
+				case PACK_LESS: v|= P::gt(t,a)<<j; break;
+				case PACK_GREATER_OR_EQUAL: v|= P::ge(a,t)<<j; break;
+				default: v|= P::ge(t,a)<<j; break;
+			}
+		}
+		d[k]= (jlong)v;
+	}
+}
+
+template <class T> static void packBits(jlong *dest, jlong destPos, const T *src, jlong count, T threshold, jint cmp) {
+	switch (cmp) {
+		case PACK_GREATER:
+			_packBits<PACK_GREATER,T>(dest,destPos,src,count,threshold,packBitsWords<PACK_GREATER,T>); break;
+		case PACK_LESS:
+			_packBits<PACK_LESS,T>(dest,destPos,src,count,threshold,packBitsWords<PACK_LESS,T>); break;
+		case PACK_GREATER_OR_EQUAL:
+			_packBits<PACK_GREATER_OR_EQUAL,T>(dest,destPos,src,count,threshold,packBitsWords<PACK_GREATER_OR_EQUAL,T>); break;
+		case PACK_LESS_OR_EQUAL:
+			_packBits<PACK_LESS_OR_EQUAL,T>(dest,destPos,src,count,threshold,packBitsWords<PACK_LESS_OR_EQUAL,T>); break;
+	}
+}
+
+// Bit unpacking (see ArraysBits.h): 64 source bits per block of 64 elements, VEC_BYTES/sizeof(T) bits
+// per vector. UNPACK_UNITS (UNPACK_ZEROS) blend value1 (value0) into the loaded destination and skip
+// the blocks without 1 (0) bits.
+template <class T> struct UnpackVec;
+#define UNPACK_VEC(TYPE,SET1,SELECT) \
+template <> struct UnpackVec<TYPE> {\
+	static const int LANES= VEC_BYTES/sizeof(TYPE);\
+	static inline VInt set1(TYPE v) {return SET1(v);}\
+	static inline VInt select(uint64_t bits, VInt a, VInt b) {return SELECT(bits,a,b);}\
+};
+UNPACK_VEC(jbyte,vSet1I8,vSelectI8)
+UNPACK_VEC(jshort,vSet1I16,vSelectI16)
+UNPACK_VEC(jint,vSet1I32,vSelectI32)
+UNPACK_VEC(jlong,vSet1I64,vSelectI64)
+#undef UNPACK_VEC
+
+template <int MODE, class T> static void unpackBitsWords(T *dest, const jlong *src, jlong srcPos, jlong n, jlong lastWord,
+	T value0, T value1)
+{
+	typedef UnpackVec<T> U;
+	const VInt v0= U::set1(value0), v1= U::set1(value1);
+	for (jlong k= 0; k<n; k++) {
+		uint64_t bits= _getBits64(src,srcPos+(k<<6),lastWord);
+		if (MODE==UNPACK_UNITS && bits==0) continue;
+		if (MODE==UNPACK_ZEROS && bits==~(uint64_t)0) continue;
+		T *d= dest+(k<<6);
+		for (int j= 0; j<64; j+= U::LANES) {
+			VInt a= MODE==UNPACK_ALL? v0: MODE==UNPACK_ZEROS? v0: vLoad(d+j);
+			VInt b= MODE==UNPACK_ALL? v1: MODE==UNPACK_UNITS? v1: vLoad(d+j);
+			vStore(d+j,U::select(bits>>j,a,b));
+		}
+	}
+}
+
+template <class T> static void unpackBits(T *dest, const jlong *src, jlong srcPos, jlong count, T value0, T value1, jint mode) {
+	switch (mode) {
+		case UNPACK_ALL:
+			_unpackBits<UNPACK_ALL,T>(dest,src,srcPos,count,value0,value1,unpackBitsWords<UNPACK_ALL,T>); break;
+		case UNPACK_UNITS:
+			_unpackBits<UNPACK_UNITS,T>(dest,src,srcPos,count,value0,value1,unpackBitsWords<UNPACK_UNITS,T>); break;
+		case UNPACK_ZEROS:
+			_unpackBits<UNPACK_ZEROS,T>(dest,src,srcPos,count,value0,value1,unpackBitsWords<UNPACK_ZEROS,T>); break;
+	}
+}
+
+// Byte order reversal: like copyBytes, but dest and src may not overlap partially, so the main loop
+// simply goes forward; large non-overlapping areas are written by non-temporal stores
+template <class T> struct SwapVec;
+template <> struct SwapVec<jshort> {static inline VInt swap(VInt a) {return vSwapBytes16(a);}};
+template <> struct SwapVec<jint> {static inline VInt swap(VInt a) {return vSwapBytes32(a);}};
+template <> struct SwapVec<jlong> {static inline VInt swap(VInt a) {return vSwapBytes64(a);}};
+
+template <class T> static void swapBytes(T *dest, const T *src, jlong len, jlong nonTemporalMinLen) {
+	typedef SwapVec<T> S;
+	const jlong step= VEC_BYTES/sizeof(T);
+	jlong k= 0;
+	if (dest!=src && len*(jlong)sizeof(T)>=nonTemporalMinLen) {
+		// aligning the destination for streaming; elements are naturally aligned in Java arrays and buffers
+		for (; k<len && ((size_t)(dest+k)&(VEC_BYTES-1))!=0; k++) dest[k]= _swapBytes(src[k]);
+		if (((size_t)(dest+k)&(VEC_BYTES-1))==0) {
+			for (; k+4*step<=len; k+= 4*step) {
+				const T *q= src+k;
+				VInt v0= vLoad(q), v1= vLoad(q+step), v2= vLoad(q+2*step), v3= vLoad(q+3*step);
+				vStream(dest+k,S::swap(v0));
+				vStream(dest+k+step,S::swap(v1));
+				vStream(dest+k+2*step,S::swap(v2));
+				vStream(dest+k+3*step,S::swap(v3));
+			}
+			vFence();
+		}
+	}
+	for (; k+4*step<=len; k+= 4*step) {
+		const T *q= src+k;
+		VInt v0= vLoad(q), v1= vLoad(q+step), v2= vLoad(q+2*step), v3= vLoad(q+3*step);
+		vStore(dest+k,S::swap(v0));
+		vStore(dest+k+step,S::swap(v1));
+		vStore(dest+k+2*step,S::swap(v2));
+		vStore(dest+k+3*step,S::swap(v3));
+	}
+	for (; k+step<=len; k+= step) vStore(dest+k,S::swap(vLoad(src+k)));
+	for (; k<len; k++) dest[k]= _swapBytes(src[k]);
+}
+
+// Search: 4 vectors are compared per iteration, the first (last) found lane is the lowest (highest) mask bit;
+// NaN value means any NaN (MATCH_NAN), integer types have no NaN
+template <class T> struct SearchVec;
+#define SEARCH_VEC(TYPE,V,LOAD,SET1,EQ,NAN_MASK) \
+template <> struct SearchVec<TYPE> {\
+	typedef V Vec;\
+	static const int LANES= VEC_BYTES/sizeof(TYPE);\
+	static inline V load(const TYPE *p) {return LOAD(p);}\
+	static inline V set1(TYPE v) {return SET1(v);}\
+	static inline uint64_t eq(V a, V b) {return EQ(a,b);}\
+	static inline uint64_t nan(V a) {(void)a; return NAN_MASK;}\
+};
+SEARCH_VEC(jbyte,VInt,vLoad,vSet1I8,vEqMaskI8,0)
+SEARCH_VEC(jshort,VInt,vLoad,vSet1I16,vEqMaskI16,0)
+SEARCH_VEC(jint,VInt,vLoad,vSet1I32,vEqMaskI32,0)
+SEARCH_VEC(jlong,VInt,vLoad,vSet1I64,vEqMaskI64,0)
+SEARCH_VEC(jfloat,VFloat,vLoadF,vSet1F,vEqMaskF,vNaNMaskF(a))
+SEARCH_VEC(jdouble,VDouble,vLoadD,vSet1D,vEqMaskD,vNaNMaskD(a))
+#undef SEARCH_VEC
+
+template <bool MATCH_NAN, class T> static inline uint64_t searchMask(const T *p, typename SearchVec<T>::Vec x) {
+	return MATCH_NAN? SearchVec<T>::nan(SearchVec<T>::load(p)): SearchVec<T>::eq(SearchVec<T>::load(p),x);
+}
+
+template <bool MATCH_NAN, class T> static jlong indexOfValues(const T *a, jlong len, T v) {
+	const jlong step= SearchVec<T>::LANES;
+	const typename SearchVec<T>::Vec x= SearchVec<T>::set1(v);
+	jlong k= 0;
+	for (; k+4*step<=len; k+= 4*step) {
+		const T *p= a+k;
+		uint64_t m0= searchMask<MATCH_NAN>(p,x), m1= searchMask<MATCH_NAN>(p+step,x);
+		uint64_t m2= searchMask<MATCH_NAN>(p+2*step,x), m3= searchMask<MATCH_NAN>(p+3*step,x);
+		if ((m0|m1|m2|m3)==0) continue;
+		if (m0!=0) return k+_lowestBit64(m0);
+		if (m1!=0) return k+step+_lowestBit64(m1);
+		if (m2!=0) return k+2*step+_lowestBit64(m2);
+		return k+3*step+_lowestBit64(m3);
+	}
+	jlong r= _indexOfLoop(a+k,len-k,v);
+	return r>=0? k+r: -1;
+}
+
+template <bool MATCH_NAN, class T> static jlong lastIndexOfValues(const T *a, jlong len, T v) {
+	const jlong step= SearchVec<T>::LANES;
+	const typename SearchVec<T>::Vec x= SearchVec<T>::set1(v);
+	jlong k= len;
+	for (; k>=4*step; k-= 4*step) {
+		const T *p= a+k-4*step;
+		uint64_t m0= searchMask<MATCH_NAN>(p,x), m1= searchMask<MATCH_NAN>(p+step,x);
+		uint64_t m2= searchMask<MATCH_NAN>(p+2*step,x), m3= searchMask<MATCH_NAN>(p+3*step,x);
+		if ((m0|m1|m2|m3)==0) continue;
+		if (m3!=0) return k-step+_highestBit64(m3);
+		if (m2!=0) return k-2*step+_highestBit64(m2);
+		if (m1!=0) return k-3*step+_highestBit64(m1);
+		return k-4*step+_highestBit64(m0);
+	}
+	return _lastIndexOfLoop(a,k,v);
+}
+
+template <class T> static jlong indexOfValue(const T *a, jlong len, T v) {
+	return v!=v? indexOfValues<true>(a,len,v): indexOfValues<false>(a,len,v);
+}
+
+template <class T> static jlong lastIndexOfValue(const T *a, jlong len, T v) {
+	return v!=v? lastIndexOfValues<true>(a,len,v): lastIndexOfValues<false>(a,len,v);
+}
+
+// 3x3 filters: every row of the result is made from 3 source rows in one or two passes over the columns.
+// Square min/max, sums and percentiles first combine every source column vertically into the work memory
+// (once per column: every column is used by 3 results), then combine 3 neighbouring columns horizontally.
+// SIMD loops process the columns 1..dimX-2 by unaligned loads at x-1, x, x+1; the first and the last
+// columns (cyclic neighbours) and the tails are made by the C++ code of ArraysFilter3x3.h.
+// Averages and float gradients are calculated in wider lanes: SUM_LANES elements per step.
+template <class T> struct Filter3x3Vec;
+template <> struct Filter3x3Vec<jbyte> {
+	typedef VInt V;
+	typedef uint16_t SumT;
+	static const int LANES= VEC_BYTES, SUM_LANES= VEC_BYTES/2;
+	static inline V load(const jbyte *p)            {return vLoad(p);}
+	static inline void store(jbyte *p, V v)         {vStore(p,v);}
+	static inline V min(V a, V b)                   {return vMinU8(a,b);}
+	static inline V max(V a, V b)                   {return vMaxU8(a,b);}
+	static inline void sum(SumT *t, const jbyte *a, const jbyte *b, const jbyte *c) {
+		vStore(t,vAddI16(vAddI16(vLoadU8U16(a),vLoadU8U16(b)),vLoadU8U16(c)));
+	}
+	// (s+4)/9 = (s+4)*7282>>16 for all s+4<=2299 (7282/65536 exceeds 1/9 by less than 0.007/2299)
+	static inline void average(jbyte *d, const SumT *t) {
+		VInt s= vAddI16(vAddI16(vAddI16(vLoad(t),vLoad(t+1)),vLoad(t+2)),vSet1I16(4));
+		vStoreU16U8(d,vMulhiU16(s,vSet1I16(7282)));
+	}
+	// floor((x+y)/2) = avg(x,y)-((x^y)&1), where avg is rounded up
+	static inline void gradient(jbyte *dest, const jbyte *l, const jbyte *r, const jbyte *u, const jbyte *d) {
+		VInt x= vAbsDiffU8(vLoad(r),vLoad(l)), y= vAbsDiffU8(vLoad(d),vLoad(u));
+		vStore(dest,vSubI8(vAvgU8(x,y),vAnd(vXor(x,y),vSet1I8(1))));
+	}
+	static const int GRADIENT_LANES= VEC_BYTES;
+};
+template <> struct Filter3x3Vec<jshort> {
+	typedef VInt V;
+	typedef jint SumT;
+	static const int LANES= VEC_BYTES/2, SUM_LANES= VEC_BYTES/4;
+	static inline V load(const jshort *p)           {return vLoad(p);}
+	static inline void store(jshort *p, V v)        {vStore(p,v);}
+	static inline V min(V a, V b)                   {return vMinU16(a,b);}
+	static inline V max(V a, V b)                   {return vMaxU16(a,b);}
+	static inline void sum(SumT *t, const jshort *a, const jshort *b, const jshort *c) {
+		vStore(t,vAddI32(vAddI32(vLoadU16U32(a),vLoadU16U32(b)),vLoadU16U32(c)));
+	}
+	// s+4<2^24 is exact in float; (s+4)/9 rounded to float stays below the next integer
+	// (the fraction is at most 8/9), so the truncation gives the integer quotient
+	static inline void average(jshort *d, const SumT *t) {
+		VInt s= vAddI32(vAddI32(vAddI32(vLoad(t),vLoad(t+1)),vLoad(t+2)),vSet1I32(4));
+		vStoreU32U16(d,vCvttFI32(vDivF(vCvtI32F(s),vSet1F(9.0f))));
+	}
+	static inline void gradient(jshort *dest, const jshort *l, const jshort *r, const jshort *u, const jshort *d) {
+		VInt x= vAbsDiffU16(vLoad(r),vLoad(l)), y= vAbsDiffU16(vLoad(d),vLoad(u));
+		vStore(dest,vSubI16(vAvgU16(x,y),vAnd(vXor(x,y),vSet1I16(1))));
+	}
+	static const int GRADIENT_LANES= VEC_BYTES/2;
+};
+template <> struct Filter3x3Vec<jfloat> {
+	typedef VFloat V;
+	typedef jdouble SumT;
+	static const int LANES= VEC_BYTES/4, SUM_LANES= VEC_BYTES/8;
+	static inline V load(const jfloat *p)           {return vLoadF(p);}
+	static inline void store(jfloat *p, V v)        {vStoreF(p,v);}
+	static inline V min(V a, V b)                   {return vMinF(a,b);}
+	static inline V max(V a, V b)                   {return vMaxF(a,b);}
+	static inline void sum(SumT *t, const jfloat *a, const jfloat *b, const jfloat *c) {
+		vStoreD(t,vAddD(vAddD(vLoadFD(a),vLoadFD(b)),vLoadFD(c)));
+	}
+	static inline void average(jfloat *d, const SumT *t) {
+		vStoreDF(d,vDivD(vAddD(vAddD(vLoadD(t),vLoadD(t+1)),vLoadD(t+2)),vSet1D(9.0)));
+	}
+	static inline void gradient(jfloat *dest, const jfloat *l, const jfloat *r, const jfloat *u, const jfloat *d) {
+		VDouble x= vAbsDiffD(vLoadFD(r),vLoadFD(l)), y= vAbsDiffD(vLoadFD(d),vLoadFD(u));
+		vStoreDF(dest,vMulD(vAddD(x,y),vSet1D(0.5)));
+	}
+	static const int GRADIENT_LANES= VEC_BYTES/8;
+};
+
+template <bool MAX, class F> static inline typename F::V filter3x3MinMax(typename F::V a, typename F::V b) {
+	return MAX? F::max(a,b): F::min(a,b);
+}
+
+template <bool MAX, class T> static void filter3x3SquareRow(T *dest, const T *up, const T *middle, const T *down,
+	jlong dimX, jint filter, void *work)
+{
+	typedef Filter3x3Vec<T> F;
+	typedef Filter3x3Elem<T> E;
+	T *t= (T*)work;
+	jlong x= 0;
+	for (; x+F::LANES<=dimX; x+= F::LANES) {
+		F::store(t+x,filter3x3MinMax<MAX,F>(filter3x3MinMax<MAX,F>(F::load(up+x),F::load(middle+x)),F::load(down+x)));
+	}
+	for (; x<dimX; x++) {
+		typename E::V v= MAX? E::max(E::get(up[x]),E::get(middle[x])): E::min(E::get(up[x]),E::get(middle[x]));
+		t[x]= E::set(MAX? E::max(v,E::get(down[x])): E::min(v,E::get(down[x])));
+	}
+	for (x= 1; x+F::LANES<dimX; x+= F::LANES) {
+		F::store(dest+x,filter3x3MinMax<MAX,F>(filter3x3MinMax<MAX,F>(F::load(t+x-1),F::load(t+x)),F::load(t+x+1)));
+	}
+	_filter3x3Columns(dest,up,middle,down,dimX,filter,0,0,1);
+	_filter3x3Columns(dest,up,middle,down,dimX,filter,0,x,dimX);
+}
+
+template <bool MAX, class T> static void filter3x3CrossRow(T *dest, const T *up, const T *middle, const T *down,
+	jlong dimX, jint filter)
+{
+	typedef Filter3x3Vec<T> F;
+	jlong x= 1;
+	for (; x+F::LANES<dimX; x+= F::LANES) {
+		typename F::V v= filter3x3MinMax<MAX,F>(F::load(up+x),F::load(down+x));
+		typename F::V h= filter3x3MinMax<MAX,F>(filter3x3MinMax<MAX,F>(F::load(middle+x-1),F::load(middle+x)),
+			F::load(middle+x+1));
+		F::store(dest+x,filter3x3MinMax<MAX,F>(v,h));
+	}
+	_filter3x3Columns(dest,up,middle,down,dimX,filter,0,0,1);
+	_filter3x3Columns(dest,up,middle,down,dimX,filter,0,x,dimX);
+}
+
+template <class T> static void filter3x3AverageRow(T *dest, const T *up, const T *middle, const T *down, jlong dimX,
+	void *work)
+{
+	typedef Filter3x3Vec<T> F;
+	typedef Filter3x3Elem<T> E;
+	typename F::SumT *t= (typename F::SumT*)work;
+	jlong x= 0;
+	for (; x+F::SUM_LANES<=dimX; x+= F::SUM_LANES) F::sum(t+x,up+x,middle+x,down+x);
+	for (; x<dimX; x++) t[x]= (typename F::SumT)E::sum(E::get(up[x]),E::get(middle[x]),E::get(down[x]));
+	for (x= 1; x+F::SUM_LANES<dimX; x+= F::SUM_LANES) F::average(dest+x,t+x-1);
+	_filter3x3Columns(dest,up,middle,down,dimX,FILTER3X3_AVERAGE_BY_SQUARE,0,0,1);
+	_filter3x3Columns(dest,up,middle,down,dimX,FILTER3X3_AVERAGE_BY_SQUARE,0,x,dimX);
+}
+
+template <class T> static void filter3x3GradientRow(T *dest, const T *up, const T *middle, const T *down, jlong dimX) {
+	typedef Filter3x3Vec<T> F;
+	jlong x= 1;
+	for (; x+F::GRADIENT_LANES<dimX; x+= F::GRADIENT_LANES) {
+		F::gradient(dest+x,middle+x-1,middle+x+1,up+x,down+x);
+	}
+	_filter3x3Columns(dest,up,middle,down,dimX,FILTER3X3_QUICK_GRADIENT_BY_CROSS,0,0,1);
+	_filter3x3Columns(dest,up,middle,down,dimX,FILTER3X3_QUICK_GRADIENT_BY_CROSS,0,x,dimX);
+}
+
+// Work memory: the rows lo, mid and hi of vertically sorted columns
+template <int K, class T> static void filter3x3PercentileRow(T *dest, const T *up, const T *middle, const T *down,
+	jlong dimX, void *work)
+{
+	typedef Filter3x3Vec<T> F;
+	typedef Filter3x3Elem<T> E;
+	T *lo= (T*)work, *mid= lo+dimX, *hi= mid+dimX;
+	jlong x= 0;
+	for (; x+F::LANES<=dimX; x+= F::LANES) {
+		typename F::V a= F::load(up+x), b= F::load(middle+x), c= F::load(down+x);
+		_sort3<F>(a,b,c);
+		F::store(lo+x,a);
+		F::store(mid+x,b);
+		F::store(hi+x,c);
+	}
+	for (; x<dimX; x++) {
+		typename E::V a= E::get(up[x]), b= E::get(middle[x]), c= E::get(down[x]);
+		_sort3<E>(a,b,c);
+		lo[x]= E::set(a);
+		mid[x]= E::set(b);
+		hi[x]= E::set(c);
+	}
+	for (x= 1; x+F::LANES<dimX; x+= F::LANES) {
+		F::store(dest+x,_percentile9<K,F>(F::load(lo+x-1),F::load(lo+x),F::load(lo+x+1),
+			F::load(mid+x-1),F::load(mid+x),F::load(mid+x+1),F::load(hi+x-1),F::load(hi+x),F::load(hi+x+1)));
+	}
+	_percentile3x3Columns<K>(dest,up,middle,down,dimX,0,1);
+	_percentile3x3Columns<K>(dest,up,middle,down,dimX,x,dimX);
+}
+
+template <class T> static void filter3x3(T *dest, const T *src, jlong dimX, jlong dimY, jlong fromY, jlong toY,
+	jint filter, jint percentileIndex, void *work)
+{
+	for (jlong y= fromY; y<toY; y++) {
+		const T *up, *middle, *down;
+		_filter3x3Lines(src,dimX,dimY,y,up,middle,down);
+		T *d= dest+y*dimX;
+		switch (filter) {
+			case FILTER3X3_EROSION_BY_SQUARE: filter3x3SquareRow<false>(d,up,middle,down,dimX,filter,work); break;
+			case FILTER3X3_DILATION_BY_SQUARE: filter3x3SquareRow<true>(d,up,middle,down,dimX,filter,work); break;
+			case FILTER3X3_EROSION_BY_CROSS: filter3x3CrossRow<false>(d,up,middle,down,dimX,filter); break;
+			case FILTER3X3_DILATION_BY_CROSS: filter3x3CrossRow<true>(d,up,middle,down,dimX,filter); break;
+			case FILTER3X3_AVERAGE_BY_SQUARE: filter3x3AverageRow(d,up,middle,down,dimX,work); break;
+			case FILTER3X3_QUICK_GRADIENT_BY_CROSS: filter3x3GradientRow(d,up,middle,down,dimX); break;
+			case FILTER3X3_PERCENTILE_BY_SQUARE:
+				switch (percentileIndex) {
+					case 0: filter3x3PercentileRow<0>(d,up,middle,down,dimX,work); break;
+					case 1: filter3x3PercentileRow<1>(d,up,middle,down,dimX,work); break;
+					case 2: filter3x3PercentileRow<2>(d,up,middle,down,dimX,work); break;
+					case 3: filter3x3PercentileRow<3>(d,up,middle,down,dimX,work); break;
+					case 4: filter3x3PercentileRow<4>(d,up,middle,down,dimX,work); break;
+					case 5: filter3x3PercentileRow<5>(d,up,middle,down,dimX,work); break;
+					case 6: filter3x3PercentileRow<6>(d,up,middle,down,dimX,work); break;
+					case 7: filter3x3PercentileRow<7>(d,up,middle,down,dimX,work); break;
+					case 8: filter3x3PercentileRow<8>(d,up,middle,down,dimX,work); break;
+				}
+				break;
+		}
+	}
+}
+
+// Rank filters (see ArraysRank.h): 16 uint16 bars of column histograms are added to jint aperture bars
+struct RankVecOps: RankScalarOps {
+	static inline void add(jint *k, const uint16_t *a) {
+		for (jint j= 0; j<RANK_LEVEL_BARS; j+= VEC_BYTES/4) vStore(k+j,vAddI32(vLoad(k+j),vLoadU16U32(a+j)));
+	}
+	static inline void update(jint *k, const uint16_t *added, const uint16_t *subtracted) {
+		for (jint j= 0; j<RANK_LEVEL_BARS; j+= VEC_BYTES/4) {
+			vStore(k+j,vAddI32(vLoad(k+j),vSubI32(vLoadU16U32(added+j),vLoadU16U32(subtracted+j))));
+		}
+	}
+};
+
+template <class T> static void rank(T *dest, const T *src, jlong dimX, jlong dimY, jlong fromX, jlong toX,
+	jint apertureDimX, jint apertureDimY, jint mode, jlong fromIndex, jlong toIndex, void *work)
+{
+	_rankFilter<T,RankVecOps>(dest,src,dimX,dimY,fromX,toX,apertureDimX,apertureDimY,mode,fromIndex,toIndex,work);
+}
+
+static ArraysKernels newKernels() {
+	ArraysKernels k;
+	memset(&k,0,sizeof(k));
+	k.name= KERNELS_NAME;
+	k.level= KERNELS_LEVEL;
+	k.copyBytes= copyBytes;
+	k.swapBytesShort= swapBytes<jshort>;
+	k.swapBytesInt= swapBytes<jint>;
+	k.swapBytesLong= swapBytes<jlong>;
+	k.fillByte= fillByte;
+	k.fillShort= fillShort;
+	k.fillInt= fillInt;
+	k.fillLong= fillLong;
+	k.minByte= minByte;
+	k.maxByte= maxByte;
+	k.minuByte= minuByte;
+	k.maxuByte= maxuByte;
+	k.minShort= minShort;
+	k.maxShort= maxShort;
+	k.minuShort= minuShort;
+	k.maxuShort= maxuShort;
+	k.minInt= minInt;
+	k.maxInt= maxInt;
+	k.minuInt= minuInt;
+	k.maxuInt= maxuInt;
+	k.minLong= minLong;
+	k.maxLong= maxLong;
+	k.minuLong= minuLong;
+	k.maxuLong= maxuLong;
+	k.minFloat= minFloat;
+	k.maxFloat= maxFloat;
+	k.minDouble= minDouble;
+	k.maxDouble= maxDouble;
+	k.rangeByte= rangeByte;
+	k.rangeChar= rangeChar;
+	k.rangeShort= rangeShort;
+	k.rangeInt= rangeInt;
+	k.rangeLong= rangeLong;
+	k.rangeFloat= rangeFloat;
+	k.rangeDouble= rangeDouble;
+	k.addByte= addByte;
+	k.addShort= addShort;
+	k.addInt= addInt;
+	k.addLong= addLong;
+	k.addFloat= addFloat;
+	k.addDouble= addDouble;
+	k.subByte= subByte;
+	k.subShort= subShort;
+	k.subInt= subInt;
+	k.subLong= subLong;
+	k.subFloat= subFloat;
+	k.subDouble= subDouble;
+	k.addsByte= addsByte;
+	k.addsShort= addsShort;
+	k.subsByte= subsByte;
+	k.subsShort= subsShort;
+	k.addusByte= addusByte;
+	k.addusShort= addusShort;
+	k.subusByte= subusByte;
+	k.subusShort= subusShort;
+	k.absDiffByte= absDiffByte;
+	k.absDiffShort= absDiffShort;
+	k.absDiffInt= absDiffInt;
+	k.absDiffLong= absDiffLong;
+	k.absDiffFloat= absDiffFloat;
+	k.absDiffDouble= absDiffDouble;
+	k.absDiffuByte= absDiffuByte;
+	k.absDiffuShort= absDiffuShort;
+	k.absDiffuInt= absDiffuInt;
+	k.absDiffuLong= absDiffuLong;
+	k.oppositeByte= oppositeByte;
+	k.oppositeShort= oppositeShort;
+	k.oppositeInt= oppositeInt;
+	k.oppositeLong= oppositeLong;
+	k.oppositeFloat= oppositeFloat;
+	k.oppositeDouble= oppositeDouble;
+	k.copyBits= copyBits;
+	k.andBits= andBits;
+	k.orBits= orBits;
+	k.xorBits= xorBits;
+	k.andNotBits= andNotBits;
+	k.notBits= notBits;
+	k.cardinalityBits= cardinalityBits;
+#if defined(ARRAYS_KERNELS_AVX512)
+	k.cardinalityBitsVpopcnt= cardinalityBitsVpopcnt;
+#endif
+	k.indexOfBit= indexOfBit;
+	k.lastIndexOfBit= lastIndexOfBit;
+	k.packBitsByte= packBits<uint8_t>;
+	k.packBitsChar= packBits<jchar>;
+	k.packBitsInt= packBits<jint>;
+	k.packBitsLong= packBits<jlong>;
+	k.packBitsFloat= packBits<jfloat>;
+	k.packBitsDouble= packBits<jdouble>;
+	k.unpackBitsByte= unpackBits<jbyte>;
+	k.unpackBitsShort= unpackBits<jshort>;
+	k.unpackBitsInt= unpackBits<jint>;
+	k.unpackBitsLong= unpackBits<jlong>;
+	k.indexOfByte= indexOfValue<jbyte>;
+	k.indexOfShort= indexOfValue<jshort>;
+	k.indexOfInt= indexOfValue<jint>;
+	k.indexOfLong= indexOfValue<jlong>;
+	k.indexOfFloat= indexOfValue<jfloat>;
+	k.indexOfDouble= indexOfValue<jdouble>;
+	k.lastIndexOfByte= lastIndexOfValue<jbyte>;
+	k.lastIndexOfShort= lastIndexOfValue<jshort>;
+	k.lastIndexOfInt= lastIndexOfValue<jint>;
+	k.lastIndexOfLong= lastIndexOfValue<jlong>;
+	k.lastIndexOfFloat= lastIndexOfValue<jfloat>;
+	k.lastIndexOfDouble= lastIndexOfValue<jdouble>;
+	k.filter3x3Byte= filter3x3<jbyte>;
+	k.filter3x3Short= filter3x3<jshort>;
+	k.filter3x3Float= filter3x3<jfloat>;
+	k.rankByte= rank<jbyte>;
+	k.rankShort= rank<jshort>;
+	return k;
+}
+
+extern const ArraysKernels KERNELS_TABLE= newKernels();
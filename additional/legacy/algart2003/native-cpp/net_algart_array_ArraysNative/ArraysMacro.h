@@ -22,20 +22,25 @@
  * SOFTWARE.
  */
 
+#include <stdint.h>
+
 #define CPU_FPU (1)
 #define CPU_TSC (1<<4)
 #define CPU_CMOV (1<<15)
 #define CPU_MMX (1<<23)
 #define CPU_SSE (1<<25)
 #define CPU_SSE2 (1<<26)
-#define CPU_AMD ((__int64)1<<59)
-#define CPU_MMXEX ((__int64)1<<60)
-#define CPU_3DNOWEX ((__int64)1<<62)
-#define CPU_3DNOW ((__int64)1<<63)
+#define CPU_AVX2 ((jlong)1<<54)
+#define CPU_AVX512 ((jlong)1<<55)
+#define CPU_AVX512POPCNT ((jlong)1<<56)
+#define CPU_AMD ((jlong)1<<59)
+#define CPU_MMXEX ((jlong)1<<60)
+#define CPU_3DNOWEX ((jlong)1<<62)
+#define CPU_3DNOW ((jlong)1<<63)
 
 #define CPU_AMD_L (1<<(59-32))
 #define CPU_3DNOWEX_L (1<<(62-32))
-#define CPU_3DNOW_L (1<<(63-32))
+#define CPU_3DNOW_L (1u<<(63-32))
 
 #define CPU_L2SIZE_SHIFT 32
 #define CPU_L2SIZE_UNIT (32*1024)
@@ -76,6 +81,72 @@ SINGLE_PREFIX_NO_ARGUMENTS(TYPE)\
 		} env->ReleasePrimitiveArrayCritical((jarray)B, b, JNI_ABORT); _FB: ;\
 SINGLE_POSTFIX\
 
+// Packed bits of long[] arrays: A is the destination, B is the source; positions and counts are in bits
+#define BITS_PREFIX \
+(JNIEnv *env, jclass, jlong CpuInfo, jlongArray A, jlong APos, jlongArray B, jlong BPos, jlong Count) {\
+PAIR_PREFIX_NO_ARGUMENTS(jlong)\
+
+// Threshold packing: A is the destination long[] (APos is in bits), B is the source TYPEARRAY
+#define PACK_BITS_PREFIX(TYPE,TYPEARRAY) \
+(JNIEnv *env, jclass, jlong CpuInfo, jlongArray A, jlong APos, TYPEARRAY B, jint Bofs, jint Count, TYPE Threshold, jint Cmp) {\
+SINGLE_PREFIX_NO_ARGUMENTS(jlong)\
+		TYPE *b= (TYPE*)env->GetPrimitiveArrayCritical((jarray)B, NULL); if (b==NULL) {OUT_OF_MEMORY; goto _FB;} {\
+
+// Bit unpacking: A is the destination TYPEARRAY, B is the source long[] (BPos is in bits)
+#define UNPACK_BITS_PREFIX(TYPE,TYPEARRAY) \
+(JNIEnv *env, jclass, jlong CpuInfo, TYPEARRAY A, jint Aofs, jlongArray B, jlong BPos, jint Count, TYPE Value0, TYPE Value1, jint Mode) {\
+SINGLE_PREFIX_NO_ARGUMENTS(TYPE)\
+		jlong *b= (jlong*)env->GetPrimitiveArrayCritical((jarray)B, NULL); if (b==NULL) {OUT_OF_MEMORY; goto _FB;} {\
+
+// Histogram: A is the long[] bars (its length is requested before entering critical regions),
+// B is the source TYPEARRAY
+#define HISTOGRAM_PREFIX(TYPE,TYPEARRAY) \
+(JNIEnv *env, jclass, jlong CpuInfo, jlongArray A, TYPEARRAY B, jint Bofs, jint Len, jint Shift) {\
+	jint BarsLen= env->GetArrayLength(A);\
+SINGLE_PREFIX_NO_ARGUMENTS(jlong)\
+		TYPE *b= (TYPE*)env->GetPrimitiveArrayCritical((jarray)B, NULL); if (b==NULL) {OUT_OF_MEMORY; goto _FB;} {\
+
+// 3x3 filters: A is the destination, B is the source DimX x DimY matrix (see ArraysFilter3x3.h)
+#define FILTER3X3_PREFIX(TYPE,TYPEARRAY) \
+(JNIEnv *env, jclass, jlong CpuInfo, TYPEARRAY A, jint Aofs, TYPEARRAY B, jint Bofs, jint DimX, jint DimY,\
+	jint Filter, jint PercentileIndex) {\
+PAIR_PREFIX_NO_ARGUMENTS(TYPE)\
+
+// Rank filters: A is the destination, B is the source DimX x DimY matrix (see ArraysRank.h)
+#define RANK_PREFIX(TYPE,TYPEARRAY) \
+(JNIEnv *env, jclass, jlong CpuInfo, TYPEARRAY A, jint Aofs, TYPEARRAY B, jint Bofs, jint DimX, jint DimY,\
+	jint ApertureDimX, jint ApertureDimY, jint Mode, jint FromIndex, jint ToIndex) {\
+PAIR_PREFIX_NO_ARGUMENTS(TYPE)\
+
+// Erosion/dilation by rectangles: A is the destination, B is the source DimX x DimY matrix (see ArraysMorphology.h)
+#define MORPHOLOGY_PREFIX(TYPE,TYPEARRAY) \
+(JNIEnv *env, jclass, jlong CpuInfo, TYPEARRAY A, jint Aofs, TYPEARRAY B, jint Bofs, jint DimX, jint DimY,\
+	jint ApertureDimX, jint ApertureDimY, jboolean Dilation) {\
+PAIR_PREFIX_NO_ARGUMENTS(TYPE)\
+
+// Reading packed bits FromIndex..ToIndex-1 of a long[] array into jlong Result
+#define BITS_COUNT_PREFIX \
+(JNIEnv *env, jclass, jlong CpuInfo, jlongArray A, jlong FromIndex, jlong ToIndex) {\
+BITS_READ_PREFIX_NO_ARGUMENTS\
+
+#define BITS_SEARCH_PREFIX \
+(JNIEnv *env, jclass, jlong CpuInfo, jlongArray A, jlong FromIndex, jlong ToIndex, jboolean Value) {\
+BITS_READ_PREFIX_NO_ARGUMENTS\
+
+#define BITS_READ_PREFIX_NO_ARGUMENTS \
+	jlong Result= -1;\
+	try {\
+		jlong *a= (jlong*)env->GetPrimitiveArrayCritical((jarray)A, NULL); if (a==NULL) {OUT_OF_MEMORY; return Result;} {\
+
+#define BITS_READ_POSTFIX \
+		} env->ReleasePrimitiveArrayCritical((jarray)A, a, JNI_ABORT);\
+	} catch (...) {\
+		env->ThrowNew(env->FindClass("java/lang/InternalError"),\
+			"Unexpected exception in ArraysNative, C++ or Assembler code");\
+	}\
+	return Result;\
+}
+
 #define PAIRBUFFER_PREFIX(TYPE,TYPEOBJECT) \
 (JNIEnv *env, jclass, jlong CpuInfo, TYPEOBJECT A, jint Aofs, TYPEOBJECT B, jint Bofs, jint Len) {\
 	try {\
@@ -89,24 +160,240 @@ SINGLE_POSTFIX\
 	}\
 }
 
-#define LOOP_PREFIX_ALIGNED(UNLOOPING) \
-	jint len= Len;\
-	int disp= (int)pa&31;\
-	jint lenStart= 0;\
-	if (disp!=0 && (disp&(sizeof(*pa)-1))==0) {\
-		lenStart= (32-disp)/sizeof(*pa);\
-		if (len<lenStart) lenStart= 0;\
-		else              len-= lenStart;\
+// Every operand may be a Java array or a direct buffer (of any element type): the buffer addresses
+// are requested before entering critical regions, where no other JNI calls are allowed.
+// Heap (non-direct) buffers must not be passed here.
+#define MIXED_PAIR_PREFIX(TYPE) \
+(JNIEnv *env, jclass, jlong CpuInfo, jobject A, jint Aofs, jobject B, jint Bofs, jint Len) {\
+	try {\
+		TYPE *aBuf= (TYPE*)env->GetDirectBufferAddress(A);\
+		TYPE *bBuf= (TYPE*)env->GetDirectBufferAddress(B);\
+		TYPE *a= aBuf!=NULL? aBuf: (TYPE*)env->GetPrimitiveArrayCritical((jarray)A, NULL); if (a==NULL) {OUT_OF_MEMORY; goto _FA;} {\
+		TYPE *b= bBuf!=NULL? bBuf: (TYPE*)env->GetPrimitiveArrayCritical((jarray)B, NULL); if (b==NULL) {OUT_OF_MEMORY; goto _FB;} {\
+
+#define MIXED_PAIR_POSTFIX \
+		} if (bBuf==NULL) env->ReleasePrimitiveArrayCritical((jarray)B, b, JNI_ABORT); _FB: ;\
+		} if (aBuf==NULL) env->ReleasePrimitiveArrayCritical((jarray)A, a, 0); _FA: ;\
+PAIRBUFFER_POSTFIX\
+
+// Reductions of an array or a direct buffer into a Java array RESULT: result[RANGE_MIN], result[RANGE_MAX],
+// result[RANGE_MIN_INDEX], result[RANGE_MAX_INDEX] (indexes in A, -1 if there is no minimum), result[RANGE_SUM].
+// RESULT is filled after leaving the critical region.
+#define RANGE_MIN 0
+#define RANGE_MAX 1
+#define RANGE_MIN_INDEX 2
+#define RANGE_MAX_INDEX 3
+#define RANGE_SUM 4
+#define RANGE_RESULT_LENGTH 5
+
+#define MIXED_RANGE_PREFIX(TYPE,RESULTTYPE) \
+(JNIEnv *env, jclass, jlong CpuInfo, jobject A, jint Aofs, jint Len, RESULTTYPE##Array Result) {\
+	try {\
+		RESULTTYPE result[RANGE_RESULT_LENGTH];\
+		TYPE *aBuf= (TYPE*)env->GetDirectBufferAddress(A);\
+		TYPE *a= aBuf!=NULL? aBuf: (TYPE*)env->GetPrimitiveArrayCritical((jarray)A, NULL); if (a==NULL) {OUT_OF_MEMORY; return;} {\
+
+#define MIXED_RANGE_POSTFIX(RESULTNAME) \
+		} if (aBuf==NULL) env->ReleasePrimitiveArrayCritical((jarray)A, a, JNI_ABORT);\
+		env->Set##RESULTNAME##ArrayRegion(Result, 0, RANGE_RESULT_LENGTH, result);\
+PAIRBUFFER_POSTFIX\
+
+// Search in a Java array or a direct buffer A: returns Aofs+index of the found element or -1
+#define MIXED_SEARCH_PREFIX(TYPE) \
+(JNIEnv *env, jclass, jlong CpuInfo, jobject A, jint Aofs, jint Len, TYPE V) {\
+	jint Result= -1;\
+	try {\
+		TYPE *aBuf= (TYPE*)env->GetDirectBufferAddress(A);\
+		TYPE *a= aBuf!=NULL? aBuf: (TYPE*)env->GetPrimitiveArrayCritical((jarray)A, NULL); if (a==NULL) {OUT_OF_MEMORY; return Result;} {\
+
+#define MIXED_SEARCH_POSTFIX \
+		} if (aBuf==NULL) env->ReleasePrimitiveArrayCritical((jarray)A, a, JNI_ABORT);\
+	} catch (...) {\
+		env->ThrowNew(env->FindClass("java/lang/InternalError"),\
+			"Unexpected exception in ArraysNative, C++ or Assembler code");\
+	}\
+	return Result;\
+}
+
+// Long-indexed variants for off-heap memory (direct or mapped buffers): raw addresses and 64-bit lengths
+#define NULL_ADDRESS \
+	env->ThrowNew(env->FindClass("java/lang/NullPointerException"),\
+		"Zero memory address in ArraysNative");\
+
+#define ADDRESS_SINGLE_PREFIX(TYPE) \
+(JNIEnv *env, jclass, jlong CpuInfo, jlong AAddress, jlong Len, TYPE V) {\
+	const jlong BeginIndex= 0;\
+	try {\
+		TYPE *a= (TYPE*)(size_t)AAddress; if (a==NULL) {NULL_ADDRESS; return;}\
+
+#define ADDRESS_PAIR_PREFIX(TYPE) \
+(JNIEnv *env, jclass, jlong CpuInfo, jlong AAddress, jlong BAddress, jlong Len) {\
+	const jlong Aofs= 0, Bofs= 0;\
+	try {\
+		TYPE *a= (TYPE*)(size_t)AAddress; if (a==NULL) {NULL_ADDRESS; return;}\
+		TYPE *b= (TYPE*)(size_t)BAddress; if (b==NULL) {NULL_ADDRESS; return;}\
+
+#define ADDRESS_POSTFIX \
+PAIRBUFFER_POSTFIX\
+
+#define PAIR_KERNEL(COUNTER,KERNEL,TYPE,C_LOOP) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)Len*sizeof(TYPE))\
+	if (kernels!=NULL) {\
+		kernels->KERNEL((TYPE*)a+Aofs,(TYPE*)b+Bofs,Len);\
+	} else {\
+		C_LOOP\
+	}\
+
+#define BITS_KERNEL(COUNTER,KERNEL,OP) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,Count>>3)\
+	if (kernels!=NULL) {\
+		kernels->KERNEL(a,APos,b,BPos,Count);\
+	} else {\
+		_bits<OP>(a,APos,b,BPos,Count,_bitsWords<OP>);\
+	}\
+
+// TYPE is the element type of the kernel: unsigned for byte and short elements
+#define PACK_BITS_KERNEL(COUNTER,KERNEL,TYPE) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)Count*sizeof(TYPE))\
+	if (kernels!=NULL) {\
+		kernels->KERNEL(a,APos,(const TYPE*)b+Bofs,Count,(TYPE)Threshold,Cmp);\
+	} else {\
+		_packBitsLoop<TYPE>(a,APos,(const TYPE*)b+Bofs,Count,(TYPE)Threshold,Cmp);\
+	}\
+
+// KERNELTYPE is the integer type of the same size as the Java elements
+#define UNPACK_BITS_KERNEL(COUNTER,KERNEL,KERNELTYPE) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)Count*sizeof(KERNELTYPE))\
+	KERNELTYPE v0, v1; memcpy(&v0,&Value0,sizeof(v0)); memcpy(&v1,&Value1,sizeof(v1));\
+	if (kernels!=NULL) {\
+		kernels->KERNEL((KERNELTYPE*)a+Aofs,b,BPos,Count,v0,v1,Mode);\
+	} else {\
+		_unpackBitsLoop<KERNELTYPE>((KERNELTYPE*)a+Aofs,b,BPos,Count,v0,v1,Mode);\
+	}\
+
+// Byte order reversal for MIXED_PAIR_PREFIX: a is the destination, b is the source
+// (released without copying back), offsets and Len are in elements
+#define SWAP_BYTES_KERNEL(COUNTER,KERNEL,TYPE) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)Len*sizeof(TYPE))\
+	if (kernels!=NULL) {\
+		kernels->KERNEL(a+Aofs,b+Bofs,Len,_nonTemporalMinLen(CpuInfo)/2);\
+	} else {\
+		_swapBytesLoop(a+Aofs,b+Bofs,Len,0);\
 	}\
-	jint lenEnd= len&(UNLOOPING/sizeof(*pa)-1);\
-	len/= (UNLOOPING/sizeof(*pa));\
-	if (len>0) {len--; lenEnd+= UNLOOPING/sizeof(*pa);}\
+
+// Histograms are not vectorized: the same C++ code is used for all CPUs
+#define HISTOGRAM_KERNEL(COUNTER,TYPE) \
+	COUNTED(COUNTER,0,(jlong)Len*sizeof(TYPE))\
+	_parallelHistogram<TYPE>(a,BarsLen,b+Bofs,Len,Shift);\
+
+// TYPE is the type of the kernel: jshort for Java char
+#define FILTER3X3_KERNEL(COUNTER,KERNEL,TYPE) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)DimX*DimY*sizeof(TYPE))\
+	_parallelFilter3x3<TYPE>(kernels!=NULL? kernels->KERNEL: _filter3x3Loop<TYPE>,\
+		(TYPE*)a+Aofs,(const TYPE*)b+Bofs,DimX,DimY,Filter,PercentileIndex);\
+
+// TYPE is the type of the kernel: jshort for Java char
+#define RANK_KERNEL(COUNTER,KERNEL,TYPE) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)DimX*DimY*sizeof(TYPE))\
+	_parallelRank<TYPE>(kernels!=NULL? kernels->KERNEL: _rankLoop<TYPE>,\
+		(TYPE*)a+Aofs,(const TYPE*)b+Bofs,DimX,DimY,ApertureDimX,ApertureDimY,Mode,FromIndex,ToIndex);\
+
+// TYPE is the type of the kernel: jshort for Java char; the column pass uses the pairwise MIN/MAX kernels
+#define MORPHOLOGY_KERNEL(COUNTER,MIN,MAX,TYPE) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)DimX*DimY*sizeof(TYPE))\
+	void (*op)(TYPE *a, const TYPE *b, jlong len)= kernels!=NULL? (Dilation? kernels->MAX: kernels->MIN):\
+		Dilation? _morphologyPairLoop<TYPE,true>: _morphologyPairLoop<TYPE,false>;\
+	_parallelMorphology<TYPE>(op,(TYPE*)a+Aofs,(const TYPE*)b+Bofs,DimX,DimY,ApertureDimX,ApertureDimY,Dilation!=0);\
+
+// KERNELTYPE is the type of the kernel: jshort for Java char
+#define SEARCH_KERNEL(COUNTER,KERNEL,KERNELTYPE,C_LOOP) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)Len*sizeof(KERNELTYPE))\
+	KERNELTYPE v; memcpy(&v,&V,sizeof(v));\
+	const KERNELTYPE *pa= (KERNELTYPE*)a+Aofs;\
+	jlong index= kernels!=NULL? kernels->KERNEL(pa,Len,v): C_LOOP<KERNELTYPE>(pa,Len,v);\
+	Result= index>=0? Aofs+(jint)index: -1;\
+
+// The AVX-512 kernels use vpopcntq only if CpuInfo contains CPU_AVX512POPCNT
+#define BITS_COUNT_KERNEL \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(cardinalityBits,kernels!=NULL? kernels->level: 0,(ToIndex-FromIndex)>>3)\
+	if (kernels==NULL) {\
+		Result= _cardinalityBits(a,FromIndex,ToIndex-FromIndex,_bitCountWords);\
+	} else if ((CpuInfo&CPU_AVX512POPCNT) && kernels->cardinalityBitsVpopcnt!=NULL) {\
+		Result= kernels->cardinalityBitsVpopcnt(a,FromIndex,ToIndex-FromIndex);\
+	} else {\
+		Result= kernels->cardinalityBits(a,FromIndex,ToIndex-FromIndex);\
+	}\
+
+#define BITS_SEARCH_KERNEL(COUNTER,KERNEL,C_FUNCTION,C_WORDS) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(ToIndex-FromIndex)>>3)\
+	if (kernels!=NULL) {\
+		Result= kernels->KERNEL(a,FromIndex,ToIndex,Value);\
+	} else {\
+		Result= C_FUNCTION(a,FromIndex,ToIndex,Value!=0,C_WORDS);\
+	}\
+
+// SUMTYPE is uint64_t (wrapping integer sums, stored in ArraysRange::sum) or jdouble (ArraysRange::doubleSum)
+#define RANGE_KERNEL(COUNTER,KERNEL,TYPE,SUMTYPE,SUMFIELD) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)Len*sizeof(TYPE))\
+	const TYPE *pa= (TYPE*)a+Aofs;\
+	ArraysRange r;\
+	if (kernels!=NULL) {\
+		kernels->KERNEL(pa,Len,&r);\
+	} else {\
+		r.SUMFIELD= (SUMTYPE)_rangeLoop<TYPE,SUMTYPE>(pa,Len,&r);\
+	}\
+	result[RANGE_MIN]= r.minIndex>=0? pa[r.minIndex]: 0;\
+	result[RANGE_MAX]= r.maxIndex>=0? pa[r.maxIndex]: 0;\
+	result[RANGE_MIN_INDEX]= r.minIndex>=0? Aofs+r.minIndex: -1;\
+	result[RANGE_MAX_INDEX]= r.maxIndex>=0? Aofs+r.maxIndex: -1;\
+	result[RANGE_SUM]= r.SUMFIELD;\
+
+#define SINGLE_KERNEL(COUNTER,KERNEL,TYPE,C_LOOP) \
+	const ArraysKernels *kernels= _kernels(CpuInfo);\
+	COUNTED(COUNTER,kernels!=NULL? kernels->level: 0,(jlong)Len*sizeof(TYPE))\
+	if (kernels!=NULL) {\
+		TYPE v; memcpy(&v,&V,sizeof(v));\
+		kernels->KERNEL((TYPE*)a+BeginIndex,Len,v,_nonTemporalMinLen(CpuInfo));\
+	} else {\
+		C_LOOP\
+	}\
+
+// Floating-point min/max with Java Math.min/max semantics (ArraysJavaMath.h)
+#define JAVA_MINMAXBODY_LOOP(TYPE,MINMAX) \
+	TYPE *pa= (TYPE*)a+Aofs, *pb= (TYPE*)b+Bofs;\
+	for (jlong len= Len; len>0; len--,pa++,pb++) *pa= MINMAX(*pa,*pb);\
+
+// Element-wise arithmetic "a= OP(a,b)" (ArraysArithmetic.h)
+#define PAIROPBODY_LOOP(TYPE,OP) \
+	TYPE *pa= (TYPE*)a+Aofs, *pb= (TYPE*)b+Bofs;\
+	for (jlong len= Len; len>0; len--,pa++,pb++) *pa= OP(*pa,*pb);\
 
 #define LOOP_PREFIX(UNLOOPING) \
-	jint len= Len;\
+	jlong len= Len;\
 	jint lenEnd= len&(UNLOOPING/sizeof(*pa)-1);\
 	len/= (UNLOOPING/sizeof(*pa));\
 
+#define FILLBODY_LOOP(TYPE) \
+	TYPE *pa= (TYPE*)a+BeginIndex;\
+	LOOP_PREFIX(8*sizeof(TYPE))\
+	for (; len>0; len--,pa+=8) {\
+		pa[0]= V; pa[1]= V; pa[2]= V; pa[3]= V;\
+		pa[4]= V; pa[5]= V; pa[6]= V; pa[7]= V;\
+	}\
+	for (; lenEnd>0; lenEnd--,pa++) *pa= V;\
+
 #define MINBODY_LOOP(TYPE) \
 	TYPE *pa= (TYPE*)a+Aofs, *pb= (TYPE*)b+Bofs;\
 	LOOP_PREFIX(32*sizeof(TYPE))\
@@ -0,0 +1,179 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef A_ARRAYSMORPHOLOGY_H__INCLUDED_
+#define A_ARRAYSMORPHOLOGY_H__INCLUDED_
+
+// Erosion (minimum) and dilation (maximum) of a dimX x dimY matrix, stored row by row, by the rectangular
+// aperture of ArraysRank.h: x-apertureDimX/2..x-apertureDimX/2+apertureDimX-1, y-apertureDimY/2..
+// y-apertureDimY/2+apertureDimY-1, with the same pseudo-cyclic continuation. jbyte and jshort elements are
+// unsigned (Java char is processed as jshort), jint and jlong are signed, jfloat and jdouble minimum and
+// maximum are Java Math.min/max (see ArraysJavaMath.h).
+//
+// The rectangle is the Minkowski sum of a vertical and a horizontal segment, and every segment of any
+// length w is processed by the van Herk / Gil-Werman algorithm: the line is split into blocks of w
+// elements, g[i] is the minimum (maximum) from the start of the block to i, h[i] from i to the end of
+// the block, and the result for the segment i..i+w-1 is min(h[i],g[i+w-1]): 3 comparisons per element.
+// The vertical pass is made first, from src to dest, by bands of columns: all rows of the band fit
+// in MORPHOLOGY_BAND_BYTES, and every row of the band is processed by the SIMD pairwise min/max
+// kernels (ArraysKernels::minuByte etc.). Then the horizontal pass processes the rows of dest in place.
+// Apertures longer than the matrix are equivalent to the whole row (column) and are reduced to it.
+#define MORPHOLOGY_BAND_BYTES (512<<10)
+#define MORPHOLOGY_MIN_BAND_BYTES 256
+
+#include "ArraysJavaMath.h"
+
+template <class T> struct MorphologyElem;
+template <> struct MorphologyElem<jbyte> {
+	static inline jbyte min(jbyte a, jbyte b)       {return (uint8_t)a<(uint8_t)b? a: b;}
+	static inline jbyte max(jbyte a, jbyte b)       {return (uint8_t)a>(uint8_t)b? a: b;}
+};
+template <> struct MorphologyElem<jshort> {
+	static inline jshort min(jshort a, jshort b)    {return (uint16_t)a<(uint16_t)b? a: b;}
+	static inline jshort max(jshort a, jshort b)    {return (uint16_t)a>(uint16_t)b? a: b;}
+};
+template <> struct MorphologyElem<jint> {
+	static inline jint min(jint a, jint b)          {return a<b? a: b;}
+	static inline jint max(jint a, jint b)          {return a>b? a: b;}
+};
+template <> struct MorphologyElem<jlong> {
+	static inline jlong min(jlong a, jlong b)       {return a<b? a: b;}
+	static inline jlong max(jlong a, jlong b)       {return a>b? a: b;}
+};
+template <> struct MorphologyElem<jfloat> {
+	static inline jfloat min(jfloat a, jfloat b)    {return _javaMinF(a,b);}
+	static inline jfloat max(jfloat a, jfloat b)    {return _javaMaxF(a,b);}
+};
+template <> struct MorphologyElem<jdouble> {
+	static inline jdouble min(jdouble a, jdouble b) {return _javaMinD(a,b);}
+	static inline jdouble max(jdouble a, jdouble b) {return _javaMaxD(a,b);}
+};
+
+template <class T, bool DILATION> inline T _morphologyOp(T a, T b) {
+	return DILATION? MorphologyElem<T>::max(a,b): MorphologyElem<T>::min(a,b);
+}
+
+// C++ loop of the pairwise operation a[k]=min(a[k],b[k]) (max for dilation), like ArraysKernels::minuByte
+template <class T, bool DILATION> void _morphologyPairLoop(T *a, const T *b, jlong len) {
+	for (jlong k= 0; k<len; k++) a[k]= _morphologyOp<T,DILATION>(a[k],b[k]);
+}
+
+inline jlong _morphologyMod(jlong v, jlong n) {
+	v%= n;
+	return v<0? v+n: v;
+}
+
+// Columns of one band of the vertical pass
+template <class T> inline jlong _morphologyBandWidth(jlong dimX, jlong dimY, jlong apertureDimY) {
+	jlong result= MORPHOLOGY_BAND_BYTES/((dimY+apertureDimY)*(jlong)sizeof(T));
+	if (result<MORPHOLOGY_MIN_BAND_BYTES/(jlong)sizeof(T)) result= MORPHOLOGY_MIN_BAND_BYTES/(jlong)sizeof(T);
+	return result<dimX? result: dimX;
+}
+
+// Work memory of one thread for both passes; apertures must be already reduced to the matrix
+template <class T> inline size_t _morphologyWorkBytes(jlong dimX, jlong dimY, jlong apertureDimX, jlong apertureDimY) {
+	jlong columns= (dimY+apertureDimY)*_morphologyBandWidth<T>(dimX,dimY,apertureDimY);
+	jlong rows= 2*(dimX+apertureDimX-1);
+	return (size_t)((columns>rows? columns: rows)*sizeof(T));
+}
+
+// The vertical pass: the columns fromX..toX-1 of dest are the minima (maxima) of apertureDimY elements of src;
+// op is the pairwise SIMD kernel or _morphologyPairLoop
+template <class T> void _morphologyColumns(void (*op)(T *a, const T *b, jlong len), T *dest, const T *src,
+	jlong dimX, jlong dimY, jlong fromX, jlong toX, jlong apertureDimY, void *work)
+{
+	const jlong bandWidth= _morphologyBandWidth<T>(dimX,dimY,apertureDimY), ext= dimY+apertureDimY-1;
+	for (jlong x0= fromX; x0<toX; x0+= bandWidth) {
+		const jlong w= toX-x0<bandWidth? toX-x0: bandWidth;
+		const size_t rowBytes= w*sizeof(T);
+		if (apertureDimY==1) {
+			for (jlong y= 0; y<dimY; y++) memcpy(dest+y*dimX+x0,src+y*dimX+x0,rowBytes);
+			continue;
+		}
+		T *h= (T*)work, *g= h+ext*w; // g: the single current row
+		// h: from the row e to the end of its block, the blocks start at e=0, apertureDimY, 2*apertureDimY, ...
+		jlong y= _morphologyMod(ext-1-apertureDimY/2,dimY);
+		for (jlong e= ext-1; e>=0; e--) {
+			memcpy(h+e*w,src+y*dimX+x0,rowBytes);
+			if (e<ext-1 && (e+1)%apertureDimY!=0) op(h+e*w,h+(e+1)*w,w);
+			y= y>0? y-1: dimY-1;
+		}
+		y= _morphologyMod(-apertureDimY/2,dimY);
+		for (jlong e= 0, i= 0; e<ext; e++, i++) {
+			if (i==apertureDimY) i= 0;
+			if (i==0) {
+				memcpy(g,src+y*dimX+x0,rowBytes);
+			} else {
+				op(g,src+y*dimX+x0,w);
+			}
+			if (e>=apertureDimY-1) {
+				T *d= dest+(e-apertureDimY+1)*dimX+x0;
+				memcpy(d,h+(e-apertureDimY+1)*w,rowBytes);
+				op(d,g,w);
+			}
+			y= y<dimY-1? y+1: 0;
+		}
+	}
+}
+
+// The van Herk / Gil-Werman 1D filter of one row in place: a[x] is replaced with the minimum (maximum)
+// of a[x-apertureDimX/2..x-apertureDimX/2+apertureDimX-1], cyclically; work: 2*(len+apertureDimX-1) elements
+template <class T, bool DILATION> void _morphologyRow(T *a, jlong len, jlong apertureDimX, T *work) {
+	const jlong ext= len+apertureDimX-1;
+	T *s= work, *h= work+ext;
+	for (jlong e= 0, x= _morphologyMod(-apertureDimX/2,len); e<ext; e++) {
+		s[e]= a[x];
+		x= x<len-1? x+1: 0;
+	}
+	jlong i= (ext-1)%apertureDimX;
+	h[ext-1]= s[ext-1];
+	for (jlong e= ext-2; e>=0; e--) {
+		if (i==0) i= apertureDimX;
+		i--;
+		h[e]= i==apertureDimX-1? s[e]: _morphologyOp<T,DILATION>(s[e],h[e+1]);
+	}
+	T g= s[0];
+	for (jlong e= 0, j= 0; e<ext; e++, j++) {
+		if (j==apertureDimX) j= 0;
+		g= j==0? s[e]: _morphologyOp<T,DILATION>(g,s[e]);
+		if (e>=apertureDimX-1) a[e-apertureDimX+1]= _morphologyOp<T,DILATION>(h[e-apertureDimX+1],g);
+	}
+}
+
+// The horizontal pass: the rows fromY..toY-1 of the matrix a in place
+template <class T> void _morphologyRows(T *a, jlong dimX, jlong fromY, jlong toY, jlong apertureDimX,
+	bool dilation, void *work)
+{
+	if (apertureDimX==1) return;
+	for (jlong y= fromY; y<toY; y++) {
+		if (dilation) {
+			_morphologyRow<T,true>(a+y*dimX,dimX,apertureDimX,(T*)work);
+		} else {
+			_morphologyRow<T,false>(a+y*dimX,dimX,apertureDimX,(T*)work);
+		}
+	}
+}
+
+#endif //A_ARRAYSMORPHOLOGY_H__INCLUDED_
@@ -26,16 +26,18 @@
 #include "net_algart_array_ArraysNative.h"
 #include "ArraysMacro.h"
 #include "ArraysFunctions.h"
+#include "ArraysKernels.h"
+#include "ArraysJavaMath.h"
+#include "ArraysArithmetic.h"
+#include "ArraysBits.h"
+#include "ArraysCounters.h"
+#include "ArraysFilter3x3.h"
+#include "ArraysRank.h"
+#include "ArraysMorphology.h"
+#include "ArraysThreadPool.h"
+#include "ArraysHistogram.h"
 
-#include <string.h> // memmove()
-
-#define MMXASM_SUPPORTED
-#define SSEASM_SUPPORTED
-#ifdef _MSC_VER
-	#if _MSC_VER<1200
-		#undef SSEASM_SUPPORTED
-	#endif
-#endif //_MSC_VER
+#include <string.h> // memmove(), memcpy()
 
 /*
  * Class:     net_algart_array_ArraysNative
@@ -56,6 +58,42 @@ JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_detectImplementedFlags
 	env->SetStaticBooleanField(clazz,
 		env->GetStaticFieldID(clazz,"minmaxuImplemented","Z"),
 		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"rangeImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"arithmeticImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"bitsImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"bitsSearchImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"packBitsImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"unpackBitsImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"searchImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"swapBytesImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"histogramImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"filter3x3Implemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"rankImplemented","Z"),
+		JNI_TRUE);
+	env->SetStaticBooleanField(clazz,
+		env->GetStaticFieldID(clazz,"morphologyImplemented","Z"),
+		JNI_TRUE);
 }
 
 /*
@@ -68,6 +106,129 @@ JNIEXPORT jlong JNICALL Java_net_algart_array_ArraysNative_getCpuInfoInternal
 	return _cpuInfo();
 }
 
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    getCpuDescriptorInternal
+ * Signature: ()[J
+ */
+JNIEXPORT jlongArray JNICALL Java_net_algart_array_ArraysNative_getCpuDescriptorInternal
+(JNIEnv *env, jclass) {
+	const CpuDescriptor &d= _cpuDescriptor();
+	jlong values[CPU_DESCRIPTOR_NUMANODEMAP+CPU_MAX_LOGICAL_PROCESSORS];
+	values[CPU_DESCRIPTOR_VENDOR]= d.vendor;
+	values[CPU_DESCRIPTOR_FAMILY]= d.family;
+	values[CPU_DESCRIPTOR_MODEL]= d.model;
+	values[CPU_DESCRIPTOR_STEPPING]= d.stepping;
+	values[CPU_DESCRIPTOR_FEATURES]= d.features;
+	values[CPU_DESCRIPTOR_L1DATASIZE]= d.l1DataSize;
+	values[CPU_DESCRIPTOR_L1INSTRUCTIONSIZE]= d.l1InstructionSize;
+	values[CPU_DESCRIPTOR_L2SIZE]= d.l2Size;
+	values[CPU_DESCRIPTOR_L3SIZE]= d.l3Size;
+	values[CPU_DESCRIPTOR_CACHELINESIZE]= d.cacheLineSize;
+	values[CPU_DESCRIPTOR_L2SHAREDBY]= d.l2SharedBy;
+	values[CPU_DESCRIPTOR_L3SHAREDBY]= d.l3SharedBy;
+	values[CPU_DESCRIPTOR_LOGICALPROCESSORS]= d.logicalProcessors;
+	values[CPU_DESCRIPTOR_PHYSICALCORES]= d.physicalCores;
+	values[CPU_DESCRIPTOR_PACKAGES]= d.packages;
+	values[CPU_DESCRIPTOR_NUMANODES]= d.numaNodes;
+	jint n= d.logicalProcessors<CPU_MAX_LOGICAL_PROCESSORS? d.logicalProcessors: CPU_MAX_LOGICAL_PROCESSORS;
+	for (jint k=0; k<n; k++) values[CPU_DESCRIPTOR_NUMANODEMAP+k]= d.numaNode[k];
+	jlongArray result= env->NewLongArray(CPU_DESCRIPTOR_NUMANODEMAP+n);
+	if (result==NULL) return NULL; // OutOfMemoryError is already thrown
+	env->SetLongArrayRegion(result,0,CPU_DESCRIPTOR_NUMANODEMAP+n,values);
+	return result;
+}
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    getKernelsName
+ * Signature: (J)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_net_algart_array_ArraysNative_getKernelsName
+(JNIEnv *env, jclass, jlong CpuInfo) {
+	const ArraysKernels *kernels= _kernels(CpuInfo);
+	return env->NewStringUTF(kernels!=NULL? kernels->name: "C++");
+}
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    getCounterNames
+ * Signature: ()[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_net_algart_array_ArraysNative_getCounterNames
+(JNIEnv *env, jclass) {
+#define COUNTER_NAME_ITEM(NAME) #NAME,
+	static const char *names[COUNTER_COUNT]= {ARRAYS_COUNTERS(COUNTER_NAME_ITEM)};
+#undef COUNTER_NAME_ITEM
+	jobjectArray result= env->NewObjectArray(COUNTER_COUNT,env->FindClass("java/lang/String"),NULL);
+	if (result==NULL) return NULL;
+	for (jint k=0; k<COUNTER_COUNT; k++) {
+		jstring name= env->NewStringUTF(names[k]);
+		if (name==NULL) return NULL;
+		env->SetObjectArrayElement(result,k,name);
+		env->DeleteLocalRef(name);
+	}
+	return result;
+}
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    getCountersInternal
+ * Signature: ()[J
+ */
+JNIEXPORT jlongArray JNICALL Java_net_algart_array_ArraysNative_getCountersInternal
+(JNIEnv *env, jclass) {
+	jlong sum[COUNTER_COUNT][COUNTER_FIELDS];
+	_countersSum(sum);
+	jlong (&baseline)[COUNTER_COUNT][COUNTER_FIELDS]= _countersBaseline();
+	for (int k=0; k<COUNTER_COUNT; k++)
+		for (int j=0; j<COUNTER_FIELDS; j++) sum[k][j]-= baseline[k][j];
+	jlongArray result= env->NewLongArray(COUNTER_COUNT*COUNTER_FIELDS);
+	if (result==NULL) return NULL;
+	env->SetLongArrayRegion(result,0,COUNTER_COUNT*COUNTER_FIELDS,&sum[0][0]);
+	return result;
+}
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    resetCounters
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_resetCounters
+(JNIEnv *, jclass) {
+	_countersSum(_countersBaseline());
+}
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    setCountersEnabled
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_setCountersEnabled
+(JNIEnv *, jclass, jboolean enabled) {
+	_countersEnabled().store(enabled!=JNI_FALSE);
+}
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    getThreadsInternal
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_getThreadsInternal
+(JNIEnv *, jclass) {
+	return _threadPool().threads();
+}
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    setThreadsInternal
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_setThreadsInternal
+(JNIEnv *, jclass, jint threads) {
+	_threadPool().setThreads(threads);
+}
+
 /*
  * Class:     net_algart_array_ArraysNative
  * Method:    ptrOfs
@@ -79,7 +240,7 @@ JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_ptrOfs
 		void *a= env->GetPrimitiveArrayCritical((jarray)A, NULL);
 		if (a==NULL) return 0;
 		env->ReleasePrimitiveArrayCritical((jarray)A, a, 0);
-		return (jint)a;
+		return (jint)(size_t)a;
 	} catch (...) {\
 		return 0;
 	}\
@@ -92,88 +253,16 @@ JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_ptrOfs
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_copyBytes
 PAIR_PREFIX(jbyte,jobject)
-#ifdef SSEASM_SUPPORTED
-if (CpuInfo & CPU_SSE) {
-	int cacheSize= (int)((CpuInfo>>CPU_L2SIZE_SHIFT)&CPU_L2SIZE)*CPU_L2SIZE_UNIT;
-	if (cacheSize<65536) cacheSize= 65536;
-	int cacheSizeIn64ByteBlocks= cacheSize/64;
-	int nonCachedCopyMinLen= cacheSizeIn64ByteBlocks/2;
-	jbyte *pb= a+Aofs, *pa= b+Bofs;\
-	LOOP_PREFIX_ALIGNED(64)
-	__asm {
-		push esi;
-		push edi;
-		mov esi,pb;
-		mov edi,pa;
-		mov ecx,lenStart;
-		cld;
-		rep movsb;
-		mov ecx,len;
-		jecxz _EndLoopAligned_ntps;
-		test esi,0xF;
-		jnz _Loop;
-		test edi,0xF;
-		jnz _Loop;
-		cmp ecx,nonCachedCopyMinLen;
-		jb _LoopAligned;
-	_LoopAligned_ntps:
-		prefetcht0 [esi+64];
-		movaps xmm0,[esi];
-		movaps xmm1,[esi+16];
-		prefetcht0 [esi+96];
-		movaps xmm2,[esi+32];
-		movaps xmm3,[esi+48];
-		movntps [edi],xmm0;
-		movntps [edi+16],xmm1;
-		movntps [edi+32],xmm2;
-		movntps [edi+48],xmm3;
-		add esi,64;
-		add edi,64;
-		dec ecx;
-		jnz _LoopAligned_ntps;
-	_EndLoopAligned_ntps:
-		jmp _EndLoop;
-	_LoopAligned:
-		prefetcht0 [esi+64];
-		movaps xmm0,[esi];
-		movaps xmm1,[esi+16];
-		prefetcht0 [esi+96];
-		movaps xmm2,[esi+32];
-		movaps xmm3,[esi+48];
-		movaps [edi],xmm0;
-		movaps [edi+16],xmm1;
-		movaps [edi+32],xmm2;
-		movaps [edi+48],xmm3;
-		add esi,64;
-		add edi,64;
-		dec ecx;
-		jnz _LoopAligned;
-		jmp _EndLoop;
-	_Loop:
-		prefetcht0 [esi+64];
-		movups xmm0,[esi];
-		movups xmm1,[esi+16];
-		prefetcht0 [esi+96];
-		movups xmm2,[esi+32];
-		movups xmm3,[esi+48];
-		movups [edi],xmm0;
-		movups [edi+16],xmm1;
-		movups [edi+32],xmm2;
-		movups [edi+48],xmm3;
-		add esi,64;
-		add edi,64;
-		dec ecx;
-		jnz _Loop;
-	_EndLoop:
-		mov ecx,lenEnd;
-		cld;
-		rep movsb;
-		pop edi;
-		pop esi;
+const ArraysKernels *kernels= _kernels(CpuInfo);
+COUNTED(copyBytes,kernels!=NULL? kernels->level: 0,Len)
+if (kernels!=NULL) {
+	jbyte *dest= b+Bofs, *src= a+Aofs;
+	if (Len>=_parallelCopyMinLen() && (dest+Len<=src || src+Len<=dest) && _threadPool().threads()>1) {
+		_parallelCopyBytes(kernels,dest,src,Len,_nonTemporalMinLen(CpuInfo)/2);
+	} else {
+		kernels->copyBytes(dest,src,Len,_nonTemporalMinLen(CpuInfo)/2);
 	}
-} else 
-#endif
-{
+} else {
 	memmove(b+Bofs,a+Aofs,Len);
 }
 PAIR_POSTFIX
@@ -185,8 +274,7 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fill__J_3CIIC
 SINGLE_PREFIX(jchar,jcharArray)
-#define TYPE jchar
-#include "Arrays_fill.h"
+SINGLE_KERNEL(fillChar,fillShort,jshort,FILLBODY_LOOP(jchar))
 SINGLE_POSTFIX
 
 /*
@@ -196,8 +284,7 @@ SINGLE_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fill__J_3BIIB
 SINGLE_PREFIX(jbyte,jbyteArray)
-#define TYPE jbyte
-#include "Arrays_fill.h"
+SINGLE_KERNEL(fillByte,fillByte,jbyte,FILLBODY_LOOP(jbyte))
 SINGLE_POSTFIX
 
 /*
@@ -207,8 +294,7 @@ SINGLE_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fill__J_3SIIS
 SINGLE_PREFIX(jshort,jshortArray)
-#define TYPE jshort
-#include "Arrays_fill.h"
+SINGLE_KERNEL(fillShort,fillShort,jshort,FILLBODY_LOOP(jshort))
 SINGLE_POSTFIX
 
 /*
@@ -218,8 +304,7 @@ SINGLE_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fill__J_3IIII
 SINGLE_PREFIX(jint,jintArray)
-#define TYPE jint
-#include "Arrays_fill.h"
+SINGLE_KERNEL(fillInt,fillInt,jint,FILLBODY_LOOP(jint))
 SINGLE_POSTFIX
 
 /*
@@ -229,8 +314,7 @@ SINGLE_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fill__J_3JIIJ
 SINGLE_PREFIX(jlong,jlongArray)
-#define TYPE jlong
-#include "Arrays_fill.h"
+SINGLE_KERNEL(fillLong,fillLong,jlong,FILLBODY_LOOP(jlong))
 SINGLE_POSTFIX
 
 /*
@@ -240,8 +324,7 @@ SINGLE_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fill__J_3FIIF
 SINGLE_PREFIX(jfloat,jfloatArray)
-#define TYPE jfloat
-#include "Arrays_fill.h"
+SINGLE_KERNEL(fillFloat,fillInt,jint,FILLBODY_LOOP(jfloat))
 SINGLE_POSTFIX
 
 /*
@@ -251,8 +334,7 @@ SINGLE_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fill__J_3DIID
 SINGLE_PREFIX(jdouble,jdoubleArray)
-#define TYPE jdouble
-#include "Arrays_fill.h"
+SINGLE_KERNEL(fillDouble,fillLong,jlong,FILLBODY_LOOP(jdouble))
 SINGLE_POSTFIX
 
 /*
@@ -261,10 +343,12 @@ SINGLE_POSTFIX
  * Signature: (J[Ljava/lang/Object;IILjava/lang/Object;)V
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fill__J_3Ljava_lang_Object_2IILjava_lang_Object_2
-SINGLE_PREFIX(jobject,jobjectArray)
-#define TYPE jobject
-#include "Arrays_fill.h"
-SINGLE_POSTFIX
+(JNIEnv *env, jclass, jlong, jobjectArray A, jint BeginIndex, jint EndIndex, jobject V) {
+	COUNTED(fillObject,0,(jlong)(EndIndex-BeginIndex)*sizeof(jobject))
+	// References cannot be written into the array body directly: they may be compressed
+	// and such stores bypass the garbage collector barriers
+	for (jint k=BeginIndex; k<EndIndex; k++) env->SetObjectArrayElement(A,k,V);
+}
 
 /*
  * Class:     net_algart_array_ArraysNative
@@ -273,15 +357,7 @@ SINGLE_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_min__J_3BI_3BII
 PAIR_PREFIX(jbyte,jbyteArray)
-#define TYPE jbyte
-#define C_LOOP MINBODY_LOOP(jbyte)
-#define CMP >
-#define BIT_MASK_SSE 0x8080808080808080
-#define MINMAX_MMXEX pminub
-#define PCMPGT pcmpgtb
-#define MM0_FOR_MIN mm0
-#define MM1_FOR_MIN mm1
-#include "Arrays_minmax_int.h"
+PAIR_KERNEL(minByte,minByte,jbyte,MINBODY_LOOP(jbyte))
 PAIR_POSTFIX
 
 /*
@@ -290,16 +366,8 @@ PAIR_POSTFIX
  * Signature: (J[BI[BII)V
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_max__J_3BI_3BII
-PAIR_PREFIX(jbyte,jbyteArray) 
-#define TYPE jbyte
-#define C_LOOP MAXBODY_LOOP(jbyte)
-#define CMP <
-#define BIT_MASK_SSE 0x8080808080808080
-#define MINMAX_MMXEX pmaxub
-#define PCMPGT pcmpgtb
-#define MM0_FOR_MIN mm1
-#define MM1_FOR_MIN mm0
-#include "Arrays_minmax_int.h"
+PAIR_PREFIX(jbyte,jbyteArray)
+PAIR_KERNEL(maxByte,maxByte,jbyte,MAXBODY_LOOP(jbyte))
 PAIR_POSTFIX
 
 /*
@@ -309,15 +377,7 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_min__JLjava_nio_ByteBuffer_2ILjava_nio_ByteBuffer_2II
 PAIRBUFFER_PREFIX(jbyte,jobject)
-#define TYPE jbyte
-#define C_LOOP MINBODY_LOOP(jbyte)
-#define CMP >
-#define BIT_MASK_SSE 0x8080808080808080
-#define MINMAX_MMXEX pminub
-#define PCMPGT pcmpgtb
-#define MM0_FOR_MIN mm0
-#define MM1_FOR_MIN mm1
-#include "Arrays_minmax_int.h"
+PAIR_KERNEL(minByteBuffer,minByte,jbyte,MINBODY_LOOP(jbyte))
 PAIRBUFFER_POSTFIX
 
 /*
@@ -327,15 +387,7 @@ PAIRBUFFER_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_max__JLjava_nio_ByteBuffer_2ILjava_nio_ByteBuffer_2II
 PAIRBUFFER_PREFIX(jbyte,jobject)
-#define TYPE jbyte
-#define C_LOOP MAXBODY_LOOP(jbyte)
-#define CMP <
-#define BIT_MASK_SSE 0x8080808080808080
-#define MINMAX_MMXEX pmaxub
-#define PCMPGT pcmpgtb
-#define MM0_FOR_MIN mm1
-#define MM1_FOR_MIN mm0
-#include "Arrays_minmax_int.h"
+PAIR_KERNEL(maxByteBuffer,maxByte,jbyte,MAXBODY_LOOP(jbyte))
 PAIRBUFFER_POSTFIX
 
 /*
@@ -345,14 +397,7 @@ PAIRBUFFER_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_min__J_3SI_3SII
 PAIR_PREFIX(jshort,jshortArray)
-#define TYPE jshort
-#define C_LOOP MINBODY_LOOP(jshort)
-#define CMP >
-#define MINMAX_MMXEX pminsw
-#define PCMPGT pcmpgtw
-#define MM0_FOR_MIN mm0
-#define MM1_FOR_MIN mm1
-#include "Arrays_minmax_int.h"
+PAIR_KERNEL(minShort,minShort,jshort,MINBODY_LOOP(jshort))
 PAIR_POSTFIX
 
 /*
@@ -362,16 +407,28 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_max__J_3SI_3SII
 PAIR_PREFIX(jshort,jshortArray)
-#define TYPE jshort
-#define C_LOOP MAXBODY_LOOP(jshort)
-#define CMP <
-#define MINMAX_MMXEX pmaxsw
-#define PCMPGT pcmpgtw
-#define MM0_FOR_MIN mm1
-#define MM1_FOR_MIN mm0
-#include "Arrays_minmax_int.h"
+PAIR_KERNEL(maxShort,maxShort,jshort,MAXBODY_LOOP(jshort))
 PAIR_POSTFIX
 
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    min
+ * Signature: (J[CI[CII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_min__J_3CI_3CII
+PAIR_PREFIX(jchar,jcharArray)
+PAIR_KERNEL(minChar,minuShort,jshort,MINBODY_LOOP(jchar))
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    max
+ * Signature: (J[CI[CII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_max__J_3CI_3CII
+PAIR_PREFIX(jchar,jcharArray)
+PAIR_KERNEL(maxChar,maxuShort,jshort,MAXBODY_LOOP(jchar))
+PAIR_POSTFIX
 
 /*
  * Class:     net_algart_array_ArraysNative
@@ -380,16 +437,9 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_min__J_3II_3III
 PAIR_PREFIX(jint,jintArray)
-#define TYPE jint
-#define C_LOOP MINBODY_LOOP(jint)
-#define CMP >
-#define PCMPGT pcmpgtd
-#define MM0_FOR_MIN mm0
-#define MM1_FOR_MIN mm1
-#include "Arrays_minmax_int.h"
+PAIR_KERNEL(minInt,minInt,jint,MINBODY_LOOP(jint))
 PAIR_POSTFIX
 
-
 /*
  * Class:     net_algart_array_ArraysNative
  * Method:    max
@@ -397,13 +447,7 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_max__J_3II_3III
 PAIR_PREFIX(jint,jintArray)
-#define TYPE jint
-#define C_LOOP MAXBODY_LOOP(jint)
-#define CMP <
-#define PCMPGT pcmpgtd
-#define MM0_FOR_MIN mm1
-#define MM1_FOR_MIN mm0
-#include "Arrays_minmax_int.h"
+PAIR_KERNEL(maxInt,maxInt,jint,MAXBODY_LOOP(jint))
 PAIR_POSTFIX
 
 /*
@@ -413,7 +457,7 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_min__J_3JI_3JII
 PAIR_PREFIX(jlong,jlongArray)
-MINBODY_LOOP(jlong)
+PAIR_KERNEL(minLong,minLong,jlong,MINBODY_LOOP(jlong))
 PAIR_POSTFIX
 
 /*
@@ -423,7 +467,7 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_max__J_3JI_3JII
 PAIR_PREFIX(jlong,jlongArray)
-MAXBODY_LOOP(jlong)
+PAIR_KERNEL(maxLong,maxLong,jlong,MAXBODY_LOOP(jlong))
 PAIR_POSTFIX
 
 /*
@@ -433,11 +477,7 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_min__J_3FI_3FII
 PAIR_PREFIX(jfloat,jfloatArray)
-#define TYPE jfloat
-#define C_LOOP MINBODY_LOOP(jfloat)
-#define CMP >
-#define MINMAX_SSE minps
-#include "Arrays_minmax_float.h"
+PAIR_KERNEL(minFloat,minFloat,jfloat,JAVA_MINMAXBODY_LOOP(jfloat,_javaMinF))
 PAIR_POSTFIX
 
 /*
@@ -447,11 +487,7 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_max__J_3FI_3FII
 PAIR_PREFIX(jfloat,jfloatArray)
-#define TYPE jfloat
-#define C_LOOP MAXBODY_LOOP(jfloat)
-#define CMP <
-#define MINMAX_SSE maxps
-#include "Arrays_minmax_float.h"
+PAIR_KERNEL(maxFloat,maxFloat,jfloat,JAVA_MINMAXBODY_LOOP(jfloat,_javaMaxF))
 PAIR_POSTFIX
 
 /*
@@ -461,11 +497,7 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_min__J_3DI_3DII
 PAIR_PREFIX(jdouble,jdoubleArray)
-#define TYPE jdouble
-#define C_LOOP MINBODY_LOOP(jdouble)
-#define CMP >
-#define FCMOV fcmovnb
-#include "Arrays_minmax_double.h"
+PAIR_KERNEL(minDouble,minDouble,jdouble,JAVA_MINMAXBODY_LOOP(jdouble,_javaMinD))
 PAIR_POSTFIX
 
 /*
@@ -475,11 +507,7 @@ PAIR_POSTFIX
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_max__J_3DI_3DII
 PAIR_PREFIX(jdouble,jdoubleArray)
-#define TYPE jdouble
-#define C_LOOP MAXBODY_LOOP(jdouble)
-#define CMP <
-#define FCMOV fcmovb
-#include "Arrays_minmax_double.h"
+PAIR_KERNEL(maxDouble,maxDouble,jdouble,JAVA_MINMAXBODY_LOOP(jdouble,_javaMaxD))
 PAIR_POSTFIX
 
 /*
@@ -488,8 +516,8 @@ PAIR_POSTFIX
  * Signature: (J[BI[BII)V
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minu__J_3BI_3BII
-PAIR_PREFIX(unsigned __int8,jbyteArray) 
-#include "Arrays_pminub.h"
+PAIR_PREFIX(uint8_t,jbyteArray)
+PAIR_KERNEL(minuByte,minuByte,jbyte,MINBODY_LOOP(uint8_t))
 PAIR_POSTFIX
 
 /*
@@ -498,19 +526,18 @@ PAIR_POSTFIX
  * Signature: (J[BI[BII)V
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxu__J_3BI_3BII
-PAIR_PREFIX(unsigned __int8,jbyteArray)
-#include "Arrays_pmaxub.h"
+PAIR_PREFIX(uint8_t,jbyteArray)
+PAIR_KERNEL(maxuByte,maxuByte,jbyte,MAXBODY_LOOP(uint8_t))
 PAIR_POSTFIX
 
-
 /*
  * Class:     net_algart_array_ArraysNative
  * Method:    minu
  * Signature: (JLjava/nio/ByteBuffer;ILjava/nio/ByteBuffer;II)V
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minu__JLjava_nio_ByteBuffer_2ILjava_nio_ByteBuffer_2II
-PAIRBUFFER_PREFIX(unsigned __int8,jobject)
-#include "Arrays_pminub.h"
+PAIRBUFFER_PREFIX(uint8_t,jobject)
+PAIR_KERNEL(minuByteBuffer,minuByte,jbyte,MINBODY_LOOP(uint8_t))
 PAIRBUFFER_POSTFIX
 
 /*
@@ -519,8 +546,8 @@ PAIRBUFFER_POSTFIX
  * Signature: (JLjava/nio/ByteBuffer;ILjava/nio/ByteBuffer;II)V
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxu__JLjava_nio_ByteBuffer_2ILjava_nio_ByteBuffer_2II
-PAIRBUFFER_PREFIX(unsigned __int8,jobject)
-#include "Arrays_pmaxub.h"
+PAIRBUFFER_PREFIX(uint8_t,jobject)
+PAIR_KERNEL(maxuByteBuffer,maxuByte,jbyte,MAXBODY_LOOP(uint8_t))
 PAIRBUFFER_POSTFIX
 
 /*
@@ -529,17 +556,8 @@ PAIRBUFFER_POSTFIX
  * Signature: (J[SI[SII)V
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minu__J_3SI_3SII
-PAIR_PREFIX(unsigned __int16,jshortArray)
-#define TYPE unsigned __int16
-#define C_LOOP MINBODY_LOOP(unsigned __int16)
-#define CMP >
-#define BIT_MASK_SSE 0x8000800080008000
-#define MINMAX_MMXEX pminsw
-#define BIT_MASK_MMX 0x8000800080008000
-#define PCMPGT pcmpgtw
-#define MM0_FOR_MIN mm0
-#define MM1_FOR_MIN mm1
-#include "Arrays_minmax_int.h"
+PAIR_PREFIX(uint16_t,jshortArray)
+PAIR_KERNEL(minuShort,minuShort,jshort,MINBODY_LOOP(uint16_t))
 PAIR_POSTFIX
 
 /*
@@ -548,15 +566,1550 @@ PAIR_POSTFIX
  * Signature: (J[SI[SII)V
  */
 JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxu__J_3SI_3SII
-PAIR_PREFIX(unsigned __int16,jshortArray)
-#define TYPE unsigned __int16
-#define C_LOOP MAXBODY_LOOP(unsigned __int16)
-#define CMP <
-#define BIT_MASK_SSE 0x8000800080008000
-#define MINMAX_MMXEX pmaxsw
-#define BIT_MASK_MMX 0x8000800080008000
-#define PCMPGT pcmpgtw
-#define MM0_FOR_MIN mm1
-#define MM1_FOR_MIN mm0
-#include "Arrays_minmax_int.h"
+PAIR_PREFIX(uint16_t,jshortArray)
+PAIR_KERNEL(maxuShort,maxuShort,jshort,MAXBODY_LOOP(uint16_t))
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minu
+ * Signature: (J[II[III)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minu__J_3II_3III
+PAIR_PREFIX(uint32_t,jintArray)
+PAIR_KERNEL(minuInt,minuInt,jint,MINBODY_LOOP(uint32_t))
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxu
+ * Signature: (J[II[III)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxu__J_3II_3III
+PAIR_PREFIX(uint32_t,jintArray)
+PAIR_KERNEL(maxuInt,maxuInt,jint,MAXBODY_LOOP(uint32_t))
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minu
+ * Signature: (J[JI[JII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minu__J_3JI_3JII
+PAIR_PREFIX(uint64_t,jlongArray)
+PAIR_KERNEL(minuLong,minuLong,jlong,MINBODY_LOOP(uint64_t))
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxu
+ * Signature: (J[JI[JII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxu__J_3JI_3JII
+PAIR_PREFIX(uint64_t,jlongArray)
+PAIR_KERNEL(maxuLong,maxuLong,jlong,MAXBODY_LOOP(uint64_t))
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    directBufferAddress
+ * Signature: (Ljava/nio/Buffer;)J
+ */
+JNIEXPORT jlong JNICALL Java_net_algart_array_ArraysNative_directBufferAddress
+(JNIEnv *env, jclass, jobject B) {
+	return (jlong)(size_t)env->GetDirectBufferAddress(B);
+}
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    copyMemory
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_copyMemory
+ADDRESS_PAIR_PREFIX(jbyte)
+const ArraysKernels *kernels= _kernels(CpuInfo);
+COUNTED(copyMemory,kernels!=NULL? kernels->level: 0,Len)
+// a is the source, b is the destination, like in copyBytes
+jbyte *dest= b+Bofs, *src= a+Aofs;
+if (kernels!=NULL) {
+	if (Len>=_parallelCopyMinLen() && (dest+Len<=src || src+Len<=dest) && _threadPool().threads()>1) {
+		_parallelCopyBytes(kernels,dest,src,Len,_nonTemporalMinLen(CpuInfo)/2);
+	} else {
+		kernels->copyBytes(dest,src,Len,_nonTemporalMinLen(CpuInfo)/2);
+	}
+} else {
+	memmove(dest,src,(size_t)Len);
+}
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    fillBytes
+ * Signature: (JJJB)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fillBytes
+ADDRESS_SINGLE_PREFIX(jbyte)
+SINGLE_KERNEL(fillMemory,fillByte,jbyte,FILLBODY_LOOP(jbyte))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    fillShorts
+ * Signature: (JJJS)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fillShorts
+ADDRESS_SINGLE_PREFIX(jshort)
+SINGLE_KERNEL(fillMemory,fillShort,jshort,FILLBODY_LOOP(jshort))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    fillInts
+ * Signature: (JJJI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fillInts
+ADDRESS_SINGLE_PREFIX(jint)
+SINGLE_KERNEL(fillMemory,fillInt,jint,FILLBODY_LOOP(jint))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    fillLongs
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_fillLongs
+ADDRESS_SINGLE_PREFIX(jlong)
+SINGLE_KERNEL(fillMemory,fillLong,jlong,FILLBODY_LOOP(jlong))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minBytes
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minBytes
+ADDRESS_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(minmaxMemory,minByte,jbyte,MINBODY_LOOP(jbyte))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxBytes
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxBytes
+ADDRESS_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(minmaxMemory,maxByte,jbyte,MAXBODY_LOOP(jbyte))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minShorts
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minShorts
+ADDRESS_PAIR_PREFIX(jshort)
+PAIR_KERNEL(minmaxMemory,minShort,jshort,MINBODY_LOOP(jshort))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxShorts
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxShorts
+ADDRESS_PAIR_PREFIX(jshort)
+PAIR_KERNEL(minmaxMemory,maxShort,jshort,MAXBODY_LOOP(jshort))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minInts
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minInts
+ADDRESS_PAIR_PREFIX(jint)
+PAIR_KERNEL(minmaxMemory,minInt,jint,MINBODY_LOOP(jint))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxInts
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxInts
+ADDRESS_PAIR_PREFIX(jint)
+PAIR_KERNEL(minmaxMemory,maxInt,jint,MAXBODY_LOOP(jint))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minFloats
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minFloats
+ADDRESS_PAIR_PREFIX(jfloat)
+PAIR_KERNEL(minmaxMemory,minFloat,jfloat,JAVA_MINMAXBODY_LOOP(jfloat,_javaMinF))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxFloats
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxFloats
+ADDRESS_PAIR_PREFIX(jfloat)
+PAIR_KERNEL(minmaxMemory,maxFloat,jfloat,JAVA_MINMAXBODY_LOOP(jfloat,_javaMaxF))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minDoubles
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minDoubles
+ADDRESS_PAIR_PREFIX(jdouble)
+PAIR_KERNEL(minmaxMemory,minDouble,jdouble,JAVA_MINMAXBODY_LOOP(jdouble,_javaMinD))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxDoubles
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxDoubles
+ADDRESS_PAIR_PREFIX(jdouble)
+PAIR_KERNEL(minmaxMemory,maxDouble,jdouble,JAVA_MINMAXBODY_LOOP(jdouble,_javaMaxD))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minLongs
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minLongs
+ADDRESS_PAIR_PREFIX(jlong)
+PAIR_KERNEL(minmaxMemory,minLong,jlong,MINBODY_LOOP(jlong))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxLongs
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxLongs
+ADDRESS_PAIR_PREFIX(jlong)
+PAIR_KERNEL(minmaxMemory,maxLong,jlong,MAXBODY_LOOP(jlong))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minuBytes
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minuBytes
+ADDRESS_PAIR_PREFIX(uint8_t)
+PAIR_KERNEL(minmaxMemory,minuByte,jbyte,MINBODY_LOOP(uint8_t))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxuBytes
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxuBytes
+ADDRESS_PAIR_PREFIX(uint8_t)
+PAIR_KERNEL(minmaxMemory,maxuByte,jbyte,MAXBODY_LOOP(uint8_t))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minuShorts
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minuShorts
+ADDRESS_PAIR_PREFIX(uint16_t)
+PAIR_KERNEL(minmaxMemory,minuShort,jshort,MINBODY_LOOP(uint16_t))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxuShorts
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxuShorts
+ADDRESS_PAIR_PREFIX(uint16_t)
+PAIR_KERNEL(minmaxMemory,maxuShort,jshort,MAXBODY_LOOP(uint16_t))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minuInts
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minuInts
+ADDRESS_PAIR_PREFIX(uint32_t)
+PAIR_KERNEL(minmaxMemory,minuInt,jint,MINBODY_LOOP(uint32_t))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxuInts
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxuInts
+ADDRESS_PAIR_PREFIX(uint32_t)
+PAIR_KERNEL(minmaxMemory,maxuInt,jint,MAXBODY_LOOP(uint32_t))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minuLongs
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minuLongs
+ADDRESS_PAIR_PREFIX(uint64_t)
+PAIR_KERNEL(minmaxMemory,minuLong,jlong,MINBODY_LOOP(uint64_t))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxuLongs
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxuLongs
+ADDRESS_PAIR_PREFIX(uint64_t)
+PAIR_KERNEL(minmaxMemory,maxuLong,jlong,MAXBODY_LOOP(uint64_t))
+ADDRESS_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    copyBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_copyBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+const ArraysKernels *kernels= _kernels(CpuInfo);
+COUNTED(copyBuffer,kernels!=NULL? kernels->level: 0,Len)
+// a is the source, b is the destination, like in copyBytes
+jbyte *dest= b+Bofs, *src= a+Aofs;
+if (kernels!=NULL) {
+	if (Len>=_parallelCopyMinLen() && (dest+Len<=src || src+Len<=dest) && _threadPool().threads()>1) {
+		_parallelCopyBytes(kernels,dest,src,Len,_nonTemporalMinLen(CpuInfo)/2);
+	} else {
+		kernels->copyBytes(dest,src,Len,_nonTemporalMinLen(CpuInfo)/2);
+	}
+} else {
+	memmove(dest,src,Len);
+}
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    copyAndSwapShorts
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_copyAndSwapShorts
+MIXED_PAIR_PREFIX(jshort)
+SWAP_BYTES_KERNEL(copyAndSwapShorts,swapBytesShort,jshort)
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    copyAndSwapInts
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_copyAndSwapInts
+MIXED_PAIR_PREFIX(jint)
+SWAP_BYTES_KERNEL(copyAndSwapInts,swapBytesInt,jint)
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    copyAndSwapLongs
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_copyAndSwapLongs
+MIXED_PAIR_PREFIX(jlong)
+SWAP_BYTES_KERNEL(copyAndSwapLongs,swapBytesLong,jlong)
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(minmaxBuffer,minByte,jbyte,MINBODY_LOOP(jbyte))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(minmaxBuffer,maxByte,jbyte,MAXBODY_LOOP(jbyte))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(minmaxBuffer,minShort,jshort,MINBODY_LOOP(jshort))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(minmaxBuffer,maxShort,jshort,MAXBODY_LOOP(jshort))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minIntsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minIntsBuffer
+MIXED_PAIR_PREFIX(jint)
+PAIR_KERNEL(minmaxBuffer,minInt,jint,MINBODY_LOOP(jint))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxIntsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxIntsBuffer
+MIXED_PAIR_PREFIX(jint)
+PAIR_KERNEL(minmaxBuffer,maxInt,jint,MAXBODY_LOOP(jint))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minFloatsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minFloatsBuffer
+MIXED_PAIR_PREFIX(jfloat)
+PAIR_KERNEL(minmaxBuffer,minFloat,jfloat,JAVA_MINMAXBODY_LOOP(jfloat,_javaMinF))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxFloatsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxFloatsBuffer
+MIXED_PAIR_PREFIX(jfloat)
+PAIR_KERNEL(minmaxBuffer,maxFloat,jfloat,JAVA_MINMAXBODY_LOOP(jfloat,_javaMaxF))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minDoublesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minDoublesBuffer
+MIXED_PAIR_PREFIX(jdouble)
+PAIR_KERNEL(minmaxBuffer,minDouble,jdouble,JAVA_MINMAXBODY_LOOP(jdouble,_javaMinD))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxDoublesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxDoublesBuffer
+MIXED_PAIR_PREFIX(jdouble)
+PAIR_KERNEL(minmaxBuffer,maxDouble,jdouble,JAVA_MINMAXBODY_LOOP(jdouble,_javaMaxD))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minLongsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minLongsBuffer
+MIXED_PAIR_PREFIX(jlong)
+PAIR_KERNEL(minmaxBuffer,minLong,jlong,MINBODY_LOOP(jlong))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxLongsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxLongsBuffer
+MIXED_PAIR_PREFIX(jlong)
+PAIR_KERNEL(minmaxBuffer,maxLong,jlong,MAXBODY_LOOP(jlong))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minuBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minuBytesBuffer
+MIXED_PAIR_PREFIX(uint8_t)
+PAIR_KERNEL(minmaxBuffer,minuByte,jbyte,MINBODY_LOOP(uint8_t))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxuBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxuBytesBuffer
+MIXED_PAIR_PREFIX(uint8_t)
+PAIR_KERNEL(minmaxBuffer,maxuByte,jbyte,MAXBODY_LOOP(uint8_t))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minuShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minuShortsBuffer
+MIXED_PAIR_PREFIX(uint16_t)
+PAIR_KERNEL(minmaxBuffer,minuShort,jshort,MINBODY_LOOP(uint16_t))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxuShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxuShortsBuffer
+MIXED_PAIR_PREFIX(uint16_t)
+PAIR_KERNEL(minmaxBuffer,maxuShort,jshort,MAXBODY_LOOP(uint16_t))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minuIntsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minuIntsBuffer
+MIXED_PAIR_PREFIX(uint32_t)
+PAIR_KERNEL(minmaxBuffer,minuInt,jint,MINBODY_LOOP(uint32_t))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxuIntsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxuIntsBuffer
+MIXED_PAIR_PREFIX(uint32_t)
+PAIR_KERNEL(minmaxBuffer,maxuInt,jint,MAXBODY_LOOP(uint32_t))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    minuLongsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_minuLongsBuffer
+MIXED_PAIR_PREFIX(uint64_t)
+PAIR_KERNEL(minmaxBuffer,minuLong,jlong,MINBODY_LOOP(uint64_t))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    maxuLongsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_maxuLongsBuffer
+MIXED_PAIR_PREFIX(uint64_t)
+PAIR_KERNEL(minmaxBuffer,maxuLong,jlong,MAXBODY_LOOP(uint64_t))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rangeBytes
+ * Signature: (JLjava/lang/Object;II[J)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rangeBytes
+MIXED_RANGE_PREFIX(jbyte,jlong)
+RANGE_KERNEL(rangeByte,rangeByte,jbyte,uint64_t,sum)
+MIXED_RANGE_POSTFIX(Long)
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rangeChars
+ * Signature: (JLjava/lang/Object;II[J)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rangeChars
+MIXED_RANGE_PREFIX(jchar,jlong)
+RANGE_KERNEL(rangeChar,rangeChar,jchar,uint64_t,sum)
+MIXED_RANGE_POSTFIX(Long)
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rangeShorts
+ * Signature: (JLjava/lang/Object;II[J)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rangeShorts
+MIXED_RANGE_PREFIX(jshort,jlong)
+RANGE_KERNEL(rangeShort,rangeShort,jshort,uint64_t,sum)
+MIXED_RANGE_POSTFIX(Long)
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rangeInts
+ * Signature: (JLjava/lang/Object;II[J)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rangeInts
+MIXED_RANGE_PREFIX(jint,jlong)
+RANGE_KERNEL(rangeInt,rangeInt,jint,uint64_t,sum)
+MIXED_RANGE_POSTFIX(Long)
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rangeLongs
+ * Signature: (JLjava/lang/Object;II[J)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rangeLongs
+MIXED_RANGE_PREFIX(jlong,jlong)
+RANGE_KERNEL(rangeLong,rangeLong,jlong,uint64_t,sum)
+MIXED_RANGE_POSTFIX(Long)
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rangeFloats
+ * Signature: (JLjava/lang/Object;II[D)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rangeFloats
+MIXED_RANGE_PREFIX(jfloat,jdouble)
+RANGE_KERNEL(rangeFloat,rangeFloat,jfloat,jdouble,doubleSum)
+MIXED_RANGE_POSTFIX(Double)
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rangeDoubles
+ * Signature: (JLjava/lang/Object;II[D)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rangeDoubles
+MIXED_RANGE_PREFIX(jdouble,jdouble)
+RANGE_KERNEL(rangeDouble,rangeDouble,jdouble,jdouble,doubleSum)
+MIXED_RANGE_POSTFIX(Double)
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(add,addByte,jbyte,PAIROPBODY_LOOP(jbyte,_addI8))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(add,addShort,jshort,PAIROPBODY_LOOP(jshort,_addI16))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addIntsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addIntsBuffer
+MIXED_PAIR_PREFIX(jint)
+PAIR_KERNEL(add,addInt,jint,PAIROPBODY_LOOP(jint,_addI32))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addLongsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addLongsBuffer
+MIXED_PAIR_PREFIX(jlong)
+PAIR_KERNEL(add,addLong,jlong,PAIROPBODY_LOOP(jlong,_addI64))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addFloatsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addFloatsBuffer
+MIXED_PAIR_PREFIX(jfloat)
+PAIR_KERNEL(add,addFloat,jfloat,PAIROPBODY_LOOP(jfloat,_addF))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addDoublesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addDoublesBuffer
+MIXED_PAIR_PREFIX(jdouble)
+PAIR_KERNEL(add,addDouble,jdouble,PAIROPBODY_LOOP(jdouble,_addD))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(sub,subByte,jbyte,PAIROPBODY_LOOP(jbyte,_subI8))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(sub,subShort,jshort,PAIROPBODY_LOOP(jshort,_subI16))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subIntsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subIntsBuffer
+MIXED_PAIR_PREFIX(jint)
+PAIR_KERNEL(sub,subInt,jint,PAIROPBODY_LOOP(jint,_subI32))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subLongsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subLongsBuffer
+MIXED_PAIR_PREFIX(jlong)
+PAIR_KERNEL(sub,subLong,jlong,PAIROPBODY_LOOP(jlong,_subI64))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subFloatsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subFloatsBuffer
+MIXED_PAIR_PREFIX(jfloat)
+PAIR_KERNEL(sub,subFloat,jfloat,PAIROPBODY_LOOP(jfloat,_subF))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subDoublesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subDoublesBuffer
+MIXED_PAIR_PREFIX(jdouble)
+PAIR_KERNEL(sub,subDouble,jdouble,PAIROPBODY_LOOP(jdouble,_subD))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addsBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addsBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(adds,addsByte,jbyte,PAIROPBODY_LOOP(jbyte,_addsI8))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addsShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addsShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(adds,addsShort,jshort,PAIROPBODY_LOOP(jshort,_addsI16))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subsBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subsBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(subs,subsByte,jbyte,PAIROPBODY_LOOP(jbyte,_subsI8))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subsShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subsShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(subs,subsShort,jshort,PAIROPBODY_LOOP(jshort,_subsI16))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addusBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addusBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(addus,addusByte,jbyte,PAIROPBODY_LOOP(jbyte,_addusI8))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    addusShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_addusShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(addus,addusShort,jshort,PAIROPBODY_LOOP(jshort,_addusI16))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subusBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subusBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(subus,subusByte,jbyte,PAIROPBODY_LOOP(jbyte,_subusI8))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    subusShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_subusShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(subus,subusShort,jshort,PAIROPBODY_LOOP(jshort,_subusI16))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(absDiff,absDiffByte,jbyte,PAIROPBODY_LOOP(jbyte,_absDiffI8))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(absDiff,absDiffShort,jshort,PAIROPBODY_LOOP(jshort,_absDiffI16))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffIntsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffIntsBuffer
+MIXED_PAIR_PREFIX(jint)
+PAIR_KERNEL(absDiff,absDiffInt,jint,PAIROPBODY_LOOP(jint,_absDiffI32))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffLongsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffLongsBuffer
+MIXED_PAIR_PREFIX(jlong)
+PAIR_KERNEL(absDiff,absDiffLong,jlong,PAIROPBODY_LOOP(jlong,_absDiffI64))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffFloatsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffFloatsBuffer
+MIXED_PAIR_PREFIX(jfloat)
+PAIR_KERNEL(absDiff,absDiffFloat,jfloat,PAIROPBODY_LOOP(jfloat,_absDiffF))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffDoublesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffDoublesBuffer
+MIXED_PAIR_PREFIX(jdouble)
+PAIR_KERNEL(absDiff,absDiffDouble,jdouble,PAIROPBODY_LOOP(jdouble,_absDiffD))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffuBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffuBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(absDiffu,absDiffuByte,jbyte,PAIROPBODY_LOOP(jbyte,_absDiffUI8))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffuShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffuShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(absDiffu,absDiffuShort,jshort,PAIROPBODY_LOOP(jshort,_absDiffUI16))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffuIntsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffuIntsBuffer
+MIXED_PAIR_PREFIX(jint)
+PAIR_KERNEL(absDiffu,absDiffuInt,jint,PAIROPBODY_LOOP(jint,_absDiffUI32))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    absDiffuLongsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_absDiffuLongsBuffer
+MIXED_PAIR_PREFIX(jlong)
+PAIR_KERNEL(absDiffu,absDiffuLong,jlong,PAIROPBODY_LOOP(jlong,_absDiffUI64))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    oppositeBytesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_oppositeBytesBuffer
+MIXED_PAIR_PREFIX(jbyte)
+PAIR_KERNEL(opposite,oppositeByte,jbyte,PAIROPBODY_LOOP(jbyte,_oppositeI8))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    oppositeShortsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_oppositeShortsBuffer
+MIXED_PAIR_PREFIX(jshort)
+PAIR_KERNEL(opposite,oppositeShort,jshort,PAIROPBODY_LOOP(jshort,_oppositeI16))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    oppositeIntsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_oppositeIntsBuffer
+MIXED_PAIR_PREFIX(jint)
+PAIR_KERNEL(opposite,oppositeInt,jint,PAIROPBODY_LOOP(jint,_oppositeI32))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    oppositeLongsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_oppositeLongsBuffer
+MIXED_PAIR_PREFIX(jlong)
+PAIR_KERNEL(opposite,oppositeLong,jlong,PAIROPBODY_LOOP(jlong,_oppositeI64))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    oppositeFloatsBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_oppositeFloatsBuffer
+MIXED_PAIR_PREFIX(jfloat)
+PAIR_KERNEL(opposite,oppositeFloat,jfloat,PAIROPBODY_LOOP(jfloat,_oppositeF))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    oppositeDoublesBuffer
+ * Signature: (JLjava/lang/Object;ILjava/lang/Object;II)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_oppositeDoublesBuffer
+MIXED_PAIR_PREFIX(jdouble)
+PAIR_KERNEL(opposite,oppositeDouble,jdouble,PAIROPBODY_LOOP(jdouble,_oppositeD))
+MIXED_PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    copyBits
+ * Signature: (J[JJ[JJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_copyBits
+BITS_PREFIX
+BITS_KERNEL(copyBits,copyBits,BITS_COPY)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    andBits
+ * Signature: (J[JJ[JJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_andBits
+BITS_PREFIX
+BITS_KERNEL(andBits,andBits,BITS_AND)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    orBits
+ * Signature: (J[JJ[JJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_orBits
+BITS_PREFIX
+BITS_KERNEL(orBits,orBits,BITS_OR)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    xorBits
+ * Signature: (J[JJ[JJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_xorBits
+BITS_PREFIX
+BITS_KERNEL(xorBits,xorBits,BITS_XOR)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    andNotBits
+ * Signature: (J[JJ[JJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_andNotBits
+BITS_PREFIX
+BITS_KERNEL(andNotBits,andNotBits,BITS_ANDNOT)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    notBits
+ * Signature: (J[JJ[JJJ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_notBits
+BITS_PREFIX
+BITS_KERNEL(notBits,notBits,BITS_NOT)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    cardinalityBits
+ * Signature: (J[JJJ)J
+ */
+JNIEXPORT jlong JNICALL Java_net_algart_array_ArraysNative_cardinalityBits
+BITS_COUNT_PREFIX
+BITS_COUNT_KERNEL
+BITS_READ_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    indexOfBit
+ * Signature: (J[JJJZ)J
+ */
+JNIEXPORT jlong JNICALL Java_net_algart_array_ArraysNative_indexOfBit
+BITS_SEARCH_PREFIX
+BITS_SEARCH_KERNEL(indexOfBit,indexOfBit,_indexOfBit,_indexOfWord)
+BITS_READ_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    lastIndexOfBit
+ * Signature: (J[JJJZ)J
+ */
+JNIEXPORT jlong JNICALL Java_net_algart_array_ArraysNative_lastIndexOfBit
+BITS_SEARCH_PREFIX
+BITS_SEARCH_KERNEL(lastIndexOfBit,lastIndexOfBit,_lastIndexOfBit,_lastIndexOfWord)
+BITS_READ_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    packBits
+ * Signature: (J[JJ[BIIBI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_packBits__J_3JJ_3BIIBI
+PACK_BITS_PREFIX(jbyte,jbyteArray)
+PACK_BITS_KERNEL(packBitsByte,packBitsByte,uint8_t)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    packBits
+ * Signature: (J[JJ[CIICI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_packBits__J_3JJ_3CIICI
+PACK_BITS_PREFIX(jchar,jcharArray)
+PACK_BITS_KERNEL(packBitsChar,packBitsChar,jchar)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    packBits
+ * Signature: (J[JJ[SIISI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_packBits__J_3JJ_3SIISI
+PACK_BITS_PREFIX(jshort,jshortArray)
+PACK_BITS_KERNEL(packBitsShort,packBitsChar,jchar)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    packBits
+ * Signature: (J[JJ[IIIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_packBits__J_3JJ_3IIIII
+PACK_BITS_PREFIX(jint,jintArray)
+PACK_BITS_KERNEL(packBitsInt,packBitsInt,jint)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    packBits
+ * Signature: (J[JJ[JIIJI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_packBits__J_3JJ_3JIIJI
+PACK_BITS_PREFIX(jlong,jlongArray)
+PACK_BITS_KERNEL(packBitsLong,packBitsLong,jlong)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    packBits
+ * Signature: (J[JJ[FIIFI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_packBits__J_3JJ_3FIIFI
+PACK_BITS_PREFIX(jfloat,jfloatArray)
+PACK_BITS_KERNEL(packBitsFloat,packBitsFloat,jfloat)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    packBits
+ * Signature: (J[JJ[DIIDI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_packBits__J_3JJ_3DIIDI
+PACK_BITS_PREFIX(jdouble,jdoubleArray)
+PACK_BITS_KERNEL(packBitsDouble,packBitsDouble,jdouble)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    unpackBits
+ * Signature: (J[BI[JJIBBI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_unpackBits__J_3BI_3JJIBBI
+UNPACK_BITS_PREFIX(jbyte,jbyteArray)
+UNPACK_BITS_KERNEL(unpackBitsByte,unpackBitsByte,jbyte)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    unpackBits
+ * Signature: (J[CI[JJICCI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_unpackBits__J_3CI_3JJICCI
+UNPACK_BITS_PREFIX(jchar,jcharArray)
+UNPACK_BITS_KERNEL(unpackBitsChar,unpackBitsShort,jshort)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    unpackBits
+ * Signature: (J[SI[JJISSI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_unpackBits__J_3SI_3JJISSI
+UNPACK_BITS_PREFIX(jshort,jshortArray)
+UNPACK_BITS_KERNEL(unpackBitsShort,unpackBitsShort,jshort)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    unpackBits
+ * Signature: (J[II[JJIIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_unpackBits__J_3II_3JJIIII
+UNPACK_BITS_PREFIX(jint,jintArray)
+UNPACK_BITS_KERNEL(unpackBitsInt,unpackBitsInt,jint)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    unpackBits
+ * Signature: (J[JI[JJIJJI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_unpackBits__J_3JI_3JJIJJI
+UNPACK_BITS_PREFIX(jlong,jlongArray)
+UNPACK_BITS_KERNEL(unpackBitsLong,unpackBitsLong,jlong)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    unpackBits
+ * Signature: (J[FI[JJIFFI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_unpackBits__J_3FI_3JJIFFI
+UNPACK_BITS_PREFIX(jfloat,jfloatArray)
+UNPACK_BITS_KERNEL(unpackBitsFloat,unpackBitsInt,jint)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    unpackBits
+ * Signature: (J[DI[JJIDDI)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_unpackBits__J_3DI_3JJIDDI
+UNPACK_BITS_PREFIX(jdouble,jdoubleArray)
+UNPACK_BITS_KERNEL(unpackBitsDouble,unpackBitsLong,jlong)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    indexOfBytes
+ * Signature: (JLjava/lang/Object;IIB)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_indexOfBytes
+MIXED_SEARCH_PREFIX(jbyte)
+SEARCH_KERNEL(indexOfByte,indexOfByte,jbyte,_indexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    indexOfChars
+ * Signature: (JLjava/lang/Object;IIC)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_indexOfChars
+MIXED_SEARCH_PREFIX(jchar)
+SEARCH_KERNEL(indexOfChar,indexOfShort,jshort,_indexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    indexOfShorts
+ * Signature: (JLjava/lang/Object;IIS)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_indexOfShorts
+MIXED_SEARCH_PREFIX(jshort)
+SEARCH_KERNEL(indexOfShort,indexOfShort,jshort,_indexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    indexOfInts
+ * Signature: (JLjava/lang/Object;III)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_indexOfInts
+MIXED_SEARCH_PREFIX(jint)
+SEARCH_KERNEL(indexOfInt,indexOfInt,jint,_indexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    indexOfLongs
+ * Signature: (JLjava/lang/Object;IIJ)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_indexOfLongs
+MIXED_SEARCH_PREFIX(jlong)
+SEARCH_KERNEL(indexOfLong,indexOfLong,jlong,_indexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    indexOfFloats
+ * Signature: (JLjava/lang/Object;IIF)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_indexOfFloats
+MIXED_SEARCH_PREFIX(jfloat)
+SEARCH_KERNEL(indexOfFloat,indexOfFloat,jfloat,_indexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    indexOfDoubles
+ * Signature: (JLjava/lang/Object;IID)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_indexOfDoubles
+MIXED_SEARCH_PREFIX(jdouble)
+SEARCH_KERNEL(indexOfDouble,indexOfDouble,jdouble,_indexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    lastIndexOfBytes
+ * Signature: (JLjava/lang/Object;IIB)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_lastIndexOfBytes
+MIXED_SEARCH_PREFIX(jbyte)
+SEARCH_KERNEL(lastIndexOfByte,lastIndexOfByte,jbyte,_lastIndexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    lastIndexOfChars
+ * Signature: (JLjava/lang/Object;IIC)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_lastIndexOfChars
+MIXED_SEARCH_PREFIX(jchar)
+SEARCH_KERNEL(lastIndexOfChar,lastIndexOfShort,jshort,_lastIndexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    lastIndexOfShorts
+ * Signature: (JLjava/lang/Object;IIS)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_lastIndexOfShorts
+MIXED_SEARCH_PREFIX(jshort)
+SEARCH_KERNEL(lastIndexOfShort,lastIndexOfShort,jshort,_lastIndexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    lastIndexOfInts
+ * Signature: (JLjava/lang/Object;III)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_lastIndexOfInts
+MIXED_SEARCH_PREFIX(jint)
+SEARCH_KERNEL(lastIndexOfInt,lastIndexOfInt,jint,_lastIndexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    lastIndexOfLongs
+ * Signature: (JLjava/lang/Object;IIJ)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_lastIndexOfLongs
+MIXED_SEARCH_PREFIX(jlong)
+SEARCH_KERNEL(lastIndexOfLong,lastIndexOfLong,jlong,_lastIndexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    lastIndexOfFloats
+ * Signature: (JLjava/lang/Object;IIF)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_lastIndexOfFloats
+MIXED_SEARCH_PREFIX(jfloat)
+SEARCH_KERNEL(lastIndexOfFloat,lastIndexOfFloat,jfloat,_lastIndexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    lastIndexOfDoubles
+ * Signature: (JLjava/lang/Object;IID)I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_array_ArraysNative_lastIndexOfDoubles
+MIXED_SEARCH_PREFIX(jdouble)
+SEARCH_KERNEL(lastIndexOfDouble,lastIndexOfDouble,jdouble,_lastIndexOfLoop)
+MIXED_SEARCH_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    histogram
+ * Signature: (J[J[BIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_histogram__J_3J_3BIII
+HISTOGRAM_PREFIX(jbyte,jbyteArray)
+HISTOGRAM_KERNEL(histogramByte,jbyte)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    histogram
+ * Signature: (J[J[CIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_histogram__J_3J_3CIII
+HISTOGRAM_PREFIX(jchar,jcharArray)
+HISTOGRAM_KERNEL(histogramChar,jchar)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    histogram
+ * Signature: (J[J[SIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_histogram__J_3J_3SIII
+HISTOGRAM_PREFIX(jshort,jshortArray)
+HISTOGRAM_KERNEL(histogramShort,jshort)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    histogram
+ * Signature: (J[J[IIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_histogram__J_3J_3IIII
+HISTOGRAM_PREFIX(jint,jintArray)
+HISTOGRAM_KERNEL(histogramInt,jint)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    filter3x3
+ * Signature: (J[BI[BIIIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_filter3x3__J_3BI_3BIIIII
+FILTER3X3_PREFIX(jbyte,jbyteArray)
+FILTER3X3_KERNEL(filter3x3Byte,filter3x3Byte,jbyte)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    filter3x3
+ * Signature: (J[CI[CIIIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_filter3x3__J_3CI_3CIIIII
+FILTER3X3_PREFIX(jchar,jcharArray)
+FILTER3X3_KERNEL(filter3x3Short,filter3x3Short,jshort)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    filter3x3
+ * Signature: (J[SI[SIIIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_filter3x3__J_3SI_3SIIIII
+FILTER3X3_PREFIX(jshort,jshortArray)
+FILTER3X3_KERNEL(filter3x3Short,filter3x3Short,jshort)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    filter3x3
+ * Signature: (J[FI[FIIIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_filter3x3__J_3FI_3FIIIII
+FILTER3X3_PREFIX(jfloat,jfloatArray)
+FILTER3X3_KERNEL(filter3x3Float,filter3x3Float,jfloat)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rank
+ * Signature: (J[BI[BIIIIIIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rank__J_3BI_3BIIIIIIII
+RANK_PREFIX(jbyte,jbyteArray)
+RANK_KERNEL(rankByte,rankByte,jbyte)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rank
+ * Signature: (J[CI[CIIIIIIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rank__J_3CI_3CIIIIIIII
+RANK_PREFIX(jchar,jcharArray)
+RANK_KERNEL(rankShort,rankShort,jshort)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    rank
+ * Signature: (J[SI[SIIIIIIII)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_rank__J_3SI_3SIIIIIIII
+RANK_PREFIX(jshort,jshortArray)
+RANK_KERNEL(rankShort,rankShort,jshort)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    morphology
+ * Signature: (J[BI[BIIIIIZ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_morphology__J_3BI_3BIIIIIZ
+MORPHOLOGY_PREFIX(jbyte,jbyteArray)
+MORPHOLOGY_KERNEL(morphologyByte,minuByte,maxuByte,jbyte)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    morphology
+ * Signature: (J[CI[CIIIIIZ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_morphology__J_3CI_3CIIIIIZ
+MORPHOLOGY_PREFIX(jchar,jcharArray)
+MORPHOLOGY_KERNEL(morphologyShort,minuShort,maxuShort,jshort)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    morphology
+ * Signature: (J[SI[SIIIIIZ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_morphology__J_3SI_3SIIIIIZ
+MORPHOLOGY_PREFIX(jshort,jshortArray)
+MORPHOLOGY_KERNEL(morphologyShort,minuShort,maxuShort,jshort)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    morphology
+ * Signature: (J[II[IIIIIIZ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_morphology__J_3II_3IIIIIIZ
+MORPHOLOGY_PREFIX(jint,jintArray)
+MORPHOLOGY_KERNEL(morphologyInt,minInt,maxInt,jint)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    morphology
+ * Signature: (J[JI[JIIIIIZ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_morphology__J_3JI_3JIIIIIZ
+MORPHOLOGY_PREFIX(jlong,jlongArray)
+MORPHOLOGY_KERNEL(morphologyLong,minLong,maxLong,jlong)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    morphology
+ * Signature: (J[FI[FIIIIIZ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_morphology__J_3FI_3FIIIIIZ
+MORPHOLOGY_PREFIX(jfloat,jfloatArray)
+MORPHOLOGY_KERNEL(morphologyFloat,minFloat,maxFloat,jfloat)
+PAIR_POSTFIX
+
+/*
+ * Class:     net_algart_array_ArraysNative
+ * Method:    morphology
+ * Signature: (J[DI[DIIIIIZ)V
+ */
+JNIEXPORT void JNICALL Java_net_algart_array_ArraysNative_morphology__J_3DI_3DIIIIIZ
+MORPHOLOGY_PREFIX(jdouble,jdoubleArray)
+MORPHOLOGY_KERNEL(morphologyDouble,minDouble,maxDouble,jdouble)
 PAIR_POSTFIX
@@ -0,0 +1,435 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef A_ARRAYSRANK_H__INCLUDED_
+#define A_ARRAYSRANK_H__INCLUDED_
+
+// Rank filters by rectangular apertures with the cost per element independent of the aperture size
+// (Perreault and Hebert, "Median filtering in constant time"). The dimX x dimY matrix is stored row by row
+// and continued pseudo-cyclically, like in ArraysFilter3x3.h; the aperture of the element (x,y) is
+// x-apertureDimX/2..x-apertureDimX/2+apertureDimX-1, y-apertureDimY/2..y-apertureDimY/2+apertureDimY-1.
+// jbyte and jshort elements are unsigned (0..255, 0..65535); Java char is filtered as jshort.
+//
+// Every column of the aperture has its own histogram of apertureDimY elements, which is updated by
+// 1 removed and 1 added element when the aperture moves down. The histogram of the aperture is the sum
+// of apertureDimX column histograms and is updated by 1 added and 1 subtracted column histogram when
+// the aperture moves along a row. Histograms have levels of RANK_LEVEL_BITS bits: the level l has bars
+// of the highest 4*(l+1) bits of elements (2 levels for jbyte, 4 levels for jshort), so every search
+// passes at most 16 bars of every level. Only the first level of the aperture histogram is updated
+// at every step; the bars of other levels are updated lazily, by 16 bars with the same parent bar,
+// when the search comes into the parent bar.
+//
+// The last level of column histograms is sparse: a column of apertureDimY elements has at most
+// min(apertureDimY,bars of the previous level) non-empty parent bars, and only they have pages of 16 bars,
+// allocated from the own pool of the column. So a column of jshort elements takes about 17 KB (35 KB with
+// sums) + 32 bytes per element instead of 157 KB with full 65536 bars.
+//
+// Column histograms are kept for a vertical strip of the matrix, which is processed from the top to
+// the bottom; the strip width is chosen by RANK_STRIP_BYTES, but not less than the aperture width
+// (else most of the work would be spent on the columns outside the strip results) and not more than
+// RANK_MAX_STRIP_BYTES. Wider strips are not better: the search often comes into new bars of the last
+// levels, which were not visited near the current aperture position, and sums apertureDimX columns
+// for them. The rows are passed in turn from left to right and from right to left, so the aperture
+// histogram is never rebuilt: moving down, it is only corrected by the replaced elements of the columns.
+#define RANK_PERCENTILE 0                   // the element #fromIndex of sorted aperture elements
+#define RANK_MEAN_BETWEEN_PERCENTILES 1     // the mean of sorted elements #fromIndex..toIndex-1, rounded
+
+#define RANK_LEVEL_BITS 4
+#define RANK_LEVEL_BARS 16                  // bars of every level inside one bar of the previous level
+#define RANK_MAX_LEVELS 4
+#define RANK_STRIP_BYTES (2<<20)            // the preferred memory of column histograms of a strip
+#define RANK_STRIP_APERTURES 1              // the minimal strip width in apertureDimX-1 columns
+#define RANK_MAX_STRIP_BYTES (64<<20)
+#define RANK_MIN_STRIP_WIDTH 64
+#define RANK_MAX_WORK_BYTES (256<<20)       // the work memory of all threads (but at least one strip)
+
+#include <string.h>
+
+template <class T> struct RankLevels;
+template <> struct RankLevels<jbyte> {
+	enum {BITS= 8, LEVELS= 2, SPARSE= 0};
+	static inline jint get(jbyte v)  {return (uint8_t)v;}
+};
+template <> struct RankLevels<jshort> {
+	enum {BITS= 16, LEVELS= 4, SPARSE= 1};
+	static inline jint get(jshort v) {return (uint16_t)v;}
+};
+
+// Sums of RANK_LEVEL_BARS bars of column histograms: counts of apertureDimY<=65535 elements and their
+// sums in every column, jint and jlong in the aperture; kernels replace the count loops with SIMD ones.
+struct RankScalarOps {
+	static inline void add(jint *k, const uint16_t *a) {
+		for (jint j= 0; j<RANK_LEVEL_BARS; j++) k[j]+= a[j];
+	}
+	static inline void update(jint *k, const uint16_t *added, const uint16_t *subtracted) {
+		for (jint j= 0; j<RANK_LEVEL_BARS; j++) k[j]+= (jint)added[j]-(jint)subtracted[j];
+	}
+	static inline void addSums(jlong *k, const uint32_t *a) {
+		for (jint j= 0; j<RANK_LEVEL_BARS; j++) k[j]+= a[j];
+	}
+	static inline void updateSums(jlong *k, const uint32_t *added, const uint32_t *subtracted) {
+		for (jint j= 0; j<RANK_LEVEL_BARS; j++) k[j]+= (jlong)added[j]-(jlong)subtracted[j];
+	}
+};
+
+inline jlong _rankBars(int level) {
+	return (jlong)1<<(RANK_LEVEL_BITS*(level+1));
+}
+
+// Pages of the last level of one column, if it is sparse: not more than its elements
+template <class T> inline jlong _rankColumnPages(jint apertureDimY) {
+	const jlong parents= _rankBars(RankLevels<T>::LEVELS-2);
+	return !RankLevels<T>::SPARSE? 0: apertureDimY<parents? apertureDimY: parents;
+}
+
+// Bytes of the histograms of one column: counts of the dense levels and, in RANK_MEAN_BETWEEN_PERCENTILES
+// mode, sums of all levels except the last; for the sparse last level, the pages of the parent bars,
+// the free and used pages and the pages themselves
+template <class T> inline jlong _rankColumnBytes(jint apertureDimY, jint mode) {
+	const int last= RankLevels<T>::LEVELS-1, dense= RankLevels<T>::SPARSE? last: last+1;
+	jlong result= 8; // the source column index
+	for (int l= 0; l<dense; l++) {
+		result+= _rankBars(l)*(mode==RANK_MEAN_BETWEEN_PERCENTILES && l<last? 2+4: 2);
+	}
+	if (RankLevels<T>::SPARSE) {
+		result+= _rankBars(last-1)*2+2+2+_rankColumnPages<T>(apertureDimY)*RANK_LEVEL_BARS*2;
+	}
+	return result;
+}
+
+// Bytes of the aperture histogram: counts, sums and positions of the actual bars
+template <class T> inline jlong _rankApertureBytes() {
+	jlong result= 0;
+	for (int l= 0; l<RankLevels<T>::LEVELS; l++) {
+		result+= _rankBars(l)*(l<RankLevels<T>::LEVELS-1? 4+8: 4)+(l>0? _rankBars(l-1)*8: 0);
+	}
+	return result;
+}
+
+template <class T> inline jlong _rankStripWidth(jlong dimX, jint apertureDimX, jint apertureDimY, jint mode) {
+	const jlong columnBytes= _rankColumnBytes<T>(apertureDimY,mode), margin= apertureDimX-1;
+	jlong result= RANK_STRIP_BYTES/columnBytes-margin;
+	if (result<RANK_STRIP_APERTURES*margin) result= RANK_STRIP_APERTURES*margin;
+	if (result>RANK_MAX_STRIP_BYTES/columnBytes-margin) result= RANK_MAX_STRIP_BYTES/columnBytes-margin;
+	if (result<RANK_MIN_STRIP_WIDTH) result= RANK_MIN_STRIP_WIDTH;
+	return result<dimX? result: dimX;
+}
+
+// Work memory of one kernel call
+template <class T> inline size_t _rankWorkBytes(jlong dimX, jint apertureDimX, jint apertureDimY, jint mode) {
+	jlong columns= _rankStripWidth<T>(dimX,apertureDimX,apertureDimY,mode)+apertureDimX-1;
+	return (size_t)(columns*_rankColumnBytes<T>(apertureDimY,mode)+_rankApertureBytes<T>()+64);
+}
+
+inline jlong _rankMod(jlong v, jlong n) {
+	v%= n;
+	return v<0? v+n: v;
+}
+
+template <class T, class Ops> class RankStrip {
+	typedef RankLevels<T> L;
+	enum {LEVELS= L::LEVELS, LAST= L::LEVELS-1, DENSE= L::SPARSE? LAST: LEVELS, BARS= RANK_LEVEL_BARS};
+	jint ax, ay;
+	jlong columns, apertureSize, pages;
+	bool sums;
+	jlong *columnX;                 // source column of every strip column
+	jlong bars[LEVELS];
+	uint16_t *colCount[LEVELS];     // l<DENSE: bars[l] bars of every column (see at())
+	uint32_t *colSum[LEVELS];       // l<LAST: sums of elements in these bars, if sums
+	uint16_t *colPage;              // sparse last level: the page of every non-empty bar of the level LAST-1 (see at())
+	uint16_t *colFree;              // the first free page of every column (the next one is in its bar #0), or 0xFFFF
+	uint16_t *colUsed;              // pages of every column, which were ever used
+	uint16_t *colPages;             // the pages: 16 bars, pages*BARS bars of every column
+	uint16_t empty[BARS];
+	jint *kCount[LEVELS];           // the aperture histogram
+	jlong *kSum[LEVELS];
+	jlong *last[LEVELS];            // l>0: the aperture position of the actual bars inside every bar of the level l-1,
+	                                // -1 if none
+
+	static inline jint bar(jint v, int l) {return v>>(L::BITS-RANK_LEVEL_BITS*(l+1));}
+
+	// The index of the bar b of a level in the column c: 16 bars with the same parent of all columns are
+	// stored in turn, so neighbouring columns, passed by replace() and segment(), are neighbours in memory
+	inline jlong at(jlong c, jint b) const {return ((jlong)(b/BARS)*columns+c)*BARS+b%BARS;}
+
+	inline uint16_t *page(jlong c, jint parent) {
+		return colPages+(c*pages+colPage[at(c,parent)])*BARS;
+	}
+
+	// The bars of the column c inside the bar #parent of the level l-1 (the first level: parent=0);
+	// empty bars of the sparse level are the same array empty
+	inline const uint16_t *columnBars(int l, jlong parent, jlong c) {
+		if (l<DENSE) return colCount[l]+(parent*columns+c)*BARS;
+		return colCount[LAST-1][at(c,(jint)parent)]!=0? page(c,(jint)parent): empty;
+	}
+
+	// Called when the bar #parent of the level LAST-1 of the column c becomes non-empty
+	inline void allocate(jlong c, jint parent) {
+		jint p= colFree[c];
+		if (p!=0xFFFF) {
+			colFree[c]= colPages[(c*pages+p)*BARS];
+		} else {
+			p= colUsed[c]++;
+		}
+		colPage[at(c,parent)]= (uint16_t)p;
+		memset(colPages+(c*pages+p)*BARS,0,BARS*sizeof(uint16_t));
+	}
+
+	// Called when the bar #parent of the level LAST-1 of the column c becomes empty: all its page bars are 0
+	inline void release(jlong c, jint parent) {
+		const uint16_t p= colPage[at(c,parent)];
+		colPages[(c*pages+p)*BARS]= colFree[c];
+		colFree[c]= p;
+	}
+
+	inline void include(jlong c, jint v) {
+		for (int l= 0; l<DENSE; l++) {
+			const jlong k= at(c,bar(v,l));
+			colCount[l][k]++;
+			if (sums && l<LAST) colSum[l][k]+= v;
+		}
+		if (L::SPARSE) {
+			const jint parent= bar(v,LAST-1);
+			if (colCount[LAST-1][at(c,parent)]==1) allocate(c,parent);
+			page(c,parent)[v%BARS]++;
+		}
+	}
+
+	// Replaces the element vOut with vIn in the column c, also in the aperture histogram if it contains this column
+	inline void replace(jlong c, jint vOut, jint vIn, jlong position) {
+		if (vOut==vIn) return;
+		for (int l= 0; l<LEVELS; l++) {
+			const jint bOut= bar(vOut,l), bIn= bar(vIn,l);
+			if (l<DENSE) {
+				const jlong kOut= at(c,bOut), kIn= at(c,bIn);
+				colCount[l][kOut]--;
+				colCount[l][kIn]++;
+				if (sums && l<LAST) {
+					colSum[l][kOut]-= vOut;
+					colSum[l][kIn]+= vIn;
+				}
+			} else {
+				const jint pOut= bOut/BARS, pIn= bIn/BARS;
+				page(c,pOut)[bOut%BARS]--;
+				if (pOut!=pIn) {
+					if (colCount[LAST-1][at(c,pOut)]==0) release(c,pOut);
+					if (colCount[LAST-1][at(c,pIn)]==1) allocate(c,pIn);
+				}
+				page(c,pIn)[bIn%BARS]++;
+			}
+			const jlong pOut= l==0? position: last[l][bOut/BARS], pIn= l==0? position: last[l][bIn/BARS];
+			if (pOut>=0 && c>=pOut && c<pOut+ax) {
+				kCount[l][bOut]--;
+				if (sums && l<LAST) kSum[l][bOut]-= vOut;
+			}
+			if (pIn>=0 && c>=pIn && c<pIn+ax) {
+				kCount[l][bIn]++;
+				if (sums && l<LAST) kSum[l][bIn]+= vIn;
+			}
+		}
+	}
+
+	// Moves the first level of the aperture histogram from the strip column i-delta to i, delta=+1 or -1
+	inline void move(jlong i, jint delta) {
+		const jlong added= delta>0? i+ax-1: i, removed= delta>0? i-1: i+ax;
+		Ops::update(kCount[0],colCount[0]+added*BARS,colCount[0]+removed*BARS);
+		if (sums) Ops::updateSums(kSum[0],colSum[0]+added*BARS,colSum[0]+removed*BARS);
+	}
+
+	// Actualizes the bars of the level l>0 inside the bar #parent of the level l-1 for the aperture
+	// at the strip column i
+	inline const jint *segment(int l, jlong parent, jlong i) {
+		jint *f= kCount[l]+parent*BARS;
+		jlong *fs= kSum[l]+parent*BARS;
+		const bool s= sums && l<LAST;
+		const uint32_t *cs= s? colSum[l]+parent*columns*BARS: NULL;
+		const jlong p= last[l][parent];
+		if (p<0 || 2*(i>p? i-p: p-i)>=ax) {
+			memset(f,0,BARS*sizeof(jint));
+			if (s) memset(fs,0,BARS*sizeof(jlong));
+			for (jlong c= i; c<i+ax; c++) {
+				const uint16_t *a= columnBars(l,parent,c);
+				if (a!=empty) Ops::add(f,a);
+				if (s) Ops::addSums(fs,cs+c*BARS);
+			}
+		} else if (i>p) {
+			for (jlong q= p+1; q<=i; q++) {
+				const uint16_t *a= columnBars(l,parent,q+ax-1), *r= columnBars(l,parent,q-1);
+				if (a!=r) Ops::update(f,a,r);
+				if (s) Ops::updateSums(fs,cs+(q+ax-1)*BARS,cs+(q-1)*BARS);
+			}
+		} else {
+			for (jlong q= p-1; q>=i; q--) {
+				const uint16_t *a= columnBars(l,parent,q), *r= columnBars(l,parent,q+ax);
+				if (a!=r) Ops::update(f,a,r);
+				if (s) Ops::updateSums(fs,cs+q*BARS,cs+(q+ax)*BARS);
+			}
+		}
+		last[l][parent]= i;
+		return f;
+	}
+
+	inline jint percentile(jlong k, jlong i) {
+		jlong acc= 0, b= 0;
+		for (int l= 0; l<LEVELS; l++) {
+			const jint *f= l==0? kCount[0]: segment(l,b,i);
+			jint j= 0;
+			while (acc+f[j]<=k) acc+= f[j++];
+			b= b*BARS+j;
+		}
+		return (jint)b;
+	}
+
+	// The sum of k least elements of the aperture
+	inline jlong leastSum(jlong k, jlong i) {
+		jlong acc= 0, sum= 0, b= 0;
+		if (k>=apertureSize) {
+			for (jint j= 0; j<BARS; j++) sum+= kSum[0][j];
+			return sum;
+		}
+		for (int l= 0; l<LEVELS; l++) {
+			const jint *f= l==0? kCount[0]: segment(l,b,i);
+			jint j= 0;
+			if (l<LAST) {
+				const jlong *fs= kSum[l]+b*BARS;
+				for (; acc+f[j]<=k; j++) {
+					acc+= f[j];
+					sum+= fs[j];
+				}
+			} else {
+				for (; acc+f[j]<=k; j++) {
+					acc+= f[j];
+					sum+= (jlong)f[j]*(b*BARS+j);
+				}
+			}
+			b= b*BARS+j;
+		}
+		return sum+(k-acc)*b;
+	}
+
+public:
+	RankStrip(jlong width, jint apertureDimX, jint apertureDimY, jint mode, void *work):
+		ax(apertureDimX), ay(apertureDimY), sums(mode==RANK_MEAN_BETWEEN_PERCENTILES)
+	{
+		columns= width+ax-1;
+		apertureSize= (jlong)ax*ay;
+		pages= _rankColumnPages<T>(ay);
+		memset(empty,0,sizeof(empty));
+		jbyte *p= (jbyte*)(((size_t)work+7)&~(size_t)7);
+		columnX= (jlong*)p; p+= columns*8;
+		for (int l= 0; l<LEVELS; l++) {
+			bars[l]= _rankBars(l);
+			kSum[l]= (jlong*)p; p+= l<LAST? bars[l]*8: 0;
+			last[l]= (jlong*)p; p+= l>0? bars[l-1]*8: 0;
+			kCount[l]= (jint*)p; p+= bars[l]*4;
+		}
+		for (int l= 0; l<LAST; l++) {
+			colSum[l]= (uint32_t*)p; p+= sums? columns*bars[l]*4: 0;
+		}
+		for (int l= 0; l<DENSE; l++) {
+			colCount[l]= (uint16_t*)p; p+= columns*bars[l]*2;
+		}
+		if (L::SPARSE) {
+			colPage= (uint16_t*)p; p+= columns*bars[LAST-1]*2;
+			colFree= (uint16_t*)p; p+= columns*2;
+			colUsed= (uint16_t*)p; p+= columns*2;
+			colPages= (uint16_t*)p;
+		} else {
+			colPage= colFree= colUsed= colPages= NULL;
+		}
+	}
+
+	// The columns x0..x0+width-1 of the result
+	void run(T *dest, const T *src, jlong dimX, jlong dimY, jlong x0, jlong width, jint mode,
+		jlong fromIndex, jlong toIndex)
+	{
+		const jlong top= ay/2;
+		for (jlong c= 0; c<columns; c++) columnX[c]= _rankMod(x0-ax/2+c,dimX);
+		for (int l= 0; l<LEVELS; l++) {
+			if (l<DENSE) memset(colCount[l],0,columns*bars[l]*sizeof(uint16_t));
+			if (l<LAST && sums) memset(colSum[l],0,columns*bars[l]*sizeof(uint32_t));
+			if (l>0) memset(last[l],-1,bars[l-1]*sizeof(jlong));
+		}
+		if (L::SPARSE) {
+			memset(colFree,0xFF,columns*sizeof(uint16_t));
+			memset(colUsed,0,columns*sizeof(uint16_t));
+		}
+		for (jint dy= 0; dy<ay; dy++) {
+			const T *row= src+_rankMod(dy-top,dimY)*dimX;
+			for (jlong c= 0; c<columns; c++) include(c,L::get(row[columnX[c]]));
+		}
+		memset(kCount[0],0,BARS*sizeof(jint));
+		memset(kSum[0],0,BARS*sizeof(jlong));
+		for (jlong c= 0; c<ax; c++) {
+			Ops::add(kCount[0],colCount[0]+c*BARS);
+			if (sums) Ops::addSums(kSum[0],colSum[0]+c*BARS);
+		}
+		jlong position= 0; // of the first level of the aperture histogram
+		for (jlong y= 0; y<dimY; y++) {
+			if (y>0) {
+				const T *removed= src+_rankMod(y-1-top,dimY)*dimX, *added= src+_rankMod(y-1-top+ay,dimY)*dimX;
+				for (jlong c= 0; c<columns; c++) {
+					replace(c,L::get(removed[columnX[c]]),L::get(added[columnX[c]]),position);
+				}
+			}
+			const jint delta= (y&1)==0? 1: -1;
+			T *d= dest+y*dimX+x0;
+			for (jlong i= delta>0? 0: width-1; i>=0 && i<width; i+= delta) {
+				if (i!=position) {
+					move(i,delta);
+					position= i;
+				}
+				if (mode==RANK_PERCENTILE) {
+					d[i]= (T)percentile(fromIndex,i);
+				} else {
+					jlong n= toIndex-fromIndex, s= leastSum(toIndex,i)-leastSum(fromIndex,i);
+					d[i]= (T)((2*s+n)/(2*n));
+				}
+			}
+		}
+	}
+};
+
+// The columns fromX..toX-1 of the result, strip by strip;
+// work: _rankWorkBytes<T>(dimX,apertureDimX,apertureDimY,mode) bytes
+template <class T, class Ops> void _rankFilter(T *dest, const T *src, jlong dimX, jlong dimY, jlong fromX, jlong toX,
+	jint apertureDimX, jint apertureDimY, jint mode, jlong fromIndex, jlong toIndex, void *work)
+{
+	const jlong stripWidth= _rankStripWidth<T>(dimX,apertureDimX,apertureDimY,mode);
+	for (jlong x0= fromX; x0<toX; x0+= stripWidth) {
+		jlong width= toX-x0<stripWidth? toX-x0: stripWidth;
+		RankStrip<T,Ops> strip(width,apertureDimX,apertureDimY,mode,work);
+		strip.run(dest,src,dimX,dimY,x0,width,mode,fromIndex,toIndex);
+	}
+}
+
+// C++ loop (see ArraysKernels::rankByte)
+template <class T> void _rankLoop(T *dest, const T *src, jlong dimX, jlong dimY, jlong fromX, jlong toX,
+	jint apertureDimX, jint apertureDimY, jint mode, jlong fromIndex, jlong toIndex, void *work)
+{
+	_rankFilter<T,RankScalarOps>(dest,src,dimX,dimY,fromX,toX,apertureDimX,apertureDimY,mode,fromIndex,toIndex,work);
+}
+
+#endif //A_ARRAYSRANK_H__INCLUDED_
@@ -0,0 +1,684 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+// Vector primitives for one instruction set level, selected by ARRAYS_KERNELS_SSE2,
+// ARRAYS_KERNELS_AVX2 or ARRAYS_KERNELS_AVX512. Included once per ArraysKernels_xxx.cpp.
+// vMinF/vMaxF/vMinD/vMaxD have the semantics of Java Math.min/max (see ArraysJavaMath.h). Hardware
+// min/max return the second argument for NaN and for equal values (including -0.0 and +0.0), so both
+// argument orders are combined: OR-ing gives NaN or -0.0 for min, AND-ing gives +0.0 for max,
+// and NaN lanes of max are set to all-ones (a NaN) by an unordered compare.
+
+#ifndef A_ARRAYSSIMD_H__INCLUDED_
+#define A_ARRAYSSIMD_H__INCLUDED_
+
+#include <immintrin.h>
+
+#if defined(ARRAYS_KERNELS_SSE2)
+
+#define VEC_BYTES 16
+typedef __m128i VInt;
+typedef __m128 VFloat;
+typedef __m128d VDouble;
+
+static inline VInt vLoad(const void *p)             {return _mm_loadu_si128((const __m128i*)p);}
+static inline void vStore(void *p, VInt v)          {_mm_storeu_si128((__m128i*)p,v);}
+static inline void vStream(void *p, VInt v)         {_mm_stream_si128((__m128i*)p,v);}
+static inline VFloat vLoadF(const jfloat *p)        {return _mm_loadu_ps(p);}
+static inline void vStoreF(jfloat *p, VFloat v)     {_mm_storeu_ps(p,v);}
+static inline VDouble vLoadD(const jdouble *p)      {return _mm_loadu_pd(p);}
+static inline void vStoreD(jdouble *p, VDouble v)   {_mm_storeu_pd(p,v);}
+
+static inline VInt vSet1I8(jbyte v)                 {return _mm_set1_epi8(v);}
+static inline VInt vSet1I16(jshort v)               {return _mm_set1_epi16(v);}
+static inline VInt vSet1I32(jint v)                 {return _mm_set1_epi32(v);}
+static inline VInt vSet1I64(jlong v)                {return _mm_set1_epi64x(v);}
+
+static inline VInt vBlend(VInt mask, VInt a, VInt b) { // mask? b: a
+	return _mm_or_si128(_mm_and_si128(mask,b),_mm_andnot_si128(mask,a));
+}
+static inline VInt vMinU8(VInt a, VInt b)           {return _mm_min_epu8(a,b);}
+static inline VInt vMaxU8(VInt a, VInt b)           {return _mm_max_epu8(a,b);}
+static inline VInt vMinI8(VInt a, VInt b) {
+	const VInt bias= _mm_set1_epi8((char)0x80);
+	return _mm_xor_si128(_mm_min_epu8(_mm_xor_si128(a,bias),_mm_xor_si128(b,bias)),bias);
+}
+static inline VInt vMaxI8(VInt a, VInt b) {
+	const VInt bias= _mm_set1_epi8((char)0x80);
+	return _mm_xor_si128(_mm_max_epu8(_mm_xor_si128(a,bias),_mm_xor_si128(b,bias)),bias);
+}
+static inline VInt vMinI16(VInt a, VInt b)          {return _mm_min_epi16(a,b);}
+static inline VInt vMaxI16(VInt a, VInt b)          {return _mm_max_epi16(a,b);}
+// SSE2 has no pminuw/pmaxuw: the saturating difference subs(a,b)=max(a-b,0) gives them in 2 instructions
+static inline VInt vMinU16(VInt a, VInt b)          {return _mm_sub_epi16(a,_mm_subs_epu16(a,b));}
+static inline VInt vMaxU16(VInt a, VInt b)          {return _mm_add_epi16(b,_mm_subs_epu16(a,b));}
+static inline VInt vMinI32(VInt a, VInt b)          {return vBlend(_mm_cmpgt_epi32(a,b),a,b);}
+static inline VInt vMaxI32(VInt a, VInt b)          {return vBlend(_mm_cmpgt_epi32(b,a),a,b);}
+static inline VInt vCmpGtU32(VInt a, VInt b) {
+	const VInt bias= _mm_set1_epi32((int)0x80000000);
+	return _mm_cmpgt_epi32(_mm_xor_si128(a,bias),_mm_xor_si128(b,bias));
+}
+static inline VInt vMinU32(VInt a, VInt b)          {return vBlend(vCmpGtU32(a,b),a,b);}
+static inline VInt vMaxU32(VInt a, VInt b)          {return vBlend(vCmpGtU32(b,a),a,b);}
+// SSE2 has no 64-bit compares: the high halves are compared as signed (or unsigned, by BIAS) 32-bit numbers,
+// the low halves as unsigned ones; the high half of the result is then copied into the low one
+static inline VInt vCmpGt64(VInt a, VInt b, VInt bias) {
+	VInt x= _mm_xor_si128(a,bias), y= _mm_xor_si128(b,bias);
+	VInt gt= _mm_cmpgt_epi32(x,y);
+	VInt r= _mm_or_si128(gt,_mm_and_si128(_mm_cmpeq_epi32(x,y),_mm_slli_epi64(gt,32)));
+	return _mm_shuffle_epi32(r,_MM_SHUFFLE(3,3,1,1));
+}
+static inline VInt vCmpGtI64(VInt a, VInt b)        {return vCmpGt64(a,b,_mm_set_epi32(0,(int)0x80000000,0,(int)0x80000000));}
+static inline VInt vCmpGtU64(VInt a, VInt b)        {return vCmpGt64(a,b,_mm_set1_epi32((int)0x80000000));}
+static inline VInt vMinI64(VInt a, VInt b)          {return vBlend(vCmpGtI64(a,b),a,b);}
+static inline VInt vMaxI64(VInt a, VInt b)          {return vBlend(vCmpGtI64(b,a),a,b);}
+static inline VInt vMinU64(VInt a, VInt b)          {return vBlend(vCmpGtU64(a,b),a,b);}
+static inline VInt vMaxU64(VInt a, VInt b)          {return vBlend(vCmpGtU64(b,a),a,b);}
+static inline VFloat vMinF(VFloat a, VFloat b)      {return _mm_or_ps(_mm_min_ps(a,b),_mm_min_ps(b,a));}
+static inline VFloat vMaxF(VFloat a, VFloat b) {
+	return _mm_or_ps(_mm_and_ps(_mm_max_ps(a,b),_mm_max_ps(b,a)),_mm_cmpunord_ps(a,b));
+}
+static inline VDouble vMinD(VDouble a, VDouble b)   {return _mm_or_pd(_mm_min_pd(a,b),_mm_min_pd(b,a));}
+static inline VDouble vMaxD(VDouble a, VDouble b) {
+	return _mm_or_pd(_mm_and_pd(_mm_max_pd(a,b),_mm_max_pd(b,a)),_mm_cmpunord_pd(a,b));
+}
+
+// Reduction helpers: vMinNumF/vMaxNumF... return the accumulator ACC for NaN elements of A;
+// vSumXxx add all elements of a vector to 64-bit (integer or double) accumulators
+static inline VFloat vSet1F(jfloat v)               {return _mm_set1_ps(v);}
+static inline VDouble vSet1D(jdouble v)             {return _mm_set1_pd(v);}
+static inline VFloat vMinNumF(VFloat a, VFloat acc) {return _mm_min_ps(a,acc);}
+static inline VFloat vMaxNumF(VFloat a, VFloat acc) {return _mm_max_ps(a,acc);}
+static inline VDouble vMinNumD(VDouble a, VDouble acc) {return _mm_min_pd(a,acc);}
+static inline VDouble vMaxNumD(VDouble a, VDouble acc) {return _mm_max_pd(a,acc);}
+static inline VInt vZero()                          {return _mm_setzero_si128();}
+static inline VDouble vZeroD()                      {return _mm_setzero_pd();}
+static inline VInt vXor(VInt a, VInt b)             {return _mm_xor_si128(a,b);}
+static inline VInt vAddI32(VInt a, VInt b)          {return _mm_add_epi32(a,b);}
+static inline VInt vAddI64(VInt a, VInt b)          {return _mm_add_epi64(a,b);}
+static inline VDouble vAddD(VDouble a, VDouble b)   {return _mm_add_pd(a,b);}
+static inline VInt vSadU8(VInt a)                   {return _mm_sad_epu8(a,_mm_setzero_si128());}
+static inline VInt vMaddI16(VInt a, VInt b)         {return _mm_madd_epi16(a,b);}
+static inline VInt vSignI32(VInt a)                 {return _mm_srai_epi32(a,31);}
+static inline VInt vUnpackLo16(VInt a, VInt b)      {return _mm_unpacklo_epi16(a,b);}
+static inline VInt vUnpackHi16(VInt a, VInt b)      {return _mm_unpackhi_epi16(a,b);}
+static inline VInt vUnpackLo32(VInt a, VInt b)      {return _mm_unpacklo_epi32(a,b);}
+static inline VInt vUnpackHi32(VInt a, VInt b)      {return _mm_unpackhi_epi32(a,b);}
+static inline VDouble vCvtLoFD(VFloat a)            {return _mm_cvtps_pd(a);}
+static inline VDouble vCvtHiFD(VFloat a)            {return _mm_cvtps_pd(_mm_movehl_ps(a,a));}
+
+// Element-wise arithmetic: wrapping (vAdd/vSub), signed (vAdds/vSubs) and unsigned (vAddsU/vSubsU) saturation
+static inline VInt vAddI8(VInt a, VInt b)           {return _mm_add_epi8(a,b);}
+static inline VInt vAddI16(VInt a, VInt b)          {return _mm_add_epi16(a,b);}
+static inline VInt vSubI8(VInt a, VInt b)           {return _mm_sub_epi8(a,b);}
+static inline VInt vSubI16(VInt a, VInt b)          {return _mm_sub_epi16(a,b);}
+static inline VInt vSubI32(VInt a, VInt b)          {return _mm_sub_epi32(a,b);}
+static inline VInt vSubI64(VInt a, VInt b)          {return _mm_sub_epi64(a,b);}
+static inline VInt vAddsI8(VInt a, VInt b)          {return _mm_adds_epi8(a,b);}
+static inline VInt vSubsI8(VInt a, VInt b)          {return _mm_subs_epi8(a,b);}
+static inline VInt vAddsU8(VInt a, VInt b)          {return _mm_adds_epu8(a,b);}
+static inline VInt vSubsU8(VInt a, VInt b)          {return _mm_subs_epu8(a,b);}
+static inline VInt vAddsI16(VInt a, VInt b)         {return _mm_adds_epi16(a,b);}
+static inline VInt vSubsI16(VInt a, VInt b)         {return _mm_subs_epi16(a,b);}
+static inline VInt vAddsU16(VInt a, VInt b)         {return _mm_adds_epu16(a,b);}
+static inline VInt vSubsU16(VInt a, VInt b)         {return _mm_subs_epu16(a,b);}
+static inline VInt vOr(VInt a, VInt b)              {return _mm_or_si128(a,b);}
+static inline VFloat vAddF(VFloat a, VFloat b)      {return _mm_add_ps(a,b);}
+static inline VFloat vSubF(VFloat a, VFloat b)      {return _mm_sub_ps(a,b);}
+static inline VDouble vSubD(VDouble a, VDouble b)   {return _mm_sub_pd(a,b);}
+static inline VFloat vAbsF(VFloat a)                {return _mm_andnot_ps(_mm_set1_ps(-0.0f),a);}
+static inline VFloat vNegF(VFloat a)                {return _mm_xor_ps(a,_mm_set1_ps(-0.0f));}
+static inline VDouble vAbsD(VDouble a)              {return _mm_andnot_pd(_mm_set1_pd(-0.0),a);}
+static inline VDouble vNegD(VDouble a)              {return _mm_xor_pd(a,_mm_set1_pd(-0.0));}
+
+// Packed bits: vAndNot(a,b)= ~a&b; 64-bit shifts by a variable count 0..64 (64 gives 0)
+static inline VInt vAnd(VInt a, VInt b)             {return _mm_and_si128(a,b);}
+static inline VInt vAndNot(VInt a, VInt b)          {return _mm_andnot_si128(a,b);}
+static inline VInt vSrlI64(VInt a, int n)           {return _mm_srl_epi64(a,_mm_cvtsi32_si128(n));}
+static inline VInt vSllI64(VInt a, int n)           {return _mm_sll_epi64(a,_mm_cvtsi32_si128(n));}
+// vPopcnt64: numbers of set bits in 64-bit elements (SWAR: SSE2 has no pshufb); vIsZero: all bits are 0
+static inline VInt vPopcnt64(VInt v) {
+	const VInt m1= _mm_set1_epi8(0x55), m2= _mm_set1_epi8(0x33), m4= _mm_set1_epi8(0x0F);
+	v= _mm_sub_epi8(v,_mm_and_si128(_mm_srli_epi64(v,1),m1));
+	v= _mm_add_epi8(_mm_and_si128(v,m2),_mm_and_si128(_mm_srli_epi64(v,2),m2));
+	v= _mm_and_si128(_mm_add_epi8(v,_mm_srli_epi64(v,4)),m4);
+	return _mm_sad_epu8(v,_mm_setzero_si128());
+}
+static inline bool vIsZero(VInt v)                  {return _mm_movemask_epi8(_mm_cmpeq_epi8(v,_mm_setzero_si128()))==0xFFFF;}
+// Threshold packing: bit j of vGtMaskXxx (vGeMaskXxx) is a[j]>b[j] (a[j]>=b[j]) for all lanes j;
+// floating-point compares are ordered (false for NaN), like Java ones
+static inline uint64_t vGtMaskU8(VInt a, VInt b) {
+	const VInt bias= _mm_set1_epi8((char)0x80);
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_xor_si128(a,bias),_mm_xor_si128(b,bias)));
+}
+static inline uint64_t vGtMaskI16(VInt a, VInt b) {
+	VInt c= _mm_cmpgt_epi16(a,b);
+	return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(c,c))&0xFF;
+}
+static inline uint64_t vGtMaskU16(VInt a, VInt b) {
+	const VInt bias= _mm_set1_epi16((short)0x8000);
+	return vGtMaskI16(_mm_xor_si128(a,bias),_mm_xor_si128(b,bias));
+}
+static inline uint64_t vGtMaskI32(VInt a, VInt b)   {return (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a,b)));}
+static inline uint64_t vGtMaskI64(VInt a, VInt b)   {return (uint32_t)_mm_movemask_pd(_mm_castsi128_pd(vCmpGtI64(a,b)));}
+static inline uint64_t vGtMaskF(VFloat a, VFloat b) {return (uint32_t)_mm_movemask_ps(_mm_cmpgt_ps(a,b));}
+static inline uint64_t vGeMaskF(VFloat a, VFloat b) {return (uint32_t)_mm_movemask_ps(_mm_cmpge_ps(a,b));}
+static inline uint64_t vGtMaskD(VDouble a, VDouble b) {return (uint32_t)_mm_movemask_pd(_mm_cmpgt_pd(a,b));}
+static inline uint64_t vGeMaskD(VDouble a, VDouble b) {return (uint32_t)_mm_movemask_pd(_mm_cmpge_pd(a,b));}
+// Bit unpacking: lane j of vSelectXxx(bits,a,b) is (bit j of BITS)? b[j]: a[j]
+static inline VInt vSelectI8(uint64_t bits, VInt a, VInt b) {
+	const VInt sel= _mm_set1_epi64x((jlong)0x8040201008040201ULL);
+	const uint64_t spread= 0x0101010101010101ULL;
+	VInt x= _mm_set_epi64x((jlong)(((bits>>8)&0xFF)*spread),(jlong)((bits&0xFF)*spread));
+	return vBlend(_mm_cmpeq_epi8(_mm_and_si128(x,sel),sel),a,b);
+}
+static inline VInt vSelectI16(uint64_t bits, VInt a, VInt b) {
+	const VInt sel= _mm_setr_epi16(1,2,4,8,16,32,64,128);
+	return vBlend(_mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16((short)bits),sel),sel),a,b);
+}
+static inline VInt vSelectI32(uint64_t bits, VInt a, VInt b) {
+	const VInt sel= _mm_setr_epi32(1,2,4,8);
+	return vBlend(_mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32((int)bits),sel),sel),a,b);
+}
+static inline VInt vSelectI64(uint64_t bits, VInt a, VInt b) {
+	const VInt sel= _mm_setr_epi32(1,1,2,2); // SSE2 has no pcmpeqq: both halves of a lane test the same bit
+	return vBlend(_mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32((int)bits),sel),sel),a,b);
+}
+// Search: bit j of vEqMaskXxx is a[j]==b[j] (floating-point compares are ordered, like Java ==),
+// bit j of vNaNMaskXxx is isNaN(a[j])
+static inline uint64_t vEqMaskI8(VInt a, VInt b)    {return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a,b));}
+static inline uint64_t vEqMaskI16(VInt a, VInt b) {
+	VInt c= _mm_cmpeq_epi16(a,b);
+	return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(c,c))&0xFF;
+}
+static inline uint64_t vEqMaskI32(VInt a, VInt b)   {return (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a,b)));}
+static inline uint64_t vEqMaskI64(VInt a, VInt b) {
+	VInt c= _mm_cmpeq_epi32(a,b);
+	return (uint32_t)_mm_movemask_pd(_mm_castsi128_pd(_mm_and_si128(c,_mm_shuffle_epi32(c,_MM_SHUFFLE(2,3,0,1)))));
+}
+static inline uint64_t vEqMaskF(VFloat a, VFloat b) {return (uint32_t)_mm_movemask_ps(_mm_cmpeq_ps(a,b));}
+static inline uint64_t vEqMaskD(VDouble a, VDouble b) {return (uint32_t)_mm_movemask_pd(_mm_cmpeq_pd(a,b));}
+static inline uint64_t vNaNMaskF(VFloat a)         {return (uint32_t)_mm_movemask_ps(_mm_cmpunord_ps(a,a));}
+static inline uint64_t vNaNMaskD(VDouble a)        {return (uint32_t)_mm_movemask_pd(_mm_cmpunord_pd(a,a));}
+// Byte order reversal inside 16-, 32- and 64-bit elements; SSE2 has no pshufb: bytes are swapped
+// by shifts inside 16-bit words, then the words are reordered
+static inline VInt vSwapBytes16(VInt a)             {return _mm_or_si128(_mm_slli_epi16(a,8),_mm_srli_epi16(a,8));}
+static inline VInt vSwapBytes32(VInt a) {
+	VInt w= vSwapBytes16(a);
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(w,_MM_SHUFFLE(2,3,0,1)),_MM_SHUFFLE(2,3,0,1));
+}
+static inline VInt vSwapBytes64(VInt a) {
+	VInt w= vSwapBytes16(a);
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(w,_MM_SHUFFLE(0,1,2,3)),_MM_SHUFFLE(0,1,2,3));
+}
+// 3x3 filters: vLoadU8U16 (vLoadU16U32, vLoadFD) loads VEC_BYTES/2 bytes (elements) and extends them
+// to 16-bit (32-bit, double) lanes in the same order; vStoreU16U8 (vStoreU32U16, vStoreDF) stores them back,
+// the values must be in the range of the narrow type. vAvgU8/vAvgU16 are rounded up: (a+b+1)>>1
+static inline VInt vLoadU8U16(const void *p)        {return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)p),_mm_setzero_si128());}
+static inline void vStoreU16U8(void *p, VInt v)     {_mm_storel_epi64((__m128i*)p,_mm_packus_epi16(v,v));}
+static inline VInt vLoadU16U32(const void *p)       {return _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)p),_mm_setzero_si128());}
+// SSE2 has no packusdw: the values are sign-extended from 16 bits, so the signed saturation keeps all bits
+static inline void vStoreU32U16(void *p, VInt v) {
+	v= _mm_srai_epi32(_mm_slli_epi32(v,16),16);
+	_mm_storel_epi64((__m128i*)p,_mm_packs_epi32(v,v));
+}
+static inline VDouble vLoadFD(const jfloat *p)      {return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)p)));}
+static inline void vStoreDF(jfloat *p, VDouble v)   {_mm_storel_epi64((__m128i*)p,_mm_castps_si128(_mm_cvtpd_ps(v)));}
+static inline VInt vMulhiU16(VInt a, VInt b)        {return _mm_mulhi_epu16(a,b);}
+static inline VInt vAvgU8(VInt a, VInt b)           {return _mm_avg_epu8(a,b);}
+static inline VInt vAvgU16(VInt a, VInt b)          {return _mm_avg_epu16(a,b);}
+static inline VFloat vCvtI32F(VInt a)               {return _mm_cvtepi32_ps(a);}
+static inline VInt vCvttFI32(VFloat a)              {return _mm_cvttps_epi32(a);}
+static inline VFloat vDivF(VFloat a, VFloat b)      {return _mm_div_ps(a,b);}
+static inline VDouble vDivD(VDouble a, VDouble b)   {return _mm_div_pd(a,b);}
+static inline VDouble vMulD(VDouble a, VDouble b)   {return _mm_mul_pd(a,b);}
+
+#elif defined(ARRAYS_KERNELS_AVX2)
+
+#define VEC_BYTES 32
+typedef __m256i VInt;
+typedef __m256 VFloat;
+typedef __m256d VDouble;
+
+static inline VInt vLoad(const void *p)             {return _mm256_loadu_si256((const __m256i*)p);}
+static inline void vStore(void *p, VInt v)          {_mm256_storeu_si256((__m256i*)p,v);}
+static inline void vStream(void *p, VInt v)         {_mm256_stream_si256((__m256i*)p,v);}
+static inline VFloat vLoadF(const jfloat *p)        {return _mm256_loadu_ps(p);}
+static inline void vStoreF(jfloat *p, VFloat v)     {_mm256_storeu_ps(p,v);}
+static inline VDouble vLoadD(const jdouble *p)      {return _mm256_loadu_pd(p);}
+static inline void vStoreD(jdouble *p, VDouble v)   {_mm256_storeu_pd(p,v);}
+
+static inline VInt vSet1I8(jbyte v)                 {return _mm256_set1_epi8(v);}
+static inline VInt vSet1I16(jshort v)               {return _mm256_set1_epi16(v);}
+static inline VInt vSet1I32(jint v)                 {return _mm256_set1_epi32(v);}
+static inline VInt vSet1I64(jlong v)                {return _mm256_set1_epi64x(v);}
+
+static inline VInt vBlend(VInt mask, VInt a, VInt b) {return _mm256_blendv_epi8(a,b,mask);}
+static inline VInt vMinU8(VInt a, VInt b)           {return _mm256_min_epu8(a,b);}
+static inline VInt vMaxU8(VInt a, VInt b)           {return _mm256_max_epu8(a,b);}
+static inline VInt vMinI8(VInt a, VInt b)           {return _mm256_min_epi8(a,b);}
+static inline VInt vMaxI8(VInt a, VInt b)           {return _mm256_max_epi8(a,b);}
+static inline VInt vMinI16(VInt a, VInt b)          {return _mm256_min_epi16(a,b);}
+static inline VInt vMaxI16(VInt a, VInt b)          {return _mm256_max_epi16(a,b);}
+static inline VInt vMinU16(VInt a, VInt b)          {return _mm256_min_epu16(a,b);}
+static inline VInt vMaxU16(VInt a, VInt b)          {return _mm256_max_epu16(a,b);}
+static inline VInt vMinI32(VInt a, VInt b)          {return _mm256_min_epi32(a,b);}
+static inline VInt vMaxI32(VInt a, VInt b)          {return _mm256_max_epi32(a,b);}
+static inline VInt vMinU32(VInt a, VInt b)          {return _mm256_min_epu32(a,b);}
+static inline VInt vMaxU32(VInt a, VInt b)          {return _mm256_max_epu32(a,b);}
+static inline VInt vCmpGtU64(VInt a, VInt b) {
+	const VInt bias= _mm256_set1_epi64x((jlong)0x8000000000000000ULL);
+	return _mm256_cmpgt_epi64(_mm256_xor_si256(a,bias),_mm256_xor_si256(b,bias));
+}
+static inline VInt vMinI64(VInt a, VInt b)          {return vBlend(_mm256_cmpgt_epi64(a,b),a,b);}
+static inline VInt vMaxI64(VInt a, VInt b)          {return vBlend(_mm256_cmpgt_epi64(b,a),a,b);}
+static inline VInt vMinU64(VInt a, VInt b)          {return vBlend(vCmpGtU64(a,b),a,b);}
+static inline VInt vMaxU64(VInt a, VInt b)          {return vBlend(vCmpGtU64(b,a),a,b);}
+static inline VFloat vMinF(VFloat a, VFloat b)      {return _mm256_or_ps(_mm256_min_ps(a,b),_mm256_min_ps(b,a));}
+static inline VFloat vMaxF(VFloat a, VFloat b) {
+	return _mm256_or_ps(_mm256_and_ps(_mm256_max_ps(a,b),_mm256_max_ps(b,a)),_mm256_cmp_ps(a,b,_CMP_UNORD_Q));
+}
+static inline VDouble vMinD(VDouble a, VDouble b)   {return _mm256_or_pd(_mm256_min_pd(a,b),_mm256_min_pd(b,a));}
+static inline VDouble vMaxD(VDouble a, VDouble b) {
+	return _mm256_or_pd(_mm256_and_pd(_mm256_max_pd(a,b),_mm256_max_pd(b,a)),_mm256_cmp_pd(a,b,_CMP_UNORD_Q));
+}
+
+static inline VFloat vSet1F(jfloat v)               {return _mm256_set1_ps(v);}
+static inline VDouble vSet1D(jdouble v)             {return _mm256_set1_pd(v);}
+static inline VFloat vMinNumF(VFloat a, VFloat acc) {return _mm256_min_ps(a,acc);}
+static inline VFloat vMaxNumF(VFloat a, VFloat acc) {return _mm256_max_ps(a,acc);}
+static inline VDouble vMinNumD(VDouble a, VDouble acc) {return _mm256_min_pd(a,acc);}
+static inline VDouble vMaxNumD(VDouble a, VDouble acc) {return _mm256_max_pd(a,acc);}
+static inline VInt vZero()                          {return _mm256_setzero_si256();}
+static inline VDouble vZeroD()                      {return _mm256_setzero_pd();}
+static inline VInt vXor(VInt a, VInt b)             {return _mm256_xor_si256(a,b);}
+static inline VInt vAddI32(VInt a, VInt b)          {return _mm256_add_epi32(a,b);}
+static inline VInt vAddI64(VInt a, VInt b)          {return _mm256_add_epi64(a,b);}
+static inline VDouble vAddD(VDouble a, VDouble b)   {return _mm256_add_pd(a,b);}
+static inline VInt vSadU8(VInt a)                   {return _mm256_sad_epu8(a,_mm256_setzero_si256());}
+static inline VInt vMaddI16(VInt a, VInt b)         {return _mm256_madd_epi16(a,b);}
+static inline VInt vSignI32(VInt a)                 {return _mm256_srai_epi32(a,31);}
+static inline VInt vUnpackLo16(VInt a, VInt b)      {return _mm256_unpacklo_epi16(a,b);}
+static inline VInt vUnpackHi16(VInt a, VInt b)      {return _mm256_unpackhi_epi16(a,b);}
+static inline VInt vUnpackLo32(VInt a, VInt b)      {return _mm256_unpacklo_epi32(a,b);}
+static inline VInt vUnpackHi32(VInt a, VInt b)      {return _mm256_unpackhi_epi32(a,b);}
+static inline VDouble vCvtLoFD(VFloat a)            {return _mm256_cvtps_pd(_mm256_castps256_ps128(a));}
+static inline VDouble vCvtHiFD(VFloat a)            {return _mm256_cvtps_pd(_mm256_extractf128_ps(a,1));}
+
+// Element-wise arithmetic: wrapping (vAdd/vSub), signed (vAdds/vSubs) and unsigned (vAddsU/vSubsU) saturation
+static inline VInt vAddI8(VInt a, VInt b)           {return _mm256_add_epi8(a,b);}
+static inline VInt vAddI16(VInt a, VInt b)          {return _mm256_add_epi16(a,b);}
+static inline VInt vSubI8(VInt a, VInt b)           {return _mm256_sub_epi8(a,b);}
+static inline VInt vSubI16(VInt a, VInt b)          {return _mm256_sub_epi16(a,b);}
+static inline VInt vSubI32(VInt a, VInt b)          {return _mm256_sub_epi32(a,b);}
+static inline VInt vSubI64(VInt a, VInt b)          {return _mm256_sub_epi64(a,b);}
+static inline VInt vAddsI8(VInt a, VInt b)          {return _mm256_adds_epi8(a,b);}
+static inline VInt vSubsI8(VInt a, VInt b)          {return _mm256_subs_epi8(a,b);}
+static inline VInt vAddsU8(VInt a, VInt b)          {return _mm256_adds_epu8(a,b);}
+static inline VInt vSubsU8(VInt a, VInt b)          {return _mm256_subs_epu8(a,b);}
+static inline VInt vAddsI16(VInt a, VInt b)         {return _mm256_adds_epi16(a,b);}
+static inline VInt vSubsI16(VInt a, VInt b)         {return _mm256_subs_epi16(a,b);}
+static inline VInt vAddsU16(VInt a, VInt b)         {return _mm256_adds_epu16(a,b);}
+static inline VInt vSubsU16(VInt a, VInt b)         {return _mm256_subs_epu16(a,b);}
+static inline VInt vOr(VInt a, VInt b)              {return _mm256_or_si256(a,b);}
+static inline VFloat vAddF(VFloat a, VFloat b)      {return _mm256_add_ps(a,b);}
+static inline VFloat vSubF(VFloat a, VFloat b)      {return _mm256_sub_ps(a,b);}
+static inline VDouble vSubD(VDouble a, VDouble b)   {return _mm256_sub_pd(a,b);}
+static inline VFloat vAbsF(VFloat a)                {return _mm256_andnot_ps(_mm256_set1_ps(-0.0f),a);}
+static inline VFloat vNegF(VFloat a)                {return _mm256_xor_ps(a,_mm256_set1_ps(-0.0f));}
+static inline VDouble vAbsD(VDouble a)              {return _mm256_andnot_pd(_mm256_set1_pd(-0.0),a);}
+static inline VDouble vNegD(VDouble a)              {return _mm256_xor_pd(a,_mm256_set1_pd(-0.0));}
+
+// Packed bits: vAndNot(a,b)= ~a&b; 64-bit shifts by a variable count 0..64 (64 gives 0)
+static inline VInt vAnd(VInt a, VInt b)             {return _mm256_and_si256(a,b);}
+static inline VInt vAndNot(VInt a, VInt b)          {return _mm256_andnot_si256(a,b);}
+static inline VInt vSrlI64(VInt a, int n)           {return _mm256_srl_epi64(a,_mm_cvtsi32_si128(n));}
+static inline VInt vSllI64(VInt a, int n)           {return _mm256_sll_epi64(a,_mm_cvtsi32_si128(n));}
+// vPopcnt64: numbers of set bits in 64-bit elements (4-bit lookup by pshufb); vIsZero: all bits are 0
+static inline VInt vPopcnt64(VInt v) {
+	const VInt lookup= _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4, 0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+	const VInt m4= _mm256_set1_epi8(0x0F);
+	VInt lo= _mm256_shuffle_epi8(lookup,_mm256_and_si256(v,m4));
+	VInt hi= _mm256_shuffle_epi8(lookup,_mm256_and_si256(_mm256_srli_epi16(v,4),m4));
+	return _mm256_sad_epu8(_mm256_add_epi8(lo,hi),_mm256_setzero_si256());
+}
+static inline bool vIsZero(VInt v)                  {return _mm256_testz_si256(v,v)!=0;}
+// Threshold packing: bit j of vGtMaskXxx (vGeMaskXxx) is a[j]>b[j] (a[j]>=b[j]) for all lanes j;
+// floating-point compares are ordered (false for NaN), like Java ones
+static inline uint64_t vGtMaskU8(VInt a, VInt b) {
+	const VInt bias= _mm256_set1_epi8((char)0x80);
+	return (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_xor_si256(a,bias),_mm256_xor_si256(b,bias)));
+}
+static inline uint64_t vGtMaskI16(VInt a, VInt b) {
+	VInt c= _mm256_cmpgt_epi16(a,b);
+	return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(_mm256_castsi256_si128(c),_mm256_extracti128_si256(c,1)));
+}
+static inline uint64_t vGtMaskU16(VInt a, VInt b) {
+	const VInt bias= _mm256_set1_epi16((short)0x8000);
+	return vGtMaskI16(_mm256_xor_si256(a,bias),_mm256_xor_si256(b,bias));
+}
+static inline uint64_t vGtMaskI32(VInt a, VInt b) {
+	return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a,b)));
+}
+static inline uint64_t vGtMaskI64(VInt a, VInt b) {
+	return (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a,b)));
+}
+static inline uint64_t vGtMaskF(VFloat a, VFloat b) {return (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a,b,_CMP_GT_OQ));}
+static inline uint64_t vGeMaskF(VFloat a, VFloat b) {return (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a,b,_CMP_GE_OQ));}
+static inline uint64_t vGtMaskD(VDouble a, VDouble b) {return (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(a,b,_CMP_GT_OQ));}
+static inline uint64_t vGeMaskD(VDouble a, VDouble b) {return (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(a,b,_CMP_GE_OQ));}
+// Bit unpacking: lane j of vSelectXxx(bits,a,b) is (bit j of BITS)? b[j]: a[j].
+// Bytes: pshufb copies bit byte j/8 into byte j (pdep would need BMI2, which is not required by this level)
+static inline VInt vSelectI8(uint64_t bits, VInt a, VInt b) {
+	const VInt index= _mm256_setr_epi8(0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1, 2,2,2,2,2,2,2,2,3,3,3,3,3,3,3,3);
+	const VInt sel= _mm256_set1_epi64x((jlong)0x8040201008040201ULL);
+	VInt x= _mm256_shuffle_epi8(_mm256_set1_epi32((int)bits),index);
+	return vBlend(_mm256_cmpeq_epi8(_mm256_and_si256(x,sel),sel),a,b);
+}
+static inline VInt vSelectI16(uint64_t bits, VInt a, VInt b) {
+	const VInt sel= _mm256_setr_epi16(1,2,4,8,16,32,64,128,256,512,1024,2048,4096,8192,16384,(short)0x8000);
+	return vBlend(_mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16((short)bits),sel),sel),a,b);
+}
+static inline VInt vSelectI32(uint64_t bits, VInt a, VInt b) {
+	const VInt sel= _mm256_setr_epi32(1,2,4,8,16,32,64,128);
+	return vBlend(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int)bits),sel),sel),a,b);
+}
+static inline VInt vSelectI64(uint64_t bits, VInt a, VInt b) {
+	const VInt sel= _mm256_setr_epi64x(1,2,4,8);
+	return vBlend(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x((jlong)bits),sel),sel),a,b);
+}
+// Search: bit j of vEqMaskXxx is a[j]==b[j] (floating-point compares are ordered, like Java ==),
+// bit j of vNaNMaskXxx is isNaN(a[j])
+static inline uint64_t vEqMaskI8(VInt a, VInt b)    {return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a,b));}
+static inline uint64_t vEqMaskI16(VInt a, VInt b) {
+	VInt c= _mm256_cmpeq_epi16(a,b);
+	return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(_mm256_castsi256_si128(c),_mm256_extracti128_si256(c,1)));
+}
+static inline uint64_t vEqMaskI32(VInt a, VInt b) {
+	return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a,b)));
+}
+static inline uint64_t vEqMaskI64(VInt a, VInt b) {
+	return (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a,b)));
+}
+static inline uint64_t vEqMaskF(VFloat a, VFloat b) {return (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a,b,_CMP_EQ_OQ));}
+static inline uint64_t vEqMaskD(VDouble a, VDouble b) {return (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(a,b,_CMP_EQ_OQ));}
+static inline uint64_t vNaNMaskF(VFloat a)         {return (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a,a,_CMP_UNORD_Q));}
+static inline uint64_t vNaNMaskD(VDouble a)        {return (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(a,a,_CMP_UNORD_Q));}
+// Byte order reversal inside 16-, 32- and 64-bit elements (pshufb inside 128-bit lanes)
+static inline VInt vSwapBytes16(VInt a) {
+	return _mm256_shuffle_epi8(a,_mm256_broadcastsi128_si256(_mm_setr_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14)));
+}
+static inline VInt vSwapBytes32(VInt a) {
+	return _mm256_shuffle_epi8(a,_mm256_broadcastsi128_si256(_mm_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12)));
+}
+static inline VInt vSwapBytes64(VInt a) {
+	return _mm256_shuffle_epi8(a,_mm256_broadcastsi128_si256(_mm_setr_epi8(7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8)));
+}
+// 3x3 filters: vLoadU8U16 (vLoadU16U32, vLoadFD) loads VEC_BYTES/2 bytes (elements) and extends them
+// to 16-bit (32-bit, double) lanes in the same order; vStoreU16U8 (vStoreU32U16, vStoreDF) stores them back,
+// the values must be in the range of the narrow type. vAvgU8/vAvgU16 are rounded up: (a+b+1)>>1
+static inline VInt vLoadU8U16(const void *p)        {return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)p));}
+static inline VInt vLoadU16U32(const void *p)       {return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)p));}
+// Packing works inside 128-bit lanes: the 64-bit halves 0 and 2 are joined by vpermq
+static inline void vStoreU16U8(void *p, VInt v) {
+	VInt r= _mm256_permute4x64_epi64(_mm256_packus_epi16(v,v),_MM_SHUFFLE(3,1,2,0));
+	_mm_storeu_si128((__m128i*)p,_mm256_castsi256_si128(r));
+}
+static inline void vStoreU32U16(void *p, VInt v) {
+	VInt r= _mm256_permute4x64_epi64(_mm256_packus_epi32(v,v),_MM_SHUFFLE(3,1,2,0));
+	_mm_storeu_si128((__m128i*)p,_mm256_castsi256_si128(r));
+}
+static inline VDouble vLoadFD(const jfloat *p)      {return _mm256_cvtps_pd(_mm_loadu_ps(p));}
+static inline void vStoreDF(jfloat *p, VDouble v)   {_mm_storeu_ps(p,_mm256_cvtpd_ps(v));}
+static inline VInt vMulhiU16(VInt a, VInt b)        {return _mm256_mulhi_epu16(a,b);}
+static inline VInt vAvgU8(VInt a, VInt b)           {return _mm256_avg_epu8(a,b);}
+static inline VInt vAvgU16(VInt a, VInt b)          {return _mm256_avg_epu16(a,b);}
+static inline VFloat vCvtI32F(VInt a)               {return _mm256_cvtepi32_ps(a);}
+static inline VInt vCvttFI32(VFloat a)              {return _mm256_cvttps_epi32(a);}
+static inline VFloat vDivF(VFloat a, VFloat b)      {return _mm256_div_ps(a,b);}
+static inline VDouble vDivD(VDouble a, VDouble b)   {return _mm256_div_pd(a,b);}
+static inline VDouble vMulD(VDouble a, VDouble b)   {return _mm256_mul_pd(a,b);}
+
+#elif defined(ARRAYS_KERNELS_AVX512)
+
+#define VEC_BYTES 64
+typedef __m512i VInt;
+typedef __m512 VFloat;
+typedef __m512d VDouble;
+
+static inline VInt vLoad(const void *p)             {return _mm512_loadu_si512(p);}
+static inline void vStore(void *p, VInt v)          {_mm512_storeu_si512(p,v);}
+static inline void vStream(void *p, VInt v)         {_mm512_stream_si512((__m512i*)p,v);}
+static inline VFloat vLoadF(const jfloat *p)        {return _mm512_loadu_ps(p);}
+static inline void vStoreF(jfloat *p, VFloat v)     {_mm512_storeu_ps(p,v);}
+static inline VDouble vLoadD(const jdouble *p)      {return _mm512_loadu_pd(p);}
+static inline void vStoreD(jdouble *p, VDouble v)   {_mm512_storeu_pd(p,v);}
+
+static inline VInt vSet1I8(jbyte v)                 {return _mm512_set1_epi8(v);}
+static inline VInt vSet1I16(jshort v)               {return _mm512_set1_epi16(v);}
+static inline VInt vSet1I32(jint v)                 {return _mm512_set1_epi32(v);}
+static inline VInt vSet1I64(jlong v)                {return _mm512_set1_epi64(v);}
+
+static inline VInt vMinU8(VInt a, VInt b)           {return _mm512_min_epu8(a,b);}
+static inline VInt vMaxU8(VInt a, VInt b)           {return _mm512_max_epu8(a,b);}
+static inline VInt vMinI8(VInt a, VInt b)           {return _mm512_min_epi8(a,b);}
+static inline VInt vMaxI8(VInt a, VInt b)           {return _mm512_max_epi8(a,b);}
+static inline VInt vMinI16(VInt a, VInt b)          {return _mm512_min_epi16(a,b);}
+static inline VInt vMaxI16(VInt a, VInt b)          {return _mm512_max_epi16(a,b);}
+static inline VInt vMinU16(VInt a, VInt b)          {return _mm512_min_epu16(a,b);}
+static inline VInt vMaxU16(VInt a, VInt b)          {return _mm512_max_epu16(a,b);}
+static inline VInt vMinI32(VInt a, VInt b)          {return _mm512_min_epi32(a,b);}
+static inline VInt vMaxI32(VInt a, VInt b)          {return _mm512_max_epi32(a,b);}
+static inline VInt vMinU32(VInt a, VInt b)          {return _mm512_min_epu32(a,b);}
+static inline VInt vMaxU32(VInt a, VInt b)          {return _mm512_max_epu32(a,b);}
+static inline VInt vMinI64(VInt a, VInt b)          {return _mm512_min_epi64(a,b);}
+static inline VInt vMaxI64(VInt a, VInt b)          {return _mm512_max_epi64(a,b);}
+static inline VInt vMinU64(VInt a, VInt b)          {return _mm512_min_epu64(a,b);}
+static inline VInt vMaxU64(VInt a, VInt b)          {return _mm512_max_epu64(a,b);}
+// AVX-512F has no floating-point logical operations (they are AVX512DQ): integer ones are used
+static inline VFloat vMinF(VFloat a, VFloat b) {
+	return _mm512_castsi512_ps(_mm512_or_si512(
+		_mm512_castps_si512(_mm512_min_ps(a,b)),_mm512_castps_si512(_mm512_min_ps(b,a))));
+}
+static inline VFloat vMaxF(VFloat a, VFloat b) {
+	VInt m= _mm512_and_si512(_mm512_castps_si512(_mm512_max_ps(a,b)),_mm512_castps_si512(_mm512_max_ps(b,a)));
+	return _mm512_castsi512_ps(_mm512_mask_mov_epi32(m,_mm512_cmp_ps_mask(a,b,_CMP_UNORD_Q),_mm512_set1_epi32(-1)));
+}
+static inline VDouble vMinD(VDouble a, VDouble b) {
+	return _mm512_castsi512_pd(_mm512_or_si512(
+		_mm512_castpd_si512(_mm512_min_pd(a,b)),_mm512_castpd_si512(_mm512_min_pd(b,a))));
+}
+static inline VDouble vMaxD(VDouble a, VDouble b) {
+	VInt m= _mm512_and_si512(_mm512_castpd_si512(_mm512_max_pd(a,b)),_mm512_castpd_si512(_mm512_max_pd(b,a)));
+	return _mm512_castsi512_pd(_mm512_mask_mov_epi64(m,_mm512_cmp_pd_mask(a,b,_CMP_UNORD_Q),_mm512_set1_epi64(-1)));
+}
+
+static inline VFloat vSet1F(jfloat v)               {return _mm512_set1_ps(v);}
+static inline VDouble vSet1D(jdouble v)             {return _mm512_set1_pd(v);}
+static inline VFloat vMinNumF(VFloat a, VFloat acc) {return _mm512_min_ps(a,acc);}
+static inline VFloat vMaxNumF(VFloat a, VFloat acc) {return _mm512_max_ps(a,acc);}
+static inline VDouble vMinNumD(VDouble a, VDouble acc) {return _mm512_min_pd(a,acc);}
+static inline VDouble vMaxNumD(VDouble a, VDouble acc) {return _mm512_max_pd(a,acc);}
+static inline VInt vZero()                          {return _mm512_setzero_si512();}
+static inline VDouble vZeroD()                      {return _mm512_setzero_pd();}
+static inline VInt vXor(VInt a, VInt b)             {return _mm512_xor_si512(a,b);}
+static inline VInt vAddI32(VInt a, VInt b)          {return _mm512_add_epi32(a,b);}
+static inline VInt vAddI64(VInt a, VInt b)          {return _mm512_add_epi64(a,b);}
+static inline VDouble vAddD(VDouble a, VDouble b)   {return _mm512_add_pd(a,b);}
+static inline VInt vSadU8(VInt a)                   {return _mm512_sad_epu8(a,_mm512_setzero_si512());}
+static inline VInt vMaddI16(VInt a, VInt b)         {return _mm512_madd_epi16(a,b);}
+static inline VInt vSignI32(VInt a)                 {return _mm512_srai_epi32(a,31);}
+static inline VInt vUnpackLo16(VInt a, VInt b)      {return _mm512_unpacklo_epi16(a,b);}
+static inline VInt vUnpackHi16(VInt a, VInt b)      {return _mm512_unpackhi_epi16(a,b);}
+static inline VInt vUnpackLo32(VInt a, VInt b)      {return _mm512_unpacklo_epi32(a,b);}
+static inline VInt vUnpackHi32(VInt a, VInt b)      {return _mm512_unpackhi_epi32(a,b);}
+static inline VDouble vCvtLoFD(VFloat a)            {return _mm512_cvtps_pd(_mm512_castps512_ps256(a));}
+static inline VDouble vCvtHiFD(VFloat a) {
+	return _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a),1)));
+}
+
+// Element-wise arithmetic: wrapping (vAdd/vSub), signed (vAdds/vSubs) and unsigned (vAddsU/vSubsU) saturation
+static inline VInt vAddI8(VInt a, VInt b)           {return _mm512_add_epi8(a,b);}
+static inline VInt vAddI16(VInt a, VInt b)          {return _mm512_add_epi16(a,b);}
+static inline VInt vSubI8(VInt a, VInt b)           {return _mm512_sub_epi8(a,b);}
+static inline VInt vSubI16(VInt a, VInt b)          {return _mm512_sub_epi16(a,b);}
+static inline VInt vSubI32(VInt a, VInt b)          {return _mm512_sub_epi32(a,b);}
+static inline VInt vSubI64(VInt a, VInt b)          {return _mm512_sub_epi64(a,b);}
+static inline VInt vAddsI8(VInt a, VInt b)          {return _mm512_adds_epi8(a,b);}
+static inline VInt vSubsI8(VInt a, VInt b)          {return _mm512_subs_epi8(a,b);}
+static inline VInt vAddsU8(VInt a, VInt b)          {return _mm512_adds_epu8(a,b);}
+static inline VInt vSubsU8(VInt a, VInt b)          {return _mm512_subs_epu8(a,b);}
+static inline VInt vAddsI16(VInt a, VInt b)         {return _mm512_adds_epi16(a,b);}
+static inline VInt vSubsI16(VInt a, VInt b)         {return _mm512_subs_epi16(a,b);}
+static inline VInt vAddsU16(VInt a, VInt b)         {return _mm512_adds_epu16(a,b);}
+static inline VInt vSubsU16(VInt a, VInt b)         {return _mm512_subs_epu16(a,b);}
+static inline VInt vOr(VInt a, VInt b)              {return _mm512_or_si512(a,b);}
+static inline VFloat vAddF(VFloat a, VFloat b)      {return _mm512_add_ps(a,b);}
+static inline VFloat vSubF(VFloat a, VFloat b)      {return _mm512_sub_ps(a,b);}
+static inline VDouble vSubD(VDouble a, VDouble b)   {return _mm512_sub_pd(a,b);}
+static inline VFloat vAbsF(VFloat a) {
+	return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a),_mm512_set1_epi32(0x7FFFFFFF)));
+}
+static inline VFloat vNegF(VFloat a) {
+	return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a),_mm512_set1_epi32((int)0x80000000)));
+}
+static inline VDouble vAbsD(VDouble a) {
+	return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a),_mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL)));
+}
+static inline VDouble vNegD(VDouble a) {
+	return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a),_mm512_set1_epi64((jlong)0x8000000000000000ULL)));
+}
+
+// Packed bits: vAndNot(a,b)= ~a&b; 64-bit shifts by a variable count 0..64 (64 gives 0).
+// The funnel shift vpshrdvq needs AVX512_VBMI2, which is not required by this level: 2 shifts are used.
+static inline VInt vAnd(VInt a, VInt b)             {return _mm512_and_si512(a,b);}
+static inline VInt vAndNot(VInt a, VInt b)          {return _mm512_andnot_si512(a,b);}
+static inline VInt vSrlI64(VInt a, int n)           {return _mm512_srl_epi64(a,_mm_cvtsi32_si128(n));}
+static inline VInt vSllI64(VInt a, int n)           {return _mm512_sll_epi64(a,_mm_cvtsi32_si128(n));}
+// vPopcnt64: numbers of set bits in 64-bit elements (4-bit lookup by pshufb: vpopcntq needs
+// AVX512_VPOPCNTDQ, see CPU_AVX512POPCNT); vIsZero: all bits are 0
+static inline VInt vPopcnt64(VInt v) {
+	const VInt lookup= _mm512_broadcast_i32x4(_mm_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4));
+	const VInt m4= _mm512_set1_epi8(0x0F);
+	VInt lo= _mm512_shuffle_epi8(lookup,_mm512_and_si512(v,m4));
+	VInt hi= _mm512_shuffle_epi8(lookup,_mm512_and_si512(_mm512_srli_epi16(v,4),m4));
+	return _mm512_sad_epu8(_mm512_add_epi8(lo,hi),_mm512_setzero_si512());
+}
+static inline bool vIsZero(VInt v)                  {return _mm512_test_epi64_mask(v,v)==0;}
+// Threshold packing: bit j of vGtMaskXxx (vGeMaskXxx) is a[j]>b[j] (a[j]>=b[j]) for all lanes j;
+// floating-point compares are ordered (false for NaN), like Java ones
+static inline uint64_t vGtMaskU8(VInt a, VInt b)    {return _mm512_cmpgt_epu8_mask(a,b);}
+static inline uint64_t vGtMaskU16(VInt a, VInt b)   {return _mm512_cmpgt_epu16_mask(a,b);}
+static inline uint64_t vGtMaskI32(VInt a, VInt b)   {return _mm512_cmpgt_epi32_mask(a,b);}
+static inline uint64_t vGtMaskI64(VInt a, VInt b)   {return _mm512_cmpgt_epi64_mask(a,b);}
+static inline uint64_t vGtMaskF(VFloat a, VFloat b) {return _mm512_cmp_ps_mask(a,b,_CMP_GT_OQ);}
+static inline uint64_t vGeMaskF(VFloat a, VFloat b) {return _mm512_cmp_ps_mask(a,b,_CMP_GE_OQ);}
+static inline uint64_t vGtMaskD(VDouble a, VDouble b) {return _mm512_cmp_pd_mask(a,b,_CMP_GT_OQ);}
+static inline uint64_t vGeMaskD(VDouble a, VDouble b) {return _mm512_cmp_pd_mask(a,b,_CMP_GE_OQ);}
+// Bit unpacking: lane j of vSelectXxx(bits,a,b) is (bit j of BITS)? b[j]: a[j] (the bits are a mask register)
+static inline VInt vSelectI8(uint64_t bits, VInt a, VInt b)  {return _mm512_mask_blend_epi8((__mmask64)bits,a,b);}
+static inline VInt vSelectI16(uint64_t bits, VInt a, VInt b) {return _mm512_mask_blend_epi16((__mmask32)bits,a,b);}
+static inline VInt vSelectI32(uint64_t bits, VInt a, VInt b) {return _mm512_mask_blend_epi32((__mmask16)bits,a,b);}
+static inline VInt vSelectI64(uint64_t bits, VInt a, VInt b) {return _mm512_mask_blend_epi64((__mmask8)bits,a,b);}
+// Search: bit j of vEqMaskXxx is a[j]==b[j] (floating-point compares are ordered, like Java ==),
+// bit j of vNaNMaskXxx is isNaN(a[j])
+static inline uint64_t vEqMaskI8(VInt a, VInt b)    {return _mm512_cmpeq_epi8_mask(a,b);}
+static inline uint64_t vEqMaskI16(VInt a, VInt b)   {return _mm512_cmpeq_epi16_mask(a,b);}
+static inline uint64_t vEqMaskI32(VInt a, VInt b)   {return _mm512_cmpeq_epi32_mask(a,b);}
+static inline uint64_t vEqMaskI64(VInt a, VInt b)   {return _mm512_cmpeq_epi64_mask(a,b);}
+static inline uint64_t vEqMaskF(VFloat a, VFloat b) {return _mm512_cmp_ps_mask(a,b,_CMP_EQ_OQ);}
+static inline uint64_t vEqMaskD(VDouble a, VDouble b) {return _mm512_cmp_pd_mask(a,b,_CMP_EQ_OQ);}
+static inline uint64_t vNaNMaskF(VFloat a)         {return _mm512_cmp_ps_mask(a,a,_CMP_UNORD_Q);}
+static inline uint64_t vNaNMaskD(VDouble a)        {return _mm512_cmp_pd_mask(a,a,_CMP_UNORD_Q);}
+// Byte order reversal inside 16-, 32- and 64-bit elements (pshufb inside 128-bit lanes)
+static inline VInt vSwapBytes16(VInt a) {
+	return _mm512_shuffle_epi8(a,_mm512_broadcast_i32x4(_mm_setr_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14)));
+}
+static inline VInt vSwapBytes32(VInt a) {
+	return _mm512_shuffle_epi8(a,_mm512_broadcast_i32x4(_mm_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12)));
+}
+static inline VInt vSwapBytes64(VInt a) {
+	return _mm512_shuffle_epi8(a,_mm512_broadcast_i32x4(_mm_setr_epi8(7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8)));
+}
+// 3x3 filters: vLoadU8U16 (vLoadU16U32, vLoadFD) loads VEC_BYTES/2 bytes (elements) and extends them
+// to 16-bit (32-bit, double) lanes in the same order; vStoreU16U8 (vStoreU32U16, vStoreDF) stores them back,
+// the values must be in the range of the narrow type. vAvgU8/vAvgU16 are rounded up: (a+b+1)>>1
+static inline VInt vLoadU8U16(const void *p)        {return _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)p));}
+static inline void vStoreU16U8(void *p, VInt v)     {_mm256_storeu_si256((__m256i*)p,_mm512_cvtepi16_epi8(v));}
+static inline VInt vLoadU16U32(const void *p)       {return _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)p));}
+static inline void vStoreU32U16(void *p, VInt v)    {_mm256_storeu_si256((__m256i*)p,_mm512_cvtepi32_epi16(v));}
+static inline VDouble vLoadFD(const jfloat *p)      {return _mm512_cvtps_pd(_mm256_loadu_ps(p));}
+static inline void vStoreDF(jfloat *p, VDouble v)   {_mm256_storeu_ps(p,_mm512_cvtpd_ps(v));}
+static inline VInt vMulhiU16(VInt a, VInt b)        {return _mm512_mulhi_epu16(a,b);}
+static inline VInt vAvgU8(VInt a, VInt b)           {return _mm512_avg_epu8(a,b);}
+static inline VInt vAvgU16(VInt a, VInt b)          {return _mm512_avg_epu16(a,b);}
+static inline VFloat vCvtI32F(VInt a)               {return _mm512_cvtepi32_ps(a);}
+static inline VInt vCvttFI32(VFloat a)              {return _mm512_cvttps_epi32(a);}
+static inline VFloat vDivF(VFloat a, VFloat b)      {return _mm512_div_ps(a,b);}
+static inline VDouble vDivD(VDouble a, VDouble b)   {return _mm512_div_pd(a,b);}
+static inline VDouble vMulD(VDouble a, VDouble b)   {return _mm512_mul_pd(a,b);}
+
+#else
+	#error ArraysSimd.h requires ARRAYS_KERNELS_SSE2, ARRAYS_KERNELS_AVX2 or ARRAYS_KERNELS_AVX512
+#endif
+
+static inline void vFence()                         {_mm_sfence();}
+
+// 64-bit sums; the unpacking order inside 128-bit lanes (AVX2, AVX-512) is not important for sums.
+// vSumI8 adds the elements +128 (biased to unsigned for psadbw): the caller subtracts 128*count
+static inline VInt vSumU8(VInt acc, VInt a)         {return vAddI64(acc,vSadU8(a));}
+static inline VInt vSumI8(VInt acc, VInt a)         {return vSumU8(acc,vXor(a,vSet1I8((jbyte)0x80)));}
+static inline VInt vSumI32(VInt acc, VInt a) {
+	VInt sign= vSignI32(a);
+	return vAddI64(vAddI64(acc,vUnpackLo32(a,sign)),vUnpackHi32(a,sign));
+}
+static inline VInt vSumI16(VInt acc, VInt a)        {return vSumI32(acc,vMaddI16(a,vSet1I16(1)));}
+static inline VInt vSumU16(VInt acc, VInt a) {
+	VInt s= vAddI32(vUnpackLo16(a,vZero()),vUnpackHi16(a,vZero())); // non-negative 32-bit sums
+	return vAddI64(vAddI64(acc,vUnpackLo32(s,vZero())),vUnpackHi32(s,vZero()));
+}
+static inline VInt vSumI64(VInt acc, VInt a)        {return vAddI64(acc,a);}
+static inline VDouble vSumF(VDouble acc, VFloat a)  {return vAddD(vAddD(acc,vCvtLoFD(a)),vCvtHiFD(a));}
+static inline VDouble vSumD(VDouble acc, VDouble a) {return vAddD(acc,a);}
+
+// Absolute differences: |a-b| modulo 2^n for signed integers (max-min), exact for unsigned ones;
+// vOppositeXxx ignore the first argument (pair operations "a= -b")
+static inline VInt vAbsDiffI8(VInt a, VInt b)       {return vSubI8(vMaxI8(a,b),vMinI8(a,b));}
+static inline VInt vAbsDiffI16(VInt a, VInt b)      {return vSubI16(vMaxI16(a,b),vMinI16(a,b));}
+static inline VInt vAbsDiffI32(VInt a, VInt b)      {return vSubI32(vMaxI32(a,b),vMinI32(a,b));}
+static inline VInt vAbsDiffI64(VInt a, VInt b)      {return vSubI64(vMaxI64(a,b),vMinI64(a,b));}
+static inline VInt vAbsDiffU8(VInt a, VInt b)       {return vOr(vSubsU8(a,b),vSubsU8(b,a));}
+static inline VInt vAbsDiffU16(VInt a, VInt b)      {return vOr(vSubsU16(a,b),vSubsU16(b,a));}
+static inline VInt vAbsDiffU32(VInt a, VInt b)      {return vSubI32(vMaxU32(a,b),vMinU32(a,b));}
+static inline VInt vAbsDiffU64(VInt a, VInt b)      {return vSubI64(vMaxU64(a,b),vMinU64(a,b));}
+static inline VFloat vAbsDiffF(VFloat a, VFloat b)  {return vAbsF(vSubF(a,b));}
+static inline VDouble vAbsDiffD(VDouble a, VDouble b) {return vAbsD(vSubD(a,b));}
+static inline VInt vOppositeI8(VInt, VInt b)        {return vSubI8(vZero(),b);}
+static inline VInt vOppositeI16(VInt, VInt b)       {return vSubI16(vZero(),b);}
+static inline VInt vOppositeI32(VInt, VInt b)       {return vSubI32(vZero(),b);}
+static inline VInt vOppositeI64(VInt, VInt b)       {return vSubI64(vZero(),b);}
+static inline VFloat vOppositeF(VFloat, VFloat b)   {return vNegF(b);}
+static inline VDouble vOppositeD(VDouble, VDouble b) {return vNegD(b);}
+
+#endif //A_ARRAYSSIMD_H__INCLUDED_
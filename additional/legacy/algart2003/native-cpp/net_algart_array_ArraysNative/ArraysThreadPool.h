@@ -0,0 +1,323 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef A_ARRAYSTHREADPOOL_H__INCLUDED_
+#define A_ARRAYSTHREADPOOL_H__INCLUDED_
+
+// Native worker pool for splitting huge memory-bound operations (copying hundreds of megabytes)
+// between cores: one core cannot saturate all memory channels. The calling thread works too.
+// Only one parallel job is executed at a time; if the pool is busy, the caller does all work itself.
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+
+#define POOL_PAGE_SIZE 4096
+#define POOL_MAX_THREADS 64
+
+class ArraysThreadPool {
+	typedef void (*TaskFunction)(void *arg, jlong taskIndex);
+
+	std::mutex jobMutex; // held while a job is running
+	std::mutex mutex;
+	std::condition_variable workAvailable, workDone;
+	std::vector<std::thread*> workers;
+	unsigned long long generation;
+	TaskFunction task;
+	void *taskArg;
+	jlong taskCount;
+	std::atomic<jlong> nextTask;
+	int activeWorkers;
+	std::atomic<int> threadCount;
+
+	void runTasks() {
+		for (jlong k; (k= nextTask.fetch_add(1))<taskCount; ) task(taskArg,k);
+	}
+
+	void workerLoop() {
+		unsigned long long seen= 0;
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				while (generation==seen) workAvailable.wait(lock);
+				seen= generation;
+			}
+			runTasks();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (--activeWorkers==0) workDone.notify_all();
+			}
+		}
+	}
+
+public:
+	ArraysThreadPool(int threads): generation(0), task(NULL), taskArg(NULL), taskCount(0), nextTask(0),
+		activeWorkers(0), threadCount(threads) {}
+
+	// Number of threads (including the caller) used for parallel jobs; 1 disables parallelism
+	int threads() const {return threadCount.load();}
+	void setThreads(int threads) {
+		threadCount.store(threads<1? 1: threads>POOL_MAX_THREADS? POOL_MAX_THREADS: threads);
+	}
+
+	// Executes task(arg,0..count-1) in parallel; returns when all tasks are completed
+	void run(TaskFunction function, void *arg, jlong count) {
+		std::unique_lock<std::mutex> job(jobMutex,std::try_to_lock);
+		int n= threads();
+		if (!job.owns_lock() || n<=1 || count<=1) {
+			for (jlong k=0; k<count; k++) function(arg,k);
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			// Workers are created lazily and never stopped: the library is not unloaded
+			while ((int)workers.size()<n-1) workers.push_back(new std::thread(&ArraysThreadPool::workerLoop,this));
+			task= function;
+			taskArg= arg;
+			taskCount= count;
+			nextTask.store(0);
+			activeWorkers= (int)workers.size();
+			generation++;
+		}
+		workAvailable.notify_all();
+		runTasks();
+		std::unique_lock<std::mutex> lock(mutex);
+		while (activeWorkers>0) workDone.wait(lock);
+	}
+};
+
+inline ArraysThreadPool &_threadPool() {
+	// Never destroyed: waiting for blocked workers at process exit would hang
+	static ArraysThreadPool *pool= NULL;
+	static std::once_flag once;
+	std::call_once(once,[]() {
+		const CpuDescriptor &d= _cpuDescriptor();
+		int cores= d.physicalCores>0? d.physicalCores: (int)std::thread::hardware_concurrency();
+		pool= new ArraysThreadPool(cores>POOL_MAX_THREADS? POOL_MAX_THREADS: cores<1? 1: cores);
+	});
+	return *pool;
+}
+
+// Minimal length (in bytes) of copying, from which it is split between threads:
+// the data must be far beyond the last level cache, else one core is fast enough
+inline jlong _parallelCopyMinLen() {
+	jlong llc= _cpuDescriptor().lastLevelCacheSize();
+	jlong result= 2*llc;
+	return result<(16<<20)? (16<<20): result;
+}
+
+struct ParallelCopy {
+	const ArraysKernels *kernels;
+	jbyte *dest;
+	const jbyte *src;
+	jlong len, chunk, nonTemporalMinLen;
+	jlong firstChunk; // up to the page boundary in dest, so all other chunks start at page-aligned addresses
+};
+
+static void _parallelCopyTask(void *arg, jlong k) {
+	const ParallelCopy &p= *(const ParallelCopy*)arg;
+	jlong from= k==0? 0: p.firstChunk+(k-1)*p.chunk;
+	jlong to= k==0? p.firstChunk: from+p.chunk;
+	if (to>p.len) to= p.len;
+	if (from<to) p.kernels->copyBytes(p.dest+from,p.src+from,to-from,p.nonTemporalMinLen);
+}
+
+// Copies non-overlapping len bytes using all pool threads; the non-temporal decision is made
+// for the whole area (every chunk is less than the cache, but together they would flush it)
+inline void _parallelCopyBytes(const ArraysKernels *kernels, jbyte *dest, const jbyte *src, jlong len,
+	jlong nonTemporalMinLen)
+{
+	ParallelCopy p;
+	int n= _threadPool().threads();
+	p.kernels= kernels;
+	p.dest= dest;
+	p.src= src;
+	p.len= len;
+	p.nonTemporalMinLen= len>=nonTemporalMinLen? 0: nonTemporalMinLen;
+	// 4 chunks per thread for load balancing, rounded up to whole pages
+	jlong chunk= len/(4*n);
+	p.chunk= (chunk+POOL_PAGE_SIZE-1)&~(jlong)(POOL_PAGE_SIZE-1);
+	p.firstChunk= POOL_PAGE_SIZE-((size_t)dest&(POOL_PAGE_SIZE-1));
+	jlong count= 1+(len-p.firstChunk+p.chunk-1)/p.chunk;
+	_threadPool().run(_parallelCopyTask,&p,count);
+}
+
+template <class T> struct ParallelFilter3x3 {
+	void (*rows)(T *dest, const T *src, jlong dimX, jlong dimY, jlong fromY, jlong toY,
+		jint filter, jint percentileIndex, void *work);
+	T *dest;
+	const T *src;
+	jlong dimX, dimY, chunk;
+	jint filter, percentileIndex;
+	jbyte *work; // FILTER3X3_WORK_BYTES(dimX) bytes for every task
+	size_t workBytes;
+};
+
+template <class T> static void _parallelFilter3x3Task(void *arg, jlong k) {
+	const ParallelFilter3x3<T> &p= *(const ParallelFilter3x3<T>*)arg;
+	jlong from= k*p.chunk, to= from+p.chunk<p.dimY? from+p.chunk: p.dimY;
+	if (from<to) p.rows(p.dest,p.src,p.dimX,p.dimY,from,to,p.filter,p.percentileIndex,p.work+k*p.workBytes);
+}
+
+// 3x3 filter of the whole dimX x dimY matrix (see ArraysFilter3x3.h): the rows are split between
+// the pool threads, every thread streams its own band of rows with its own work memory
+template <class T> inline void _parallelFilter3x3(void (*rows)(T *dest, const T *src, jlong dimX, jlong dimY,
+	jlong fromY, jlong toY, jint filter, jint percentileIndex, void *work),
+	T *dest, const T *src, jlong dimX, jlong dimY, jint filter, jint percentileIndex)
+{
+	int n= _threadPool().threads();
+	size_t workBytes= (FILTER3X3_WORK_BYTES(dimX)+63)&~(size_t)63;
+	if (n<=1 || dimX*dimY<(1<<18) || dimY<2*n) n= 1;
+	std::vector<jlong> work(n*workBytes/sizeof(jlong));
+	if (n==1) {
+		rows(dest,src,dimX,dimY,0,dimY,filter,percentileIndex,&work[0]);
+		return;
+	}
+	ParallelFilter3x3<T> p;
+	p.rows= rows;
+	p.dest= dest;
+	p.src= src;
+	p.dimX= dimX;
+	p.dimY= dimY;
+	p.chunk= (dimY+n-1)/n;
+	p.filter= filter;
+	p.percentileIndex= percentileIndex;
+	p.work= (jbyte*)&work[0];
+	p.workBytes= workBytes;
+	_threadPool().run(_parallelFilter3x3Task<T>,&p,n);
+}
+
+template <class T> struct ParallelRank {
+	void (*columns)(T *dest, const T *src, jlong dimX, jlong dimY, jlong fromX, jlong toX,
+		jint apertureDimX, jint apertureDimY, jint mode, jlong fromIndex, jlong toIndex, void *work);
+	T *dest;
+	const T *src;
+	jlong dimX, dimY, chunk, fromIndex, toIndex;
+	jint apertureDimX, apertureDimY, mode;
+	jbyte *work; // _rankWorkBytes<T>(dimX,apertureDimX,apertureDimY,mode) bytes for every task
+	size_t workBytes;
+};
+
+template <class T> static void _parallelRankTask(void *arg, jlong k) {
+	const ParallelRank<T> &p= *(const ParallelRank<T>*)arg;
+	jlong from= k*p.chunk, to= from+p.chunk<p.dimX? from+p.chunk: p.dimX;
+	if (from<to) p.columns(p.dest,p.src,p.dimX,p.dimY,from,to,p.apertureDimX,p.apertureDimY,p.mode,
+		p.fromIndex,p.toIndex,p.work+k*p.workBytes);
+}
+
+// Rank filter of the whole dimX x dimY matrix (see ArraysRank.h): the columns are split between
+// the pool threads, every thread processes its own vertical strips with its own column histograms;
+// the threads are limited by RANK_MAX_WORK_BYTES of these histograms
+template <class T> inline void _parallelRank(void (*columns)(T *dest, const T *src, jlong dimX, jlong dimY,
+	jlong fromX, jlong toX, jint apertureDimX, jint apertureDimY, jint mode, jlong fromIndex, jlong toIndex,
+	void *work), T *dest, const T *src, jlong dimX, jlong dimY, jint apertureDimX, jint apertureDimY, jint mode,
+	jlong fromIndex, jlong toIndex)
+{
+	int n= _threadPool().threads();
+	size_t workBytes= (_rankWorkBytes<T>(dimX,apertureDimX,apertureDimY,mode)+63)&~(size_t)63;
+	if (dimX*dimY<(1<<16)) n= 1;
+	if (n>dimX/RANK_MIN_STRIP_WIDTH) n= dimX/RANK_MIN_STRIP_WIDTH>1? (int)(dimX/RANK_MIN_STRIP_WIDTH): 1;
+	if ((jlong)n*workBytes>RANK_MAX_WORK_BYTES) n= workBytes<RANK_MAX_WORK_BYTES? (int)(RANK_MAX_WORK_BYTES/workBytes): 1;
+	std::vector<jlong> work(n*workBytes/sizeof(jlong));
+	if (n==1) {
+		columns(dest,src,dimX,dimY,0,dimX,apertureDimX,apertureDimY,mode,fromIndex,toIndex,&work[0]);
+		return;
+	}
+	ParallelRank<T> p;
+	p.columns= columns;
+	p.dest= dest;
+	p.src= src;
+	p.dimX= dimX;
+	p.dimY= dimY;
+	p.chunk= (dimX+n-1)/n;
+	p.fromIndex= fromIndex;
+	p.toIndex= toIndex;
+	p.apertureDimX= apertureDimX;
+	p.apertureDimY= apertureDimY;
+	p.mode= mode;
+	p.work= (jbyte*)&work[0];
+	p.workBytes= workBytes;
+	_threadPool().run(_parallelRankTask<T>,&p,n);
+}
+
+template <class T> struct ParallelMorphology {
+	void (*op)(T *a, const T *b, jlong len);
+	T *dest;
+	const T *src;
+	jlong dimX, dimY, apertureDimX, apertureDimY, chunkX, chunkY;
+	bool dilation;
+	jbyte *work; // _morphologyWorkBytes<T>(...) bytes for every task
+	size_t workBytes;
+};
+
+template <class T> static void _parallelMorphologyColumnsTask(void *arg, jlong k) {
+	const ParallelMorphology<T> &p= *(const ParallelMorphology<T>*)arg;
+	jlong from= k*p.chunkX, to= from+p.chunkX<p.dimX? from+p.chunkX: p.dimX;
+	if (from<to) _morphologyColumns<T>(p.op,p.dest,p.src,p.dimX,p.dimY,from,to,p.apertureDimY,p.work+k*p.workBytes);
+}
+
+template <class T> static void _parallelMorphologyRowsTask(void *arg, jlong k) {
+	const ParallelMorphology<T> &p= *(const ParallelMorphology<T>*)arg;
+	jlong from= k*p.chunkY, to= from+p.chunkY<p.dimY? from+p.chunkY: p.dimY;
+	if (from<to) _morphologyRows<T>(p.dest,p.dimX,from,to,p.apertureDimX,p.dilation,p.work+k*p.workBytes);
+}
+
+// Erosion or dilation of the whole dimX x dimY matrix by a rectangle (see ArraysMorphology.h): the vertical
+// pass splits the columns between the pool threads, then the horizontal pass splits the rows
+template <class T> inline void _parallelMorphology(void (*op)(T *a, const T *b, jlong len),
+	T *dest, const T *src, jlong dimX, jlong dimY, jlong apertureDimX, jlong apertureDimY, bool dilation)
+{
+	if (dimX==0 || dimY==0) return;
+	if (apertureDimX>dimX) apertureDimX= dimX;
+	if (apertureDimY>dimY) apertureDimY= dimY;
+	int n= _threadPool().threads();
+	size_t workBytes= (_morphologyWorkBytes<T>(dimX,dimY,apertureDimX,apertureDimY)+63)&~(size_t)63;
+	if (n<=1 || dimX*dimY<(1<<16) || dimX<2*n || dimY<2*n) n= 1;
+	std::vector<jlong> work(n*workBytes/sizeof(jlong));
+	if (n==1) {
+		_morphologyColumns<T>(op,dest,src,dimX,dimY,0,dimX,apertureDimY,&work[0]);
+		_morphologyRows<T>(dest,dimX,0,dimY,apertureDimX,dilation,&work[0]);
+		return;
+	}
+	ParallelMorphology<T> p;
+	p.op= op;
+	p.dest= dest;
+	p.src= src;
+	p.dimX= dimX;
+	p.dimY= dimY;
+	p.apertureDimX= apertureDimX;
+	p.apertureDimY= apertureDimY;
+	p.chunkX= (dimX+n-1)/n;
+	p.chunkY= (dimY+n-1)/n;
+	p.dilation= dilation;
+	p.work= (jbyte*)&work[0];
+	p.workBytes= workBytes;
+	_threadPool().run(_parallelMorphologyColumnsTask<T>,&p,n);
+	_threadPool().run(_parallelMorphologyRowsTask<T>,&p,n);
+}
+
+#endif //A_ARRAYSTHREADPOOL_H__INCLUDED_
@@ -22,80 +22,23 @@
  * SOFTWARE.
  */
 
-#ifdef SSEASM_SUPPORTED
-if (CpuInfo & CPU_CMOV) {
-	TYPE *pa= (TYPE*)a+Aofs, *pb= (TYPE*)b+Bofs;
-	LOOP_PREFIX_ALIGNED(64)
-	for (; lenStart>0; lenStart--,pa++,pb++) if (*pa CMP *pb) *pa= *pb;
-	__asm {
-		mov eax,pa;
-		mov edx,pb;
-		mov ecx,len;
-		jecxz _EndLoop;
-	_Loop:
-		fld qword ptr [eax];
-		fld qword ptr [edx];
-		fucomi st(0),st(1);
-		FCMOV st(0),st(1);
-		fstp qword ptr [eax];
-		fstp st(0);
-		fld qword ptr [eax+8];
-		fld qword ptr [edx+8];
-		fucomi st(0),st(1);
-		FCMOV st(0),st(1);
-		fstp qword ptr [eax+8];
-		fstp st(0);
-		fld qword ptr [eax+16];
-		fld qword ptr [edx+16];
-		fucomi st(0),st(1);
-		FCMOV st(0),st(1);
-		fstp qword ptr [eax+16];
-		fstp st(0);
-		fld qword ptr [eax+24];
-		fld qword ptr [edx+24];
-		fucomi st(0),st(1);
-		FCMOV st(0),st(1);
-		fstp qword ptr [eax+24];
-		fstp st(0);
-		fld qword ptr [eax+32];
-		fld qword ptr [edx+32];
-		fucomi st(0),st(1);
-		FCMOV st(0),st(1);
-		fstp qword ptr [eax+32];
-		fstp st(0);
-		fld qword ptr [eax+40];
-		fld qword ptr [edx+40];
-		fucomi st(0),st(1);
-		FCMOV st(0),st(1);
-		fstp qword ptr [eax+40];
-		fstp st(0);
-		fld qword ptr [eax+48];
-		fld qword ptr [edx+48];
-		fucomi st(0),st(1);
-		FCMOV st(0),st(1);
-		fstp qword ptr [eax+48];
-		fstp st(0);
-		fld qword ptr [eax+56];
-		fld qword ptr [edx+56];
-		fucomi st(0),st(1);
-		FCMOV st(0),st(1);
-		fstp qword ptr [eax+56];
-		fstp st(0);
-		add eax,64;
-		add edx,64;
-		dec ecx;
-		jnz _Loop;
-	_EndLoop:
-		mov pa,eax;
-		mov pb,edx;
-	}
-	for (; lenEnd>0; lenEnd--,pa++,pb++) if (*pa CMP *pb) *pa= *pb;
-} else
-#endif //SSEASM_SUPPORTED
+
+// Kernel body: pa[k]= min(pa[k],pb[k]) or max(pa[k],pb[k]) for double arrays.
+// Requires SMINMAX (_javaMinD or _javaMaxD) and MINMAX (vMinD or vMaxD): both have Java Math.min/max semantics;
+// pa, pb, len are the kernel arguments.
 {
-	C_LOOP
+	const jlong step= VEC_BYTES/sizeof(jdouble);
+	if (((size_t)pa&(sizeof(jdouble)-1))==0)
+		for (; len>0 && ((size_t)pa&(VEC_BYTES-1))!=0; len--,pa++,pb++) *pa= SMINMAX(*pa,*pb);
+	for (; len>=4*step; len-=4*step,pa+=4*step,pb+=4*step) {
+		VDouble a0= vLoadD(pa), a1= vLoadD(pa+step), a2= vLoadD(pa+2*step), a3= vLoadD(pa+3*step);
+		vStoreD(pa,MINMAX(a0,vLoadD(pb)));
+		vStoreD(pa+step,MINMAX(a1,vLoadD(pb+step)));
+		vStoreD(pa+2*step,MINMAX(a2,vLoadD(pb+2*step)));
+		vStoreD(pa+3*step,MINMAX(a3,vLoadD(pb+3*step)));
+	}
+	for (; len>=step; len-=step,pa+=step,pb+=step) vStoreD(pa,MINMAX(vLoadD(pa),vLoadD(pb)));
+	for (; len>0; len--,pa++,pb++) *pa= SMINMAX(*pa,*pb);
 }
-#undef TYPE
-#undef C_LOOP
-#undef CMP
-#undef FCMOV
+#undef SMINMAX
+#undef MINMAX
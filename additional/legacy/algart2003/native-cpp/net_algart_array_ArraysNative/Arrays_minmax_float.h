@@ -22,79 +22,23 @@
  * SOFTWARE.
  */
 
-#ifdef SSEASM_SUPPORTED
-if (CpuInfo & CPU_SSE) {
-	TYPE *pa= (TYPE*)a+Aofs, *pb= (TYPE*)b+Bofs;
-	LOOP_PREFIX_ALIGNED(64)
-	for (; lenStart>0; lenStart--,pa++,pb++) if (*pa CMP *pb) *pa= *pb;
-	__asm {
-		mov eax,pa;
-		mov edx,pb;
-		mov ecx,len;
-		jecxz _EndLoopAligned;
-		test eax,0xF;
-		jnz _Loop;
-		test edx,0xF;
-		jnz _Loop;
-	_LoopAligned:
-		prefetcht0 [eax+64];
-		movaps xmm0,[eax];
-		movaps xmm1,[eax+16];
-		prefetcht0 [edx+64];
-		movaps xmm2,[eax+32];
-		movaps xmm3,[eax+48];
-		prefetcht0 [eax+96];
-		MINMAX_SSE xmm0,[edx];
-		MINMAX_SSE xmm1,[edx+16];
-		prefetcht0 [edx+96];
-		MINMAX_SSE xmm2,[edx+32];
-		MINMAX_SSE xmm3,[edx+48];
-		movaps [eax],xmm0;
-		movaps [eax+16],xmm1;
-		movaps [eax+32],xmm2;
-		movaps [eax+48],xmm3;
-		add eax,64;
-		add edx,64;
-		dec ecx;
-		jnz _LoopAligned;
-	_EndLoopAligned:
-		jmp _EndLoop;
-	_Loop:
-		prefetcht0 [eax+64];
-		movups xmm0,[eax];
-		movups xmm1,[eax+16];
-		prefetcht0 [edx+64];
-		movups xmm2,[eax+32];
-		movups xmm3,[eax+48];
-		prefetcht0 [eax+96];
-		movups xmm4,[edx];
-		movups xmm5,[edx+16];
-		prefetcht0 [edx+96];
-		movups xmm6,[edx+32];
-		movups xmm7,[edx+48];
-		MINMAX_SSE xmm0,xmm4;
-		MINMAX_SSE xmm1,xmm5;
-		MINMAX_SSE xmm2,xmm6;
-		MINMAX_SSE xmm3,xmm7;
-		movups [eax],xmm0;
-		movups [eax+16],xmm1;
-		movups [eax+32],xmm2;
-		movups [eax+48],xmm3;
-		add eax,64;
-		add edx,64;
-		dec ecx;
-		jnz _Loop;
-	_EndLoop:
-		mov pa,eax;
-		mov pb,edx;
-	}
-	for (; lenEnd>0; lenEnd--,pa++,pb++) if (*pa CMP *pb) *pa= *pb;
-} else
-#endif //SSEASM_SUPPORTED
+
+// Kernel body: pa[k]= min(pa[k],pb[k]) or max(pa[k],pb[k]) for float arrays.
+// Requires SMINMAX (_javaMinF or _javaMaxF) and MINMAX (vMinF or vMaxF): both have Java Math.min/max semantics;
+// pa, pb, len are the kernel arguments.
 {
-	C_LOOP
+	const jlong step= VEC_BYTES/sizeof(jfloat);
+	if (((size_t)pa&(sizeof(jfloat)-1))==0)
+		for (; len>0 && ((size_t)pa&(VEC_BYTES-1))!=0; len--,pa++,pb++) *pa= SMINMAX(*pa,*pb);
+	for (; len>=4*step; len-=4*step,pa+=4*step,pb+=4*step) {
+		VFloat a0= vLoadF(pa), a1= vLoadF(pa+step), a2= vLoadF(pa+2*step), a3= vLoadF(pa+3*step);
+		vStoreF(pa,MINMAX(a0,vLoadF(pb)));
+		vStoreF(pa+step,MINMAX(a1,vLoadF(pb+step)));
+		vStoreF(pa+2*step,MINMAX(a2,vLoadF(pb+2*step)));
+		vStoreF(pa+3*step,MINMAX(a3,vLoadF(pb+3*step)));
+	}
+	for (; len>=step; len-=step,pa+=step,pb+=step) vStoreF(pa,MINMAX(vLoadF(pa),vLoadF(pb)));
+	for (; len>0; len--,pa++,pb++) *pa= SMINMAX(*pa,*pb);
 }
-#undef TYPE
-#undef C_LOOP
-#undef CMP
-#undef MINMAX_SSE
+#undef SMINMAX
+#undef MINMAX
@@ -0,0 +1,47 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Kernel body: pa[k]= OP(pa[k],pb[k]) for any element type.
+// Requires TYPE, VTYPE, VLOAD and VSTORE (vLoad/vStore, vLoadF/vStoreF or vLoadD/vStoreD), SOP (scalar
+// function from ArraysArithmetic.h) and VOP (vector function from ArraysSimd.h); pa, pb, len are the kernel arguments.
+{
+	const jlong step= VEC_BYTES/sizeof(TYPE);
+	if (((size_t)pa&(sizeof(TYPE)-1))==0)
+		for (; len>0 && ((size_t)pa&(VEC_BYTES-1))!=0; len--,pa++,pb++) *pa= SOP(*pa,*pb);
+	for (; len>=4*step; len-=4*step,pa+=4*step,pb+=4*step) {
+		VTYPE a0= VLOAD(pa), a1= VLOAD(pa+step), a2= VLOAD(pa+2*step), a3= VLOAD(pa+3*step);
+		VSTORE(pa,VOP(a0,VLOAD(pb)));
+		VSTORE(pa+step,VOP(a1,VLOAD(pb+step)));
+		VSTORE(pa+2*step,VOP(a2,VLOAD(pb+2*step)));
+		VSTORE(pa+3*step,VOP(a3,VLOAD(pb+3*step)));
+	}
+	for (; len>=step; len-=step,pa+=step,pb+=step) VSTORE(pa,VOP(VLOAD(pa),VLOAD(pb)));
+	for (; len>0; len--,pa++,pb++) *pa= SOP(*pa,*pb);
+}
+#undef TYPE
+#undef VTYPE
+#undef VLOAD
+#undef VSTORE
+#undef SOP
+#undef VOP
@@ -22,12 +22,8 @@
  * SOFTWARE.
  */
 
-#define TYPE unsigned __int8
-#define C_LOOP MAXBODY_LOOP(unsigned __int8)
+
+#define TYPE uint8_t
 #define CMP <
-#define MINMAX_MMXEX pmaxub
-#define BIT_MASK_MMX 0x8080808080808080
-#define PCMPGT pcmpgtb
-#define MM0_FOR_MIN mm1
-#define MM1_FOR_MIN mm0
+#define MINMAX vMaxU8
 #include "Arrays_minmax_int.h"
@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Kernel body: minimum and maximum with the indexes of their first occurrences, and the sum of pa[0..len-1].
+// Requires TYPE, VTYPE, VLOAD, VSTORE, VSET1, VMIN and VMAX (returning the second argument, the accumulator,
+// for NaN elements), MIN_INIT and MAX_INIT (the greatest and the least TYPE values or infinities),
+// SUM_TYPE (uint64_t: wrapping integer sums, or jdouble), VACC, VACC_ZERO, VACC_STORE, VSUM and SUM_BIAS
+// (added by VSUM per element), SUM_FIELD (sum or doubleSum); pa, len, r are the kernel arguments.
+// The array is processed by blocks in one pass; then only the blocks containing the first minimum and
+// the first maximum are scanned for the first element equal (==) to them, so the results are the same
+// as of the loop "if (a[k]<min) min= a[k]" (with -0.0==+0.0; NaN elements are skipped).
+{
+	const jlong step= VEC_BYTES/sizeof(TYPE);
+	TYPE gMin= MIN_INIT, gMax= MAX_INIT;
+	jlong minBlock= -1, maxBlock= -1;
+	SUM_TYPE sum= 0;
+	for (jlong ofs= 0; ofs<len; ofs+= RANGE_BLOCK_LEN) {
+		const TYPE *p= pa+ofs;
+		jlong n= len-ofs<RANGE_BLOCK_LEN? len-ofs: RANGE_BLOCK_LEN;
+		TYPE bMin= MIN_INIT, bMax= MAX_INIT;
+		jlong k= 0;
+		if (n>=step) {
+			VTYPE vMin= VSET1(MIN_INIT), vMax= VSET1(MAX_INIT);
+			VACC acc= VACC_ZERO;
+			for (; k+step<=n; k+= step) {
+				VTYPE v= VLOAD(p+k);
+				vMin= VMIN(v,vMin);
+				vMax= VMAX(v,vMax);
+				acc= VSUM(acc,v);
+			}
+			TYPE t[VEC_BYTES/sizeof(TYPE)];
+			VSTORE(t,vMin);
+			for (jlong j= 0; j<step; j++) if (t[j]<bMin) bMin= t[j];
+			VSTORE(t,vMax);
+			for (jlong j= 0; j<step; j++) if (t[j]>bMax) bMax= t[j];
+			SUM_TYPE s[VEC_BYTES/8];
+			VACC_STORE(s,acc);
+			for (int j= 0; j<VEC_BYTES/8; j++) sum+= s[j];
+			sum-= (SUM_TYPE)SUM_BIAS*(SUM_TYPE)k;
+		}
+		for (; k<n; k++) {
+			if (p[k]<bMin) bMin= p[k];
+			if (p[k]>bMax) bMax= p[k];
+			sum+= p[k];
+		}
+		if (bMin<=bMax) { // false only if all elements are NaN
+			if (minBlock<0 || bMin<gMin) {gMin= bMin; minBlock= ofs;}
+			if (maxBlock<0 || bMax>gMax) {gMax= bMax; maxBlock= ofs;}
+		}
+	}
+	r->minIndex= r->maxIndex= -1;
+	if (minBlock>=0) {
+		for (jlong k= minBlock; ; k++) if (pa[k]==gMin) {r->minIndex= k; break;}
+		for (jlong k= maxBlock; ; k++) if (pa[k]==gMax) {r->maxIndex= k; break;}
+	}
+	r->SUM_FIELD= (SUM_TYPE)sum;
+}
+#undef TYPE
+#undef VTYPE
+#undef VLOAD
+#undef VSTORE
+#undef VSET1
+#undef VMIN
+#undef VMAX
+#undef MIN_INIT
+#undef MAX_INIT
+#undef SUM_TYPE
+#undef VACC
+#undef VACC_ZERO
+#undef VACC_STORE
+#undef VSUM
+#undef SUM_BIAS
+#undef SUM_FIELD
@@ -23,16 +23,28 @@
  */
 
 #include <jni.h>
-#include <windows.h>
 #include "net_algart_lib_TimingNative.h"
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define TSC_SUPPORTED
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+		#include <x86intrin.h>
+	#endif
+#endif
 
-/*
- * Class:     net_algart_lib_TimingNative
- * Method:    timens
- * Signature: ()J
- */
-JNIEXPORT jlong JNICALL Java_net_algart_lib_TimingNative_timens
-(JNIEnv *, jclass) {
+// Monotonic time in nanoseconds: QueryPerformanceCounter on Windows,
+// CLOCK_MONOTONIC_RAW (not slewed by NTP) on Linux. Note: Linux kernels before 5.3 have
+// no vDSO fast path for CLOCK_MONOTONIC_RAW, so there every call is a real system call,
+// noticeably slower than CLOCK_MONOTONIC
+static jlong _timens() {
+#ifdef _WIN32
 	static bool firstCall= true;
 	static LARGE_INTEGER frequency;
 	if (firstCall) {
@@ -42,6 +54,124 @@ JNIEXPORT jlong JNICALL Java_net_algart_lib_TimingNative_timens
 	LARGE_INTEGER counter;
 	::QueryPerformanceCounter(&counter);
 	return (jlong)(counter.QuadPart*1000000000.0/frequency.QuadPart+0.5);
+#else
+	struct timespec ts;
+#ifdef CLOCK_MONOTONIC_RAW
+	if (clock_gettime(CLOCK_MONOTONIC_RAW,&ts)!=0)
+#endif
+		clock_gettime(CLOCK_MONOTONIC,&ts);
+	return (jlong)ts.tv_sec*1000000000+ts.tv_nsec;
+#endif
+}
+
+#ifdef TSC_SUPPORTED
+static void _cpuid(unsigned regs[4], unsigned leaf) {
+#ifdef _MSC_VER
+	__cpuidex((int*)regs,(int)leaf,0);
+#else
+	__cpuid_count(leaf,0,regs[0],regs[1],regs[2],regs[3]);
+#endif
+}
+#endif
+
+struct TscInfo {
+	bool supported;  // RDTSC
+	bool rdtscp;     // RDTSCP (reads TSC after all previous instructions complete)
+	bool invariant;  // constant rate in all P-/C-states, synchronized between cores
+	jlong frequency; // ticks per second, 0 if unknown
+};
+
+static TscInfo _detectTsc() {
+	TscInfo info= {false,false,false,0};
+#ifdef TSC_SUPPORTED
+	unsigned regs[4];
+	_cpuid(regs,0);
+	unsigned maxLeaf= regs[0];
+	if (maxLeaf<1) return info;
+	_cpuid(regs,1);
+	info.supported= (regs[3]&(1u<<4))!=0;
+	if (!info.supported) return info;
+	_cpuid(regs,0x80000000);
+	unsigned maxExtLeaf= regs[0];
+	if (maxExtLeaf>=0x80000001) {
+		_cpuid(regs,0x80000001);
+		info.rdtscp= (regs[3]&(1u<<27))!=0;
+	}
+	if (maxExtLeaf>=0x80000007) {
+		_cpuid(regs,0x80000007);
+		info.invariant= (regs[3]&(1u<<8))!=0;
+	}
+	// Leaf 0x15: TSC = crystal clock * EBX/EAX (exact, if the crystal frequency ECX is reported)
+	if (maxLeaf>=0x15) {
+		_cpuid(regs,0x15);
+		if (regs[0]!=0 && regs[1]!=0 && regs[2]!=0) {
+			info.frequency= (jlong)((unsigned long long)regs[2]*regs[1]/regs[0]);
+		}
+	}
+#endif
+	return info;
+}
+
+static const TscInfo &_tsc() {
+	static TscInfo info= _detectTsc();
+	return info;
+}
+
+// Serialized TSC read: not executed before the previous instructions, and the following
+// instructions do not start before it (LFENCE after RDTSCP, or LFENCE on both sides of RDTSC)
+static jlong _timecpu() {
+#ifdef TSC_SUPPORTED
+	unsigned aux;
+	jlong result;
+	if (_tsc().rdtscp) {
+		result= (jlong)__rdtscp(&aux);
+	} else {
+		_mm_lfence();
+		result= (jlong)__rdtsc();
+	}
+	_mm_lfence();
+	return result;
+#else
+	return 0;
+#endif
+}
+
+// Measures TSC frequency against _timens(): every sample takes the clock between two close TSC reads
+static jlong _calibrateTsc() {
+	const jlong interval= 20000000; // 20 ms
+	jlong best= 0, bestUncertainty= 0;
+	for (int attempt=0; attempt<3; attempt++) {
+		jlong c1= _timecpu(), t1= _timens(), c2= _timecpu();
+		jlong t2, c3, c4;
+		do {
+			c3= _timecpu(); t2= _timens(); c4= _timecpu();
+		} while (t2-t1<interval);
+		// The attempt with the smallest read uncertainty (c2-c1)+(c4-c3) wins
+		jlong uncertainty= (c2-c1)+(c4-c3);
+		if (best==0 || uncertainty<bestUncertainty) {
+			best= (jlong)(((c3+c4)/2-(c1+c2)/2)*1e9/(double)(t2-t1)+0.5);
+			bestUncertainty= uncertainty;
+		}
+	}
+	return best;
+}
+
+static jlong _tscFrequency() {
+	static jlong frequency= -1;
+	if (frequency<0) {
+		frequency= !_tsc().supported? 0: _tsc().frequency>0? _tsc().frequency: _calibrateTsc();
+	}
+	return frequency;
+}
+
+/*
+ * Class:     net_algart_lib_TimingNative
+ * Method:    timens
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_net_algart_lib_TimingNative_timens
+(JNIEnv *, jclass) {
+	return _timens();
 }
 
 /*
@@ -51,28 +181,27 @@ JNIEXPORT jlong JNICALL Java_net_algart_lib_TimingNative_timens
  */
 JNIEXPORT jint JNICALL Java_net_algart_lib_TimingNative_getTimecpuSupportedInternal
 (JNIEnv *, jclass) {
-	static int _timecpuSupported= -1;
-	if (_timecpuSupported>=0) return _timecpuSupported;
-	_timecpuSupported= 0;
-	try {
-		__asm {
-			mov eax,1;
-			_emit 0Fh;
-			_emit 0A2h; //cpuid;
-			test edx,1<<4;
-			jz _TSC_No;
-				xor eax,eax;
-				xor edx,edx;
-				_emit 0Fh;
-				_emit 31h; //rdtsc;
-				or eax,edx;
-				jz _TSC_No;
-				mov _timecpuSupported,1;
-_TSC_No:
-		}
-	} catch (...) {
-	}
-	return _timecpuSupported;
+	return _tsc().supported && _timecpu()!=0? 1: 0;
+}
+
+/*
+ * Class:     net_algart_lib_TimingNative
+ * Method:    getTimecpuInvariantInternal
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_net_algart_lib_TimingNative_getTimecpuInvariantInternal
+(JNIEnv *, jclass) {
+	return _tsc().supported && _tsc().invariant? 1: 0;
+}
+
+/*
+ * Class:     net_algart_lib_TimingNative
+ * Method:    getTimecpuFrequencyInternal
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_net_algart_lib_TimingNative_getTimecpuFrequencyInternal
+(JNIEnv *, jclass) {
+	return _tscFrequency();
 }
 
 /*
@@ -82,12 +211,5 @@ _TSC_No:
  */
 JNIEXPORT jlong JNICALL Java_net_algart_lib_TimingNative_timecpuInternal
 (JNIEnv *, jclass) {
-	jlong result= 0;
-	__asm {
-		_emit 0Fh;
-		_emit 31h; //rdtsc;
-		mov dword ptr result,eax;
-		mov dword ptr result+4,edx;
-	}
-	return result;
+	return _timecpu();
 }
@@ -178,64 +178,73 @@ public final class Arrays implements TrueStatic {
     public static void copy(Object[] a, Object[] b) {copy(a,0,b,0,min(a.length,b.length));}
     public static void copy(Object a, Object b)     {copy(a,0,b,0,min(Array.getLength(a),Array.getLength(b)));}
 
+    // Explicit range checks before passing arrays to the native code, which doesn't check indexes
+    private static void checkRange(int arrayLength, int ofs, int len) {
+        if (len<0 || ofs<0 || ofs>arrayLength-len) throw new IndexOutOfBoundsException("Array range "+ofs+".."+((long)ofs+len-1)+" is out of 0.."+(arrayLength-1)+" in " + Arrays.class.getName());
+    }
+    private static void checkRanges(int aLength, int aofs, int bLength, int bofs, int len) {
+        checkRange(aLength,aofs,len);
+        checkRange(bLength,bofs,len);
+    }
     public static void copy(char[] a, int aofs, char[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLenFill) {
-            b[bofs]= a[aofs]; b[bofs+len-1]= a[aofs+len-1];
-            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<1,b,bofs<<1,(len-1)<<1);
+        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLensCopy[NT_CHAR]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<1,b,bofs<<1,len<<1);
             return;
         }
         System.arraycopy(a,aofs,b,bofs,len);
     }
     public static void copy(byte[] a, int aofs, byte[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLenFill) {
-            b[bofs]= a[aofs]; b[bofs+len-1]= a[aofs+len-1];
-            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len-1);
+        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLensCopy[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
         }
         System.arraycopy(a,aofs,b,bofs,len);
     }
     public static void copy(short[] a, int aofs, short[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLenFill) {
-            b[bofs]= a[aofs]; b[bofs+len-1]= a[aofs+len-1];
-            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<1,b,bofs<<1,(len-1)<<1);
+        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLensCopy[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<1,b,bofs<<1,len<<1);
             return;
         }
         System.arraycopy(a,aofs,b,bofs,len);
     }
     public static void copy(int[] a, int aofs, int[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLenFill) {
-            b[bofs]= a[aofs]; b[bofs+len-1]= a[aofs+len-1];
-            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<2,b,bofs<<2,(len-1)<<2);
+        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLensCopy[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<2,b,bofs<<2,len<<2);
             return;
         }
         System.arraycopy(a,aofs,b,bofs,len);
     }
     public static void copy(long[] a, int aofs, long[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLenFill) {
-            b[bofs]= a[aofs]; b[bofs+len-1]= a[aofs+len-1];
-            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<3,b,bofs<<3,(len-1)<<3);
+        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLensCopy[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<3,b,bofs<<3,len<<3);
             return;
         }
         System.arraycopy(a,aofs,b,bofs,len);
     }
     public static void copy(float[] a, int aofs, float[] b, int bofs, int len) {
-        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLenFill) {
-            b[bofs]= a[aofs]; b[bofs+len-1]= a[aofs+len-1];
-            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<2,b,bofs<<2,(len-1)<<2);
+        if (len<=0) return;
+        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLensCopy[NT_FLOAT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<2,b,bofs<<2,len<<2);
             return;
         }
         System.arraycopy(a,aofs,b,bofs,len);
     }
     public static void copy(double[] a, int aofs, double[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLenFill) {
-            b[bofs]= a[aofs]; b[bofs+len-1]= a[aofs+len-1];
-            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<3,b,bofs<<3,(len-1)<<3);
+        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLensCopy[NT_DOUBLE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<3,b,bofs<<3,len<<3);
             return;
         }
         System.arraycopy(a,aofs,b,bofs,len);
@@ -247,19 +256,21 @@ public final class Arrays implements TrueStatic {
         System.arraycopy(a,aofs,b,bofs,len);
     }
     public static void copy(Object a, int aofs, Object b, int bofs, int len) {
+        if (b instanceof Buffer) {copy(a,aofs,(Buffer)b,bofs,len); return;}
+        if (a instanceof Buffer) {copy((Buffer)a,aofs,b,bofs,len); return;}
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0 && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && (ArraysNative.cpuInfo&CPU_SSE)!=0) {
             Class elemClass= a.getClass().getComponentType();
             int sizeLog= elemClass==byte.class? 0:
                 elemClass==short.class || elemClass==char.class? 1:
                 elemClass==int.class || elemClass==float.class? 2:
                 elemClass==long.class || elemClass==double.class? 3:
                 -1;
-            if (sizeLog!=-1) {
-                System.arraycopy(a,aofs,b,bofs,1);
-                System.arraycopy(a,aofs+len-1,b,bofs+len-1,1);
-                ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<sizeLog,b,bofs<<sizeLog,
-                    (len-1)<<sizeLog);
+            if (sizeLog!=-1 && len>nativeMinLensCopy[nativeType(elemClass)]
+                && b.getClass()==a.getClass()) {
+                if (aofs<0 || bofs<0 || len>Array.getLength(a)-aofs || len>Array.getLength(b)-bofs)
+                    throw new ArrayIndexOutOfBoundsException("Illegal offsets or length in "+Arrays.class.getName()+".copy()");
+                ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs<<sizeLog,b,bofs<<sizeLog,len<<sizeLog);
                 return;
             }
         }
@@ -411,7 +422,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(char[] a, int aofs, byte[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -420,7 +431,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(byte[] a, int aofs, char[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -429,7 +440,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(short[] a, int aofs, byte[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -438,7 +449,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(byte[] a, int aofs, short[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -447,7 +458,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(int[] a, int aofs, byte[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -464,7 +475,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(byte[] a, int aofs, int[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -480,7 +491,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(long[] a, int aofs, byte[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -499,7 +510,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(byte[] a, int aofs, long[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -517,7 +528,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(float[] a, int aofs, byte[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -534,7 +545,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(byte[] a, int aofs, float[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -550,7 +561,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(double[] a, int aofs, byte[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -569,7 +580,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(byte[] a, int aofs, double[] b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             checkByteCC(a,aofs); checkByteCC(b,bofs); checkByteCC(a,aofs+len-1); checkByteCC(b,bofs+len-1);
             ArraysNative.copyBytes(ArraysNative.cpuInfo,a,aofs,b,bofs,len);
             return;
@@ -587,7 +598,7 @@ public final class Arrays implements TrueStatic {
     }
     public static void coerciveCopy(Object a, int aofs, Object b, int bofs, int len) {
         if (len<=0) return;
-        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLenFill) {
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[NT_BYTE]) {
             if (!checkByteCC(a,aofs)) throw new IllegalArgumentException("Unsupported a argument type in " + Arrays.class.getName() + ".coerciveCopy(): "+JVM.toJavaClassName(a));
             if (!checkByteCC(b,bofs)) throw new IllegalArgumentException("Unsupported b argument type in " + Arrays.class.getName() + ".coerciveCopy(): "+JVM.toJavaClassName(b));
             checkByteCC(a,aofs+len-1);
@@ -1283,7 +1294,7 @@ public final class Arrays implements TrueStatic {
         for (int k=beginIndex; k<endIndex; k++) a[k] = v;
     }
     public static void fill(char[] a, int beginIndex, int endIndex, char v) {
-        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLenFill) {
+        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLensFill[NT_CHAR]) {
             a[beginIndex]= a[endIndex-1]= v;
             ArraysNative.fill(ArraysNative.cpuInfo,a,beginIndex,endIndex,v);
             return;
@@ -1291,7 +1302,7 @@ public final class Arrays implements TrueStatic {
         for (int k=beginIndex; k<endIndex; k++) a[k] = v;
     }
     public static void fill(byte[] a, int beginIndex, int endIndex, byte v) {
-        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLenFill) {
+        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLensFill[NT_BYTE]) {
             a[beginIndex]= a[endIndex-1]= v;
             ArraysNative.fill(ArraysNative.cpuInfo,a,beginIndex,endIndex,v);
             return;
@@ -1299,7 +1310,7 @@ public final class Arrays implements TrueStatic {
         for (int k=beginIndex; k<endIndex; k++) a[k] = v;
     }
     public static void fill(short[] a, int beginIndex, int endIndex, short v) {
-        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLenFill) {
+        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLensFill[NT_SHORT]) {
             a[beginIndex]= a[endIndex-1]= v;
             ArraysNative.fill(ArraysNative.cpuInfo,a,beginIndex,endIndex,v);
             return;
@@ -1307,7 +1318,7 @@ public final class Arrays implements TrueStatic {
         for (int k=beginIndex; k<endIndex; k++) a[k] = v;
     }
     public static void fill(int[] a, int beginIndex, int endIndex, int v) {
-        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLenFill) {
+        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLensFill[NT_INT]) {
             a[beginIndex]= a[endIndex-1]= v;
             ArraysNative.fill(ArraysNative.cpuInfo,a,beginIndex,endIndex,v);
             return;
@@ -1316,7 +1327,7 @@ public final class Arrays implements TrueStatic {
     }
 
     public static void fill(long[] a, int beginIndex, int endIndex, long v) {
-        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLenFill) {
+        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLensFill[NT_LONG]) {
             a[beginIndex]= a[endIndex-1]= v;
             ArraysNative.fill(ArraysNative.cpuInfo,a,beginIndex,endIndex,v);
             return;
@@ -1324,7 +1335,7 @@ public final class Arrays implements TrueStatic {
         for (int k=beginIndex; k<endIndex; k++) a[k] = v;
     }
     public static void fill(float[] a, int beginIndex, int endIndex, float v) {
-        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLenFill) {
+        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLensFill[NT_FLOAT]) {
             a[beginIndex]= a[endIndex-1]= v;
             ArraysNative.fill(ArraysNative.cpuInfo,a,beginIndex,endIndex,v);
             return;
@@ -1332,7 +1343,7 @@ public final class Arrays implements TrueStatic {
         for (int k=beginIndex; k<endIndex; k++) a[k] = v;
     }
     public static void fill(double[] a, int beginIndex, int endIndex,double v){
-        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLenFill) {
+        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLensFill[NT_DOUBLE]) {
             a[beginIndex]= a[endIndex-1]= v;
             ArraysNative.fill(ArraysNative.cpuInfo,a,beginIndex,endIndex,v);
             return;
@@ -1340,7 +1351,7 @@ public final class Arrays implements TrueStatic {
         for (int k=beginIndex; k<endIndex; k++) a[k] = v;
     }
     public static void fill(Object[] a, int beginIndex, int endIndex, Object v){
-        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLenFill) {
+        if (isNative && ArraysNative.fillImplemented && endIndex-beginIndex>nativeMinLensFill[NT_OBJECT]) {
             a[beginIndex]= a[endIndex-1]= v;
             ArraysNative.fill(ArraysNative.cpuInfo,a,beginIndex,endIndex,v);
             return;
@@ -1628,18 +1639,48 @@ public final class Arrays implements TrueStatic {
     public static int indexOf(byte[] a, byte b)           {return indexOf(a,b,0);}
     public static int indexOf(short[] a, short b)         {return indexOf(a,b,0);}
     public static int indexOf(int[] a, int b)             {return indexOf(a,b,0);}
+    public static int indexOf(long[] a, long b)           {return indexOf(a,b,0);}
     public static int indexOf(float[] a, float b)         {return indexOf(a,b,0);}
     public static int indexOf(double[] a, double b)       {return indexOf(a,b,0);}
     public static int indexOf(Object[] a, Object b)       {return indexOf(a,b,0);}
     public static int indexOfEqual(Object[] a, Object b)  {return indexOfEqual(a,b,0);}
 
     public static int indexOf(boolean[] a, boolean b, int fromIndex)     {for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;}
-    public static int indexOf(char[] a, char b, int fromIndex)           {for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;}
-    public static int indexOf(byte[] a, byte b, int fromIndex)           {for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;}
-    public static int indexOf(short[] a, short b, int fromIndex)         {for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;}
-    public static int indexOf(int[] a, int b, int fromIndex)             {for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;}
-    public static int indexOf(float[] a, float b, int fromIndex)         {for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;}
-    public static int indexOf(double[] a, double b, int fromIndex)       {for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;}
+    public static int indexOf(char[] a, char b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex>=0 && a.length-fromIndex>nativeMinLensPairOp[NT_CHAR])
+            return ArraysNative.indexOfChars(ArraysNative.cpuInfo,a,fromIndex,a.length-fromIndex,b);
+        for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;
+    }
+    public static int indexOf(byte[] a, byte b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex>=0 && a.length-fromIndex>nativeMinLensPairOp[NT_BYTE])
+            return ArraysNative.indexOfBytes(ArraysNative.cpuInfo,a,fromIndex,a.length-fromIndex,b);
+        for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;
+    }
+    public static int indexOf(short[] a, short b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex>=0 && a.length-fromIndex>nativeMinLensPairOp[NT_SHORT])
+            return ArraysNative.indexOfShorts(ArraysNative.cpuInfo,a,fromIndex,a.length-fromIndex,b);
+        for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;
+    }
+    public static int indexOf(int[] a, int b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex>=0 && a.length-fromIndex>nativeMinLensPairOp[NT_INT])
+            return ArraysNative.indexOfInts(ArraysNative.cpuInfo,a,fromIndex,a.length-fromIndex,b);
+        for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;
+    }
+    public static int indexOf(long[] a, long b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex>=0 && a.length-fromIndex>nativeMinLensPairOp[NT_LONG])
+            return ArraysNative.indexOfLongs(ArraysNative.cpuInfo,a,fromIndex,a.length-fromIndex,b);
+        for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;
+    }
+    public static int indexOf(float[] a, float b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && b==b && fromIndex>=0 && a.length-fromIndex>nativeMinLensPairOp[NT_FLOAT])
+            return ArraysNative.indexOfFloats(ArraysNative.cpuInfo,a,fromIndex,a.length-fromIndex,b);
+        for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;
+    }
+    public static int indexOf(double[] a, double b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && b==b && fromIndex>=0 && a.length-fromIndex>nativeMinLensPairOp[NT_DOUBLE])
+            return ArraysNative.indexOfDoubles(ArraysNative.cpuInfo,a,fromIndex,a.length-fromIndex,b);
+        for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;
+    }
     public static int indexOf(Object[] a, Object b, int fromIndex)       {for (int k=fromIndex; k<a.length; k++) if (a[k]==b) return k; return -1;}
     public static int indexOfEqual(Object[] a, Object b, int fromIndex)  {
         if (b==null) return indexOf(a,b,fromIndex);
@@ -1658,19 +1699,69 @@ public final class Arrays implements TrueStatic {
     public static int lastIndexOfEqual(Object[] a, Object b){return lastIndexOfEqual(a,b,a.length-1);}
 
     public static int lastIndexOf(boolean[] a, boolean b, int fromIndex)   {for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;}
-    public static int lastIndexOf(char[] a, char b, int fromIndex)         {for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;}
-    public static int lastIndexOf(byte[] a, byte b, int fromIndex)         {for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;}
-    public static int lastIndexOf(short[] a, short b, int fromIndex)       {for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;}
-    public static int lastIndexOf(int[] a, int b, int fromIndex)           {for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;}
-    public static int lastIndexOf(long[] a, long b, int fromIndex)         {for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;}
-    public static int lastIndexOf(float[] a, float b, int fromIndex)       {for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;}
-    public static int lastIndexOf(double[] a, double b, int fromIndex)     {for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;}
+    public static int lastIndexOf(char[] a, char b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex<a.length && fromIndex+1>nativeMinLensPairOp[NT_CHAR])
+            return ArraysNative.lastIndexOfChars(ArraysNative.cpuInfo,a,0,fromIndex+1,b);
+        for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;
+    }
+    public static int lastIndexOf(byte[] a, byte b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex<a.length && fromIndex+1>nativeMinLensPairOp[NT_BYTE])
+            return ArraysNative.lastIndexOfBytes(ArraysNative.cpuInfo,a,0,fromIndex+1,b);
+        for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;
+    }
+    public static int lastIndexOf(short[] a, short b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex<a.length && fromIndex+1>nativeMinLensPairOp[NT_SHORT])
+            return ArraysNative.lastIndexOfShorts(ArraysNative.cpuInfo,a,0,fromIndex+1,b);
+        for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;
+    }
+    public static int lastIndexOf(int[] a, int b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex<a.length && fromIndex+1>nativeMinLensPairOp[NT_INT])
+            return ArraysNative.lastIndexOfInts(ArraysNative.cpuInfo,a,0,fromIndex+1,b);
+        for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;
+    }
+    public static int lastIndexOf(long[] a, long b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex<a.length && fromIndex+1>nativeMinLensPairOp[NT_LONG])
+            return ArraysNative.lastIndexOfLongs(ArraysNative.cpuInfo,a,0,fromIndex+1,b);
+        for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;
+    }
+    public static int lastIndexOf(float[] a, float b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && b==b && fromIndex<a.length && fromIndex+1>nativeMinLensPairOp[NT_FLOAT])
+            return ArraysNative.lastIndexOfFloats(ArraysNative.cpuInfo,a,0,fromIndex+1,b);
+        for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;
+    }
+    public static int lastIndexOf(double[] a, double b, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && b==b && fromIndex<a.length && fromIndex+1>nativeMinLensPairOp[NT_DOUBLE])
+            return ArraysNative.lastIndexOfDoubles(ArraysNative.cpuInfo,a,0,fromIndex+1,b);
+        for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;
+    }
     public static int lastIndexOf(Object[] a, Object b, int fromIndex)     {for (int k=fromIndex; k>=0; k--) if (a[k]==b) return k; return -1;}
     public static int lastIndexOfEqual(Object[] a, Object b, int fromIndex){
         if (b==null) return lastIndexOf(a,b,fromIndex);
         for (int k=fromIndex; k>=0; k--) if (b.equals(a[k])) return k; return -1;
     }
 
+    // Search for NaN (missing values), which is never found by indexOf/lastIndexOf because NaN!=NaN
+    public static int indexOfNaN(float[] a, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex>=0 && a.length-fromIndex>nativeMinLensPairOp[NT_FLOAT])
+            return ArraysNative.indexOfFloats(ArraysNative.cpuInfo,a,fromIndex,a.length-fromIndex,Float.NaN);
+        for (int k=fromIndex; k<a.length; k++) if (a[k]!=a[k]) return k; return -1;
+    }
+    public static int indexOfNaN(double[] a, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex>=0 && a.length-fromIndex>nativeMinLensPairOp[NT_DOUBLE])
+            return ArraysNative.indexOfDoubles(ArraysNative.cpuInfo,a,fromIndex,a.length-fromIndex,Double.NaN);
+        for (int k=fromIndex; k<a.length; k++) if (a[k]!=a[k]) return k; return -1;
+    }
+    public static int lastIndexOfNaN(float[] a, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex<a.length && fromIndex+1>nativeMinLensPairOp[NT_FLOAT])
+            return ArraysNative.lastIndexOfFloats(ArraysNative.cpuInfo,a,0,fromIndex+1,Float.NaN);
+        for (int k=fromIndex; k>=0; k--) if (a[k]!=a[k]) return k; return -1;
+    }
+    public static int lastIndexOfNaN(double[] a, int fromIndex) {
+        if (isNative && ArraysNative.searchImplemented && fromIndex<a.length && fromIndex+1>nativeMinLensPairOp[NT_DOUBLE])
+            return ArraysNative.lastIndexOfDoubles(ArraysNative.cpuInfo,a,0,fromIndex+1,Double.NaN);
+        for (int k=fromIndex; k>=0; k--) if (a[k]!=a[k]) return k; return -1;
+    }
+
 
     public static Object insert(Object a, int aofs, Object b) {
         return replace(a,aofs,0,b,0,length(b));
@@ -1875,6 +1966,713 @@ public final class Arrays implements TrueStatic {
     public static double sum(double[] a)  {double r= 0.0; for (int i=0;i<a.length;r+=a[i],i++); return r;}
 
 
+    // Minimum, maximum, indexes of their first occurrences and sum of a[ofs..ofs+len-1] in one pass:
+    // result[RANGE_MIN], result[RANGE_MAX], result[RANGE_MIN_INDEX], result[RANGE_MAX_INDEX], result[RANGE_SUM].
+    // The indexes are -1 if there are no elements. NaN elements are skipped by the minimum and maximum
+    // (the first of equal -0.0 and +0.0 is found), but are added to the sum. Integer sums are exact modulo 2^64
+    // (like the sum of Java longs); float and double sums are calculated in double and, in native code,
+    // in another order than in a simple loop, so the last bits may differ.
+    public static final int RANGE_MIN= 0, RANGE_MAX= 1, RANGE_MIN_INDEX= 2, RANGE_MAX_INDEX= 3, RANGE_SUM= 4;
+    public static final int RANGE_LENGTH= 5;
+
+    public static long[] range(byte[] a, int ofs, int len) {
+        long[] r= new long[RANGE_LENGTH];
+        if (isNative && ArraysNative.rangeImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRange(a.length,ofs,len);
+            ArraysNative.rangeBytes(ArraysNative.cpuInfo,a,ofs,len,r);
+            return r;
+        }
+        int minIndex= -1, maxIndex= -1;
+        long sum= 0;
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            byte v= a[k];
+            sum+= v;
+            if (minIndex<0 || v<a[minIndex]) minIndex= k;
+            if (maxIndex<0 || v>a[maxIndex]) maxIndex= k;
+        }
+        if (minIndex>=0) {r[RANGE_MIN]= a[minIndex]; r[RANGE_MAX]= a[maxIndex];}
+        r[RANGE_MIN_INDEX]= minIndex; r[RANGE_MAX_INDEX]= maxIndex; r[RANGE_SUM]= sum;
+        return r;
+    }
+    public static long[] range(char[] a, int ofs, int len) {
+        long[] r= new long[RANGE_LENGTH];
+        if (isNative && ArraysNative.rangeImplemented && len>nativeMinLensPairOp[NT_CHAR]) {
+            checkRange(a.length,ofs,len);
+            ArraysNative.rangeChars(ArraysNative.cpuInfo,a,ofs,len,r);
+            return r;
+        }
+        int minIndex= -1, maxIndex= -1;
+        long sum= 0;
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            char v= a[k];
+            sum+= v;
+            if (minIndex<0 || v<a[minIndex]) minIndex= k;
+            if (maxIndex<0 || v>a[maxIndex]) maxIndex= k;
+        }
+        if (minIndex>=0) {r[RANGE_MIN]= a[minIndex]; r[RANGE_MAX]= a[maxIndex];}
+        r[RANGE_MIN_INDEX]= minIndex; r[RANGE_MAX_INDEX]= maxIndex; r[RANGE_SUM]= sum;
+        return r;
+    }
+    public static long[] range(short[] a, int ofs, int len) {
+        long[] r= new long[RANGE_LENGTH];
+        if (isNative && ArraysNative.rangeImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRange(a.length,ofs,len);
+            ArraysNative.rangeShorts(ArraysNative.cpuInfo,a,ofs,len,r);
+            return r;
+        }
+        int minIndex= -1, maxIndex= -1;
+        long sum= 0;
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            short v= a[k];
+            sum+= v;
+            if (minIndex<0 || v<a[minIndex]) minIndex= k;
+            if (maxIndex<0 || v>a[maxIndex]) maxIndex= k;
+        }
+        if (minIndex>=0) {r[RANGE_MIN]= a[minIndex]; r[RANGE_MAX]= a[maxIndex];}
+        r[RANGE_MIN_INDEX]= minIndex; r[RANGE_MAX_INDEX]= maxIndex; r[RANGE_SUM]= sum;
+        return r;
+    }
+    public static long[] range(int[] a, int ofs, int len) {
+        long[] r= new long[RANGE_LENGTH];
+        if (isNative && ArraysNative.rangeImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRange(a.length,ofs,len);
+            ArraysNative.rangeInts(ArraysNative.cpuInfo,a,ofs,len,r);
+            return r;
+        }
+        int minIndex= -1, maxIndex= -1;
+        long sum= 0;
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            int v= a[k];
+            sum+= v;
+            if (minIndex<0 || v<a[minIndex]) minIndex= k;
+            if (maxIndex<0 || v>a[maxIndex]) maxIndex= k;
+        }
+        if (minIndex>=0) {r[RANGE_MIN]= a[minIndex]; r[RANGE_MAX]= a[maxIndex];}
+        r[RANGE_MIN_INDEX]= minIndex; r[RANGE_MAX_INDEX]= maxIndex; r[RANGE_SUM]= sum;
+        return r;
+    }
+    public static long[] range(long[] a, int ofs, int len) {
+        long[] r= new long[RANGE_LENGTH];
+        if (isNative && ArraysNative.rangeImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRange(a.length,ofs,len);
+            ArraysNative.rangeLongs(ArraysNative.cpuInfo,a,ofs,len,r);
+            return r;
+        }
+        int minIndex= -1, maxIndex= -1;
+        long sum= 0;
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            long v= a[k];
+            sum+= v;
+            if (minIndex<0 || v<a[minIndex]) minIndex= k;
+            if (maxIndex<0 || v>a[maxIndex]) maxIndex= k;
+        }
+        if (minIndex>=0) {r[RANGE_MIN]= a[minIndex]; r[RANGE_MAX]= a[maxIndex];}
+        r[RANGE_MIN_INDEX]= minIndex; r[RANGE_MAX_INDEX]= maxIndex; r[RANGE_SUM]= sum;
+        return r;
+    }
+    public static double[] range(float[] a, int ofs, int len) {
+        double[] r= new double[RANGE_LENGTH];
+        if (isNative && ArraysNative.rangeImplemented && len>nativeMinLensPairOp[NT_FLOAT]) {
+            checkRange(a.length,ofs,len);
+            ArraysNative.rangeFloats(ArraysNative.cpuInfo,a,ofs,len,r);
+            return r;
+        }
+        int minIndex= -1, maxIndex= -1;
+        double sum= 0;
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            float v= a[k];
+            sum+= v;
+            if (v!=v) continue;
+            if (minIndex<0 || v<a[minIndex]) minIndex= k;
+            if (maxIndex<0 || v>a[maxIndex]) maxIndex= k;
+        }
+        if (minIndex>=0) {r[RANGE_MIN]= a[minIndex]; r[RANGE_MAX]= a[maxIndex];}
+        r[RANGE_MIN_INDEX]= minIndex; r[RANGE_MAX_INDEX]= maxIndex; r[RANGE_SUM]= sum;
+        return r;
+    }
+    public static double[] range(double[] a, int ofs, int len) {
+        double[] r= new double[RANGE_LENGTH];
+        if (isNative && ArraysNative.rangeImplemented && len>nativeMinLensPairOp[NT_DOUBLE]) {
+            checkRange(a.length,ofs,len);
+            ArraysNative.rangeDoubles(ArraysNative.cpuInfo,a,ofs,len,r);
+            return r;
+        }
+        int minIndex= -1, maxIndex= -1;
+        double sum= 0;
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            double v= a[k];
+            sum+= v;
+            if (v!=v) continue;
+            if (minIndex<0 || v<a[minIndex]) minIndex= k;
+            if (maxIndex<0 || v>a[maxIndex]) maxIndex= k;
+        }
+        if (minIndex>=0) {r[RANGE_MIN]= a[minIndex]; r[RANGE_MAX]= a[maxIndex];}
+        r[RANGE_MIN_INDEX]= minIndex; r[RANGE_MAX_INDEX]= maxIndex; r[RANGE_SUM]= sum;
+        return r;
+    }
+
+    // Histograms: bars[v>>binShift]++ for every element v in ofs..ofs+len-1, where byte, char and short elements
+    // are unsigned (0..255, 0..65535) and int elements are signed; elements with v>>binShift out of
+    // 0..bars.length-1 (for example, negative ints) are skipped. The counts are added to bars, so one histogram
+    // may be accumulated over several arrays. binShift is 0..31.
+    public static long[] histogram(byte[] a, int ofs, int len)  {long[] r= new long[256]; histogram(a,ofs,len,r,0); return r;}
+    public static long[] histogram(char[] a, int ofs, int len)  {long[] r= new long[65536]; histogram(a,ofs,len,r,0); return r;}
+    public static long[] histogram(short[] a, int ofs, int len) {long[] r= new long[65536]; histogram(a,ofs,len,r,0); return r;}
+
+    public static void histogram(byte[] a, int ofs, int len, long[] bars, int binShift) {
+        checkHistogram(a.length,ofs,len,bars,binShift);
+        if (isNative && ArraysNative.histogramImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            ArraysNative.histogram(ArraysNative.cpuInfo,bars,a,ofs,len,binShift);
+            return;
+        }
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            int bin= (a[k]&0xFF)>>binShift;
+            if (bin<bars.length) bars[bin]++;
+        }
+    }
+    public static void histogram(char[] a, int ofs, int len, long[] bars, int binShift) {
+        checkHistogram(a.length,ofs,len,bars,binShift);
+        if (isNative && ArraysNative.histogramImplemented && len>nativeMinLensPairOp[NT_CHAR]) {
+            ArraysNative.histogram(ArraysNative.cpuInfo,bars,a,ofs,len,binShift);
+            return;
+        }
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            int bin= a[k]>>binShift;
+            if (bin<bars.length) bars[bin]++;
+        }
+    }
+    public static void histogram(short[] a, int ofs, int len, long[] bars, int binShift) {
+        checkHistogram(a.length,ofs,len,bars,binShift);
+        if (isNative && ArraysNative.histogramImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            ArraysNative.histogram(ArraysNative.cpuInfo,bars,a,ofs,len,binShift);
+            return;
+        }
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            int bin= (a[k]&0xFFFF)>>binShift;
+            if (bin<bars.length) bars[bin]++;
+        }
+    }
+    public static void histogram(int[] a, int ofs, int len, long[] bars, int binShift) {
+        checkHistogram(a.length,ofs,len,bars,binShift);
+        if (isNative && ArraysNative.histogramImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            ArraysNative.histogram(ArraysNative.cpuInfo,bars,a,ofs,len,binShift);
+            return;
+        }
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) {
+            int bin= a[k]>>binShift;
+            if (bin>=0 && bin<bars.length) bars[bin]++;
+        }
+    }
+    private static void checkHistogram(int arrayLength, int ofs, int len, long[] bars, int binShift) {
+        if (bars==null) throw new NullPointerException("Null bars argument in " + Arrays.class.getName() + ".histogram()");
+        if (binShift<0 || binShift>31) throw new IllegalArgumentException("Illegal binShift="+binShift+" in " + Arrays.class.getName() + ".histogram() (must be 0..31)");
+        if (len<0 || ofs<0 || ofs>arrayLength-len) throw new IndexOutOfBoundsException("Array range "+ofs+".."+((long)ofs+len-1)+" is out of 0.."+(arrayLength-1)+" in " + Arrays.class.getName() + ".histogram()");
+    }
+
+    // 3x3 filters of a dimX x dimY matrix, stored row by row in src[srcOfs..srcOfs+dimX*dimY-1]:
+    // every result element is calculated from the 3x3 square (or cross) around the same source element.
+    // Like in net.algart.matrices.filters3x3, the matrix is continued pseudo-cyclically (the left neighbour
+    // of the first column is the last column, the upper neighbour of the first row is the last row).
+    // byte, char and short elements are unsigned; float minimum and maximum are Math.min/max, so
+    // erosions, dilations and percentiles of squares (crosses) containing NaN are NaN.
+    // float averages and gradients are calculated in double and rounded to float once: the average is
+    // the double sum of 3 vertical sums (left, middle, right column) divided by 9, the gradient is
+    // (|right-left|+|down-up|)*0.5 in double. Like in net.algart.matrices.filters3x3, which also uses double here;
+    // only the order of additions in the average differs, which may change the last bit in rare cases.
+    // dest and src must not overlap.
+    public static final int FILTER3X3_EROSION_BY_SQUARE= 0;
+    public static final int FILTER3X3_DILATION_BY_SQUARE= 1;
+    public static final int FILTER3X3_EROSION_BY_CROSS= 2;
+    public static final int FILTER3X3_DILATION_BY_CROSS= 3;
+    public static final int FILTER3X3_AVERAGE_BY_SQUARE= 4;       // (sum+4)/9; float: sum/9 in double
+    public static final int FILTER3X3_PERCENTILE_BY_SQUARE= 5;    // the element #percentileIndex (0..8) of 9 sorted ones
+    public static final int FILTER3X3_QUICK_GRADIENT_BY_CROSS= 6; // (|right-left|+|down-up|)/2, integers rounded down
+
+    public static void filter3x3(byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int filter, int percentileIndex) {
+        checkFilter3x3(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,filter,percentileIndex);
+        if (isNative && ArraysNative.filter3x3Implemented && (long)dimX*dimY>nativeMinLensMatrix[NT_BYTE]) {
+            ArraysNative.filter3x3(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,filter,percentileIndex);
+            return;
+        }
+        int[] up= new int[dimX], middle= new int[dimX], down= new int[dimX], r= new int[dimX];
+        for (int y=0; y<dimY; y++) {
+            int ofs= srcOfs+(y>0? y-1: dimY-1)*dimX, ofsMiddle= srcOfs+y*dimX, ofsDown= srcOfs+(y<dimY-1? y+1: 0)*dimX;
+            for (int x=0; x<dimX; x++) {
+                up[x]= src[ofs+x]&0xFF; middle[x]= src[ofsMiddle+x]&0xFF; down[x]= src[ofsDown+x]&0xFF;
+            }
+            filter3x3Row(r,up,middle,down,dimX,filter,percentileIndex);
+            for (int x=0,k=destOfs+y*dimX; x<dimX; x++,k++) dest[k]= (byte)r[x];
+        }
+    }
+    public static void filter3x3(char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int filter, int percentileIndex) {
+        checkFilter3x3(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,filter,percentileIndex);
+        if (isNative && ArraysNative.filter3x3Implemented && (long)dimX*dimY>nativeMinLensMatrix[NT_CHAR]) {
+            ArraysNative.filter3x3(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,filter,percentileIndex);
+            return;
+        }
+        int[] up= new int[dimX], middle= new int[dimX], down= new int[dimX], r= new int[dimX];
+        for (int y=0; y<dimY; y++) {
+            int ofs= srcOfs+(y>0? y-1: dimY-1)*dimX, ofsMiddle= srcOfs+y*dimX, ofsDown= srcOfs+(y<dimY-1? y+1: 0)*dimX;
+            for (int x=0; x<dimX; x++) {
+                up[x]= src[ofs+x]; middle[x]= src[ofsMiddle+x]; down[x]= src[ofsDown+x];
+            }
+            filter3x3Row(r,up,middle,down,dimX,filter,percentileIndex);
+            for (int x=0,k=destOfs+y*dimX; x<dimX; x++,k++) dest[k]= (char)r[x];
+        }
+    }
+    public static void filter3x3(short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int filter, int percentileIndex) {
+        checkFilter3x3(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,filter,percentileIndex);
+        if (isNative && ArraysNative.filter3x3Implemented && (long)dimX*dimY>nativeMinLensMatrix[NT_SHORT]) {
+            ArraysNative.filter3x3(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,filter,percentileIndex);
+            return;
+        }
+        int[] up= new int[dimX], middle= new int[dimX], down= new int[dimX], r= new int[dimX];
+        for (int y=0; y<dimY; y++) {
+            int ofs= srcOfs+(y>0? y-1: dimY-1)*dimX, ofsMiddle= srcOfs+y*dimX, ofsDown= srcOfs+(y<dimY-1? y+1: 0)*dimX;
+            for (int x=0; x<dimX; x++) {
+                up[x]= src[ofs+x]&0xFFFF; middle[x]= src[ofsMiddle+x]&0xFFFF; down[x]= src[ofsDown+x]&0xFFFF;
+            }
+            filter3x3Row(r,up,middle,down,dimX,filter,percentileIndex);
+            for (int x=0,k=destOfs+y*dimX; x<dimX; x++,k++) dest[k]= (short)r[x];
+        }
+    }
+    public static void filter3x3(float[] dest, int destOfs, float[] src, int srcOfs, int dimX, int dimY, int filter, int percentileIndex) {
+        checkFilter3x3(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,filter,percentileIndex);
+        if (isNative && ArraysNative.filter3x3Implemented && (long)dimX*dimY>nativeMinLensMatrix[NT_FLOAT]) {
+            ArraysNative.filter3x3(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,filter,percentileIndex);
+            return;
+        }
+        float[] w= new float[9];
+        for (int y=0; y<dimY; y++) {
+            int u= srcOfs+(y>0? y-1: dimY-1)*dimX, m= srcOfs+y*dimX, d= srcOfs+(y<dimY-1? y+1: 0)*dimX;
+            for (int x=0,k=destOfs+y*dimX; x<dimX; x++,k++) {
+                int xl= x>0? x-1: dimX-1, xr= x<dimX-1? x+1: 0;
+                switch (filter) {
+                    case FILTER3X3_EROSION_BY_SQUARE:
+                        dest[k]= Math.min(Math.min(Math.min(src[u+xl],src[u+x]),Math.min(src[u+xr],src[d+xl])),
+                            Math.min(Math.min(src[d+x],src[d+xr]),Math.min(Math.min(src[m+xl],src[m+x]),src[m+xr])));
+                        break;
+                    case FILTER3X3_DILATION_BY_SQUARE:
+                        dest[k]= Math.max(Math.max(Math.max(src[u+xl],src[u+x]),Math.max(src[u+xr],src[d+xl])),
+                            Math.max(Math.max(src[d+x],src[d+xr]),Math.max(Math.max(src[m+xl],src[m+x]),src[m+xr])));
+                        break;
+                    case FILTER3X3_EROSION_BY_CROSS:
+                        dest[k]= Math.min(Math.min(src[u+x],src[d+x]),Math.min(Math.min(src[m+xl],src[m+x]),src[m+xr]));
+                        break;
+                    case FILTER3X3_DILATION_BY_CROSS:
+                        dest[k]= Math.max(Math.max(src[u+x],src[d+x]),Math.max(Math.max(src[m+xl],src[m+x]),src[m+xr]));
+                        break;
+                    case FILTER3X3_AVERAGE_BY_SQUARE:
+                        // the same order of additions as in the native code: 3 vertical sums, then left+middle+right
+                        dest[k]= (float)(((((double)src[u+xl]+src[m+xl])+src[d+xl])+(((double)src[u+x]+src[m+x])+src[d+x])
+                            +(((double)src[u+xr]+src[m+xr])+src[d+xr]))/9);
+                        break;
+                    case FILTER3X3_PERCENTILE_BY_SQUARE:
+                        w[0]= src[u+xl]; w[1]= src[u+x]; w[2]= src[u+xr];
+                        w[3]= src[m+xl]; w[4]= src[m+x]; w[5]= src[m+xr];
+                        w[6]= src[d+xl]; w[7]= src[d+x]; w[8]= src[d+xr];
+                        java.util.Arrays.sort(w); // NaN are the last ones
+                        dest[k]= w[8]!=w[8]? Float.NaN: w[percentileIndex];
+                        break;
+                    case FILTER3X3_QUICK_GRADIENT_BY_CROSS:
+                        dest[k]= (float)((Math.abs((double)src[m+xr]-src[m+xl])+Math.abs((double)src[d+x]-src[u+x]))*0.5);
+                        break;
+                }
+            }
+        }
+    }
+    // Unsigned integer values of 3 rows
+    private static void filter3x3Row(int[] r, int[] u, int[] m, int[] d, int dimX, int filter, int percentileIndex) {
+        int[] w= new int[9];
+        for (int x=0; x<dimX; x++) {
+            int xl= x>0? x-1: dimX-1, xr= x<dimX-1? x+1: 0;
+            switch (filter) {
+                case FILTER3X3_EROSION_BY_SQUARE:
+                    r[x]= Math.min(Math.min(Math.min(u[xl],u[x]),Math.min(u[xr],d[xl])),
+                        Math.min(Math.min(d[x],d[xr]),Math.min(Math.min(m[xl],m[x]),m[xr])));
+                    break;
+                case FILTER3X3_DILATION_BY_SQUARE:
+                    r[x]= Math.max(Math.max(Math.max(u[xl],u[x]),Math.max(u[xr],d[xl])),
+                        Math.max(Math.max(d[x],d[xr]),Math.max(Math.max(m[xl],m[x]),m[xr])));
+                    break;
+                case FILTER3X3_EROSION_BY_CROSS:
+                    r[x]= Math.min(Math.min(u[x],d[x]),Math.min(Math.min(m[xl],m[x]),m[xr]));
+                    break;
+                case FILTER3X3_DILATION_BY_CROSS:
+                    r[x]= Math.max(Math.max(u[x],d[x]),Math.max(Math.max(m[xl],m[x]),m[xr]));
+                    break;
+                case FILTER3X3_AVERAGE_BY_SQUARE:
+                    r[x]= (u[xl]+u[x]+u[xr]+m[xl]+m[x]+m[xr]+d[xl]+d[x]+d[xr]+4)/9;
+                    break;
+                case FILTER3X3_PERCENTILE_BY_SQUARE:
+                    w[0]= u[xl]; w[1]= u[x]; w[2]= u[xr];
+                    w[3]= m[xl]; w[4]= m[x]; w[5]= m[xr];
+                    w[6]= d[xl]; w[7]= d[x]; w[8]= d[xr];
+                    for (int i=1; i<9; i++) {
+                        int v= w[i], j= i;
+                        for (; j>0 && w[j-1]>v; j--) w[j]= w[j-1];
+                        w[j]= v;
+                    }
+                    r[x]= w[percentileIndex];
+                    break;
+                case FILTER3X3_QUICK_GRADIENT_BY_CROSS:
+                    r[x]= (Math.abs(m[xr]-m[xl])+Math.abs(d[x]-u[x]))>>1;
+                    break;
+            }
+        }
+    }
+    private static void checkFilter3x3(Object dest, int destLength, int destOfs, Object src, int srcLength, int srcOfs,
+        int dimX, int dimY, int filter, int percentileIndex)
+    {
+        if (filter<FILTER3X3_EROSION_BY_SQUARE || filter>FILTER3X3_QUICK_GRADIENT_BY_CROSS) throw new IllegalArgumentException("Unknown filter="+filter+" in " + Arrays.class.getName() + ".filter3x3()");
+        if (filter==FILTER3X3_PERCENTILE_BY_SQUARE && (percentileIndex<0 || percentileIndex>8)) throw new IllegalArgumentException("Illegal percentileIndex="+percentileIndex+" in " + Arrays.class.getName() + ".filter3x3() (must be 0..8)");
+        if (dimX<0 || dimY<0) throw new IllegalArgumentException("Negative matrix dimensions "+dimX+"x"+dimY+" in " + Arrays.class.getName() + ".filter3x3()");
+        long len= (long)dimX*dimY;
+        if (srcOfs<0 || srcOfs>srcLength-len) throw new IndexOutOfBoundsException("Source range "+srcOfs+".."+(srcOfs+len-1)+" is out of 0.."+(srcLength-1)+" in " + Arrays.class.getName() + ".filter3x3()");
+        if (destOfs<0 || destOfs>destLength-len) throw new IndexOutOfBoundsException("Destination range "+destOfs+".."+(destOfs+len-1)+" is out of 0.."+(destLength-1)+" in " + Arrays.class.getName() + ".filter3x3()");
+        if (dest==src && len>0 && destOfs<srcOfs+len && srcOfs<destOfs+len) throw new IllegalArgumentException("Overlapping source and destination in " + Arrays.class.getName() + ".filter3x3()");
+    }
+
+    // Rank filters of a dimX x dimY matrix, stored row by row in src[srcOfs..srcOfs+dimX*dimY-1], by the rectangular
+    // aperture x-apertureDimX/2..x-apertureDimX/2+apertureDimX-1, y-apertureDimY/2..y-apertureDimY/2+apertureDimY-1;
+    // the matrix is continued pseudo-cyclically, like in filter3x3. byte, char and short elements are unsigned.
+    // The native code uses column histograms (Perreault-Hebert), so its time per element doesn't depend on the aperture size.
+    // percentileIndex, fromIndex and toIndex are indexes in the sorted apertureDimX*apertureDimY aperture elements;
+    // the mean between percentiles is the mean of the sorted elements #fromIndex..toIndex-1, rounded to the nearest integer.
+    // dest and src must not overlap; apertureDimY must be <=65535.
+    public static final int RANK_PERCENTILE= 0;
+    public static final int RANK_MEAN_BETWEEN_PERCENTILES= 1;
+
+    public static void percentileByRectangle(byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int percentileIndex) {
+        rankByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,RANK_PERCENTILE,percentileIndex,percentileIndex+1);
+    }
+    public static void percentileByRectangle(char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int percentileIndex) {
+        rankByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,RANK_PERCENTILE,percentileIndex,percentileIndex+1);
+    }
+    public static void percentileByRectangle(short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int percentileIndex) {
+        rankByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,RANK_PERCENTILE,percentileIndex,percentileIndex+1);
+    }
+    public static void meanBetweenPercentilesByRectangle(byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int fromIndex, int toIndex) {
+        rankByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,RANK_MEAN_BETWEEN_PERCENTILES,fromIndex,toIndex);
+    }
+    public static void meanBetweenPercentilesByRectangle(char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int fromIndex, int toIndex) {
+        rankByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,RANK_MEAN_BETWEEN_PERCENTILES,fromIndex,toIndex);
+    }
+    public static void meanBetweenPercentilesByRectangle(short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int fromIndex, int toIndex) {
+        rankByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,RANK_MEAN_BETWEEN_PERCENTILES,fromIndex,toIndex);
+    }
+
+    private static void rankByRectangle(byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int mode, int fromIndex, int toIndex) {
+        checkRank(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY,mode,fromIndex,toIndex);
+        if (isNative && ArraysNative.rankImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_BYTE]) {
+            ArraysNative.rank(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,mode,fromIndex,toIndex);
+            return;
+        }
+        int[] values= new int[dimX*dimY];
+        for (int k=0; k<values.length; k++) values[k]= src[srcOfs+k]&0xFF;
+        rankInts(values,dimX,dimY,apertureDimX,apertureDimY,mode,fromIndex,toIndex,8);
+        for (int k=0; k<values.length; k++) dest[destOfs+k]= (byte)values[k];
+    }
+    private static void rankByRectangle(char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int mode, int fromIndex, int toIndex) {
+        checkRank(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY,mode,fromIndex,toIndex);
+        if (isNative && ArraysNative.rankImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_CHAR]) {
+            ArraysNative.rank(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,mode,fromIndex,toIndex);
+            return;
+        }
+        int[] values= new int[dimX*dimY];
+        for (int k=0; k<values.length; k++) values[k]= src[srcOfs+k];
+        rankInts(values,dimX,dimY,apertureDimX,apertureDimY,mode,fromIndex,toIndex,16);
+        for (int k=0; k<values.length; k++) dest[destOfs+k]= (char)values[k];
+    }
+    private static void rankByRectangle(short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int mode, int fromIndex, int toIndex) {
+        checkRank(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY,mode,fromIndex,toIndex);
+        if (isNative && ArraysNative.rankImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_SHORT]) {
+            ArraysNative.rank(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,mode,fromIndex,toIndex);
+            return;
+        }
+        int[] values= new int[dimX*dimY];
+        for (int k=0; k<values.length; k++) values[k]= src[srcOfs+k]&0xFFFF;
+        rankInts(values,dimX,dimY,apertureDimX,apertureDimY,mode,fromIndex,toIndex,16);
+        for (int k=0; k<values.length; k++) dest[destOfs+k]= (short)values[k];
+    }
+    // Replaces the unsigned bits-bit values with the results: the histogram of the aperture slides along every row
+    // (coarse bars of 16 fine ones, with sums of elements for the means), so the time per element is O(apertureDimY)
+    private static void rankInts(int[] values, int dimX, int dimY, int apertureDimX, int apertureDimY, int mode, int fromIndex, int toIndex, int bits) {
+        if (values.length==0) return;
+        int[] bars= new int[1<<bits], coarse= new int[(1<<bits)>>4];
+        long[] sums= new long[coarse.length];
+        int[] columns= new int[dimX+apertureDimX-1], rows= new int[apertureDimY];
+        for (int c=0; c<columns.length; c++) columns[c]= (int)(((long)c-apertureDimX/2)%dimX+dimX)%dimX;
+        int[] result= new int[values.length];
+        for (int y=0; y<dimY; y++) {
+            for (int j=0; j<apertureDimY; j++) rows[j]= (int)((((long)y-apertureDimY/2+j)%dimY+dimY)%dimY)*dimX;
+            java.util.Arrays.fill(bars,0); java.util.Arrays.fill(coarse,0); java.util.Arrays.fill(sums,0);
+            for (int c=0; c<apertureDimX; c++) {
+                for (int j=0; j<apertureDimY; j++) {
+                    int v= values[rows[j]+columns[c]];
+                    bars[v]++; coarse[v>>4]++; sums[v>>4]+= v;
+                }
+            }
+            for (int x=0; x<dimX; x++) {
+                if (x>0) {
+                    for (int j=0; j<apertureDimY; j++) {
+                        int v= values[rows[j]+columns[x-1]];
+                        bars[v]--; coarse[v>>4]--; sums[v>>4]-= v;
+                        v= values[rows[j]+columns[x+apertureDimX-1]];
+                        bars[v]++; coarse[v>>4]++; sums[v>>4]+= v;
+                    }
+                }
+                if (mode==RANK_PERCENTILE) {
+                    long acc= 0;
+                    int b= 0;
+                    while (acc+coarse[b]<=fromIndex) acc+= coarse[b++];
+                    int v= b<<4;
+                    while (acc+bars[v]<=fromIndex) acc+= bars[v++];
+                    result[y*dimX+x]= v;
+                } else {
+                    long n= toIndex-fromIndex;
+                    long s= rankLeastSum(bars,coarse,sums,toIndex)-rankLeastSum(bars,coarse,sums,fromIndex);
+                    result[y*dimX+x]= (int)((2*s+n)/(2*n));
+                }
+            }
+        }
+        System.arraycopy(result,0,values,0,values.length);
+    }
+    private static long rankLeastSum(int[] bars, int[] coarse, long[] sums, int k) {
+        long acc= 0, sum= 0;
+        int b= 0;
+        while (b<coarse.length && acc+coarse[b]<=k) {acc+= coarse[b]; sum+= sums[b++];}
+        if (acc==k) return sum;
+        int v= b<<4;
+        for (; acc+bars[v]<=k; v++) {acc+= bars[v]; sum+= (long)bars[v]*v;}
+        return sum+(k-acc)*v;
+    }
+    private static void checkRank(Object dest, int destLength, int destOfs, Object src, int srcLength, int srcOfs,
+        int dimX, int dimY, int apertureDimX, int apertureDimY, int mode, int fromIndex, int toIndex)
+    {
+        if (dimX<0 || dimY<0) throw new IllegalArgumentException("Negative matrix dimensions "+dimX+"x"+dimY+" in " + Arrays.class.getName() + ".rankByRectangle()");
+        if (apertureDimX<1 || apertureDimY<1 || apertureDimY>65535 || (long)apertureDimX*apertureDimY>Integer.MAX_VALUE) throw new IllegalArgumentException("Illegal aperture "+apertureDimX+"x"+apertureDimY+" in " + Arrays.class.getName() + ".rankByRectangle()");
+        int n= apertureDimX*apertureDimY;
+        if (fromIndex<0 || toIndex<=fromIndex || toIndex>n || (mode==RANK_PERCENTILE && toIndex!=fromIndex+1)) throw new IllegalArgumentException("Illegal percentile indexes "+fromIndex+".."+(toIndex-1)+" in " + Arrays.class.getName() + ".rankByRectangle() (must be in 0.."+(n-1)+")");
+        long len= (long)dimX*dimY;
+        if (srcOfs<0 || srcOfs>srcLength-len) throw new IndexOutOfBoundsException("Source range "+srcOfs+".."+(srcOfs+len-1)+" is out of 0.."+(srcLength-1)+" in " + Arrays.class.getName() + ".rankByRectangle()");
+        if (destOfs<0 || destOfs>destLength-len) throw new IndexOutOfBoundsException("Destination range "+destOfs+".."+(destOfs+len-1)+" is out of 0.."+(destLength-1)+" in " + Arrays.class.getName() + ".rankByRectangle()");
+        if (dest==src && len>0 && destOfs<srcOfs+len && srcOfs<destOfs+len) throw new IllegalArgumentException("Overlapping source and destination in " + Arrays.class.getName() + ".rankByRectangle()");
+    }
+
+
+    // Erosion (minimum) and dilation (maximum) of a dimX x dimY matrix, stored row by row in src[srcOfs..srcOfs+dimX*dimY-1],
+    // by the rectangular aperture of percentileByRectangle, with the same pseudo-cyclic continuation. byte, char and short
+    // elements are unsigned, float and double ones are compared like in Math.min/max. The rectangle is processed as
+    // a vertical and a horizontal segment by the van Herk / Gil-Werman algorithm (3 comparisons per element for any
+    // segment length), so the time per element doesn't depend on the aperture size. dest and src must not overlap.
+    public static void erosionByRectangle(byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,false);
+    }
+    public static void erosionByRectangle(char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,false);
+    }
+    public static void erosionByRectangle(short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,false);
+    }
+    public static void erosionByRectangle(int[] dest, int destOfs, int[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,false);
+    }
+    public static void erosionByRectangle(long[] dest, int destOfs, long[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,false);
+    }
+    public static void erosionByRectangle(float[] dest, int destOfs, float[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,false);
+    }
+    public static void erosionByRectangle(double[] dest, int destOfs, double[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,false);
+    }
+    public static void dilationByRectangle(byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,true);
+    }
+    public static void dilationByRectangle(char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,true);
+    }
+    public static void dilationByRectangle(short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,true);
+    }
+    public static void dilationByRectangle(int[] dest, int destOfs, int[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,true);
+    }
+    public static void dilationByRectangle(long[] dest, int destOfs, long[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,true);
+    }
+    public static void dilationByRectangle(float[] dest, int destOfs, float[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,true);
+    }
+    public static void dilationByRectangle(double[] dest, int destOfs, double[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY) {
+        morphologyByRectangle(dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,true);
+    }
+
+    private static void morphologyByRectangle(byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        checkMorphology(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY);
+        if (isNative && ArraysNative.morphologyImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_BYTE]) {
+            ArraysNative.morphology(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+            return;
+        }
+        int[] values= new int[dimX*dimY];
+        for (int k=0; k<values.length; k++) values[k]= src[srcOfs+k]&0xFF;
+        morphologyInts(values,0,dimX,dimY,apertureDimX,apertureDimY,dilation);
+        for (int k=0; k<values.length; k++) dest[destOfs+k]= (byte)values[k];
+    }
+    private static void morphologyByRectangle(char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        checkMorphology(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY);
+        if (isNative && ArraysNative.morphologyImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_CHAR]) {
+            ArraysNative.morphology(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+            return;
+        }
+        int[] values= new int[dimX*dimY];
+        for (int k=0; k<values.length; k++) values[k]= src[srcOfs+k];
+        morphologyInts(values,0,dimX,dimY,apertureDimX,apertureDimY,dilation);
+        for (int k=0; k<values.length; k++) dest[destOfs+k]= (char)values[k];
+    }
+    private static void morphologyByRectangle(short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        checkMorphology(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY);
+        if (isNative && ArraysNative.morphologyImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_SHORT]) {
+            ArraysNative.morphology(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+            return;
+        }
+        int[] values= new int[dimX*dimY];
+        for (int k=0; k<values.length; k++) values[k]= src[srcOfs+k]&0xFFFF;
+        morphologyInts(values,0,dimX,dimY,apertureDimX,apertureDimY,dilation);
+        for (int k=0; k<values.length; k++) dest[destOfs+k]= (short)values[k];
+    }
+    private static void morphologyByRectangle(int[] dest, int destOfs, int[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        checkMorphology(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY);
+        if (isNative && ArraysNative.morphologyImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_INT]) {
+            ArraysNative.morphology(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+            return;
+        }
+        System.arraycopy(src,srcOfs,dest,destOfs,dimX*dimY);
+        morphologyInts(dest,destOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+    }
+    private static void morphologyByRectangle(long[] dest, int destOfs, long[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        checkMorphology(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY);
+        if (isNative && ArraysNative.morphologyImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_LONG]) {
+            ArraysNative.morphology(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+            return;
+        }
+        System.arraycopy(src,srcOfs,dest,destOfs,dimX*dimY);
+        morphologyLongs(dest,destOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+    }
+    private static void morphologyByRectangle(float[] dest, int destOfs, float[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        checkMorphology(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY);
+        if (isNative && ArraysNative.morphologyImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_FLOAT]) {
+            ArraysNative.morphology(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+            return;
+        }
+        double[] values= new double[dimX*dimY];
+        for (int k=0; k<values.length; k++) values[k]= src[srcOfs+k];
+        morphologyDoubles(values,0,dimX,dimY,apertureDimX,apertureDimY,dilation);
+        for (int k=0; k<values.length; k++) dest[destOfs+k]= (float)values[k];
+    }
+    private static void morphologyByRectangle(double[] dest, int destOfs, double[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        checkMorphology(dest,dest.length,destOfs,src,src.length,srcOfs,dimX,dimY,apertureDimX,apertureDimY);
+        if (isNative && ArraysNative.morphologyImplemented && (long)dimX*dimY>nativeMinLensMatrix[NT_DOUBLE]) {
+            ArraysNative.morphology(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+            return;
+        }
+        System.arraycopy(src,srcOfs,dest,destOfs,dimX*dimY);
+        morphologyDoubles(dest,destOfs,dimX,dimY,apertureDimX,apertureDimY,dilation);
+    }
+    private static void morphologyInts(int[] a, int ofs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        if (dimX==0 || dimY==0) return;
+        int ax= Math.min(apertureDimX,dimX), ay= Math.min(apertureDimY,dimY);
+        int[] line= new int[Math.max(dimX,dimY)], s= new int[line.length+Math.max(ax,ay)], h= new int[s.length];
+        for (int x=0; x<dimX; x++) {
+            for (int y=0; y<dimY; y++) line[y]= a[ofs+y*dimX+x];
+            morphologyLine(line,dimY,ay,dilation,s,h);
+            for (int y=0; y<dimY; y++) a[ofs+y*dimX+x]= line[y];
+        }
+        for (int y=0; y<dimY; y++) {
+            System.arraycopy(a,ofs+y*dimX,line,0,dimX);
+            morphologyLine(line,dimX,ax,dilation,s,h);
+            System.arraycopy(line,0,a,ofs+y*dimX,dimX);
+        }
+    }
+    private static void morphologyLine(int[] line, int len, int aperture, boolean dilation, int[] s, int[] h) {
+        if (aperture==1) return;
+        int ext= len+aperture-1;
+        for (int e=0; e<ext; e++) s[e]= line[(int)((((long)e-aperture/2)%len+len)%len)];
+        h[ext-1]= s[ext-1];
+        for (int e=ext-2; e>=0; e--) h[e]= e%aperture==aperture-1? s[e]: dilation? Math.max(s[e],h[e+1]): Math.min(s[e],h[e+1]);
+        int g= s[0];
+        for (int e=0; e<ext; e++) {
+            g= e%aperture==0? s[e]: dilation? Math.max(g,s[e]): Math.min(g,s[e]);
+            if (e>=aperture-1) line[e-aperture+1]= dilation? Math.max(h[e-aperture+1],g): Math.min(h[e-aperture+1],g);
+        }
+    }
+    private static void morphologyLongs(long[] a, int ofs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        if (dimX==0 || dimY==0) return;
+        int ax= Math.min(apertureDimX,dimX), ay= Math.min(apertureDimY,dimY);
+        long[] line= new long[Math.max(dimX,dimY)], s= new long[line.length+Math.max(ax,ay)], h= new long[s.length];
+        for (int x=0; x<dimX; x++) {
+            for (int y=0; y<dimY; y++) line[y]= a[ofs+y*dimX+x];
+            morphologyLine(line,dimY,ay,dilation,s,h);
+            for (int y=0; y<dimY; y++) a[ofs+y*dimX+x]= line[y];
+        }
+        for (int y=0; y<dimY; y++) {
+            System.arraycopy(a,ofs+y*dimX,line,0,dimX);
+            morphologyLine(line,dimX,ax,dilation,s,h);
+            System.arraycopy(line,0,a,ofs+y*dimX,dimX);
+        }
+    }
+    private static void morphologyLine(long[] line, int len, int aperture, boolean dilation, long[] s, long[] h) {
+        if (aperture==1) return;
+        int ext= len+aperture-1;
+        for (int e=0; e<ext; e++) s[e]= line[(int)((((long)e-aperture/2)%len+len)%len)];
+        h[ext-1]= s[ext-1];
+        for (int e=ext-2; e>=0; e--) h[e]= e%aperture==aperture-1? s[e]: dilation? Math.max(s[e],h[e+1]): Math.min(s[e],h[e+1]);
+        long g= s[0];
+        for (int e=0; e<ext; e++) {
+            g= e%aperture==0? s[e]: dilation? Math.max(g,s[e]): Math.min(g,s[e]);
+            if (e>=aperture-1) line[e-aperture+1]= dilation? Math.max(h[e-aperture+1],g): Math.min(h[e-aperture+1],g);
+        }
+    }
+    private static void morphologyDoubles(double[] a, int ofs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation) {
+        if (dimX==0 || dimY==0) return;
+        int ax= Math.min(apertureDimX,dimX), ay= Math.min(apertureDimY,dimY);
+        double[] line= new double[Math.max(dimX,dimY)], s= new double[line.length+Math.max(ax,ay)], h= new double[s.length];
+        for (int x=0; x<dimX; x++) {
+            for (int y=0; y<dimY; y++) line[y]= a[ofs+y*dimX+x];
+            morphologyLine(line,dimY,ay,dilation,s,h);
+            for (int y=0; y<dimY; y++) a[ofs+y*dimX+x]= line[y];
+        }
+        for (int y=0; y<dimY; y++) {
+            System.arraycopy(a,ofs+y*dimX,line,0,dimX);
+            morphologyLine(line,dimX,ax,dilation,s,h);
+            System.arraycopy(line,0,a,ofs+y*dimX,dimX);
+        }
+    }
+    private static void morphologyLine(double[] line, int len, int aperture, boolean dilation, double[] s, double[] h) {
+        if (aperture==1) return;
+        int ext= len+aperture-1;
+        for (int e=0; e<ext; e++) s[e]= line[(int)((((long)e-aperture/2)%len+len)%len)];
+        h[ext-1]= s[ext-1];
+        for (int e=ext-2; e>=0; e--) h[e]= e%aperture==aperture-1? s[e]: dilation? Math.max(s[e],h[e+1]): Math.min(s[e],h[e+1]);
+        double g= s[0];
+        for (int e=0; e<ext; e++) {
+            g= e%aperture==0? s[e]: dilation? Math.max(g,s[e]): Math.min(g,s[e]);
+            if (e>=aperture-1) line[e-aperture+1]= dilation? Math.max(h[e-aperture+1],g): Math.min(h[e-aperture+1],g);
+        }
+    }
+    private static void checkMorphology(Object dest, int destLength, int destOfs, Object src, int srcLength, int srcOfs,
+        int dimX, int dimY, int apertureDimX, int apertureDimY)
+    {
+        if (dimX<0 || dimY<0) throw new IllegalArgumentException("Negative matrix dimensions "+dimX+"x"+dimY+" in " + Arrays.class.getName() + ".morphologyByRectangle()");
+        if (apertureDimX<1 || apertureDimY<1) throw new IllegalArgumentException("Illegal aperture "+apertureDimX+"x"+apertureDimY+" in " + Arrays.class.getName() + ".morphologyByRectangle()");
+        long len= (long)dimX*dimY;
+        if (srcOfs<0 || srcOfs>srcLength-len) throw new IndexOutOfBoundsException("Source range "+srcOfs+".."+(srcOfs+len-1)+" is out of 0.."+(srcLength-1)+" in " + Arrays.class.getName() + ".morphologyByRectangle()");
+        if (destOfs<0 || destOfs>destLength-len) throw new IndexOutOfBoundsException("Destination range "+destOfs+".."+(destOfs+len-1)+" is out of 0.."+(destLength-1)+" in " + Arrays.class.getName() + ".morphologyByRectangle()");
+        if (dest==src && len>0 && destOfs<srcOfs+len && srcOfs<destOfs+len) throw new IllegalArgumentException("Overlapping source and destination in " + Arrays.class.getName() + ".morphologyByRectangle()");
+    }
+
+
     public static void min(Object a, Object b) throws Exception {
         min(a,0,b,0,min(Array.getLength(a),Array.getLength(b)));
     }
@@ -1882,29 +2680,31 @@ public final class Arrays implements TrueStatic {
         max(a,0,b,0,min(Array.getLength(a),Array.getLength(b)));
     }
     public static void min(Object a, int aofs, Object b, int bofs, int len) throws Exception {
-        if (a instanceof byte[]) min((byte[])a,aofs,(byte[])b,bofs,len);
+        if (b instanceof Buffer) min(a,aofs,(Buffer)b,bofs,len);
+        else if (a instanceof byte[]) min((byte[])a,aofs,(byte[])b,bofs,len);
+        else if (a instanceof char[]) min((char[])a,aofs,(char[])b,bofs,len);
         else if (a instanceof short[]) min((short[])a,aofs,(short[])b,bofs,len);
         else if (a instanceof int[]) min((int[])a,aofs,(int[])b,bofs,len);
         else if (a instanceof long[]) min((long[])a,aofs,(long[])b,bofs,len);
         else if (a instanceof float[]) min((float[])a,aofs,(float[])b,bofs,len);
         else if (a instanceof double[]) min((double[])a,aofs,(double[])b,bofs,len);
-        else if (a instanceof ByteBuffer) min((ByteBuffer)a,aofs,(ByteBuffer)b,bofs,len);
         else throw new IllegalArgumentException("Unsupported argument type in " + Arrays.class.getName() + ".min(): "+JVM.toJavaClassName(a));
     }
     public static void max(Object a, int aofs, Object b, int bofs, int len) throws Exception {
-        if (a instanceof byte[]) max((byte[])a,aofs,(byte[])b,bofs,len);
+        if (b instanceof Buffer) max(a,aofs,(Buffer)b,bofs,len);
+        else if (a instanceof byte[]) max((byte[])a,aofs,(byte[])b,bofs,len);
+        else if (a instanceof char[]) max((char[])a,aofs,(char[])b,bofs,len);
         else if (a instanceof short[]) max((short[])a,aofs,(short[])b,bofs,len);
         else if (a instanceof int[]) max((int[])a,aofs,(int[])b,bofs,len);
         else if (a instanceof long[]) max((long[])a,aofs,(long[])b,bofs,len);
         else if (a instanceof float[]) max((float[])a,aofs,(float[])b,bofs,len);
         else if (a instanceof double[]) max((double[])a,aofs,(double[])b,bofs,len);
-        else if (a instanceof ByteBuffer) max((ByteBuffer)a,aofs,(ByteBuffer)b,bofs,len);
         else throw new IllegalArgumentException("Unsupported argument type in " + Arrays.class.getName() + ".max(): "+JVM.toJavaClassName(a));
     }
 
     public static void min(byte[] a, int aofs, byte[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>=nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1]; //avoiding GPF
+        if (isNative && ArraysNative.minmaxImplemented && len>=nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.min(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -1917,8 +2717,8 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]>b[bofs]) a[aofs]=b[bofs];
     }
     public static void max(byte[] a, int aofs, byte[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>=nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1];
+        if (isNative && ArraysNative.minmaxImplemented && len>=nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.max(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -1932,8 +2732,8 @@ public final class Arrays implements TrueStatic {
     }
 
     public static void min(ByteBuffer a, int aofs, ByteBuffer b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp && a.isDirect() && b.isDirect()) {
-            boolean check= a.get(aofs)<b.get(bofs) && a.get(aofs+len-1)<b.get(bofs+len-1); //avoiding GPF
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_BYTE] && a.isDirect() && b.isDirect()) {
+            checkBuffer(a,aofs,len,true); checkBuffer(b,bofs,len,false);
             ArraysNative.min(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -1946,8 +2746,8 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a.get(aofs)>b.get(bofs)) a.put(aofs,b.get(bofs));
     }
     public static void max(ByteBuffer a, int aofs, ByteBuffer b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp && a.isDirect() && b.isDirect()) {
-            boolean check= a.get(aofs)<b.get(bofs) && a.get(aofs+len-1)<b.get(bofs+len-1); //avoiding GPF
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_BYTE] && a.isDirect() && b.isDirect()) {
+            checkBuffer(a,aofs,len,true); checkBuffer(b,bofs,len,false);
             ArraysNative.max(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -1960,9 +2760,9 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a.get(aofs)<b.get(bofs)) a.put(aofs,b.get(bofs));
     }
 
-    public static void min(short[] a, int aofs, short[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1]; //avoiding GPF
+    public static void min(char[] a, int aofs, char[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_CHAR]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.min(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -1974,9 +2774,9 @@ public final class Arrays implements TrueStatic {
         }
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]>b[bofs]) a[aofs]=b[bofs];
     }
-    public static void max(short[] a, int aofs, short[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1];
+    public static void max(char[] a, int aofs, char[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_CHAR]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.max(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -1989,9 +2789,9 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]<b[bofs]) a[aofs]=b[bofs];
     }
 
-    public static void min(int[] a, int aofs, int[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1]; //avoiding GPF
+    public static void min(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.min(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2003,9 +2803,9 @@ public final class Arrays implements TrueStatic {
         }
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]>b[bofs]) a[aofs]=b[bofs];
     }
-    public static void max(int[] a, int aofs, int[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1];
+    public static void max(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.max(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2018,9 +2818,9 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]<b[bofs]) a[aofs]=b[bofs];
     }
 
-    public static void min(long[] a, int aofs, long[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1]; //avoiding GPF
+    public static void min(int[] a, int aofs, int[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.min(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2032,9 +2832,9 @@ public final class Arrays implements TrueStatic {
         }
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]>b[bofs]) a[aofs]=b[bofs];
     }
-    public static void max(long[] a, int aofs, long[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1];
+    public static void max(int[] a, int aofs, int[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.max(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2047,9 +2847,9 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]<b[bofs]) a[aofs]=b[bofs];
     }
 
-    public static void min(float[] a, int aofs, float[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1]; //avoiding GPF
+    public static void min(long[] a, int aofs, long[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.min(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2061,9 +2861,9 @@ public final class Arrays implements TrueStatic {
         }
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]>b[bofs]) a[aofs]=b[bofs];
     }
-    public static void max(float[] a, int aofs, float[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1];
+    public static void max(long[] a, int aofs, long[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.max(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2076,33 +2876,38 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]<b[bofs]) a[aofs]=b[bofs];
     }
 
-    public static void min(double[] a, int aofs, double[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1]; //avoiding GPF
+    public static void min(float[] a, int aofs, float[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_FLOAT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.min(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
-        int aofsmax=aofs+len-3;
-        for (; aofs<aofsmax; aofs+=4,bofs+=4) {
-            if (a[aofs]>b[bofs]) a[aofs]=b[bofs];
-            if (a[aofs+1]>b[bofs+1]) a[aofs+1]=b[bofs+1];
-            if (a[aofs+2]>b[bofs+2]) a[aofs+2]=b[bofs+2];
-            if (a[aofs+3]>b[bofs+3]) a[aofs+3]=b[bofs+3];
+        // Java Math.min semantics: NaN if any argument is NaN, -0.0 is less than +0.0
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= Math.min(a[aofs],b[bofs]);
+    }
+    public static void max(float[] a, int aofs, float[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_FLOAT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.max(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
-        for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]>b[bofs]) a[aofs]=b[bofs];
+        // Java Math.max semantics: NaN if any argument is NaN, -0.0 is less than +0.0
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= Math.max(a[aofs],b[bofs]);
+    }
+
+    public static void min(double[] a, int aofs, double[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_DOUBLE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.min(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        // Java Math.min semantics: NaN if any argument is NaN, -0.0 is less than +0.0
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= Math.min(a[aofs],b[bofs]);
     }
     public static void max(double[] a, int aofs, double[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1];
+        if (isNative && ArraysNative.minmaxImplemented && len>nativeMinLensPairOp[NT_DOUBLE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.max(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
-        int aofsmax=aofs+len-3;
-        for (; aofs<aofsmax; aofs+=4,bofs+=4) {
-            if (a[aofs]<b[bofs]) a[aofs]=b[bofs];
-            if (a[aofs+1]<b[bofs+1]) a[aofs+1]=b[bofs+1];
-            if (a[aofs+2]<b[bofs+2]) a[aofs+2]=b[bofs+2];
-            if (a[aofs+3]<b[bofs+3]) a[aofs+3]=b[bofs+3];
-        }
-        for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if (a[aofs]<b[bofs]) a[aofs]=b[bofs];
+        // Java Math.max semantics: NaN if any argument is NaN, -0.0 is less than +0.0
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= Math.max(a[aofs],b[bofs]);
     }
 
     public static void minu(Object a, Object b) throws Exception {
@@ -2112,21 +2917,25 @@ public final class Arrays implements TrueStatic {
         maxu(a,0,b,0,min(Array.getLength(a),Array.getLength(b)));
     }
     public static void minu(Object a, int aofs, Object b, int bofs, int len) throws Exception {
-        if (a instanceof byte[]) minu((byte[])a,aofs,(byte[])b,bofs,len);
+        if (b instanceof Buffer) minu(a,aofs,(Buffer)b,bofs,len);
+        else if (a instanceof byte[]) minu((byte[])a,aofs,(byte[])b,bofs,len);
         else if (a instanceof short[]) minu((short[])a,aofs,(short[])b,bofs,len);
-        else if (a instanceof ByteBuffer) minu((ByteBuffer)a,aofs,(ByteBuffer)b,bofs,len);
+        else if (a instanceof int[]) minu((int[])a,aofs,(int[])b,bofs,len);
+        else if (a instanceof long[]) minu((long[])a,aofs,(long[])b,bofs,len);
         else min(a,aofs,b,bofs,len);
     }
     public static void maxu(Object a, int aofs, Object b, int bofs, int len) throws Exception {
-        if (a instanceof byte[]) maxu((byte[])a,aofs,(byte[])b,bofs,len);
+        if (b instanceof Buffer) maxu(a,aofs,(Buffer)b,bofs,len);
+        else if (a instanceof byte[]) maxu((byte[])a,aofs,(byte[])b,bofs,len);
         else if (a instanceof short[]) maxu((short[])a,aofs,(short[])b,bofs,len);
-        else if (a instanceof ByteBuffer) maxu((ByteBuffer)a,aofs,(ByteBuffer)b,bofs,len);
+        else if (a instanceof int[]) maxu((int[])a,aofs,(int[])b,bofs,len);
+        else if (a instanceof long[]) maxu((long[])a,aofs,(long[])b,bofs,len);
         else max(a,aofs,b,bofs,len);
     }
 
     public static void minu(byte[] a, int aofs, byte[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1]; //avoiding GPF
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.minu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2139,8 +2948,8 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if ((a[aofs]&0xFF)>(b[bofs]&0xFF)) a[aofs]=b[bofs];
     }
     public static void maxu(byte[] a, int aofs, byte[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1];
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.maxu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
 /*
@@ -2159,8 +2968,8 @@ public final class Arrays implements TrueStatic {
     }
 
     public static void minu(ByteBuffer a, int aofs, ByteBuffer b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLenPairOp && a.isDirect() && b.isDirect()) {
-            boolean check= a.get(aofs)<b.get(bofs) && a.get(aofs+len-1)<b.get(bofs+len-1); //avoiding GPF
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_BYTE] && a.isDirect() && b.isDirect()) {
+            checkBuffer(a,aofs,len,true); checkBuffer(b,bofs,len,false);
             ArraysNative.minu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2173,8 +2982,8 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if ((a.get(aofs)&0xFF)>(b.get(bofs)&0xFF)) a.put(aofs,b.get(bofs));
     }
     public static void maxu(ByteBuffer a, int aofs, ByteBuffer b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLenPairOp && a.isDirect() && b.isDirect()) {
-            boolean check= a.get(aofs)<b.get(bofs) && a.get(aofs+len-1)<b.get(bofs+len-1); //avoiding GPF
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_BYTE] && a.isDirect() && b.isDirect()) {
+            checkBuffer(a,aofs,len,true); checkBuffer(b,bofs,len,false);
             ArraysNative.maxu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2188,8 +2997,8 @@ public final class Arrays implements TrueStatic {
     }
 
     public static void minu(short[] a, int aofs, short[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1]; //avoiding GPF
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.minu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2202,8 +3011,8 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if ((char)a[aofs]>(char)b[bofs]) a[aofs]=b[bofs];
     }
     public static void maxu(short[] a, int aofs, short[] b, int bofs, int len) {
-        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLenPairOp) {
-            boolean check= a[aofs]<b[bofs] && a[aofs+len-1]<b[bofs+len-1];
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
             ArraysNative.maxu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
         }
         int aofsmax=aofs+len-3;
@@ -2216,6 +3025,43 @@ public final class Arrays implements TrueStatic {
         for (aofsmax+=3; aofs<aofsmax; aofs++,bofs++) if ((char)a[aofs]<(char)b[bofs]) a[aofs]=b[bofs];
     }
 
+    public static void minu(int[] a, int aofs, int[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.minu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        // x^Integer.MIN_VALUE maps unsigned order to signed order
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++)
+            if ((a[aofs]^Integer.MIN_VALUE)>(b[bofs]^Integer.MIN_VALUE)) a[aofs]=b[bofs];
+    }
+    public static void minu(long[] a, int aofs, long[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.minu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        // x^Long.MIN_VALUE maps unsigned order to signed order
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++)
+            if ((a[aofs]^Long.MIN_VALUE)>(b[bofs]^Long.MIN_VALUE)) a[aofs]=b[bofs];
+    }
+    public static void maxu(int[] a, int aofs, int[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.maxu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        // x^Integer.MIN_VALUE maps unsigned order to signed order
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++)
+            if ((a[aofs]^Integer.MIN_VALUE)<(b[bofs]^Integer.MIN_VALUE)) a[aofs]=b[bofs];
+    }
+    public static void maxu(long[] a, int aofs, long[] b, int bofs, int len) {
+        if (isNative && ArraysNative.minmaxuImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.maxu(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        // x^Long.MIN_VALUE maps unsigned order to signed order
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++)
+            if ((a[aofs]^Long.MIN_VALUE)<(b[bofs]^Long.MIN_VALUE)) a[aofs]=b[bofs];
+    }
+
     /* Adding and subtracting */
 
     public static void add(Object a, Object b) throws Exception {
@@ -2306,11 +3152,53 @@ public final class Arrays implements TrueStatic {
         else if (a instanceof short[] && b instanceof short[]) subus((short[])a,aofs,(short[])b,bofs,len);
         else throw new IllegalArgumentException("Unsupported arguments types in " + Arrays.class.getName() + ".subus(): "+JVM.toJavaClassName(a)+","+JVM.toJavaClassName(b));
     }
+    public static void absDiff(Object a, Object b) throws Exception {
+        absDiff(a,0,b,0,min(Array.getLength(a),Array.getLength(b)));
+    }
+    public static void absDiffu(Object a, Object b) throws Exception {
+        absDiffu(a,0,b,0,min(Array.getLength(a),Array.getLength(b)));
+    }
+    public static void opposite(Object a, Object b) throws Exception {
+        opposite(a,0,b,0,min(Array.getLength(a),Array.getLength(b)));
+    }
+    public static void absDiff(Object a, int aofs, Object b, int bofs, int len) throws Exception {
+        if (a instanceof byte[] && b instanceof byte[]) absDiff((byte[])a,aofs,(byte[])b,bofs,len);
+        else if (a instanceof short[] && b instanceof short[]) absDiff((short[])a,aofs,(short[])b,bofs,len);
+        else if (a instanceof int[] && b instanceof int[]) absDiff((int[])a,aofs,(int[])b,bofs,len);
+        else if (a instanceof long[] && b instanceof long[]) absDiff((long[])a,aofs,(long[])b,bofs,len);
+        else if (a instanceof float[] && b instanceof float[]) absDiff((float[])a,aofs,(float[])b,bofs,len);
+        else if (a instanceof double[] && b instanceof double[]) absDiff((double[])a,aofs,(double[])b,bofs,len);
+        else throw new IllegalArgumentException("Unsupported arguments types in " + Arrays.class.getName() + ".absDiff(): "+JVM.toJavaClassName(a)+","+JVM.toJavaClassName(b));
+    }
+    public static void absDiffu(Object a, int aofs, Object b, int bofs, int len) throws Exception {
+        if (a instanceof byte[] && b instanceof byte[]) absDiffu((byte[])a,aofs,(byte[])b,bofs,len);
+        else if (a instanceof short[] && b instanceof short[]) absDiffu((short[])a,aofs,(short[])b,bofs,len);
+        else if (a instanceof int[] && b instanceof int[]) absDiffu((int[])a,aofs,(int[])b,bofs,len);
+        else if (a instanceof long[] && b instanceof long[]) absDiffu((long[])a,aofs,(long[])b,bofs,len);
+        else throw new IllegalArgumentException("Unsupported arguments types in " + Arrays.class.getName() + ".absDiffu(): "+JVM.toJavaClassName(a)+","+JVM.toJavaClassName(b));
+    }
+    public static void opposite(Object a, int aofs, Object b, int bofs, int len) throws Exception {
+        if (a instanceof byte[] && b instanceof byte[]) opposite((byte[])a,aofs,(byte[])b,bofs,len);
+        else if (a instanceof short[] && b instanceof short[]) opposite((short[])a,aofs,(short[])b,bofs,len);
+        else if (a instanceof int[] && b instanceof int[]) opposite((int[])a,aofs,(int[])b,bofs,len);
+        else if (a instanceof long[] && b instanceof long[]) opposite((long[])a,aofs,(long[])b,bofs,len);
+        else if (a instanceof float[] && b instanceof float[]) opposite((float[])a,aofs,(float[])b,bofs,len);
+        else if (a instanceof double[] && b instanceof double[]) opposite((double[])a,aofs,(double[])b,bofs,len);
+        else throw new IllegalArgumentException("Unsupported arguments types in " + Arrays.class.getName() + ".opposite(): "+JVM.toJavaClassName(a)+","+JVM.toJavaClassName(b));
+    }
 
     public static void add(byte[] a, int aofs, byte[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addBytesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]+=b[bofs];
     }
     public static void sub(byte[] a, int aofs, byte[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subBytesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]-=b[bofs];
     }
     public static void add(short[] a, int aofs, byte[] b, int bofs, int len) {
@@ -2320,9 +3208,17 @@ public final class Arrays implements TrueStatic {
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]-=b[bofs];
     }
     public static void add(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addShortsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]+=b[bofs];
     }
     public static void sub(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subShortsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]-=b[bofs];
     }
     public static void add(int[] a, int aofs, byte[] b, int bofs, int len) {
@@ -2338,21 +3234,45 @@ public final class Arrays implements TrueStatic {
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]-=b[bofs];
     }
     public static void add(int[] a, int aofs, int[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addIntsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]+=b[bofs];
     }
     public static void sub(int[] a, int aofs, int[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subIntsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]-=b[bofs];
     }
     public static void add(long[] a, int aofs, long[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addLongsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]+=b[bofs];
     }
     public static void sub(long[] a, int aofs, long[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subLongsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]-=b[bofs];
     }
     public static void add(float[] a, int aofs, float[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_FLOAT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addFloatsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]+=b[bofs];
     }
     public static void sub(float[] a, int aofs, float[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_FLOAT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subFloatsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]-=b[bofs];
     }
     public static void add(float[] a, int aofs, double[] b, int bofs, int len) {
@@ -2368,9 +3288,17 @@ public final class Arrays implements TrueStatic {
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]-=b[bofs];
     }
     public static void add(double[] a, int aofs, double[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_DOUBLE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addDoublesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]+=b[bofs];
     }
     public static void sub(double[] a, int aofs, double[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_DOUBLE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subDoublesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]-=b[bofs];
     }
 
@@ -2394,9 +3322,17 @@ public final class Arrays implements TrueStatic {
     }
 
     public static void adds(byte[] a, int aofs, byte[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addsBytesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(byte)median((int)a[aofs]+(int)b[bofs],Byte.MIN_VALUE,Byte.MAX_VALUE);}
     }
     public static void subs(byte[] a, int aofs, byte[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subsBytesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(byte)median((int)a[aofs]-(int)b[bofs],Byte.MIN_VALUE,Byte.MAX_VALUE);}
     }
     public static void adds(short[] a, int aofs, byte[] b, int bofs, int len) {
@@ -2406,16 +3342,32 @@ public final class Arrays implements TrueStatic {
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(short)median((int)a[aofs]-(int)b[bofs],Short.MIN_VALUE,Short.MAX_VALUE);}
     }
     public static void adds(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addsShortsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(short)median((int)a[aofs]+(int)b[bofs],Short.MIN_VALUE,Short.MAX_VALUE);}
     }
     public static void subs(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subsShortsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(short)median((int)a[aofs]-(int)b[bofs],Short.MIN_VALUE,Short.MAX_VALUE);}
     }
 
     public static void addus(byte[] a, int aofs, byte[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addusBytesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(byte)median((a[aofs]&0xFF)+(b[bofs]&0xFF),0,255);}
     }
     public static void subus(byte[] a, int aofs, byte[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subusBytesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(byte)median((a[aofs]&0xFF)-(b[bofs]&0xFF),0,255);}
     }
     public static void addus(short[] a, int aofs, byte[] b, int bofs, int len) {
@@ -2425,25 +3377,150 @@ public final class Arrays implements TrueStatic {
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(short)median((char)a[aofs]-(b[bofs]&0xFF),0,65535);}
     }
     public static void addus(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.addusShortsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(short)median((char)a[aofs]+(char)b[bofs],0,65535);}
     }
     public static void subus(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.subusShortsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
         for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {a[aofs]=(short)median((char)a[aofs]-(char)b[bofs],0,65535);}
     }
 
-
-    public static Object newmin(Object a, Object b) throws Exception {
-        if (b==null) return a;
-        int alen= length(a);
-        int blen= length(b);
-        Object r= newCompatible(a==null?b:a,max(alen,blen));
-        copy(a,0,r,0,alen);
-        min(r,0,b,0,blen);
-        return r;
+    // a[k]= |a[k]-b[k]|: modulo 2^n for byte, short, int and long (the exact difference is truncated to the type),
+    // the exact difference for absDiffu, where byte, short, int and long elements are unsigned
+    public static void absDiff(byte[] a, int aofs, byte[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffBytesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {int d= a[aofs]-b[bofs]; a[aofs]=(byte)(d>=0? d: -d);}
     }
-    public static Object newmax(Object a, Object b) throws Exception {
-        if (b==null) return a;
-        int alen= length(a);
+    public static void absDiff(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffShortsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {int d= a[aofs]-b[bofs]; a[aofs]=(short)(d>=0? d: -d);}
+    }
+    public static void absDiff(int[] a, int aofs, int[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffIntsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {long d= (long)a[aofs]-(long)b[bofs]; a[aofs]=(int)(d>=0? d: -d);}
+    }
+    public static void absDiff(long[] a, int aofs, long[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffLongsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= a[aofs]>b[bofs]? a[aofs]-b[bofs]: b[bofs]-a[aofs];
+    }
+    public static void absDiff(float[] a, int aofs, float[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_FLOAT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffFloatsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= Math.abs(a[aofs]-b[bofs]);
+    }
+    public static void absDiff(double[] a, int aofs, double[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_DOUBLE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffDoublesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= Math.abs(a[aofs]-b[bofs]);
+    }
+    public static void absDiffu(byte[] a, int aofs, byte[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffuBytesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {int d= (a[aofs]&0xFF)-(b[bofs]&0xFF); a[aofs]=(byte)(d>=0? d: -d);}
+    }
+    public static void absDiffu(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffuShortsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {int d= (char)a[aofs]-(char)b[bofs]; a[aofs]=(short)(d>=0? d: -d);}
+    }
+    public static void absDiffu(int[] a, int aofs, int[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffuIntsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) {long d= (a[aofs]&0xFFFFFFFFL)-(b[bofs]&0xFFFFFFFFL); a[aofs]=(int)(d>=0? d: -d);}
+    }
+    public static void absDiffu(long[] a, int aofs, long[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.absDiffuLongsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= (a[aofs]^Long.MIN_VALUE)>(b[bofs]^Long.MIN_VALUE)? a[aofs]-b[bofs]: b[bofs]-a[aofs];
+    }
+
+    // a[k]= -b[k] (modulo 2^n for integers); a and b may be the same array with the same offsets
+    public static void opposite(byte[] a, int aofs, byte[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_BYTE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.oppositeBytesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]=(byte)-b[bofs];
+    }
+    public static void opposite(short[] a, int aofs, short[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_SHORT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.oppositeShortsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]=(short)-b[bofs];
+    }
+    public static void opposite(int[] a, int aofs, int[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_INT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.oppositeIntsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= -b[bofs];
+    }
+    public static void opposite(long[] a, int aofs, long[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_LONG]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.oppositeLongsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= -b[bofs];
+    }
+    public static void opposite(float[] a, int aofs, float[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_FLOAT]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.oppositeFloatsBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= -b[bofs];
+    }
+    public static void opposite(double[] a, int aofs, double[] b, int bofs, int len) {
+        if (isNative && ArraysNative.arithmeticImplemented && len>nativeMinLensPairOp[NT_DOUBLE]) {
+            checkRanges(a.length,aofs,b.length,bofs,len);
+            ArraysNative.oppositeDoublesBuffer(ArraysNative.cpuInfo,a,aofs,b,bofs,len); return;
+        }
+        for (int aofsmax=aofs+len; aofs<aofsmax; aofs++,bofs++) a[aofs]= -b[bofs];
+    }
+
+
+    public static Object newmin(Object a, Object b) throws Exception {
+        if (b==null) return a;
+        int alen= length(a);
+        int blen= length(b);
+        Object r= newCompatible(a==null?b:a,max(alen,blen));
+        copy(a,0,r,0,alen);
+        min(r,0,b,0,blen);
+        return r;
+    }
+    public static Object newmax(Object a, Object b) throws Exception {
+        if (b==null) return a;
+        int alen= length(a);
         int blen= length(b);
         Object r= newCompatible(a==null?b:a,max(alen,blen));
         copy(a,0,r,0,alen);
@@ -2548,6 +3625,577 @@ public final class Arrays implements TrueStatic {
     private static int median(int a, int b, int c)  {return b<c?(a<b?b:a>c?c:a):(a<c?c:a>b?b:a);}
 
 
+    /* Packed bits */
+
+    // Bit k of a packed bit array is (a[(int)(k>>>6)]>>>(k&63))&1, like in java.util.BitSet.toLongArray().
+    // dest[destPos+k]= op(dest[destPos+k],src[srcPos+k]), 0<=k<count, at any bit positions;
+    // dest and src may be the same array, overlapping areas are processed like in System.arraycopy
+    public static void copyBits(long[] dest, long destPos, long[] src, long srcPos, long count) {
+        bitsOp(BITS_COPY,dest,destPos,src,srcPos,count);
+    }
+    public static void andBits(long[] dest, long destPos, long[] src, long srcPos, long count) {
+        bitsOp(BITS_AND,dest,destPos,src,srcPos,count);
+    }
+    public static void orBits(long[] dest, long destPos, long[] src, long srcPos, long count) {
+        bitsOp(BITS_OR,dest,destPos,src,srcPos,count);
+    }
+    public static void xorBits(long[] dest, long destPos, long[] src, long srcPos, long count) {
+        bitsOp(BITS_XOR,dest,destPos,src,srcPos,count);
+    }
+    public static void andNotBits(long[] dest, long destPos, long[] src, long srcPos, long count) {
+        // dest&= ~src
+        bitsOp(BITS_ANDNOT,dest,destPos,src,srcPos,count);
+    }
+    public static void notBits(long[] dest, long destPos, long[] src, long srcPos, long count) {
+        // dest= ~src
+        bitsOp(BITS_NOT,dest,destPos,src,srcPos,count);
+    }
+
+    private static final int BITS_COPY= 0, BITS_AND= 1, BITS_OR= 2, BITS_XOR= 3, BITS_ANDNOT= 4, BITS_NOT= 5;
+
+    private static void bitsOp(int op, long[] dest, long destPos, long[] src, long srcPos, long count) {
+        if (dest==null || src==null) throw new NullPointerException("Null array in " + Arrays.class.getName() + " bits operation");
+        if (count<0 || destPos<0 || srcPos<0 || destPos>((long)dest.length<<6)-count || srcPos>((long)src.length<<6)-count)
+            throw new IndexOutOfBoundsException("Illegal bit range in " + Arrays.class.getName() + ": destPos="+destPos
+                +", srcPos="+srcPos+", count="+count+" (dest.length="+dest.length+", src.length="+src.length+" longs)");
+        if (count==0) return;
+        if (isNative && ArraysNative.bitsImplemented && count>((long)nativeMinLensPairOp[NT_LONG]<<6)) {
+            long ci= ArraysNative.cpuInfo;
+            switch (op) {
+                case BITS_COPY: ArraysNative.copyBits(ci,dest,destPos,src,srcPos,count); return;
+                case BITS_AND: ArraysNative.andBits(ci,dest,destPos,src,srcPos,count); return;
+                case BITS_OR: ArraysNative.orBits(ci,dest,destPos,src,srcPos,count); return;
+                case BITS_XOR: ArraysNative.xorBits(ci,dest,destPos,src,srcPos,count); return;
+                case BITS_ANDNOT: ArraysNative.andNotBits(ci,dest,destPos,src,srcPos,count); return;
+                case BITS_NOT: ArraysNative.notBits(ci,dest,destPos,src,srcPos,count); return;
+            }
+        }
+        // Java: the same algorithm as in ArraysBits.h; partial words are processed by masks
+        long lastWord= (srcPos+count-1)>>>6;
+        long destEnd= destPos+count;
+        int w0= (int)((destPos+63)>>>6), w1= (int)(destEnd>>>6); // full destination words are w0..w1-1
+        if (w0>w1) {
+            bitsPartial(op,dest,destPos,src,srcPos,(int)count,lastWord);
+            return;
+        }
+        int head= (int)(((long)w0<<6)-destPos), tail= (int)(destEnd&63);
+        boolean backward= dest==src && destPos>srcPos && destPos<srcPos+count;
+        if (backward) {
+            if (tail>0) bitsPartial(op,dest,(long)w1<<6,src,srcPos+count-tail,tail,lastWord);
+            for (int k=w1-1; k>=w0; k--) dest[k]= bitsOp(op,dest[k],getBits64(src,srcPos+head+((long)(k-w0)<<6),lastWord));
+            if (head>0) bitsPartial(op,dest,destPos,src,srcPos,head,lastWord);
+        } else {
+            if (head>0) bitsPartial(op,dest,destPos,src,srcPos,head,lastWord);
+            for (int k=w0; k<w1; k++) dest[k]= bitsOp(op,dest[k],getBits64(src,srcPos+head+((long)(k-w0)<<6),lastWord));
+            if (tail>0) bitsPartial(op,dest,(long)w1<<6,src,srcPos+count-tail,tail,lastWord);
+        }
+    }
+    private static long bitsOp(int op, long d, long s) {
+        switch (op) {
+            case BITS_AND: return d&s;
+            case BITS_OR: return d|s;
+            case BITS_XOR: return d^s;
+            case BITS_ANDNOT: return d&~s;
+            case BITS_NOT: return ~s;
+            default: return s;
+        }
+    }
+    private static long getBits64(long[] src, long pos, long lastWord) {
+        // 64 bits from pos; the words after lastWord are not read
+        int w= (int)(pos>>>6), sh= (int)(pos&63);
+        long v= src[w]>>>sh;
+        if (sh!=0 && w<lastWord) v|= src[w+1]<<(64-sh);
+        return v;
+    }
+    private static void bitsPartial(int op, long[] dest, long destPos, long[] src, long srcPos, int n, long lastWord) {
+        // n<64 destination bits inside one word
+        int w= (int)(destPos>>>6), sh= (int)(destPos&63);
+        long mask= ((1L<<n)-1)<<sh;
+        long d= dest[w];
+        dest[w]= (d&~mask)|(bitsOp(op,d,getBits64(src,srcPos,lastWord)<<sh)&mask);
+    }
+
+    public static long cardinality(long[] a, long fromIndex, long toIndex) {
+        // number of set bits a[fromIndex..toIndex-1]
+        if (a==null) throw new NullPointerException("Null array in " + Arrays.class.getName() + ".cardinality");
+        if (fromIndex<0 || toIndex>((long)a.length<<6) || fromIndex>toIndex)
+            throw new IndexOutOfBoundsException("Illegal bit range in " + Arrays.class.getName() + ".cardinality: fromIndex="
+                +fromIndex+", toIndex="+toIndex+" (a.length="+a.length+" longs)");
+        if (fromIndex==toIndex) return 0;
+        if (isNative && ArraysNative.bitsSearchImplemented && toIndex-fromIndex>((long)nativeMinLensPairOp[NT_LONG]<<6))
+            return ArraysNative.cardinalityBits(ArraysNative.cpuInfo,a,fromIndex,toIndex);
+        int w0= (int)(fromIndex>>>6), w1= (int)((toIndex-1)>>>6);
+        long first= -1L<<(fromIndex&63), last= -1L>>>(63-(int)((toIndex-1)&63));
+        if (w0==w1) return bitCount(a[w0]&first&last);
+        long result= bitCount(a[w0]&first)+bitCount(a[w1]&last);
+        for (int k=w0+1; k<w1; k++) result+= bitCount(a[k]);
+        return result;
+    }
+    public static long indexOfBit(long[] a, long lowIndex, long highIndex, boolean value) {
+        // the minimal k, lowIndex<=k<highIndex, that a[k]==value, or -1 if there is no such k;
+        // like PackedBitArrays.indexOfBit, negative lowIndex or highIndex>a.length*64 is an error even for empty ranges
+        if (a==null) throw new NullPointerException("Null array in " + Arrays.class.getName() + ".indexOfBit");
+        if (lowIndex<0 || highIndex>((long)a.length<<6))
+            throw new IndexOutOfBoundsException("Illegal bit range in " + Arrays.class.getName() + ".indexOfBit: lowIndex="
+                +lowIndex+", highIndex="+highIndex+" (a.length="+a.length+" longs)");
+        if (lowIndex>=highIndex) return -1;
+        if (isNative && ArraysNative.bitsSearchImplemented && highIndex-lowIndex>((long)nativeMinLensPairOp[NT_LONG]<<6))
+            return ArraysNative.indexOfBit(ArraysNative.cpuInfo,a,lowIndex,highIndex,value);
+        long skip= value? 0: -1;
+        int w0= (int)(lowIndex>>>6), w1= (int)((highIndex-1)>>>6);
+        long v= (a[w0]^skip)&(-1L<<(lowIndex&63));
+        for (int k=w0; ; ) {
+            if (k==w1) v&= -1L>>>(63-(int)((highIndex-1)&63));
+            if (v!=0) return ((long)k<<6)+lowestBit(v);
+            if (++k>w1) return -1;
+            v= a[k]^skip;
+        }
+    }
+    public static long lastIndexOfBit(long[] a, long lowIndex, long highIndex, boolean value) {
+        // the maximal k, lowIndex<=k<highIndex, that a[k]==value, or -1 if there is no such k;
+        // like PackedBitArrays.lastIndexOfBit, negative lowIndex or highIndex>a.length*64 is an error even for empty ranges
+        if (a==null) throw new NullPointerException("Null array in " + Arrays.class.getName() + ".lastIndexOfBit");
+        if (lowIndex<0 || highIndex>((long)a.length<<6))
+            throw new IndexOutOfBoundsException("Illegal bit range in " + Arrays.class.getName() + ".lastIndexOfBit: lowIndex="
+                +lowIndex+", highIndex="+highIndex+" (a.length="+a.length+" longs)");
+        if (lowIndex>=highIndex) return -1;
+        if (isNative && ArraysNative.bitsSearchImplemented && highIndex-lowIndex>((long)nativeMinLensPairOp[NT_LONG]<<6))
+            return ArraysNative.lastIndexOfBit(ArraysNative.cpuInfo,a,lowIndex,highIndex,value);
+        long skip= value? 0: -1;
+        int w0= (int)(lowIndex>>>6), w1= (int)((highIndex-1)>>>6);
+        long v= (a[w1]^skip)&(-1L>>>(63-(int)((highIndex-1)&63)));
+        for (int k=w1; ; ) {
+            if (k==w0) v&= -1L<<(lowIndex&63);
+            if (v!=0) return ((long)k<<6)+highestBit(v);
+            if (--k<w0) return -1;
+            v= a[k]^skip;
+        }
+    }
+    private static int bitCount(long v) {
+        // SWAR, like _bitCount64 in ArraysBits.h
+        v-= (v>>>1)&0x5555555555555555L;
+        v= (v&0x3333333333333333L)+((v>>>2)&0x3333333333333333L);
+        v= (v+(v>>>4))&0x0F0F0F0F0F0F0F0FL;
+        return (int)((v*0x0101010101010101L)>>>56);
+    }
+    private static int lowestBit(long v) {
+        // v!=0
+        int r= 0;
+        if ((v&0xFFFFFFFFL)==0) {v>>>= 32; r+= 32;}
+        if ((v&0xFFFFL)==0) {v>>>= 16; r+= 16;}
+        if ((v&0xFFL)==0) {v>>>= 8; r+= 8;}
+        if ((v&0xFL)==0) {v>>>= 4; r+= 4;}
+        if ((v&0x3L)==0) {v>>>= 2; r+= 2;}
+        if ((v&0x1L)==0) r++;
+        return r;
+    }
+    private static int highestBit(long v) {
+        // v!=0
+        int r= 0;
+        if ((v>>>32)!=0) {v>>>= 32; r+= 32;}
+        if ((v>>>16)!=0) {v>>>= 16; r+= 16;}
+        if ((v>>>8)!=0) {v>>>= 8; r+= 8;}
+        if ((v>>>4)!=0) {v>>>= 4; r+= 4;}
+        if ((v>>>2)!=0) {v>>>= 2; r+= 2;}
+        if ((v>>>1)!=0) r++;
+        return r;
+    }
+
+    // Threshold packing: dest[destPos+k]= src[srcPos+k] CMP threshold, 0<=k<count, at any destination bit position;
+    // like in PackedBitArrays, byte, short and char elements are unsigned (byte and short thresholds are int and
+    // may be out of the element range), floating-point comparisons with NaN are false (like Java operators)
+    public static void packBitsGreater(long[] dest, long destPos, byte[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_GREATER,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreater(long[] dest, long destPos, char[] src, int srcPos, int count, char threshold) {
+        packBits(PACK_GREATER,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreater(long[] dest, long destPos, short[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_GREATER,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreater(long[] dest, long destPos, int[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_GREATER,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreater(long[] dest, long destPos, long[] src, int srcPos, int count, long threshold) {
+        packBits(PACK_GREATER,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreater(long[] dest, long destPos, float[] src, int srcPos, int count, float threshold) {
+        packBits(PACK_GREATER,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreater(long[] dest, long destPos, double[] src, int srcPos, int count, double threshold) {
+        packBits(PACK_GREATER,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLess(long[] dest, long destPos, byte[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_LESS,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLess(long[] dest, long destPos, char[] src, int srcPos, int count, char threshold) {
+        packBits(PACK_LESS,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLess(long[] dest, long destPos, short[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_LESS,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLess(long[] dest, long destPos, int[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_LESS,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLess(long[] dest, long destPos, long[] src, int srcPos, int count, long threshold) {
+        packBits(PACK_LESS,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLess(long[] dest, long destPos, float[] src, int srcPos, int count, float threshold) {
+        packBits(PACK_LESS,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLess(long[] dest, long destPos, double[] src, int srcPos, int count, double threshold) {
+        packBits(PACK_LESS,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreaterOrEqual(long[] dest, long destPos, byte[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_GREATER_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreaterOrEqual(long[] dest, long destPos, char[] src, int srcPos, int count, char threshold) {
+        packBits(PACK_GREATER_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreaterOrEqual(long[] dest, long destPos, short[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_GREATER_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreaterOrEqual(long[] dest, long destPos, int[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_GREATER_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreaterOrEqual(long[] dest, long destPos, long[] src, int srcPos, int count, long threshold) {
+        packBits(PACK_GREATER_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreaterOrEqual(long[] dest, long destPos, float[] src, int srcPos, int count, float threshold) {
+        packBits(PACK_GREATER_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsGreaterOrEqual(long[] dest, long destPos, double[] src, int srcPos, int count, double threshold) {
+        packBits(PACK_GREATER_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLessOrEqual(long[] dest, long destPos, byte[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_LESS_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLessOrEqual(long[] dest, long destPos, char[] src, int srcPos, int count, char threshold) {
+        packBits(PACK_LESS_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLessOrEqual(long[] dest, long destPos, short[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_LESS_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLessOrEqual(long[] dest, long destPos, int[] src, int srcPos, int count, int threshold) {
+        packBits(PACK_LESS_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLessOrEqual(long[] dest, long destPos, long[] src, int srcPos, int count, long threshold) {
+        packBits(PACK_LESS_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLessOrEqual(long[] dest, long destPos, float[] src, int srcPos, int count, float threshold) {
+        packBits(PACK_LESS_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+    public static void packBitsLessOrEqual(long[] dest, long destPos, double[] src, int srcPos, int count, double threshold) {
+        packBits(PACK_LESS_OR_EQUAL,dest,destPos,src,srcPos,count,threshold);
+    }
+
+    private static final int PACK_GREATER= 0, PACK_LESS= 1, PACK_GREATER_OR_EQUAL= 2, PACK_LESS_OR_EQUAL= 3;
+
+    private static void packBits(int cmp, long[] dest, long destPos, byte[] src, int srcPos, int count, int threshold) {
+        checkPackBits(dest,destPos,src==null? -1: src.length,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.packBitsImplemented && count>nativeMinLensPairOp[NT_BYTE]) {
+            ArraysNative.packBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,
+                (byte)(threshold<0? 0: threshold>0xFF? 0xFF: threshold),unsignedPackCmp(cmp,threshold,0xFF));
+            return;
+        }
+        for (int k=0; k<count; ) {
+            int sh= (int)((destPos+k)&63), n= min(64-sh,count-k);
+            long v= 0;
+            for (int j=0; j<n; j++, k++) if (packCmp(cmp,src[srcPos+k]&0xFF,threshold)) v|= 1L<<j;
+            packWord(dest,destPos+k-n,v,n);
+        }
+    }
+    private static void packBits(int cmp, long[] dest, long destPos, char[] src, int srcPos, int count, char threshold) {
+        checkPackBits(dest,destPos,src==null? -1: src.length,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.packBitsImplemented && count>nativeMinLensPairOp[NT_CHAR]) {
+            ArraysNative.packBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,threshold,cmp);
+            return;
+        }
+        for (int k=0; k<count; ) {
+            int sh= (int)((destPos+k)&63), n= min(64-sh,count-k);
+            long v= 0;
+            for (int j=0; j<n; j++, k++) if (packCmp(cmp,src[srcPos+k],threshold)) v|= 1L<<j;
+            packWord(dest,destPos+k-n,v,n);
+        }
+    }
+    private static void packBits(int cmp, long[] dest, long destPos, short[] src, int srcPos, int count, int threshold) {
+        checkPackBits(dest,destPos,src==null? -1: src.length,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.packBitsImplemented && count>nativeMinLensPairOp[NT_SHORT]) {
+            ArraysNative.packBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,
+                (short)(threshold<0? 0: threshold>0xFFFF? 0xFFFF: threshold),unsignedPackCmp(cmp,threshold,0xFFFF));
+            return;
+        }
+        for (int k=0; k<count; ) {
+            int sh= (int)((destPos+k)&63), n= min(64-sh,count-k);
+            long v= 0;
+            for (int j=0; j<n; j++, k++) if (packCmp(cmp,src[srcPos+k]&0xFFFF,threshold)) v|= 1L<<j;
+            packWord(dest,destPos+k-n,v,n);
+        }
+    }
+    private static void packBits(int cmp, long[] dest, long destPos, int[] src, int srcPos, int count, int threshold) {
+        checkPackBits(dest,destPos,src==null? -1: src.length,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.packBitsImplemented && count>nativeMinLensPairOp[NT_INT]) {
+            ArraysNative.packBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,threshold,cmp);
+            return;
+        }
+        for (int k=0; k<count; ) {
+            int sh= (int)((destPos+k)&63), n= min(64-sh,count-k);
+            long v= 0;
+            for (int j=0; j<n; j++, k++) if (packCmp(cmp,src[srcPos+k],threshold)) v|= 1L<<j;
+            packWord(dest,destPos+k-n,v,n);
+        }
+    }
+    private static void packBits(int cmp, long[] dest, long destPos, long[] src, int srcPos, int count, long threshold) {
+        checkPackBits(dest,destPos,src==null? -1: src.length,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.packBitsImplemented && count>nativeMinLensPairOp[NT_LONG]) {
+            ArraysNative.packBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,threshold,cmp);
+            return;
+        }
+        for (int k=0; k<count; ) {
+            int sh= (int)((destPos+k)&63), n= min(64-sh,count-k);
+            long v= 0;
+            for (int j=0; j<n; j++, k++) if (packCmp(cmp,src[srcPos+k],threshold)) v|= 1L<<j;
+            packWord(dest,destPos+k-n,v,n);
+        }
+    }
+    private static void packBits(int cmp, long[] dest, long destPos, float[] src, int srcPos, int count, float threshold) {
+        checkPackBits(dest,destPos,src==null? -1: src.length,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.packBitsImplemented && count>nativeMinLensPairOp[NT_FLOAT]) {
+            ArraysNative.packBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,threshold,cmp);
+            return;
+        }
+        for (int k=0; k<count; ) {
+            int sh= (int)((destPos+k)&63), n= min(64-sh,count-k);
+            long v= 0;
+            for (int j=0; j<n; j++, k++) if (packCmp(cmp,src[srcPos+k],threshold)) v|= 1L<<j;
+            packWord(dest,destPos+k-n,v,n);
+        }
+    }
+    private static void packBits(int cmp, long[] dest, long destPos, double[] src, int srcPos, int count, double threshold) {
+        checkPackBits(dest,destPos,src==null? -1: src.length,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.packBitsImplemented && count>nativeMinLensPairOp[NT_DOUBLE]) {
+            ArraysNative.packBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,threshold,cmp);
+            return;
+        }
+        for (int k=0; k<count; ) {
+            int sh= (int)((destPos+k)&63), n= min(64-sh,count-k);
+            long v= 0;
+            for (int j=0; j<n; j++, k++) if (packCmp(cmp,src[srcPos+k],threshold)) v|= 1L<<j;
+            packWord(dest,destPos+k-n,v,n);
+        }
+    }
+    private static void checkPackBits(long[] dest, long destPos, int srcLength, int srcPos, int count) {
+        if (dest==null || srcLength<0) throw new NullPointerException("Null array in " + Arrays.class.getName() + " bits packing");
+        if (count<0 || destPos<0 || srcPos<0 || destPos>((long)dest.length<<6)-count || srcPos>srcLength-count)
+            throw new IndexOutOfBoundsException("Illegal range in " + Arrays.class.getName() + " bits packing: destPos="+destPos
+                +", srcPos="+srcPos+", count="+count+" (dest.length="+dest.length+" longs, src.length="+srcLength+")");
+    }
+    private static int unsignedPackCmp(int cmp, int threshold, int max) {
+        // the comparison, which gives the same results for elements 0..max and the threshold clamped to 0..max
+        // (the native code compares unsigned elements with the unsigned threshold of the same type)
+        boolean greater= cmp==PACK_GREATER || cmp==PACK_GREATER_OR_EQUAL;
+        if (threshold<0) return greater? PACK_GREATER_OR_EQUAL: PACK_LESS; // always true / always false
+        if (threshold>max) return greater? PACK_GREATER: PACK_LESS_OR_EQUAL; // always false / always true
+        return cmp;
+    }
+    private static boolean packCmp(int cmp, long v, long threshold) {
+        // byte, char, short and int are compared as long without any loss
+        switch (cmp) {
+            case PACK_GREATER: return v>threshold;
+            case PACK_LESS: return v<threshold;
+            case PACK_GREATER_OR_EQUAL: return v>=threshold;
+            default: return v<=threshold;
+        }
+    }
+    private static boolean packCmp(int cmp, double v, double threshold) {
+        switch (cmp) {
+            case PACK_GREATER: return v>threshold;
+            case PACK_LESS: return v<threshold;
+            case PACK_GREATER_OR_EQUAL: return v>=threshold;
+            default: return v<=threshold;
+        }
+    }
+    private static void packWord(long[] dest, long pos, long v, int n) {
+        // n<=64 bits v into dest from the bit pos, inside one word
+        int w= (int)(pos>>>6), sh= (int)(pos&63);
+        long mask= n==64? -1L: ((1L<<n)-1)<<sh;
+        dest[w]= (dest[w]&~mask)|(v<<sh);
+    }
+
+    // Bit unpacking: dest[destPos+k]= src[srcPos+k]? value1: value0, 0<=k<count, at any source bit position;
+    // unpackUnitBits changes only the elements of 1 bits, unpackZeroBits only the elements of 0 bits
+    public static void unpackBits(byte[] dest, int destPos, long[] src, long srcPos, int count, byte value0, byte value1) {
+        unpackBits(UNPACK_ALL,dest,destPos,src,srcPos,count,value0,value1);
+    }
+    public static void unpackBits(char[] dest, int destPos, long[] src, long srcPos, int count, char value0, char value1) {
+        unpackBits(UNPACK_ALL,dest,destPos,src,srcPos,count,value0,value1);
+    }
+    public static void unpackBits(short[] dest, int destPos, long[] src, long srcPos, int count, short value0, short value1) {
+        unpackBits(UNPACK_ALL,dest,destPos,src,srcPos,count,value0,value1);
+    }
+    public static void unpackBits(int[] dest, int destPos, long[] src, long srcPos, int count, int value0, int value1) {
+        unpackBits(UNPACK_ALL,dest,destPos,src,srcPos,count,value0,value1);
+    }
+    public static void unpackBits(long[] dest, int destPos, long[] src, long srcPos, int count, long value0, long value1) {
+        unpackBits(UNPACK_ALL,dest,destPos,src,srcPos,count,value0,value1);
+    }
+    public static void unpackBits(float[] dest, int destPos, long[] src, long srcPos, int count, float value0, float value1) {
+        unpackBits(UNPACK_ALL,dest,destPos,src,srcPos,count,value0,value1);
+    }
+    public static void unpackBits(double[] dest, int destPos, long[] src, long srcPos, int count, double value0, double value1) {
+        unpackBits(UNPACK_ALL,dest,destPos,src,srcPos,count,value0,value1);
+    }
+    public static void unpackUnitBits(byte[] dest, int destPos, long[] src, long srcPos, int count, byte value1) {
+        unpackBits(UNPACK_UNITS,dest,destPos,src,srcPos,count,value1,value1);
+    }
+    public static void unpackUnitBits(char[] dest, int destPos, long[] src, long srcPos, int count, char value1) {
+        unpackBits(UNPACK_UNITS,dest,destPos,src,srcPos,count,value1,value1);
+    }
+    public static void unpackUnitBits(short[] dest, int destPos, long[] src, long srcPos, int count, short value1) {
+        unpackBits(UNPACK_UNITS,dest,destPos,src,srcPos,count,value1,value1);
+    }
+    public static void unpackUnitBits(int[] dest, int destPos, long[] src, long srcPos, int count, int value1) {
+        unpackBits(UNPACK_UNITS,dest,destPos,src,srcPos,count,value1,value1);
+    }
+    public static void unpackUnitBits(long[] dest, int destPos, long[] src, long srcPos, int count, long value1) {
+        unpackBits(UNPACK_UNITS,dest,destPos,src,srcPos,count,value1,value1);
+    }
+    public static void unpackUnitBits(float[] dest, int destPos, long[] src, long srcPos, int count, float value1) {
+        unpackBits(UNPACK_UNITS,dest,destPos,src,srcPos,count,value1,value1);
+    }
+    public static void unpackUnitBits(double[] dest, int destPos, long[] src, long srcPos, int count, double value1) {
+        unpackBits(UNPACK_UNITS,dest,destPos,src,srcPos,count,value1,value1);
+    }
+    public static void unpackZeroBits(byte[] dest, int destPos, long[] src, long srcPos, int count, byte value0) {
+        unpackBits(UNPACK_ZEROS,dest,destPos,src,srcPos,count,value0,value0);
+    }
+    public static void unpackZeroBits(char[] dest, int destPos, long[] src, long srcPos, int count, char value0) {
+        unpackBits(UNPACK_ZEROS,dest,destPos,src,srcPos,count,value0,value0);
+    }
+    public static void unpackZeroBits(short[] dest, int destPos, long[] src, long srcPos, int count, short value0) {
+        unpackBits(UNPACK_ZEROS,dest,destPos,src,srcPos,count,value0,value0);
+    }
+    public static void unpackZeroBits(int[] dest, int destPos, long[] src, long srcPos, int count, int value0) {
+        unpackBits(UNPACK_ZEROS,dest,destPos,src,srcPos,count,value0,value0);
+    }
+    public static void unpackZeroBits(long[] dest, int destPos, long[] src, long srcPos, int count, long value0) {
+        unpackBits(UNPACK_ZEROS,dest,destPos,src,srcPos,count,value0,value0);
+    }
+    public static void unpackZeroBits(float[] dest, int destPos, long[] src, long srcPos, int count, float value0) {
+        unpackBits(UNPACK_ZEROS,dest,destPos,src,srcPos,count,value0,value0);
+    }
+    public static void unpackZeroBits(double[] dest, int destPos, long[] src, long srcPos, int count, double value0) {
+        unpackBits(UNPACK_ZEROS,dest,destPos,src,srcPos,count,value0,value0);
+    }
+
+    private static final int UNPACK_ALL= 0, UNPACK_UNITS= 1, UNPACK_ZEROS= 2;
+
+    private static void unpackBits(int mode, byte[] dest, int destPos, long[] src, long srcPos, int count, byte value0, byte value1) {
+        checkUnpackBits(dest==null? -1: dest.length,destPos,src,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.unpackBitsImplemented && count>nativeMinLensPairOp[NT_BYTE]) {
+            ArraysNative.unpackBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,value0,value1,mode);
+            return;
+        }
+        for (int k=0; k<count; k++) {
+            long p= srcPos+k;
+            boolean bit= (src[(int)(p>>>6)]&(1L<<(p&63)))!=0;
+            if (bit? mode!=UNPACK_ZEROS: mode!=UNPACK_UNITS) dest[destPos+k]= bit? value1: value0;
+        }
+    }
+    private static void unpackBits(int mode, char[] dest, int destPos, long[] src, long srcPos, int count, char value0, char value1) {
+        checkUnpackBits(dest==null? -1: dest.length,destPos,src,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.unpackBitsImplemented && count>nativeMinLensPairOp[NT_CHAR]) {
+            ArraysNative.unpackBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,value0,value1,mode);
+            return;
+        }
+        for (int k=0; k<count; k++) {
+            long p= srcPos+k;
+            boolean bit= (src[(int)(p>>>6)]&(1L<<(p&63)))!=0;
+            if (bit? mode!=UNPACK_ZEROS: mode!=UNPACK_UNITS) dest[destPos+k]= bit? value1: value0;
+        }
+    }
+    private static void unpackBits(int mode, short[] dest, int destPos, long[] src, long srcPos, int count, short value0, short value1) {
+        checkUnpackBits(dest==null? -1: dest.length,destPos,src,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.unpackBitsImplemented && count>nativeMinLensPairOp[NT_SHORT]) {
+            ArraysNative.unpackBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,value0,value1,mode);
+            return;
+        }
+        for (int k=0; k<count; k++) {
+            long p= srcPos+k;
+            boolean bit= (src[(int)(p>>>6)]&(1L<<(p&63)))!=0;
+            if (bit? mode!=UNPACK_ZEROS: mode!=UNPACK_UNITS) dest[destPos+k]= bit? value1: value0;
+        }
+    }
+    private static void unpackBits(int mode, int[] dest, int destPos, long[] src, long srcPos, int count, int value0, int value1) {
+        checkUnpackBits(dest==null? -1: dest.length,destPos,src,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.unpackBitsImplemented && count>nativeMinLensPairOp[NT_INT]) {
+            ArraysNative.unpackBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,value0,value1,mode);
+            return;
+        }
+        for (int k=0; k<count; k++) {
+            long p= srcPos+k;
+            boolean bit= (src[(int)(p>>>6)]&(1L<<(p&63)))!=0;
+            if (bit? mode!=UNPACK_ZEROS: mode!=UNPACK_UNITS) dest[destPos+k]= bit? value1: value0;
+        }
+    }
+    private static void unpackBits(int mode, long[] dest, int destPos, long[] src, long srcPos, int count, long value0, long value1) {
+        checkUnpackBits(dest==null? -1: dest.length,destPos,src,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.unpackBitsImplemented && count>nativeMinLensPairOp[NT_LONG]) {
+            ArraysNative.unpackBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,value0,value1,mode);
+            return;
+        }
+        for (int k=0; k<count; k++) {
+            long p= srcPos+k;
+            boolean bit= (src[(int)(p>>>6)]&(1L<<(p&63)))!=0;
+            if (bit? mode!=UNPACK_ZEROS: mode!=UNPACK_UNITS) dest[destPos+k]= bit? value1: value0;
+        }
+    }
+    private static void unpackBits(int mode, float[] dest, int destPos, long[] src, long srcPos, int count, float value0, float value1) {
+        checkUnpackBits(dest==null? -1: dest.length,destPos,src,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.unpackBitsImplemented && count>nativeMinLensPairOp[NT_FLOAT]) {
+            ArraysNative.unpackBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,value0,value1,mode);
+            return;
+        }
+        for (int k=0; k<count; k++) {
+            long p= srcPos+k;
+            boolean bit= (src[(int)(p>>>6)]&(1L<<(p&63)))!=0;
+            if (bit? mode!=UNPACK_ZEROS: mode!=UNPACK_UNITS) dest[destPos+k]= bit? value1: value0;
+        }
+    }
+    private static void unpackBits(int mode, double[] dest, int destPos, long[] src, long srcPos, int count, double value0, double value1) {
+        checkUnpackBits(dest==null? -1: dest.length,destPos,src,srcPos,count);
+        if (count==0) return;
+        if (isNative && ArraysNative.unpackBitsImplemented && count>nativeMinLensPairOp[NT_DOUBLE]) {
+            ArraysNative.unpackBits(ArraysNative.cpuInfo,dest,destPos,src,srcPos,count,value0,value1,mode);
+            return;
+        }
+        for (int k=0; k<count; k++) {
+            long p= srcPos+k;
+            boolean bit= (src[(int)(p>>>6)]&(1L<<(p&63)))!=0;
+            if (bit? mode!=UNPACK_ZEROS: mode!=UNPACK_UNITS) dest[destPos+k]= bit? value1: value0;
+        }
+    }
+    private static void checkUnpackBits(int destLength, int destPos, long[] src, long srcPos, int count) {
+        if (destLength<0 || src==null) throw new NullPointerException("Null array in " + Arrays.class.getName() + " bits unpacking");
+        if (count<0 || destPos<0 || srcPos<0 || destPos>destLength-count || srcPos>((long)src.length<<6)-count)
+            throw new IndexOutOfBoundsException("Illegal range in " + Arrays.class.getName() + " bits unpacking: destPos="+destPos
+                +", srcPos="+srcPos+", count="+count+" (dest.length="+destLength+", src.length="+src.length+" longs)");
+    }
+
+
     /* Constants, CPU service functions */
 
     public static final long CPU_TSC= 1<<4;
@@ -2556,6 +4204,9 @@ public final class Arrays implements TrueStatic {
         // so, it means that all commands CMOVxx, FCMOVxx, FCOMI, FUCOMI are avaiable
     public static final long CPU_SSE= 1<<25;   // always set if CPU_SSE2 is set
     public static final long CPU_SSE2= 1<<26;
+    public static final long CPU_AVX2= 1L<<54;  // set only if the OS supports AVX state; implies CPU_SSE2
+    public static final long CPU_AVX512= 1L<<55; // AVX-512 F+BW+DQ+VL; always set with CPU_AVX2
+    public static final long CPU_AVX512POPCNT= 1L<<56; // AVX512_VPOPCNTDQ; always set with CPU_AVX512
     public static final long CPU_AMD= 1L<<59;
     public static final long CPU_MMXEX= 1L<<60; // always set if CPU_SSE is set
     public static final long CPU_3DNOWEX= 1L<<62;
@@ -2572,6 +4223,55 @@ public final class Arrays implements TrueStatic {
     public static final int CPU_FAMILY_SHIFT= 50;
     public static final long CPU_FAMILY= 15L;
 
+    public static final int CPU_VENDOR_UNKNOWN= 0;
+    public static final int CPU_VENDOR_INTEL= 1;
+    public static final int CPU_VENDOR_AMD= 2;
+
+    // Bits of getCpuFeatures() (not of getCpuInfo()); AVX-based features are set only if the OS supports them
+    public static final long CPU_FEATURE_SSE3= 1L<<0;
+    public static final long CPU_FEATURE_SSSE3= 1L<<1;
+    public static final long CPU_FEATURE_SSE41= 1L<<2;
+    public static final long CPU_FEATURE_SSE42= 1L<<3;
+    public static final long CPU_FEATURE_POPCNT= 1L<<4;
+    public static final long CPU_FEATURE_AVX= 1L<<5;
+    public static final long CPU_FEATURE_FMA= 1L<<6;
+    public static final long CPU_FEATURE_AVX2= 1L<<7;
+    public static final long CPU_FEATURE_BMI1= 1L<<8;
+    public static final long CPU_FEATURE_BMI2= 1L<<9;
+    public static final long CPU_FEATURE_LZCNT= 1L<<10;
+    public static final long CPU_FEATURE_ERMSB= 1L<<11;
+    public static final long CPU_FEATURE_FSRM= 1L<<12;
+    public static final long CPU_FEATURE_AVX512F= 1L<<13;
+    public static final long CPU_FEATURE_AVX512DQ= 1L<<14;
+    public static final long CPU_FEATURE_AVX512CD= 1L<<15;
+    public static final long CPU_FEATURE_AVX512BW= 1L<<16;
+    public static final long CPU_FEATURE_AVX512VL= 1L<<17;
+    public static final long CPU_FEATURE_AVX512VBMI= 1L<<18;
+    public static final long CPU_FEATURE_AVX512VBMI2= 1L<<19;
+    public static final long CPU_FEATURE_AVX512BITALG= 1L<<20;
+    public static final long CPU_FEATURE_AVX512VPOPCNTDQ= 1L<<21;
+    public static final long CPU_FEATURE_RDTSCP= 1L<<22;
+    public static final long CPU_FEATURE_INVARIANT_TSC= 1L<<23;
+
+    // Layout of ArraysNative.cpuDescriptor: must be the same as in ArraysCpuDescriptor.h
+    static final int CPU_DESCRIPTOR_VENDOR= 0;
+    static final int CPU_DESCRIPTOR_FAMILY= 1;
+    static final int CPU_DESCRIPTOR_MODEL= 2;
+    static final int CPU_DESCRIPTOR_STEPPING= 3;
+    static final int CPU_DESCRIPTOR_FEATURES= 4;
+    static final int CPU_DESCRIPTOR_L1DATASIZE= 5;
+    static final int CPU_DESCRIPTOR_L1INSTRUCTIONSIZE= 6;
+    static final int CPU_DESCRIPTOR_L2SIZE= 7;
+    static final int CPU_DESCRIPTOR_L3SIZE= 8;
+    static final int CPU_DESCRIPTOR_CACHELINESIZE= 9;
+    static final int CPU_DESCRIPTOR_L2SHAREDBY= 10;
+    static final int CPU_DESCRIPTOR_L3SHAREDBY= 11;
+    static final int CPU_DESCRIPTOR_LOGICALPROCESSORS= 12;
+    static final int CPU_DESCRIPTOR_PHYSICALCORES= 13;
+    static final int CPU_DESCRIPTOR_PACKAGES= 14;
+    static final int CPU_DESCRIPTOR_NUMANODES= 15;
+    static final int CPU_DESCRIPTOR_NUMANODEMAP= 16;
+
     public static long getCpuInfo() {
         return ArraysNative.cpuInfo;
     }
@@ -2584,10 +4284,52 @@ public final class Arrays implements TrueStatic {
     public static long getCpuL2CacheSize() {  // in bytes
         return ((getCpuInfo()>>>CPU_L2SIZE_SHIFT)&CPU_L2SIZE)*CPU_L2SIZE_UNIT;
     }
+    public static int getCpuVendor() {
+        return (int)ArraysNative.cpuDescriptor[CPU_DESCRIPTOR_VENDOR];
+    }
+    public static long getCpuFeatures() {
+        return ArraysNative.cpuDescriptor[CPU_DESCRIPTOR_FEATURES];
+    }
+    public static long getCpuL3CacheSize() {  // in bytes, 0 if no L3
+        return ArraysNative.cpuDescriptor[CPU_DESCRIPTOR_L3SIZE];
+    }
+    public static long getCpuLastLevelCacheSize() {  // in bytes, 0 if unknown
+        long[] d= ArraysNative.cpuDescriptor;
+        return d[CPU_DESCRIPTOR_L3SIZE]>0? d[CPU_DESCRIPTOR_L3SIZE]:
+            d[CPU_DESCRIPTOR_L2SIZE]>0? d[CPU_DESCRIPTOR_L2SIZE]:
+            d[CPU_DESCRIPTOR_L1DATASIZE];
+    }
+    public static int getCpuCacheLineSize() {
+        return (int)ArraysNative.cpuDescriptor[CPU_DESCRIPTOR_CACHELINESIZE];
+    }
+    public static int getCpuLogicalProcessorCount() {
+        return (int)ArraysNative.cpuDescriptor[CPU_DESCRIPTOR_LOGICALPROCESSORS];
+    }
+    public static int getCpuPhysicalCoreCount() {
+        return (int)ArraysNative.cpuDescriptor[CPU_DESCRIPTOR_PHYSICALCORES];
+    }
+    public static int getCpuPackageCount() {
+        return (int)ArraysNative.cpuDescriptor[CPU_DESCRIPTOR_PACKAGES];
+    }
+    public static int getCpuNumaNodeCount() {
+        return (int)ArraysNative.cpuDescriptor[CPU_DESCRIPTOR_NUMANODES];
+    }
+    public static int getCpuNumaNode(int logicalProcessor) {
+        long[] d= ArraysNative.cpuDescriptor;
+        if (logicalProcessor<0 || CPU_DESCRIPTOR_NUMANODEMAP+logicalProcessor>=d.length) return 0;
+        return (int)d[CPU_DESCRIPTOR_NUMANODEMAP+logicalProcessor];
+    }
+    public static long[] getCpuDescriptor() {
+        // Full native CPU descriptor; see CPU_DESCRIPTOR_xxx indexes
+        return (long[])ArraysNative.cpuDescriptor.clone();
+    }
     public static void setCpuInfo(long v) {
         if ((v&CPU_MMX)==0) v&= ~(CPU_MMXEX|CPU_SSE|CPU_SSE2);
         if ((v&CPU_MMXEX)==0) v&= ~(CPU_SSE|CPU_SSE2);
         if ((v&CPU_SSE)==0) v&= ~CPU_SSE2;
+        if ((v&CPU_SSE2)==0) v&= ~(CPU_AVX2|CPU_AVX512|CPU_AVX512POPCNT);
+        if ((v&CPU_AVX2)==0) v&= ~(CPU_AVX512|CPU_AVX512POPCNT);
+        if ((v&CPU_AVX512)==0) v&= ~CPU_AVX512POPCNT;
         if ((v&CPU_3DNOW)==0) v&= ~CPU_3DNOWEX;
         ArraysNative.cpuInfo= v;
     }
@@ -2597,6 +4339,10 @@ public final class Arrays implements TrueStatic {
                 ArraysNative.getCpuInfoInternal():
                 0;
     }
+    public static String getNativeKernelsName() {
+        // "AVX-512", "AVX2", "SSE2" or "C++": the native code really used with the current CpuInfo
+        return ArraysNative.loaded? ArraysNative.getKernelsName(ArraysNative.cpuInfo): null;
+    }
     static boolean isNative = ArraysNative.loaded;  // for maximal speed
     public static boolean isNative() {
         return isNative;
@@ -2608,12 +4354,871 @@ public final class Arrays implements TrueStatic {
         return ArraysNative.initializationExceptionMessage;
     }
 
+    // Minimal lengths (in elements) for calling native code, separately for every element type;
+    // tuned by ArraysNativeCalibration when the native library is loaded
+    static final int NT_BYTE= 0, NT_CHAR= 1, NT_SHORT= 2, NT_INT= 3, NT_LONG= 4, NT_FLOAT= 5, NT_DOUBLE= 6, NT_OBJECT= 7;
+    static final int NT_COUNT= 8;
+    static final int[] nativeMinLensCopy= new int[NT_COUNT];
+    static final int[] nativeMinLensFill= new int[NT_COUNT];
+    static final int[] nativeMinLensPairOp= new int[NT_COUNT]; // also arithmetic, range, search, bits, histogram
+    // Matrix filters (filter3x3, xxxByRectangle): minimal number of matrix elements. The work per element and
+    // the native work memory depend on the filter, so the pairOp crossover is meaningless here; not calibrated.
+    static final int[] nativeMinLensMatrix= new int[NT_COUNT];
     private static int nativeMinLenFill= 100;
     private static int nativeMinLenPairOp= 100;
+    private static int nativeMinLenMatrix= 4096;
     public static int getNativeMinLenFill() {return nativeMinLenFill;}
-    public static void setNativeMinLenFill(int v) {nativeMinLenFill= max(v,0);}
+    public static void setNativeMinLenFill(int v) {
+        // Overrides calibrated thresholds of copying and filling for all element types
+        nativeMinLenFill= max(v,0);
+        for (int k=0; k<NT_COUNT; k++) nativeMinLensCopy[k]= nativeMinLensFill[k]= nativeMinLenFill;
+    }
     public static int getNativeMinLenPairOp() {return nativeMinLenPairOp;}
-    public static void setNativeMinLenPairOp(int v) {nativeMinLenPairOp= max(v,0);}
+    public static void setNativeMinLenPairOp(int v) {
+        // Overrides calibrated thresholds of min/max/minu/maxu for all element types
+        nativeMinLenPairOp= max(v,0);
+        for (int k=0; k<NT_COUNT; k++) nativeMinLensPairOp[k]= nativeMinLenPairOp;
+    }
+    public static int getNativeMinLenMatrix() {return nativeMinLenMatrix;}
+    public static void setNativeMinLenMatrix(int v) {
+        // Sets the thresholds of matrix filters for all element types
+        nativeMinLenMatrix= max(v,0);
+        for (int k=0; k<NT_COUNT; k++) nativeMinLensMatrix[k]= nativeMinLenMatrix;
+    }
+    public static int getNativeMinLenCopy(Class elementType) {return nativeMinLensCopy[nativeType(elementType)];}
+    public static int getNativeMinLenFill(Class elementType) {return nativeMinLensFill[nativeType(elementType)];}
+    public static int getNativeMinLenPairOp(Class elementType) {return nativeMinLensPairOp[nativeType(elementType)];}
+    public static boolean isNativeCalibrated() {
+        return ArraysNativeCalibration.calibrated;
+    }
+    public static void calibrateNative(boolean useCache) {
+        // Measures Java/native crossover lengths; useCache=false forces new measuring and rewrites the cache
+        if (!ArraysNative.loaded) return;
+        ArraysNativeCalibration.calibrate(useCache);
+    }
+    static int nativeType(Class elementType) {
+        return elementType==byte.class? NT_BYTE:
+            elementType==char.class? NT_CHAR:
+            elementType==short.class? NT_SHORT:
+            elementType==int.class? NT_INT:
+            elementType==long.class? NT_LONG:
+            elementType==float.class? NT_FLOAT:
+            elementType==double.class? NT_DOUBLE:
+            NT_OBJECT;
+    }
+    static {
+        setNativeMinLenFill(nativeMinLenFill);
+        setNativeMinLenPairOp(nativeMinLenPairOp);
+        setNativeMinLenMatrix(nativeMinLenMatrix);
+        if (ArraysNative.loaded && ArraysNativeCalibration.ENABLED) ArraysNativeCalibration.calibrate(true);
+    }
+
+    // Direct buffers of any element type, also mixed with Java arrays (the array is the first argument,
+    // like in JBuffers.minByteArrayAndBuffer). Offsets and lengths are measured in elements; buffer indexes
+    // are absolute, like in get(int) and put(int), and must be less than limit(). Native code processes
+    // direct buffers with the native byte order; other buffers are processed in Java.
+    public static void copy(Buffer a, int aofs, Buffer b, int bofs, int len) {
+        checkBuffer(a,aofs,len,false);
+        checkBuffer(b,bofs,len,true);
+        int nt= bufferType(a);
+        if (bufferType(b)!=nt) throw new IllegalArgumentException("Different element types in " + Arrays.class.getName() + ".copy(): "+JVM.toJavaClassName(a)+" and "+JVM.toJavaClassName(b));
+        if (len<=0) return;
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[nt] && a.isDirect() && b.isDirect()
+            && (nt==NT_BYTE || bufferOrder(a)==bufferOrder(b))) {
+            int log= NT_LOG_SIZES[nt];
+            if ((((long)Math.max(aofs,bofs)+len)<<log)<=Integer.MAX_VALUE) {
+                ArraysNative.copyBytesBuffer(ArraysNative.cpuInfo,a,aofs<<log,b,bofs<<log,len<<log);
+            } else {
+                ArraysNative.copyMemory(ArraysNative.cpuInfo,ArraysNative.directBufferAddress(a)+((long)aofs<<log),
+                    ArraysNative.directBufferAddress(b)+((long)bofs<<log),(long)len<<log);
+            }
+            return;
+        }
+        if (a instanceof ByteBuffer) {ByteBuffer s= ((ByteBuffer)a).duplicate(), d= ((ByteBuffer)b).duplicate(); s.limit(aofs+len).position(aofs); d.position(bofs); d.put(s);}
+        else if (a instanceof CharBuffer) {CharBuffer s= ((CharBuffer)a).duplicate(), d= ((CharBuffer)b).duplicate(); s.limit(aofs+len).position(aofs); d.position(bofs); d.put(s);}
+        else if (a instanceof ShortBuffer) {ShortBuffer s= ((ShortBuffer)a).duplicate(), d= ((ShortBuffer)b).duplicate(); s.limit(aofs+len).position(aofs); d.position(bofs); d.put(s);}
+        else if (a instanceof IntBuffer) {IntBuffer s= ((IntBuffer)a).duplicate(), d= ((IntBuffer)b).duplicate(); s.limit(aofs+len).position(aofs); d.position(bofs); d.put(s);}
+        else if (a instanceof LongBuffer) {LongBuffer s= ((LongBuffer)a).duplicate(), d= ((LongBuffer)b).duplicate(); s.limit(aofs+len).position(aofs); d.position(bofs); d.put(s);}
+        else if (a instanceof FloatBuffer) {FloatBuffer s= ((FloatBuffer)a).duplicate(), d= ((FloatBuffer)b).duplicate(); s.limit(aofs+len).position(aofs); d.position(bofs); d.put(s);}
+        else if (a instanceof DoubleBuffer) {DoubleBuffer s= ((DoubleBuffer)a).duplicate(), d= ((DoubleBuffer)b).duplicate(); s.limit(aofs+len).position(aofs); d.position(bofs); d.put(s);}
+    }
+    public static void copy(Object a, int aofs, Buffer b, int bofs, int len) {
+        if (a instanceof Buffer) {copy((Buffer)a,aofs,b,bofs,len); return;}
+        // a is a Java array
+        int nt= checkArrayAndBuffer(a,aofs,b,bofs,len,true);
+        if (len<=0) return;
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[nt] && isNativeBuffer(b)
+            && (((long)bofs+len)<<NT_LOG_SIZES[nt])<=Integer.MAX_VALUE) {
+            int log= NT_LOG_SIZES[nt];
+            ArraysNative.copyBytesBuffer(ArraysNative.cpuInfo,a,aofs<<log,b,bofs<<log,len<<log);
+            return;
+        }
+        bufferPut(b,bofs,a,aofs,len);
+    }
+    public static void copy(Buffer a, int aofs, Object b, int bofs, int len) {
+        // b is a Java array
+        int nt= checkArrayAndBuffer(b,bofs,a,aofs,len,false);
+        if (len<=0) return;
+        if (isNative && ArraysNative.copyBytesImplemented && len>nativeMinLensCopy[nt] && isNativeBuffer(a)
+            && (((long)aofs+len)<<NT_LOG_SIZES[nt])<=Integer.MAX_VALUE) {
+            int log= NT_LOG_SIZES[nt];
+            ArraysNative.copyBytesBuffer(ArraysNative.cpuInfo,a,aofs<<log,b,bofs<<log,len<<log);
+            return;
+        }
+        bufferGet(a,aofs,b,bofs,len);
+    }
+
+    // Copying with reversing the byte order of every element (big-endian <-> little-endian data): b[k] is a[k]
+    // with the reversed bytes; byte elements are copied without changes. The buffer is viewed as by get/put,
+    // so native code is used for direct buffers with the native byte order only. Reversed float and double
+    // values may be NaN: Java code doesn't guarantee preserving their bits, native code does.
+    public static void copyAndSwapByteOrder(Object a, int aofs, Buffer b, int bofs, int len) {
+        // a is a Java array
+        int nt= checkArrayAndBuffer(a,aofs,b,bofs,len,true);
+        if (len<=0) return;
+        if (isNative && ArraysNative.swapBytesImplemented && nt!=NT_BYTE && len>nativeMinLensCopy[nt] && isNativeBuffer(b)) {
+            swapBytesNative(nt,b,bofs,a,aofs,len);
+            return;
+        }
+        int blockLen= Math.min(len,BUFFER_BLOCK_LEN);
+        Object t= Array.newInstance(bufferElementType(b),blockLen);
+        for (int k=0; k<len; k+=blockLen) {
+            int n= Math.min(len-k,blockLen);
+            System.arraycopy(a,aofs+k,t,0,n);
+            swapBytesJava(t,0,n);
+            bufferPut(b,bofs+k,t,0,n);
+        }
+    }
+    public static void copyAndSwapByteOrder(Buffer a, int aofs, Object b, int bofs, int len) {
+        // b is a Java array
+        int nt= checkArrayAndBuffer(b,bofs,a,aofs,len,false);
+        if (len<=0) return;
+        if (isNative && ArraysNative.swapBytesImplemented && nt!=NT_BYTE && len>nativeMinLensCopy[nt] && isNativeBuffer(a)) {
+            swapBytesNative(nt,b,bofs,a,aofs,len);
+            return;
+        }
+        bufferGet(a,aofs,b,bofs,len);
+        swapBytesJava(b,bofs,len);
+    }
+    // The same in place: a is a Java array or a buffer
+    public static void swapByteOrder(Object a, int ofs, int len) {
+        if (a instanceof Buffer) {
+            Buffer b= (Buffer)a;
+            checkBuffer(b,ofs,len,true);
+            int nt= bufferType(b);
+            if (len<=0 || nt==NT_BYTE) return;
+            if (isNative && ArraysNative.swapBytesImplemented && len>nativeMinLensCopy[nt] && isNativeBuffer(b)) {
+                swapBytesNative(nt,b,ofs,b,ofs,len);
+                return;
+            }
+            int blockLen= Math.min(len,BUFFER_BLOCK_LEN);
+            Object t= Array.newInstance(bufferElementType(b),blockLen);
+            for (int k=0; k<len; k+=blockLen) {
+                int n= Math.min(len-k,blockLen);
+                bufferGet(b,ofs+k,t,0,n);
+                swapBytesJava(t,0,n);
+                bufferPut(b,ofs+k,t,0,n);
+            }
+            return;
+        }
+        if (a==null) throw new NullPointerException("Null array argument in " + Arrays.class.getName());
+        int nt= nativeType(a.getClass().getComponentType());
+        if (nt==NT_OBJECT) throw new IllegalArgumentException("Unsupported argument type in " + Arrays.class.getName() + ".swapByteOrder(): "+JVM.toJavaClassName(a));
+        if (len<0) throw new IllegalArgumentException("Negative length in " + Arrays.class.getName());
+        if (ofs<0 || ofs>Array.getLength(a)-len) throw new IndexOutOfBoundsException("Array range "+ofs+".."+((long)ofs+len-1)+" is out of 0.."+(Array.getLength(a)-1)+" in " + Arrays.class.getName());
+        if (len<=0 || nt==NT_BYTE) return;
+        if (isNative && ArraysNative.swapBytesImplemented && len>nativeMinLensCopy[nt]) {
+            swapBytesNative(nt,a,ofs,a,ofs,len);
+            return;
+        }
+        swapBytesJava(a,ofs,len);
+    }
+
+    private static void swapBytesNative(int nt, Object dest, int destOfs, Object src, int srcOfs, int len) {
+        switch (NT_LOG_SIZES[nt]) {
+            case 1: ArraysNative.copyAndSwapShorts(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,len); break;
+            case 2: ArraysNative.copyAndSwapInts(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,len); break;
+            case 3: ArraysNative.copyAndSwapLongs(ArraysNative.cpuInfo,dest,destOfs,src,srcOfs,len); break;
+        }
+    }
+    private static void swapBytesJava(Object a, int ofs, int len) {
+        if (a instanceof char[]) {char[] b= (char[])a; for (int k=ofs,kMax=ofs+len; k<kMax; k++) b[k]= (char)((b[k]<<8)|(b[k]>>>8));}
+        else if (a instanceof short[]) {short[] b= (short[])a; for (int k=ofs,kMax=ofs+len; k<kMax; k++) b[k]= (short)((b[k]<<8)|((b[k]>>8)&0xFF));}
+        else if (a instanceof int[]) {int[] b= (int[])a; for (int k=ofs,kMax=ofs+len; k<kMax; k++) b[k]= reverseBytes(b[k]);}
+        else if (a instanceof long[]) {long[] b= (long[])a; for (int k=ofs,kMax=ofs+len; k<kMax; k++) b[k]= reverseBytes(b[k]);}
+        else if (a instanceof float[]) {float[] b= (float[])a; for (int k=ofs,kMax=ofs+len; k<kMax; k++) b[k]= Float.intBitsToFloat(reverseBytes(Float.floatToRawIntBits(b[k])));}
+        else if (a instanceof double[]) {double[] b= (double[])a; for (int k=ofs,kMax=ofs+len; k<kMax; k++) b[k]= Double.longBitsToDouble(reverseBytes(Double.doubleToRawLongBits(b[k])));}
+    }
+    private static int reverseBytes(int v) {
+        return (v<<24)|((v&0xFF00)<<8)|((v>>>8)&0xFF00)|(v>>>24);
+    }
+    private static long reverseBytes(long v) {
+        return ((long)reverseBytes((int)v)<<32)|(reverseBytes((int)(v>>>32))&0xFFFFFFFFL);
+    }
+
+    public static void fill(ByteBuffer a, int beginIndex, int endIndex, byte v) {
+        checkBuffer(a,beginIndex,endIndex-beginIndex,true);
+        int n= endIndex-beginIndex;
+        if (isNative && ArraysNative.fillImplemented && n>nativeMinLensFill[NT_BYTE] && isNativeBuffer(a)) {
+            long address= ArraysNative.directBufferAddress(a)+((long)beginIndex<<NT_LOG_SIZES[NT_BYTE]);
+            ArraysNative.fillBytes(ArraysNative.cpuInfo,address,n,v);
+            return;
+        }
+        for (int k=beginIndex; k<endIndex; k++) a.put(k,v);
+    }
+    public static void fill(CharBuffer a, int beginIndex, int endIndex, char v) {
+        checkBuffer(a,beginIndex,endIndex-beginIndex,true);
+        int n= endIndex-beginIndex;
+        if (isNative && ArraysNative.fillImplemented && n>nativeMinLensFill[NT_CHAR] && isNativeBuffer(a)) {
+            long address= ArraysNative.directBufferAddress(a)+((long)beginIndex<<NT_LOG_SIZES[NT_CHAR]);
+            ArraysNative.fillShorts(ArraysNative.cpuInfo,address,n,(short)v);
+            return;
+        }
+        for (int k=beginIndex; k<endIndex; k++) a.put(k,v);
+    }
+    public static void fill(ShortBuffer a, int beginIndex, int endIndex, short v) {
+        checkBuffer(a,beginIndex,endIndex-beginIndex,true);
+        int n= endIndex-beginIndex;
+        if (isNative && ArraysNative.fillImplemented && n>nativeMinLensFill[NT_SHORT] && isNativeBuffer(a)) {
+            long address= ArraysNative.directBufferAddress(a)+((long)beginIndex<<NT_LOG_SIZES[NT_SHORT]);
+            ArraysNative.fillShorts(ArraysNative.cpuInfo,address,n,v);
+            return;
+        }
+        for (int k=beginIndex; k<endIndex; k++) a.put(k,v);
+    }
+    public static void fill(IntBuffer a, int beginIndex, int endIndex, int v) {
+        checkBuffer(a,beginIndex,endIndex-beginIndex,true);
+        int n= endIndex-beginIndex;
+        if (isNative && ArraysNative.fillImplemented && n>nativeMinLensFill[NT_INT] && isNativeBuffer(a)) {
+            long address= ArraysNative.directBufferAddress(a)+((long)beginIndex<<NT_LOG_SIZES[NT_INT]);
+            ArraysNative.fillInts(ArraysNative.cpuInfo,address,n,v);
+            return;
+        }
+        for (int k=beginIndex; k<endIndex; k++) a.put(k,v);
+    }
+    public static void fill(LongBuffer a, int beginIndex, int endIndex, long v) {
+        checkBuffer(a,beginIndex,endIndex-beginIndex,true);
+        int n= endIndex-beginIndex;
+        if (isNative && ArraysNative.fillImplemented && n>nativeMinLensFill[NT_LONG] && isNativeBuffer(a)) {
+            long address= ArraysNative.directBufferAddress(a)+((long)beginIndex<<NT_LOG_SIZES[NT_LONG]);
+            ArraysNative.fillLongs(ArraysNative.cpuInfo,address,n,v);
+            return;
+        }
+        for (int k=beginIndex; k<endIndex; k++) a.put(k,v);
+    }
+    public static void fill(FloatBuffer a, int beginIndex, int endIndex, float v) {
+        checkBuffer(a,beginIndex,endIndex-beginIndex,true);
+        int n= endIndex-beginIndex;
+        if (isNative && ArraysNative.fillImplemented && n>nativeMinLensFill[NT_FLOAT] && isNativeBuffer(a)) {
+            long address= ArraysNative.directBufferAddress(a)+((long)beginIndex<<NT_LOG_SIZES[NT_FLOAT]);
+            ArraysNative.fillInts(ArraysNative.cpuInfo,address,n,Float.floatToRawIntBits(v));
+            return;
+        }
+        for (int k=beginIndex; k<endIndex; k++) a.put(k,v);
+    }
+    public static void fill(DoubleBuffer a, int beginIndex, int endIndex, double v) {
+        checkBuffer(a,beginIndex,endIndex-beginIndex,true);
+        int n= endIndex-beginIndex;
+        if (isNative && ArraysNative.fillImplemented && n>nativeMinLensFill[NT_DOUBLE] && isNativeBuffer(a)) {
+            long address= ArraysNative.directBufferAddress(a)+((long)beginIndex<<NT_LOG_SIZES[NT_DOUBLE]);
+            ArraysNative.fillLongs(ArraysNative.cpuInfo,address,n,Double.doubleToRawLongBits(v));
+            return;
+        }
+        for (int k=beginIndex; k<endIndex; k++) a.put(k,v);
+    }
+
+    // a[k]= min(a[k],b[k]) etc.: byte, short, int, long, float and double elements;
+    // char elements are always compared as unsigned; minu/maxu compare byte, short, int and long elements
+    // as unsigned and are equivalent to min/max for other types
+    public static void min(Buffer a, int aofs, Buffer b, int bofs, int len)  {pairOpBuffer(PAIR_OP_MIN,a,aofs,b,bofs,len);}
+    public static void max(Buffer a, int aofs, Buffer b, int bofs, int len)  {pairOpBuffer(PAIR_OP_MAX,a,aofs,b,bofs,len);}
+    public static void minu(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_MINU,a,aofs,b,bofs,len);}
+    public static void maxu(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_MAXU,a,aofs,b,bofs,len);}
+    public static void min(Object a, int aofs, Buffer b, int bofs, int len)  {pairOpBuffer(PAIR_OP_MIN,a,aofs,b,bofs,len);}
+    public static void max(Object a, int aofs, Buffer b, int bofs, int len)  {pairOpBuffer(PAIR_OP_MAX,a,aofs,b,bofs,len);}
+    public static void minu(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_MINU,a,aofs,b,bofs,len);}
+    public static void maxu(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_MAXU,a,aofs,b,bofs,len);}
+
+    // a[k]+= b[k], a[k]-= b[k], a[k]= |a[k]-b[k]|, a[k]= -b[k] etc., see the same methods for arrays:
+    // a and b must have the same element type, supported by the corresponding array method
+    public static void add(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ADD,a,aofs,b,bofs,len);}
+    public static void sub(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_SUB,a,aofs,b,bofs,len);}
+    public static void adds(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ADDS,a,aofs,b,bofs,len);}
+    public static void subs(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_SUBS,a,aofs,b,bofs,len);}
+    public static void addus(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ADDUS,a,aofs,b,bofs,len);}
+    public static void subus(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_SUBUS,a,aofs,b,bofs,len);}
+    public static void absDiff(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ABSDIFF,a,aofs,b,bofs,len);}
+    public static void absDiffu(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ABSDIFFU,a,aofs,b,bofs,len);}
+    public static void opposite(Buffer a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_OPPOSITE,a,aofs,b,bofs,len);}
+    public static void add(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ADD,a,aofs,b,bofs,len);}
+    public static void sub(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_SUB,a,aofs,b,bofs,len);}
+    public static void adds(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ADDS,a,aofs,b,bofs,len);}
+    public static void subs(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_SUBS,a,aofs,b,bofs,len);}
+    public static void addus(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ADDUS,a,aofs,b,bofs,len);}
+    public static void subus(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_SUBUS,a,aofs,b,bofs,len);}
+    public static void absDiff(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ABSDIFF,a,aofs,b,bofs,len);}
+    public static void absDiffu(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_ABSDIFFU,a,aofs,b,bofs,len);}
+    public static void opposite(Object a, int aofs, Buffer b, int bofs, int len) {pairOpBuffer(PAIR_OP_OPPOSITE,a,aofs,b,bofs,len);}
+
+    // range(...) for buffers: ofs is an absolute index, the found indexes are absolute too
+    public static long[] range(ByteBuffer a, int ofs, int len) {return (long[])rangeBuffer(a,ofs,len);}
+    public static long[] range(CharBuffer a, int ofs, int len) {return (long[])rangeBuffer(a,ofs,len);}
+    public static long[] range(ShortBuffer a, int ofs, int len) {return (long[])rangeBuffer(a,ofs,len);}
+    public static long[] range(IntBuffer a, int ofs, int len) {return (long[])rangeBuffer(a,ofs,len);}
+    public static long[] range(LongBuffer a, int ofs, int len) {return (long[])rangeBuffer(a,ofs,len);}
+    public static double[] range(FloatBuffer a, int ofs, int len) {return (double[])rangeBuffer(a,ofs,len);}
+    public static double[] range(DoubleBuffer a, int ofs, int len) {return (double[])rangeBuffer(a,ofs,len);}
+
+    // indexOf(...) and lastIndexOf(...) for buffers: the first (last) absolute index k in ofs..ofs+len-1,
+    // where a.get(k)==b, or -1; float and double values are compared by ==, so NaN is found only by indexOfNaN
+    public static int indexOf(ByteBuffer a, int ofs, int len, byte b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_BYTE] && isNativeBuffer(a))
+            return ArraysNative.indexOfBytes(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) if (a.get(k)==b) return k; return -1;
+    }
+    public static int indexOf(CharBuffer a, int ofs, int len, char b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_CHAR] && isNativeBuffer(a))
+            return ArraysNative.indexOfChars(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) if (a.get(k)==b) return k; return -1;
+    }
+    public static int indexOf(ShortBuffer a, int ofs, int len, short b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_SHORT] && isNativeBuffer(a))
+            return ArraysNative.indexOfShorts(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) if (a.get(k)==b) return k; return -1;
+    }
+    public static int indexOf(IntBuffer a, int ofs, int len, int b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_INT] && isNativeBuffer(a))
+            return ArraysNative.indexOfInts(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) if (a.get(k)==b) return k; return -1;
+    }
+    public static int indexOf(LongBuffer a, int ofs, int len, long b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_LONG] && isNativeBuffer(a))
+            return ArraysNative.indexOfLongs(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) if (a.get(k)==b) return k; return -1;
+    }
+    public static int indexOf(FloatBuffer a, int ofs, int len, float b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && b==b && len>nativeMinLensPairOp[NT_FLOAT] && isNativeBuffer(a))
+            return ArraysNative.indexOfFloats(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) if (a.get(k)==b) return k; return -1;
+    }
+    public static int indexOf(DoubleBuffer a, int ofs, int len, double b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && b==b && len>nativeMinLensPairOp[NT_DOUBLE] && isNativeBuffer(a))
+            return ArraysNative.indexOfDoubles(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) if (a.get(k)==b) return k; return -1;
+    }
+    public static int lastIndexOf(ByteBuffer a, int ofs, int len, byte b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_BYTE] && isNativeBuffer(a))
+            return ArraysNative.lastIndexOfBytes(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs+len-1; k>=ofs; k--) if (a.get(k)==b) return k; return -1;
+    }
+    public static int lastIndexOf(CharBuffer a, int ofs, int len, char b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_CHAR] && isNativeBuffer(a))
+            return ArraysNative.lastIndexOfChars(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs+len-1; k>=ofs; k--) if (a.get(k)==b) return k; return -1;
+    }
+    public static int lastIndexOf(ShortBuffer a, int ofs, int len, short b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_SHORT] && isNativeBuffer(a))
+            return ArraysNative.lastIndexOfShorts(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs+len-1; k>=ofs; k--) if (a.get(k)==b) return k; return -1;
+    }
+    public static int lastIndexOf(IntBuffer a, int ofs, int len, int b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_INT] && isNativeBuffer(a))
+            return ArraysNative.lastIndexOfInts(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs+len-1; k>=ofs; k--) if (a.get(k)==b) return k; return -1;
+    }
+    public static int lastIndexOf(LongBuffer a, int ofs, int len, long b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_LONG] && isNativeBuffer(a))
+            return ArraysNative.lastIndexOfLongs(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs+len-1; k>=ofs; k--) if (a.get(k)==b) return k; return -1;
+    }
+    public static int lastIndexOf(FloatBuffer a, int ofs, int len, float b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && b==b && len>nativeMinLensPairOp[NT_FLOAT] && isNativeBuffer(a))
+            return ArraysNative.lastIndexOfFloats(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs+len-1; k>=ofs; k--) if (a.get(k)==b) return k; return -1;
+    }
+    public static int lastIndexOf(DoubleBuffer a, int ofs, int len, double b) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && b==b && len>nativeMinLensPairOp[NT_DOUBLE] && isNativeBuffer(a))
+            return ArraysNative.lastIndexOfDoubles(ArraysNative.cpuInfo,a,ofs,len,b);
+        for (int k=ofs+len-1; k>=ofs; k--) if (a.get(k)==b) return k; return -1;
+    }
+    public static int indexOfNaN(FloatBuffer a, int ofs, int len) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_FLOAT] && isNativeBuffer(a))
+            return ArraysNative.indexOfFloats(ArraysNative.cpuInfo,a,ofs,len,Float.NaN);
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) if (Float.isNaN(a.get(k))) return k; return -1;
+    }
+    public static int indexOfNaN(DoubleBuffer a, int ofs, int len) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_DOUBLE] && isNativeBuffer(a))
+            return ArraysNative.indexOfDoubles(ArraysNative.cpuInfo,a,ofs,len,Double.NaN);
+        for (int k=ofs,kMax=ofs+len; k<kMax; k++) if (Double.isNaN(a.get(k))) return k; return -1;
+    }
+    public static int lastIndexOfNaN(FloatBuffer a, int ofs, int len) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_FLOAT] && isNativeBuffer(a))
+            return ArraysNative.lastIndexOfFloats(ArraysNative.cpuInfo,a,ofs,len,Float.NaN);
+        for (int k=ofs+len-1; k>=ofs; k--) if (Float.isNaN(a.get(k))) return k; return -1;
+    }
+    public static int lastIndexOfNaN(DoubleBuffer a, int ofs, int len) {
+        checkBuffer(a,ofs,len,false);
+        if (isNative && ArraysNative.searchImplemented && len>nativeMinLensPairOp[NT_DOUBLE] && isNativeBuffer(a))
+            return ArraysNative.lastIndexOfDoubles(ArraysNative.cpuInfo,a,ofs,len,Double.NaN);
+        for (int k=ofs+len-1; k>=ofs; k--) if (Double.isNaN(a.get(k))) return k; return -1;
+    }
+
+    private static Object rangeBuffer(Buffer a, int ofs, int len) {
+        checkBuffer(a,ofs,len,false);
+        int nt= bufferType(a);
+        boolean floating= nt==NT_FLOAT || nt==NT_DOUBLE;
+        long[] lr= floating? null: new long[RANGE_LENGTH];
+        double[] dr= floating? new double[RANGE_LENGTH]: null;
+        if (isNative && ArraysNative.rangeImplemented && len>nativeMinLensPairOp[nt] && isNativeBuffer(a)) {
+            long ci= ArraysNative.cpuInfo;
+            switch (nt) {
+                case NT_BYTE: ArraysNative.rangeBytes(ci,a,ofs,len,lr); return lr;
+                case NT_CHAR: ArraysNative.rangeChars(ci,a,ofs,len,lr); return lr;
+                case NT_SHORT: ArraysNative.rangeShorts(ci,a,ofs,len,lr); return lr;
+                case NT_INT: ArraysNative.rangeInts(ci,a,ofs,len,lr); return lr;
+                case NT_LONG: ArraysNative.rangeLongs(ci,a,ofs,len,lr); return lr;
+                case NT_FLOAT: ArraysNative.rangeFloats(ci,a,ofs,len,dr); return dr;
+                case NT_DOUBLE: ArraysNative.rangeDoubles(ci,a,ofs,len,dr); return dr;
+            }
+        }
+        // Java: staging buffer blocks through a Java array; a later block wins only with a strictly better value
+        if (floating) {dr[RANGE_MIN_INDEX]= -1; dr[RANGE_MAX_INDEX]= -1;}
+        else {lr[RANGE_MIN_INDEX]= -1; lr[RANGE_MAX_INDEX]= -1;}
+        int blockLen= Math.min(len,BUFFER_BLOCK_LEN);
+        Object t= Array.newInstance(bufferElementType(a),blockLen);
+        for (int k=0; k<len; k+=blockLen) {
+            int n= Math.min(len-k,blockLen);
+            bufferGet(a,ofs+k,t,0,n);
+            if (floating) {
+                double[] br= t instanceof float[]? range((float[])t,0,n): range((double[])t,0,n);
+                dr[RANGE_SUM]+= br[RANGE_SUM];
+                if (br[RANGE_MIN_INDEX]<0) continue; // only NaN
+                if (dr[RANGE_MIN_INDEX]<0 || br[RANGE_MIN]<dr[RANGE_MIN]) {dr[RANGE_MIN]= br[RANGE_MIN]; dr[RANGE_MIN_INDEX]= ofs+k+br[RANGE_MIN_INDEX];}
+                if (dr[RANGE_MAX_INDEX]<0 || br[RANGE_MAX]>dr[RANGE_MAX]) {dr[RANGE_MAX]= br[RANGE_MAX]; dr[RANGE_MAX_INDEX]= ofs+k+br[RANGE_MAX_INDEX];}
+            } else {
+                long[] br= t instanceof byte[]? range((byte[])t,0,n):
+                    t instanceof char[]? range((char[])t,0,n):
+                    t instanceof short[]? range((short[])t,0,n):
+                    t instanceof int[]? range((int[])t,0,n): range((long[])t,0,n);
+                lr[RANGE_SUM]+= br[RANGE_SUM];
+                if (lr[RANGE_MIN_INDEX]<0 || br[RANGE_MIN]<lr[RANGE_MIN]) {lr[RANGE_MIN]= br[RANGE_MIN]; lr[RANGE_MIN_INDEX]= ofs+k+br[RANGE_MIN_INDEX];}
+                if (lr[RANGE_MAX_INDEX]<0 || br[RANGE_MAX]>lr[RANGE_MAX]) {lr[RANGE_MAX]= br[RANGE_MAX]; lr[RANGE_MAX_INDEX]= ofs+k+br[RANGE_MAX_INDEX];}
+            }
+        }
+        return floating? (Object)dr: lr;
+    }
+
+    private static final int PAIR_OP_MIN= 0, PAIR_OP_MAX= 1, PAIR_OP_MINU= 2, PAIR_OP_MAXU= 3;
+    private static final int PAIR_OP_ADD= 4, PAIR_OP_SUB= 5, PAIR_OP_ADDS= 6, PAIR_OP_SUBS= 7,
+        PAIR_OP_ADDUS= 8, PAIR_OP_SUBUS= 9, PAIR_OP_ABSDIFF= 10, PAIR_OP_ABSDIFFU= 11, PAIR_OP_OPPOSITE= 12;
+    private static final int[] NT_LOG_SIZES= {0,1,1,2,3,2,3};
+    private static final int BUFFER_BLOCK_LEN= 4096; // elements staged through Java arrays at once
+
+    private static void pairOpBuffer(int op, Object a, int aofs, Buffer b, int bofs, int len) {
+        boolean aBuffer= a instanceof Buffer;
+        int nt;
+        if (aBuffer) {
+            checkBuffer((Buffer)a,aofs,len,true);
+            checkBuffer(b,bofs,len,false);
+            nt= bufferType((Buffer)a);
+            if (bufferType(b)!=nt) throw new IllegalArgumentException("Different element types in " + Arrays.class.getName() + ": "+JVM.toJavaClassName(a)+" and "+JVM.toJavaClassName(b));
+        } else {
+            nt= checkArrayAndBuffer(a,aofs,b,bofs,len,false);
+        }
+        if (len<=0) return;
+        if (op<=PAIR_OP_MAXU && nt!=NT_BYTE && nt!=NT_SHORT && nt!=NT_INT && nt!=NT_LONG) op&= PAIR_OP_MAX; // minu/maxu are min/max for other types
+        boolean implemented= op>=PAIR_OP_ADD? ArraysNative.arithmeticImplemented:
+            op>=PAIR_OP_MINU? ArraysNative.minmaxuImplemented: ArraysNative.minmaxImplemented;
+        if (isNative && implemented && len>nativeMinLensPairOp[nt] && isNativeBuffer(b) && (!aBuffer || isNativeBuffer((Buffer)a))) {
+            long ci= ArraysNative.cpuInfo;
+            switch (op*NT_COUNT+nt) {
+                case PAIR_OP_MIN*NT_COUNT+NT_BYTE: ArraysNative.minBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAX*NT_COUNT+NT_BYTE: ArraysNative.maxBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MINU*NT_COUNT+NT_BYTE: ArraysNative.minuBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAXU*NT_COUNT+NT_BYTE: ArraysNative.maxuBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MIN*NT_COUNT+NT_SHORT: ArraysNative.minShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAX*NT_COUNT+NT_SHORT: ArraysNative.maxShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MINU*NT_COUNT+NT_SHORT: ArraysNative.minuShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAXU*NT_COUNT+NT_SHORT: ArraysNative.maxuShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MIN*NT_COUNT+NT_CHAR: ArraysNative.minuShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAX*NT_COUNT+NT_CHAR: ArraysNative.maxuShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MIN*NT_COUNT+NT_INT: ArraysNative.minIntsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAX*NT_COUNT+NT_INT: ArraysNative.maxIntsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MINU*NT_COUNT+NT_INT: ArraysNative.minuIntsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAXU*NT_COUNT+NT_INT: ArraysNative.maxuIntsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MIN*NT_COUNT+NT_LONG: ArraysNative.minLongsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAX*NT_COUNT+NT_LONG: ArraysNative.maxLongsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MINU*NT_COUNT+NT_LONG: ArraysNative.minuLongsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAXU*NT_COUNT+NT_LONG: ArraysNative.maxuLongsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MIN*NT_COUNT+NT_FLOAT: ArraysNative.minFloatsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAX*NT_COUNT+NT_FLOAT: ArraysNative.maxFloatsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MIN*NT_COUNT+NT_DOUBLE: ArraysNative.minDoublesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_MAX*NT_COUNT+NT_DOUBLE: ArraysNative.maxDoublesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADD*NT_COUNT+NT_BYTE: ArraysNative.addBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADD*NT_COUNT+NT_SHORT: ArraysNative.addShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADD*NT_COUNT+NT_INT: ArraysNative.addIntsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADD*NT_COUNT+NT_LONG: ArraysNative.addLongsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADD*NT_COUNT+NT_FLOAT: ArraysNative.addFloatsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADD*NT_COUNT+NT_DOUBLE: ArraysNative.addDoublesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUB*NT_COUNT+NT_BYTE: ArraysNative.subBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUB*NT_COUNT+NT_SHORT: ArraysNative.subShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUB*NT_COUNT+NT_INT: ArraysNative.subIntsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUB*NT_COUNT+NT_LONG: ArraysNative.subLongsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUB*NT_COUNT+NT_FLOAT: ArraysNative.subFloatsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUB*NT_COUNT+NT_DOUBLE: ArraysNative.subDoublesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADDS*NT_COUNT+NT_BYTE: ArraysNative.addsBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADDS*NT_COUNT+NT_SHORT: ArraysNative.addsShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUBS*NT_COUNT+NT_BYTE: ArraysNative.subsBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUBS*NT_COUNT+NT_SHORT: ArraysNative.subsShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADDUS*NT_COUNT+NT_BYTE: ArraysNative.addusBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ADDUS*NT_COUNT+NT_SHORT: ArraysNative.addusShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUBUS*NT_COUNT+NT_BYTE: ArraysNative.subusBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_SUBUS*NT_COUNT+NT_SHORT: ArraysNative.subusShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFF*NT_COUNT+NT_BYTE: ArraysNative.absDiffBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFF*NT_COUNT+NT_SHORT: ArraysNative.absDiffShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFF*NT_COUNT+NT_INT: ArraysNative.absDiffIntsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFF*NT_COUNT+NT_LONG: ArraysNative.absDiffLongsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFF*NT_COUNT+NT_FLOAT: ArraysNative.absDiffFloatsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFF*NT_COUNT+NT_DOUBLE: ArraysNative.absDiffDoublesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFFU*NT_COUNT+NT_BYTE: ArraysNative.absDiffuBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFFU*NT_COUNT+NT_SHORT: ArraysNative.absDiffuShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFFU*NT_COUNT+NT_INT: ArraysNative.absDiffuIntsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_ABSDIFFU*NT_COUNT+NT_LONG: ArraysNative.absDiffuLongsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_OPPOSITE*NT_COUNT+NT_BYTE: ArraysNative.oppositeBytesBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_OPPOSITE*NT_COUNT+NT_SHORT: ArraysNative.oppositeShortsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_OPPOSITE*NT_COUNT+NT_INT: ArraysNative.oppositeIntsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_OPPOSITE*NT_COUNT+NT_LONG: ArraysNative.oppositeLongsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_OPPOSITE*NT_COUNT+NT_FLOAT: ArraysNative.oppositeFloatsBuffer(ci,a,aofs,b,bofs,len); return;
+                case PAIR_OP_OPPOSITE*NT_COUNT+NT_DOUBLE: ArraysNative.oppositeDoublesBuffer(ci,a,aofs,b,bofs,len); return;
+            }
+        }
+        // Java: staging buffer blocks through Java arrays
+        Class elementType= bufferElementType(b);
+        int blockLen= Math.min(len,BUFFER_BLOCK_LEN);
+        Object ta= aBuffer? Array.newInstance(elementType,blockLen): a;
+        Object tb= Array.newInstance(elementType,blockLen);
+        for (int k=0; k<len; k+=blockLen) {
+            int n= Math.min(len-k,blockLen);
+            int ao= aBuffer? 0: aofs+k;
+            if (aBuffer) bufferGet((Buffer)a,aofs+k,ta,0,n);
+            bufferGet(b,bofs+k,tb,0,n);
+            pairOpArrays(op,ta,ao,tb,0,n);
+            if (aBuffer) bufferPut((Buffer)a,aofs+k,ta,0,n);
+        }
+    }
+
+    private static void pairOpArrays(int op, Object a, int aofs, Object b, int bofs, int len) {
+        if (a instanceof byte[]) {
+            byte[] x= (byte[])a, y= (byte[])b;
+            switch (op) {
+                case PAIR_OP_MIN: min(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAX: max(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MINU: minu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAXU: maxu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADD: add(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUB: sub(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADDS: adds(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUBS: subs(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADDUS: addus(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUBUS: subus(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFF: absDiff(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFFU: absDiffu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_OPPOSITE: opposite(x,aofs,y,bofs,len); return;
+            }
+        } else if (a instanceof char[]) {
+            char[] x= (char[])a, y= (char[])b;
+            switch (op) {
+                case PAIR_OP_MIN: min(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAX: max(x,aofs,y,bofs,len); return;
+            }
+        } else if (a instanceof short[]) {
+            short[] x= (short[])a, y= (short[])b;
+            switch (op) {
+                case PAIR_OP_MIN: min(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAX: max(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MINU: minu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAXU: maxu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADD: add(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUB: sub(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADDS: adds(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUBS: subs(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADDUS: addus(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUBUS: subus(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFF: absDiff(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFFU: absDiffu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_OPPOSITE: opposite(x,aofs,y,bofs,len); return;
+            }
+        } else if (a instanceof int[]) {
+            int[] x= (int[])a, y= (int[])b;
+            switch (op) {
+                case PAIR_OP_MIN: min(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAX: max(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MINU: minu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAXU: maxu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADD: add(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUB: sub(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFF: absDiff(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFFU: absDiffu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_OPPOSITE: opposite(x,aofs,y,bofs,len); return;
+            }
+        } else if (a instanceof long[]) {
+            long[] x= (long[])a, y= (long[])b;
+            switch (op) {
+                case PAIR_OP_MIN: min(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAX: max(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MINU: minu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAXU: maxu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADD: add(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUB: sub(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFF: absDiff(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFFU: absDiffu(x,aofs,y,bofs,len); return;
+                case PAIR_OP_OPPOSITE: opposite(x,aofs,y,bofs,len); return;
+            }
+        } else if (a instanceof float[]) {
+            float[] x= (float[])a, y= (float[])b;
+            switch (op) {
+                case PAIR_OP_MIN: min(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAX: max(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADD: add(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUB: sub(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFF: absDiff(x,aofs,y,bofs,len); return;
+                case PAIR_OP_OPPOSITE: opposite(x,aofs,y,bofs,len); return;
+            }
+        } else if (a instanceof double[]) {
+            double[] x= (double[])a, y= (double[])b;
+            switch (op) {
+                case PAIR_OP_MIN: min(x,aofs,y,bofs,len); return;
+                case PAIR_OP_MAX: max(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ADD: add(x,aofs,y,bofs,len); return;
+                case PAIR_OP_SUB: sub(x,aofs,y,bofs,len); return;
+                case PAIR_OP_ABSDIFF: absDiff(x,aofs,y,bofs,len); return;
+                case PAIR_OP_OPPOSITE: opposite(x,aofs,y,bofs,len); return;
+            }
+        }
+        throw new IllegalArgumentException("Unsupported operation for " + JVM.toJavaClassName(a) + " in " + Arrays.class.getName());
+    }
+
+    private static Class bufferElementType(Buffer b) {
+        if (b instanceof ByteBuffer) return byte.class;
+        if (b instanceof CharBuffer) return char.class;
+        if (b instanceof ShortBuffer) return short.class;
+        if (b instanceof IntBuffer) return int.class;
+        if (b instanceof LongBuffer) return long.class;
+        if (b instanceof FloatBuffer) return float.class;
+        if (b instanceof DoubleBuffer) return double.class;
+        throw new IllegalArgumentException("Unsupported buffer type in " + Arrays.class.getName() + ": "+JVM.toJavaClassName(b));
+    }
+    private static int bufferType(Buffer b) {
+        return nativeType(bufferElementType(b));
+    }
+    private static ByteOrder bufferOrder(Buffer b) {
+        if (b instanceof ByteBuffer) return ((ByteBuffer)b).order();
+        if (b instanceof CharBuffer) return ((CharBuffer)b).order();
+        if (b instanceof ShortBuffer) return ((ShortBuffer)b).order();
+        if (b instanceof IntBuffer) return ((IntBuffer)b).order();
+        if (b instanceof LongBuffer) return ((LongBuffer)b).order();
+        if (b instanceof FloatBuffer) return ((FloatBuffer)b).order();
+        return ((DoubleBuffer)b).order();
+    }
+    private static boolean isNativeBuffer(Buffer b) {
+        // the native code sees the buffer elements exactly as Java
+        return b.isDirect() && (b instanceof ByteBuffer || bufferOrder(b)==ByteOrder.nativeOrder());
+    }
+    private static void checkBuffer(Buffer b, int ofs, int len, boolean write) {
+        if (len<0) throw new IllegalArgumentException("Negative length in " + Arrays.class.getName());
+        if (ofs<0 || ofs>b.limit()-len) throw new IndexOutOfBoundsException("Buffer range "+ofs+".."+((long)ofs+len-1)+" is out of 0.."+(b.limit()-1)+" in " + Arrays.class.getName());
+        if (write && b.isReadOnly()) throw new ReadOnlyBufferException();
+    }
+    private static int checkArrayAndBuffer(Object a, int aofs, Buffer b, int bofs, int len, boolean writeBuffer) {
+        checkBuffer(b,bofs,len,writeBuffer);
+        int nt= bufferType(b);
+        if (a==null) throw new NullPointerException("Null array argument in " + Arrays.class.getName());
+        if (a.getClass().getComponentType()!=bufferElementType(b)) throw new IllegalArgumentException("Different element types in " + Arrays.class.getName() + ": "+JVM.toJavaClassName(a)+" and "+JVM.toJavaClassName(b));
+        if (aofs<0 || aofs>Array.getLength(a)-len) throw new IndexOutOfBoundsException("Array range "+aofs+".."+((long)aofs+len-1)+" is out of 0.."+(Array.getLength(a)-1)+" in " + Arrays.class.getName());
+        return nt;
+    }
+    private static void bufferGet(Buffer b, int ofs, Object dest, int destOfs, int len) {
+        if (b instanceof ByteBuffer) {ByteBuffer d= ((ByteBuffer)b).duplicate(); d.position(ofs); d.get((byte[])dest,destOfs,len);}
+        else if (b instanceof CharBuffer) {CharBuffer d= ((CharBuffer)b).duplicate(); d.position(ofs); d.get((char[])dest,destOfs,len);}
+        else if (b instanceof ShortBuffer) {ShortBuffer d= ((ShortBuffer)b).duplicate(); d.position(ofs); d.get((short[])dest,destOfs,len);}
+        else if (b instanceof IntBuffer) {IntBuffer d= ((IntBuffer)b).duplicate(); d.position(ofs); d.get((int[])dest,destOfs,len);}
+        else if (b instanceof LongBuffer) {LongBuffer d= ((LongBuffer)b).duplicate(); d.position(ofs); d.get((long[])dest,destOfs,len);}
+        else if (b instanceof FloatBuffer) {FloatBuffer d= ((FloatBuffer)b).duplicate(); d.position(ofs); d.get((float[])dest,destOfs,len);}
+        else {DoubleBuffer d= ((DoubleBuffer)b).duplicate(); d.position(ofs); d.get((double[])dest,destOfs,len);}
+    }
+    private static void bufferPut(Buffer b, int ofs, Object src, int srcOfs, int len) {
+        if (b instanceof ByteBuffer) {ByteBuffer d= ((ByteBuffer)b).duplicate(); d.position(ofs); d.put((byte[])src,srcOfs,len);}
+        else if (b instanceof CharBuffer) {CharBuffer d= ((CharBuffer)b).duplicate(); d.position(ofs); d.put((char[])src,srcOfs,len);}
+        else if (b instanceof ShortBuffer) {ShortBuffer d= ((ShortBuffer)b).duplicate(); d.position(ofs); d.put((short[])src,srcOfs,len);}
+        else if (b instanceof IntBuffer) {IntBuffer d= ((IntBuffer)b).duplicate(); d.position(ofs); d.put((int[])src,srcOfs,len);}
+        else if (b instanceof LongBuffer) {LongBuffer d= ((LongBuffer)b).duplicate(); d.position(ofs); d.put((long[])src,srcOfs,len);}
+        else if (b instanceof FloatBuffer) {FloatBuffer d= ((FloatBuffer)b).duplicate(); d.position(ofs); d.put((float[])src,srcOfs,len);}
+        else {DoubleBuffer d= ((DoubleBuffer)b).duplicate(); d.position(ofs); d.put((double[])src,srcOfs,len);}
+    }
+
+    // Off-heap memory (direct or mapped buffers, native allocations) with 64-bit lengths.
+    // Addresses are not checked: the caller is responsible for the validity of all accessed bytes.
+    public static long getDirectBufferAddress(Buffer b) {
+        // 0 if b is not direct or the native library is not loaded
+        if (b==null) throw new NullPointerException("Null buffer argument in " + Arrays.class.getName() + ".getDirectBufferAddress()");
+        if (!ArraysNative.loaded || !b.isDirect()) return 0;
+        return ArraysNative.directBufferAddress(b);
+    }
+    public static void copyMemory(long srcAddress, long destAddress, long len) {
+        // Overlapping areas are allowed (memmove semantics)
+        checkMemory(len);
+        if (len>0) ArraysNative.copyMemory(ArraysNative.cpuInfo,srcAddress,destAddress,len);
+    }
+    public static void fillMemory(long address, long count, byte v) {
+        checkMemory(count);
+        if (count>0) ArraysNative.fillBytes(ArraysNative.cpuInfo,address,count,v);
+    }
+    public static void fillMemory(long address, long count, char v) {
+        checkMemory(count);
+        if (count>0) ArraysNative.fillShorts(ArraysNative.cpuInfo,address,count,(short)v);
+    }
+    public static void fillMemory(long address, long count, short v) {
+        checkMemory(count);
+        if (count>0) ArraysNative.fillShorts(ArraysNative.cpuInfo,address,count,v);
+    }
+    public static void fillMemory(long address, long count, int v) {
+        checkMemory(count);
+        if (count>0) ArraysNative.fillInts(ArraysNative.cpuInfo,address,count,v);
+    }
+    public static void fillMemory(long address, long count, long v) {
+        checkMemory(count);
+        if (count>0) ArraysNative.fillLongs(ArraysNative.cpuInfo,address,count,v);
+    }
+    public static void fillMemory(long address, long count, float v) {
+        checkMemory(count);
+        if (count>0) ArraysNative.fillInts(ArraysNative.cpuInfo,address,count,Float.floatToRawIntBits(v));
+    }
+    public static void fillMemory(long address, long count, double v) {
+        checkMemory(count);
+        if (count>0) ArraysNative.fillLongs(ArraysNative.cpuInfo,address,count,Double.doubleToRawLongBits(v));
+    }
+    public static void minMemory(Class elementType, long aAddress, long bAddress, long count) {
+        // a[k]= min(a[k],b[k]); char elements are compared as unsigned 16-bit values
+        checkMemory(count);
+        if (count<=0) return;
+        long ci= ArraysNative.cpuInfo;
+        if (elementType==byte.class) ArraysNative.minBytes(ci,aAddress,bAddress,count);
+        else if (elementType==char.class) ArraysNative.minuShorts(ci,aAddress,bAddress,count);
+        else if (elementType==short.class) ArraysNative.minShorts(ci,aAddress,bAddress,count);
+        else if (elementType==int.class) ArraysNative.minInts(ci,aAddress,bAddress,count);
+        else if (elementType==long.class) ArraysNative.minLongs(ci,aAddress,bAddress,count);
+        else if (elementType==float.class) ArraysNative.minFloats(ci,aAddress,bAddress,count);
+        else if (elementType==double.class) ArraysNative.minDoubles(ci,aAddress,bAddress,count);
+        else throw new IllegalArgumentException("Unsupported element type in " + Arrays.class.getName() + ".minMemory(): "+elementType);
+    }
+    public static void maxMemory(Class elementType, long aAddress, long bAddress, long count) {
+        checkMemory(count);
+        if (count<=0) return;
+        long ci= ArraysNative.cpuInfo;
+        if (elementType==byte.class) ArraysNative.maxBytes(ci,aAddress,bAddress,count);
+        else if (elementType==char.class) ArraysNative.maxuShorts(ci,aAddress,bAddress,count);
+        else if (elementType==short.class) ArraysNative.maxShorts(ci,aAddress,bAddress,count);
+        else if (elementType==int.class) ArraysNative.maxInts(ci,aAddress,bAddress,count);
+        else if (elementType==long.class) ArraysNative.maxLongs(ci,aAddress,bAddress,count);
+        else if (elementType==float.class) ArraysNative.maxFloats(ci,aAddress,bAddress,count);
+        else if (elementType==double.class) ArraysNative.maxDoubles(ci,aAddress,bAddress,count);
+        else throw new IllegalArgumentException("Unsupported element type in " + Arrays.class.getName() + ".maxMemory(): "+elementType);
+    }
+    public static void minuMemory(Class elementType, long aAddress, long bAddress, long count) {
+        // Unsigned minimum: byte, short (char), int and long elements
+        checkMemory(count);
+        if (count<=0) return;
+        if (elementType==byte.class) ArraysNative.minuBytes(ArraysNative.cpuInfo,aAddress,bAddress,count);
+        else if (elementType==short.class || elementType==char.class) ArraysNative.minuShorts(ArraysNative.cpuInfo,aAddress,bAddress,count);
+        else if (elementType==int.class) ArraysNative.minuInts(ArraysNative.cpuInfo,aAddress,bAddress,count);
+        else if (elementType==long.class) ArraysNative.minuLongs(ArraysNative.cpuInfo,aAddress,bAddress,count);
+        else throw new IllegalArgumentException("Unsupported element type in " + Arrays.class.getName() + ".minuMemory(): "+elementType);
+    }
+    public static void maxuMemory(Class elementType, long aAddress, long bAddress, long count) {
+        checkMemory(count);
+        if (count<=0) return;
+        if (elementType==byte.class) ArraysNative.maxuBytes(ArraysNative.cpuInfo,aAddress,bAddress,count);
+        else if (elementType==short.class || elementType==char.class) ArraysNative.maxuShorts(ArraysNative.cpuInfo,aAddress,bAddress,count);
+        else if (elementType==int.class) ArraysNative.maxuInts(ArraysNative.cpuInfo,aAddress,bAddress,count);
+        else if (elementType==long.class) ArraysNative.maxuLongs(ArraysNative.cpuInfo,aAddress,bAddress,count);
+        else throw new IllegalArgumentException("Unsupported element type in " + Arrays.class.getName() + ".maxuMemory(): "+elementType);
+    }
+    private static void checkMemory(long count) {
+        if (!ArraysNative.loaded) throw new UnsupportedOperationException("Off-heap memory operations require native "
+            + "code: " + ArraysNative.initializationExceptionMessage);
+        if (count<0) throw new IllegalArgumentException("Negative length in " + Arrays.class.getName());
+    }
+
+    public static int getNativeThreads() {
+        // Threads (including the calling one) used by native code for huge copying, far beyond the cache
+        return ArraysNative.loaded? ArraysNative.getThreadsInternal(): 1;
+    }
+    public static void setNativeThreads(int v) {
+        // 1 disables parallel native copying; by default, the number of physical cores
+        if (ArraysNative.loaded) ArraysNative.setThreadsInternal(v);
+    }
+
+    // Layout of getNativeCounters(): NATIVE_COUNTER_FIELDS values for every name from getNativeCounterNames()
+    public static final int NATIVE_COUNTER_CALLS= 0;
+    public static final int NATIVE_COUNTER_BYTES= 1;
+    public static final int NATIVE_COUNTER_CYCLES= 2;    // TSC cycles spent in the kernel
+    public static final int NATIVE_COUNTER_PATH_CALLS= 3; // 4 values: calls of C++ loops, SSE2, AVX2, AVX-512
+    public static final int NATIVE_COUNTER_FIELDS= 7;
+    private static final String[] NATIVE_COUNTER_PATHS= {"C++","SSE2","AVX2","AVX-512"};
+
+    public static String[] getNativeCounterNames() {
+        if (!ArraysNative.loaded) return new String[0];
+        return ArraysNative.getCounterNames();
+    }
+    public static long[] getNativeCounters() {
+        // Sum of the counters of all threads since loading or the last resetNativeCounters()
+        if (!ArraysNative.loaded) return new long[0];
+        return ArraysNative.getCountersInternal();
+    }
+    public static void resetNativeCounters() {
+        if (ArraysNative.loaded) ArraysNative.resetCounters();
+    }
+    public static void setNativeCountersEnabled(boolean v) {
+        if (ArraysNative.loaded) ArraysNative.setCountersEnabled(v);
+    }
+    public static String getNativeCountersReport() {
+        String[] names= getNativeCounterNames();
+        long[] c= getNativeCounters();
+        long frequency= Timing.timecpuFrequency();
+        StringBuffer sb= new StringBuffer();
+        for (int k=0; k<names.length; k++) {
+            int ofs= k*NATIVE_COUNTER_FIELDS;
+            if (c[ofs+NATIVE_COUNTER_CALLS]==0) continue;
+            long bytes= c[ofs+NATIVE_COUNTER_BYTES], cycles= c[ofs+NATIVE_COUNTER_CYCLES];
+            sb.append(names[k]).append(": ").append(c[ofs+NATIVE_COUNTER_CALLS]).append(" calls, ")
+                .append(bytes).append(" bytes, ").append(cycles).append(" cycles");
+            if (cycles>0 && frequency>0)
+                sb.append(" (").append((long)(bytes*(double)frequency/cycles/1.0e6)).append(" MB/s)");
+            for (int p=0; p<NATIVE_COUNTER_PATHS.length; p++) {
+                long calls= c[ofs+NATIVE_COUNTER_PATH_CALLS+p];
+                if (calls>0) sb.append(", ").append(NATIVE_COUNTER_PATHS[p]).append(": ").append(calls);
+            }
+            sb.append(GlobalProperties.LINE_SEPARATOR);
+        }
+        return sb.toString();
+    }
 
     public static int ptrOfs(Object a) {
         if (!a.getClass().isArray()) throw new IllegalArgumentException("Unsupported argument type in " + Arrays.class.getName() + ".ptrOfs(): it should be an array");
@@ -2628,10 +5233,59 @@ class ArraysNative implements TrueStatic {
     static boolean fillImplemented= false;
     static boolean minmaxImplemented= false;
     static boolean minmaxuImplemented= false;
+    static boolean rangeImplemented= false;
+    static boolean arithmeticImplemented= false;
+    static boolean bitsImplemented= false;
+    static boolean bitsSearchImplemented= false;
+    static boolean packBitsImplemented= false;
+    static boolean unpackBitsImplemented= false;
+    static boolean searchImplemented= false;
+    static boolean swapBytesImplemented= false;
+    static boolean histogramImplemented= false;
+    static boolean filter3x3Implemented= false;
+    static boolean rankImplemented= false;
+    static boolean morphologyImplemented= false;
     static native void detectImplementedFlags();
 
     static long cpuInfo= 0;
     static native long getCpuInfoInternal();
+    static long[] cpuDescriptor= null;
+    static native long[] getCpuDescriptorInternal();
+    static native String getKernelsName(long cpuInfo);
+    static native String[] getCounterNames();
+    static native long[] getCountersInternal();
+    static native void resetCounters();
+    static native void setCountersEnabled(boolean enabled);
+    static native int getThreadsInternal();
+
+    // Long-indexed off-heap variants: raw addresses, 64-bit lengths (in elements, in bytes for copyMemory)
+    static native long directBufferAddress(Buffer b);
+    static native void copyMemory(long cpuInfo, long srcAddress, long destAddress, long len);
+    static native void fillBytes(long cpuInfo, long address, long count, byte v);
+    static native void fillShorts(long cpuInfo, long address, long count, short v);
+    static native void fillInts(long cpuInfo, long address, long count, int v);
+    static native void fillLongs(long cpuInfo, long address, long count, long v);
+    static native void minBytes(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxBytes(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void minShorts(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxShorts(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void minInts(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxInts(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void minLongs(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxLongs(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void minFloats(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxFloats(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void minDoubles(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxDoubles(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void minuBytes(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxuBytes(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void minuShorts(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxuShorts(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void minuInts(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxuInts(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void minuLongs(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void maxuLongs(long cpuInfo, long aAddress, long bAddress, long count);
+    static native void setThreadsInternal(int threads);
     static native int ptrOfs(Object a);
 
     static native void copyBytes(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
@@ -2663,6 +5317,159 @@ class ArraysNative implements TrueStatic {
     static native void maxu(long cpuInfo, ByteBuffer a, int aofs, ByteBuffer b, int bofs, int len);
     static native void minu(long cpuInfo, short[] a, int aofs, short[] b, int bofs, int len);
     static native void maxu(long cpuInfo, short[] a, int aofs, short[] b, int bofs, int len);
+    static native void min(long cpuInfo, char[] a, int aofs, char[] b, int bofs, int len);
+    static native void max(long cpuInfo, char[] a, int aofs, char[] b, int bofs, int len);
+    static native void minu(long cpuInfo, int[] a, int aofs, int[] b, int bofs, int len);
+    static native void maxu(long cpuInfo, int[] a, int aofs, int[] b, int bofs, int len);
+    static native void minu(long cpuInfo, long[] a, int aofs, long[] b, int bofs, int len);
+    static native void maxu(long cpuInfo, long[] a, int aofs, long[] b, int bofs, int len);
+
+    // Every Object argument is a Java array or a direct buffer with the native byte order
+    static native void copyBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    // Byte order reversal (see Arrays.copyAndSwapByteOrder): a is the destination, b is the source,
+    // a==b with aofs==bofs means reversal in place; offsets and len are in elements
+    static native void copyAndSwapShorts(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void copyAndSwapInts(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void copyAndSwapLongs(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minIntsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxIntsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minLongsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxLongsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minFloatsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxFloatsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minDoublesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxDoublesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minuBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxuBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minuShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxuShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minuIntsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxuIntsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void minuLongsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void maxuLongsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+
+    // range(...): the results are described in Arrays.RANGE_xxx
+    static native void rangeBytes(long cpuInfo, Object a, int ofs, int len, long[] result);
+    static native void rangeChars(long cpuInfo, Object a, int ofs, int len, long[] result);
+    static native void rangeShorts(long cpuInfo, Object a, int ofs, int len, long[] result);
+    static native void rangeInts(long cpuInfo, Object a, int ofs, int len, long[] result);
+    static native void rangeLongs(long cpuInfo, Object a, int ofs, int len, long[] result);
+    static native void rangeFloats(long cpuInfo, Object a, int ofs, int len, double[] result);
+    static native void rangeDoubles(long cpuInfo, Object a, int ofs, int len, double[] result);
+
+    // a[k] op= b[k]; a and b are Java arrays or direct buffers (a may be the same as b)
+    static native void addBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void addShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void addIntsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void addLongsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void addFloatsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void addDoublesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subIntsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subLongsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subFloatsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subDoublesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void addsBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void addsShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subsBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subsShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void addusBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void addusShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subusBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void subusShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffIntsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffLongsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffFloatsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffDoublesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffuBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffuShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffuIntsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void absDiffuLongsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void oppositeBytesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void oppositeShortsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void oppositeIntsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void oppositeLongsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void oppositeFloatsBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+    static native void oppositeDoublesBuffer(long cpuInfo, Object a, int aofs, Object b, int bofs, int len);
+
+    // Packed bits (see Arrays.copyBits): positions and counts are in bits, dest and src may overlap
+    static native void copyBits(long cpuInfo, long[] dest, long destPos, long[] src, long srcPos, long count);
+    static native void andBits(long cpuInfo, long[] dest, long destPos, long[] src, long srcPos, long count);
+    static native void orBits(long cpuInfo, long[] dest, long destPos, long[] src, long srcPos, long count);
+    static native void xorBits(long cpuInfo, long[] dest, long destPos, long[] src, long srcPos, long count);
+    static native void andNotBits(long cpuInfo, long[] dest, long destPos, long[] src, long srcPos, long count);
+    static native void notBits(long cpuInfo, long[] dest, long destPos, long[] src, long srcPos, long count);
+    static native long cardinalityBits(long cpuInfo, long[] a, long fromIndex, long toIndex);
+    static native long indexOfBit(long cpuInfo, long[] a, long lowIndex, long highIndex, boolean value);
+    static native long lastIndexOfBit(long cpuInfo, long[] a, long lowIndex, long highIndex, boolean value);
+
+    // Threshold packing (see Arrays.packBitsGreater): cmp is Arrays.PACK_xxx
+    static native void packBits(long cpuInfo, long[] dest, long destPos, byte[] src, int srcPos, int count, byte threshold, int cmp);
+    static native void packBits(long cpuInfo, long[] dest, long destPos, char[] src, int srcPos, int count, char threshold, int cmp);
+    static native void packBits(long cpuInfo, long[] dest, long destPos, short[] src, int srcPos, int count, short threshold, int cmp);
+    static native void packBits(long cpuInfo, long[] dest, long destPos, int[] src, int srcPos, int count, int threshold, int cmp);
+    static native void packBits(long cpuInfo, long[] dest, long destPos, long[] src, int srcPos, int count, long threshold, int cmp);
+    static native void packBits(long cpuInfo, long[] dest, long destPos, float[] src, int srcPos, int count, float threshold, int cmp);
+    static native void packBits(long cpuInfo, long[] dest, long destPos, double[] src, int srcPos, int count, double threshold, int cmp);
+
+    // Bit unpacking (see Arrays.unpackBits): mode is Arrays.UNPACK_xxx
+    static native void unpackBits(long cpuInfo, byte[] dest, int destPos, long[] src, long srcPos, int count, byte value0, byte value1, int mode);
+    static native void unpackBits(long cpuInfo, char[] dest, int destPos, long[] src, long srcPos, int count, char value0, char value1, int mode);
+    static native void unpackBits(long cpuInfo, short[] dest, int destPos, long[] src, long srcPos, int count, short value0, short value1, int mode);
+    static native void unpackBits(long cpuInfo, int[] dest, int destPos, long[] src, long srcPos, int count, int value0, int value1, int mode);
+    static native void unpackBits(long cpuInfo, long[] dest, int destPos, long[] src, long srcPos, int count, long value0, long value1, int mode);
+    static native void unpackBits(long cpuInfo, float[] dest, int destPos, long[] src, long srcPos, int count, float value0, float value1, int mode);
+    static native void unpackBits(long cpuInfo, double[] dest, int destPos, long[] src, long srcPos, int count, double value0, double value1, int mode);
+
+    // Search (see Arrays.indexOf, lastIndexOf, indexOfNaN): "a" is a Java array or a direct buffer;
+    // returns ofs+index or -1; NaN v finds any NaN
+    static native int indexOfBytes(long cpuInfo, Object a, int ofs, int len, byte v);
+    static native int indexOfChars(long cpuInfo, Object a, int ofs, int len, char v);
+    static native int indexOfShorts(long cpuInfo, Object a, int ofs, int len, short v);
+    static native int indexOfInts(long cpuInfo, Object a, int ofs, int len, int v);
+    static native int indexOfLongs(long cpuInfo, Object a, int ofs, int len, long v);
+    static native int indexOfFloats(long cpuInfo, Object a, int ofs, int len, float v);
+    static native int indexOfDoubles(long cpuInfo, Object a, int ofs, int len, double v);
+    static native int lastIndexOfBytes(long cpuInfo, Object a, int ofs, int len, byte v);
+    static native int lastIndexOfChars(long cpuInfo, Object a, int ofs, int len, char v);
+    static native int lastIndexOfShorts(long cpuInfo, Object a, int ofs, int len, short v);
+    static native int lastIndexOfInts(long cpuInfo, Object a, int ofs, int len, int v);
+    static native int lastIndexOfLongs(long cpuInfo, Object a, int ofs, int len, long v);
+    static native int lastIndexOfFloats(long cpuInfo, Object a, int ofs, int len, float v);
+    static native int lastIndexOfDoubles(long cpuInfo, Object a, int ofs, int len, double v);
+
+    // Histograms (see Arrays.histogram): the counts are added to bars
+    static native void histogram(long cpuInfo, long[] bars, byte[] a, int aofs, int len, int binShift);
+    static native void histogram(long cpuInfo, long[] bars, char[] a, int aofs, int len, int binShift);
+    static native void histogram(long cpuInfo, long[] bars, short[] a, int aofs, int len, int binShift);
+    static native void histogram(long cpuInfo, long[] bars, int[] a, int aofs, int len, int binShift);
+
+    // 3x3 filters (see Arrays.filter3x3): dest and src don't overlap
+    static native void filter3x3(long cpuInfo, byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int filter, int percentileIndex);
+    static native void filter3x3(long cpuInfo, char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int filter, int percentileIndex);
+    static native void filter3x3(long cpuInfo, short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int filter, int percentileIndex);
+    static native void filter3x3(long cpuInfo, float[] dest, int destOfs, float[] src, int srcOfs, int dimX, int dimY, int filter, int percentileIndex);
+
+    // Rank filters by rectangles (see Arrays.percentileByRectangle): dest and src don't overlap;
+    // RANK_PERCENTILE uses only fromIndex
+    static native void rank(long cpuInfo, byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int mode, int fromIndex, int toIndex);
+    static native void rank(long cpuInfo, char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int mode, int fromIndex, int toIndex);
+    static native void rank(long cpuInfo, short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, int mode, int fromIndex, int toIndex);
+    static native void morphology(long cpuInfo, byte[] dest, int destOfs, byte[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation);
+    static native void morphology(long cpuInfo, char[] dest, int destOfs, char[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation);
+    static native void morphology(long cpuInfo, short[] dest, int destOfs, short[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation);
+    static native void morphology(long cpuInfo, int[] dest, int destOfs, int[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation);
+    static native void morphology(long cpuInfo, long[] dest, int destOfs, long[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation);
+    static native void morphology(long cpuInfo, float[] dest, int destOfs, float[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation);
+    static native void morphology(long cpuInfo, double[] dest, int destOfs, double[] src, int srcOfs, int dimX, int dimY, int apertureDimX, int apertureDimY, boolean dilation);
+
     static boolean loaded = false;
     static final String initializationExceptionMessage;
     static {
@@ -2673,12 +5480,23 @@ class ArraysNative implements TrueStatic {
         loaded = true;
         detectImplementedFlags();
         cpuInfo = getCpuInfoInternal();
+        cpuDescriptor = getCpuDescriptorInternal();
+        setCountersEnabled(GlobalProperties.getClassBooleanProperty(Arrays.class,"NATIVE_COUNTERS",true));
       } catch (UnsatisfiedLinkError e) {
         message = e.toString();
       } catch (SecurityException e) {
         message = e.toString();
       }
     initializationExceptionMessage = message;
+    if (cpuDescriptor == null) {
+      cpuDescriptor = new long[Arrays.CPU_DESCRIPTOR_NUMANODEMAP];
+      int n = Runtime.getRuntime().availableProcessors();
+      cpuDescriptor[Arrays.CPU_DESCRIPTOR_CACHELINESIZE] = 64;
+      cpuDescriptor[Arrays.CPU_DESCRIPTOR_LOGICALPROCESSORS] = n;
+      cpuDescriptor[Arrays.CPU_DESCRIPTOR_PHYSICALCORES] = n;
+      cpuDescriptor[Arrays.CPU_DESCRIPTOR_PACKAGES] = 1;
+      cpuDescriptor[Arrays.CPU_DESCRIPTOR_NUMANODES] = 1;
+    }
 //    System.out.println("!!!!Arrays: " + initializationExceptionMessage);
     }
 }
\ No newline at end of file
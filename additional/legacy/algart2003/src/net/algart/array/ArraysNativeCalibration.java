@@ -0,0 +1,260 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+package net.algart.array;
+
+import java.io.*;
+import java.util.Properties;
+import net.algart.lib.*;
+
+/**
+ * <p>Load-time tuning of the minimal array lengths, from which {@link Arrays} methods call
+ * native code instead of Java loops (<code>Arrays.nativeMinLensXxx</code> tables).
+ * The JNI call overhead and the speed of native kernels strongly depend on the computer,
+ * so the Java/native crossover length is measured for every operation and element type.
+ * The pairOp crossover is measured by <code>min()</code> and is shared by the other streaming
+ * operations with one pass over 1-2 arrays (arithmetic, range, search, bits, histogram).
+ * Matrix filters (3x3, rank, morphology) have their own fixed threshold
+ * (<code>Arrays.nativeMinLensMatrix</code>), which is not calibrated.
+ * The results are cached in a small properties file (by default
+ * <code>~/.algart/net.algart.array.ArraysNative.calibration</code>) under a key built
+ * from the CPU signature, so the measuring is performed once per host.
+ *
+ * <p>Can be disabled by the <code>net.algart.array.ArraysNativeCalibration.ENABLED=false</code>
+ * property; the file name can be changed by the <code>net.algart.array.ArraysNativeCalibration.FILE</code>
+ * property. Measuring requires the native nanosecond timer ({@link Timing#isNative()});
+ * without it the default thresholds are kept.
+ *
+ * @author  Daniel Alievsky
+ * @version 1.1
+ */
+
+class ArraysNativeCalibration implements TrueStatic {
+    static final boolean ENABLED= GlobalProperties.getClassBooleanProperty(ArraysNativeCalibration.class,"ENABLED",true);
+    static final String FILE= GlobalProperties.getClassProperty(ArraysNativeCalibration.class,"FILE",null);
+    private static final int VERSION= 2; // increase when the measuring algorithm or native kernels change
+    private static final int MAX_LEN= 8192;
+    private static final int MIN_LEN= 4;
+    private static final int WORK_PER_TRIAL= 1<<15; // elements
+    private static final int TRIALS= 3;
+    private static final String[] OPS= {"copy","fill","pairOp"};
+    private static final String[] TYPE_NAMES= {"byte","char","short","int","long","float","double","Object"};
+
+    static boolean calibrated= false;
+
+    static synchronized void calibrate(boolean useCache) {
+        String signature= signature();
+        File file= cacheFile();
+        Properties cache= new Properties();
+        if (file != null) {
+            try {
+                InputStream in= new FileInputStream(file);
+                try {cache.load(in);} finally {in.close();}
+            } catch (IOException e) {
+                // no cache yet
+            } catch (SecurityException e) {
+                file= null;
+            }
+        }
+        if (useCache && load(cache,signature)) {
+            calibrated= true;
+            return;
+        }
+        if (!Timing.isNative()) return; // millisecond timer is useless for measuring short loops
+        measure();
+        calibrated= true;
+        if (file != null) {
+            store(cache,signature);
+            try {
+                File dir= file.getParentFile();
+                if (dir != null) dir.mkdirs();
+                OutputStream out= new FileOutputStream(file);
+                try {cache.store(out,"Crossover lengths of Java/native code in net.algart.array.Arrays");} finally {out.close();}
+            } catch (IOException e) {
+                // the cache is only an optimization
+            } catch (SecurityException e) {
+            }
+        }
+    }
+
+    private static File cacheFile() {
+        try {
+            if (FILE != null) return FILE.length() == 0? null: new File(FILE);
+            String home= System.getProperty("user.home");
+            if (home == null) return null;
+            return new File(new File(home,".algart"),ArraysNative.class.getName() + ".calibration");
+        } catch (SecurityException e) {
+            return null;
+        }
+    }
+
+    private static String signature() {
+        long[] d= ArraysNative.cpuDescriptor;
+        return "v" + VERSION
+            + "-" + d[Arrays.CPU_DESCRIPTOR_VENDOR]
+            + "-" + d[Arrays.CPU_DESCRIPTOR_FAMILY]
+            + "-" + d[Arrays.CPU_DESCRIPTOR_MODEL]
+            + "-" + d[Arrays.CPU_DESCRIPTOR_STEPPING]
+            + "-" + Long.toHexString(d[Arrays.CPU_DESCRIPTOR_FEATURES])
+            + "-" + Long.toHexString(ArraysNative.cpuInfo)
+            + "-" + ArraysNative.getKernelsName(ArraysNative.cpuInfo)
+            + "-" + System.getProperty("java.vm.version");
+    }
+
+    private static int[] table(int op) {
+        return op == 0? Arrays.nativeMinLensCopy: op == 1? Arrays.nativeMinLensFill: Arrays.nativeMinLensPairOp;
+    }
+
+    private static boolean load(Properties cache, String signature) {
+        int[][] result= new int[OPS.length][Arrays.NT_COUNT];
+        for (int op=0; op<OPS.length; op++) {
+            for (int t=0; t<Arrays.NT_COUNT; t++) {
+                String v= cache.getProperty(signature + "." + OPS[op] + "." + TYPE_NAMES[t]);
+                if (v == null) return false;
+                try {
+                    result[op][t]= Integer.parseInt(v.trim());
+                } catch (NumberFormatException e) {
+                    return false;
+                }
+                // measure() stores only 0..MAX_LEN or "never"; anything else is a corrupted cache
+                if ((result[op][t]<0 || result[op][t]>MAX_LEN) && result[op][t]!=Integer.MAX_VALUE) return false;
+            }
+        }
+        for (int op=0; op<OPS.length; op++) System.arraycopy(result[op],0,table(op),0,Arrays.NT_COUNT);
+        return true;
+    }
+
+    private static void store(Properties cache, String signature) {
+        for (int op=0; op<OPS.length; op++) {
+            for (int t=0; t<Arrays.NT_COUNT; t++) {
+                cache.setProperty(signature + "." + OPS[op] + "." + TYPE_NAMES[t],String.valueOf(table(op)[t]));
+            }
+        }
+    }
+
+    private static void measure() {
+        boolean savedNative= Arrays.isNative;
+        Arrays.isNative= true;
+        try {
+            Object[] a= new Object[Arrays.NT_COUNT], b= new Object[Arrays.NT_COUNT];
+            a[Arrays.NT_BYTE]= new byte[MAX_LEN]; b[Arrays.NT_BYTE]= new byte[MAX_LEN];
+            a[Arrays.NT_CHAR]= new char[MAX_LEN]; b[Arrays.NT_CHAR]= new char[MAX_LEN];
+            a[Arrays.NT_SHORT]= new short[MAX_LEN]; b[Arrays.NT_SHORT]= new short[MAX_LEN];
+            a[Arrays.NT_INT]= new int[MAX_LEN]; b[Arrays.NT_INT]= new int[MAX_LEN];
+            a[Arrays.NT_LONG]= new long[MAX_LEN]; b[Arrays.NT_LONG]= new long[MAX_LEN];
+            a[Arrays.NT_FLOAT]= new float[MAX_LEN]; b[Arrays.NT_FLOAT]= new float[MAX_LEN];
+            a[Arrays.NT_DOUBLE]= new double[MAX_LEN]; b[Arrays.NT_DOUBLE]= new double[MAX_LEN];
+            a[Arrays.NT_OBJECT]= new Object[MAX_LEN]; b[Arrays.NT_OBJECT]= new Object[MAX_LEN];
+            for (int op=0; op<OPS.length; op++) {
+                int[] table= table(op);
+                for (int t=0; t<Arrays.NT_COUNT; t++) {
+                    if (!isImplemented(op,t)) continue;
+                    // Warming up JIT for both branches before measuring
+                    table[t]= Integer.MAX_VALUE;
+                    time(op,t,a[t],b[t],MIN_LEN,WORK_PER_TRIAL/MIN_LEN);
+                    time(op,t,a[t],b[t],MAX_LEN,2*WORK_PER_TRIAL/MAX_LEN);
+                    table[t]= 0;
+                    time(op,t,a[t],b[t],MAX_LEN,2*WORK_PER_TRIAL/MAX_LEN);
+                    int crossover= -1;
+                    for (int len=MIN_LEN; len<=MAX_LEN; len*=2) {
+                        int count= Math.max(WORK_PER_TRIAL/len,1);
+                        table[t]= Integer.MAX_VALUE;
+                        long javaTime= time(op,t,a[t],b[t],len,count);
+                        table[t]= 0;
+                        long nativeTime= time(op,t,a[t],b[t],len,count);
+                        if (nativeTime < javaTime) {
+                            if (crossover == -1) crossover= len;
+                        } else {
+                            crossover= -1;
+                        }
+                    }
+                    // Native kernels are never slower on large arrays (non-temporal stores etc.),
+                    // excepting Object[], where every element is passed through JNI separately
+                    table[t]= crossover != -1? crossover-1:
+                        t == Arrays.NT_OBJECT? Integer.MAX_VALUE:
+                        MAX_LEN;
+                }
+            }
+        } finally {
+            Arrays.isNative= savedNative;
+        }
+    }
+
+    private static boolean isImplemented(int op, int t) {
+        switch (op) {
+            case 0: return ArraysNative.copyBytesImplemented && t != Arrays.NT_OBJECT;
+            case 1: return ArraysNative.fillImplemented;
+            default: return ArraysNative.minmaxImplemented && t != Arrays.NT_OBJECT;
+        }
+    }
+
+    // Returns the best time of several trials, each performing the operation count times
+    private static long time(int op, int t, Object a, Object b, int len, int count) {
+        long best= Long.MAX_VALUE;
+        for (int trial=0; trial<TRIALS; trial++) {
+            long t1= Timing.timens();
+            for (int k=0; k<count; k++) perform(op,t,a,b,len);
+            long t2= Timing.timens();
+            if (t2-t1 < best) best= t2-t1;
+        }
+        return best;
+    }
+
+    private static void perform(int op, int t, Object a, Object b, int len) {
+        switch (op) {
+            case 0:
+                switch (t) {
+                    case Arrays.NT_BYTE: Arrays.copy((byte[])b,0,(byte[])a,0,len); return;
+                    case Arrays.NT_CHAR: Arrays.copy((char[])b,0,(char[])a,0,len); return;
+                    case Arrays.NT_SHORT: Arrays.copy((short[])b,0,(short[])a,0,len); return;
+                    case Arrays.NT_INT: Arrays.copy((int[])b,0,(int[])a,0,len); return;
+                    case Arrays.NT_LONG: Arrays.copy((long[])b,0,(long[])a,0,len); return;
+                    case Arrays.NT_FLOAT: Arrays.copy((float[])b,0,(float[])a,0,len); return;
+                    case Arrays.NT_DOUBLE: Arrays.copy((double[])b,0,(double[])a,0,len); return;
+                }
+                return;
+            case 1:
+                switch (t) {
+                    case Arrays.NT_BYTE: Arrays.fill((byte[])a,0,len,(byte)1); return;
+                    case Arrays.NT_CHAR: Arrays.fill((char[])a,0,len,(char)1); return;
+                    case Arrays.NT_SHORT: Arrays.fill((short[])a,0,len,(short)1); return;
+                    case Arrays.NT_INT: Arrays.fill((int[])a,0,len,1); return;
+                    case Arrays.NT_LONG: Arrays.fill((long[])a,0,len,1L); return;
+                    case Arrays.NT_FLOAT: Arrays.fill((float[])a,0,len,1.0f); return;
+                    case Arrays.NT_DOUBLE: Arrays.fill((double[])a,0,len,1.0); return;
+                    default: Arrays.fill((Object[])a,0,len,a); return;
+                }
+            default:
+                switch (t) {
+                    case Arrays.NT_BYTE: Arrays.min((byte[])a,0,(byte[])b,0,len); return;
+                    case Arrays.NT_CHAR: Arrays.min((char[])a,0,(char[])b,0,len); return;
+                    case Arrays.NT_SHORT: Arrays.min((short[])a,0,(short[])b,0,len); return;
+                    case Arrays.NT_INT: Arrays.min((int[])a,0,(int[])b,0,len); return;
+                    case Arrays.NT_LONG: Arrays.min((long[])a,0,(long[])b,0,len); return;
+                    case Arrays.NT_FLOAT: Arrays.min((float[])a,0,(float[])b,0,len); return;
+                    case Arrays.NT_DOUBLE: Arrays.min((double[])a,0,(double[])b,0,len); return;
+                }
+        }
+    }
+}
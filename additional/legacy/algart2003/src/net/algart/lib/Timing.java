@@ -68,6 +68,21 @@ public final class Timing implements TrueStatic {
     if (TimingNative.timecpuSupported == 0) return timens();
     return TimingNative.timecpuInternal();
   }
+  public static boolean isTimecpuInvariant() {
+    // true if timecpu() ticks at a constant rate, independent of the core and its power state
+    return TimingNative.timecpuInvariant != 0;
+  }
+  public static long timecpuFrequency() {
+    // timecpu() ticks per second (10^9 if timecpu() falls back to timens()), 0 if unknown
+    if (TimingNative.timecpuSupported == 0) return 1000000000L;
+    if (TimingNative.timecpuFrequency < 0)
+      TimingNative.timecpuFrequency = TimingNative.getTimecpuFrequencyInternal();
+    return TimingNative.timecpuFrequency;
+  }
+  public static double timecpuToNs(long cpuDiff) {
+    long frequency = timecpuFrequency();
+    return frequency == 0 ? Double.NaN : cpuDiff * 1.0e9 / frequency;
+  }
   public static double timesecDouble() {
     return timens() * 1.0E-9;
   }
@@ -159,6 +174,10 @@ class TimingNative implements TrueStatic {
   static int timecpuSupported = 0;
   static native int getTimecpuSupportedInternal();
   static native long timecpuInternal();
+  static int timecpuInvariant = 0;
+  static native int getTimecpuInvariantInternal();
+  static long timecpuFrequency = -1; // calibrated lazily: it takes ~60 ms if CPUID doesn't report it
+  static native long getTimecpuFrequencyInternal();
   static boolean loaded = false;
   static final String initializationExceptionMessage;
   static {
@@ -168,6 +187,7 @@ class TimingNative implements TrueStatic {
         System.loadLibrary(TimingNative.class.getName().replace('.','_'));
         loaded = true;
         timecpuSupported= getTimecpuSupportedInternal();
+        timecpuInvariant= getTimecpuInvariantInternal();
       } catch (UnsatisfiedLinkError e) {
         message = e.toString();
       } catch (SecurityException e) {
@@ -0,0 +1,694 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2001 Daniel Alievsky, AlgART Laboratory (http://algart.net)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+package net.algart.array.tests;
+
+import java.lang.reflect.Array;
+import java.lang.reflect.InvocationTargetException;
+import java.nio.Buffer;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.CharBuffer;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.nio.LongBuffer;
+import java.nio.ShortBuffer;
+import java.util.Random;
+
+import net.algart.array.Arrays;
+import net.algart.lib.Out;
+
+// Self-check of the native code: every native entry point of net.algart.array.Arrays is called for random
+// data of many lengths, offsets and matrix sizes, and its results are compared with the results of the same
+// call in Java code (after Arrays.setNative(false)). Also checks that illegal ranges are rejected before
+// the native calls, which don't check indexes.
+public class ArraysNativeTest {
+  static final Class[] ALL_TYPES= {byte.class,char.class,short.class,int.class,long.class,float.class,double.class};
+  static final Class[] SIGNED_TYPES= {byte.class,short.class,int.class,long.class,float.class,double.class};
+  static final Class[] INTEGER_TYPES= {byte.class,short.class,int.class,long.class};
+  static final Class[] UNSIGNED_TYPES= {byte.class,char.class,short.class,int.class,long.class};
+  static final Class[] SATURATING_TYPES= {byte.class,short.class};
+  static final Class[] HISTOGRAM_TYPES= {byte.class,char.class,short.class,int.class};
+  static final Class[] FILTER3X3_TYPES= {byte.class,char.class,short.class,float.class};
+  static final Class[] RANK_TYPES= {byte.class,char.class,short.class};
+
+  // min, max, minu and maxu: a[k]= op(a[k],b[k]); arithmetic: a[k]= op(a[k],b[k]), opposite: a[k]= -b[k]
+  static final String[] PAIR_OPS= {"min","max","minu","maxu","add","sub",
+    "adds","subs","addus","subus","absDiff","absDiffu","opposite"};
+  static final Class[][] PAIR_OP_TYPES= {ALL_TYPES,ALL_TYPES,INTEGER_TYPES,INTEGER_TYPES,SIGNED_TYPES,SIGNED_TYPES,
+    SATURATING_TYPES,SATURATING_TYPES,SATURATING_TYPES,SATURATING_TYPES,SIGNED_TYPES,INTEGER_TYPES,SIGNED_TYPES};
+  static final String[] BITS_OPS= {"copyBits","andBits","orBits","xorBits","andNotBits","notBits"};
+  static final String[] PACK_OPS= {"packBitsGreater","packBitsLess","packBitsGreaterOrEqual","packBitsLessOrEqual"};
+  static final String[] MEMORY_OPS= {"copy","fill","min","max","minu","maxu"};
+  static final Class[][] MEMORY_OP_TYPES= {ALL_TYPES,ALL_TYPES,ALL_TYPES,ALL_TYPES,UNSIGNED_TYPES,UNSIGNED_TYPES};
+
+  static final int[] LENGTHS= {0,1,2,3,4,7,8,9,15,16,17,31,32,33,63,64,65,100,127,128,129,255,256,257,
+    1000,1023,1025,4095,4096,4097,10000};
+  static final int[][] MATRIX_DIMS= {{1,1},{1,7},{7,1},{2,3},{3,2},{5,5},{16,16},{17,9},{9,17},{33,31},
+    {64,3},{3,64},{100,64},{257,19}};
+  static final int[] APERTURES= {1,2,3,4,5,8,9,16,17,33,300};
+  static final int APERTURE_TESTS= 4; // random apertures for every matrix
+
+  static int testCount= 0;
+
+  // One tested operation; perform() creates its arguments by the given random generator, so two calls with
+  // equal generators process equal data
+  abstract static class Check {
+    final String name;
+    int n, dimX, dimY; // the current length or matrix dimensions (dimX*dimY==n)
+    Check(String name) {this.name= name;}
+    abstract Object perform(Random rnd) throws Exception;
+    String difference(Object expected, Object actual) {return ArraysNativeTest.difference(expected,actual);}
+  }
+
+  static void check(Check c, long seed) throws Exception {
+    Arrays.setNative(false);
+    Object expected= c.perform(new Random(seed));
+    Arrays.setNative(true);
+    Object actual= c.perform(new Random(seed));
+    String d= c.difference(expected,actual);
+    if (d!=null) throw new AssertionError("\nError in "+c.name+" (n="+c.n
+      +(c.dimY>0? ", "+c.dimX+"x"+c.dimY+" matrix": "")+", seed="+seed+"): "+d);
+    testCount++;
+  }
+  static void checkLengths(Check c, Random seeds) throws Exception {
+    for (int k=0; k<LENGTHS.length; k++) {
+      c.n= LENGTHS[k];
+      check(c,seeds.nextLong());
+    }
+  }
+  static void checkMatrices(Check c, Random seeds) throws Exception {
+    for (int k=0; k<MATRIX_DIMS.length; k++) {
+      c.dimX= MATRIX_DIMS[k][0];
+      c.dimY= MATRIX_DIMS[k][1];
+      c.n= c.dimX*c.dimY;
+      check(c,seeds.nextLong());
+    }
+  }
+
+  // Description of the first difference or null; float and double elements are compared like in
+  // Float/Double.equals: NaN is equal to NaN, -0.0 is not equal to +0.0
+  static String difference(Object expected, Object actual) {
+    if (expected instanceof Object[]) {
+      Object[] e= (Object[])expected, a= (Object[])actual;
+      for (int k=0; k<e.length; k++) {
+        String d= difference(e[k],a[k]);
+        if (d!=null) return "result #"+k+": "+d;
+      }
+      return null;
+    }
+    if (expected.getClass().isArray()) {
+      int len= Array.getLength(expected);
+      if (Array.getLength(actual)!=len) return "length "+Array.getLength(actual)+" instead of "+len;
+      for (int k=0; k<len; k++) {
+        Object e= Array.get(expected,k), a= Array.get(actual,k);
+        if (!e.equals(a)) return "element #"+k+" is "+toString(a)+" instead of "+toString(e);
+      }
+      return null;
+    }
+    return expected.equals(actual)? null: toString(actual)+" instead of "+toString(expected);
+  }
+  static String toString(Object v) {
+    return v instanceof Character? String.valueOf((int)((Character)v).charValue()): String.valueOf(v);
+  }
+
+  static Object call(String methodName, Class[] types, Object[] args) throws Exception {
+    try {
+      return Arrays.class.getMethod(methodName,types).invoke(null,args);
+    } catch (InvocationTargetException e) {
+      Throwable t= e.getTargetException();
+      if (t instanceof Exception) throw (Exception)t;
+      throw (Error)t;
+    }
+  }
+  static void checkIllegalRange(String methodName, Class[] types, Object[] args) throws Exception {
+    try {
+      call(methodName,types,args);
+    } catch (IndexOutOfBoundsException e) {
+      testCount++;
+      return;
+    }
+    throw new AssertionError("\nNo IndexOutOfBoundsException in "+methodName+"() for an illegal range");
+  }
+
+  static Class arrayType(Class elementType) {
+    return Array.newInstance(elementType,0).getClass();
+  }
+  static Class bufferType(Class elementType) {
+    return elementType==byte.class? ByteBuffer.class: elementType==char.class? CharBuffer.class:
+      elementType==short.class? ShortBuffer.class: elementType==int.class? IntBuffer.class:
+      elementType==long.class? LongBuffer.class: elementType==float.class? FloatBuffer.class: DoubleBuffer.class;
+  }
+  static int elementSize(Class elementType) {
+    return elementType==byte.class? 1: elementType==char.class || elementType==short.class? 2:
+      elementType==int.class || elementType==float.class? 4: 8;
+  }
+  static Integer i(int v) {return new Integer(v);}
+  static Long l(long v) {return new Long(v);}
+
+  // Many small and equal values and the extreme values of the type; for float and double also NaN,
+  // infinities and both zeros
+  static Object randomValue(Random rnd, Class elementType) {
+    if (elementType==float.class || elementType==double.class) {
+      double v;
+      switch (rnd.nextInt(16)) {
+        case 0: v= Double.NaN; break;
+        case 1: v= -0.0; break;
+        case 2: v= 0.0; break;
+        case 3: v= rnd.nextBoolean()? Double.POSITIVE_INFINITY: Double.NEGATIVE_INFINITY; break;
+        case 4: case 5: case 6: v= rnd.nextInt(8)-4; break;
+        default: v= rnd.nextGaussian()*1000.0; break;
+      }
+      return elementType==float.class? (Object)new Float((float)v): new Double(v);
+    }
+    int bits= elementSize(elementType)*8;
+    long v;
+    switch (rnd.nextInt(4)) {
+      case 0: v= rnd.nextInt(8)-4; break;
+      case 1: v= rnd.nextBoolean()? -1L<<(bits-1): ~(-1L<<(bits-1)); break;
+      default: v= rnd.nextLong(); break;
+    }
+    if (elementType==byte.class) return new Byte((byte)v);
+    if (elementType==char.class) return new Character((char)v);
+    if (elementType==short.class) return new Short((short)v);
+    if (elementType==int.class) return new Integer((int)v);
+    return new Long(v);
+  }
+  static Object randomArray(Random rnd, Class elementType, int len) {
+    Object a= Array.newInstance(elementType,len);
+    for (int k=0; k<len; k++) Array.set(a,k,randomValue(rnd,elementType));
+    return a;
+  }
+  // packBitsXxx for byte and short elements, which are unsigned there, have int thresholds, also out of 0..255
+  // or 0..65535
+  static Class thresholdType(Class elementType) {
+    return elementType==byte.class || elementType==short.class? int.class: elementType;
+  }
+  static Object randomThreshold(Random rnd, Class elementType) {
+    if (elementType!=byte.class && elementType!=short.class) return randomValue(rnd,elementType);
+    int max= elementType==byte.class? 0xFF: 0xFFFF;
+    switch (rnd.nextInt(4)) {
+      case 0: return i(rnd.nextInt(2*max+5)-max-2);
+      case 1: return i(rnd.nextBoolean()? Integer.MIN_VALUE: Integer.MAX_VALUE);
+      default: return i(((Number)randomValue(rnd,elementType)).intValue()&max);
+    }
+  }
+  static long[] randomBits(Random rnd, int len) {
+    long[] a= new long[len];
+    for (int k=0; k<len; k++) {
+      switch (rnd.nextInt(4)) {
+        case 0: a[k]= 0; break;
+        case 1: a[k]= -1; break;
+        case 2: a[k]= 1L<<rnd.nextInt(64); break;
+        default: a[k]= rnd.nextLong(); break;
+      }
+    }
+    return a;
+  }
+
+  // Direct buffer with the native byte order, so it is processed by native code
+  static Buffer directBuffer(Class elementType, Object array) {
+    int len= Array.getLength(array);
+    ByteBuffer bb= ByteBuffer.allocateDirect(len*elementSize(elementType)).order(ByteOrder.nativeOrder());
+    if (elementType==byte.class) return bb.put((byte[])array).clear();
+    if (elementType==char.class) return bb.asCharBuffer().put((char[])array).clear();
+    if (elementType==short.class) return bb.asShortBuffer().put((short[])array).clear();
+    if (elementType==int.class) return bb.asIntBuffer().put((int[])array).clear();
+    if (elementType==long.class) return bb.asLongBuffer().put((long[])array).clear();
+    if (elementType==float.class) return bb.asFloatBuffer().put((float[])array).clear();
+    return bb.asDoubleBuffer().put((double[])array).clear();
+  }
+  static Object toArray(Class elementType, Buffer b) {
+    Object a= Array.newInstance(elementType,b.capacity());
+    b.clear();
+    if (elementType==byte.class) ((ByteBuffer)b).get((byte[])a);
+    else if (elementType==char.class) ((CharBuffer)b).get((char[])a);
+    else if (elementType==short.class) ((ShortBuffer)b).get((short[])a);
+    else if (elementType==int.class) ((IntBuffer)b).get((int[])a);
+    else if (elementType==long.class) ((LongBuffer)b).get((long[])a);
+    else if (elementType==float.class) ((FloatBuffer)b).get((float[])a);
+    else ((DoubleBuffer)b).get((double[])a);
+    b.clear();
+    return a;
+  }
+
+  static void testCopyAndFill(Random seeds) throws Exception {
+    for (int t=0; t<ALL_TYPES.length; t++) {
+      final Class type= ALL_TYPES[t];
+      checkLengths(new Check("copy("+type.getName()+"[])") {
+        Object perform(Random rnd) throws Exception {
+          Object a= randomArray(rnd,type,n+64), b= randomArray(rnd,type,n+64);
+          Arrays.copy(a,rnd.nextInt(33),b,rnd.nextInt(33),n);
+          return b;
+        }
+      },seeds);
+      checkLengths(new Check("copy("+type.getName()+"[]) inside one array") {
+        Object perform(Random rnd) throws Exception {
+          Object a= randomArray(rnd,type,n+64);
+          Arrays.copy(a,rnd.nextInt(33),a,rnd.nextInt(33),n);
+          return a;
+        }
+      },seeds);
+      checkLengths(new Check("fill("+type.getName()+"[])") {
+        Object perform(Random rnd) throws Exception {
+          Object a= randomArray(rnd,type,n+64);
+          int from= rnd.nextInt(33);
+          call("fill",new Class[] {arrayType(type),int.class,int.class,type},
+            new Object[] {a,i(from),i(from+n),randomValue(rnd,type)});
+          return a;
+        }
+      },seeds);
+    }
+    // Far beyond the last level cache: the native code splits such copying between several threads
+    Check huge= new Check("copy(byte[]) of a huge array") {
+      Object perform(Random rnd) throws Exception {
+        byte[] a= new byte[n+64], b= new byte[n+64];
+        rnd.nextBytes(a);
+        rnd.nextBytes(b);
+        Arrays.copy(a,rnd.nextInt(33),b,rnd.nextInt(33),n);
+        return b;
+      }
+      String difference(Object expected, Object actual) {
+        return java.util.Arrays.equals((byte[])expected,(byte[])actual)? null: "different results";
+      }
+    };
+    huge.n= (int)Math.min(Math.max(3*Arrays.getCpuLastLevelCacheSize(),24L<<20),192L<<20);
+    check(huge,seeds.nextLong());
+    Out.println("copy() and fill() tested");
+  }
+
+  static void testPairOps(Random seeds) throws Exception {
+    for (int op=0; op<PAIR_OPS.length; op++) {
+      for (int t=0; t<PAIR_OP_TYPES[op].length; t++) {
+        final String name= PAIR_OPS[op];
+        final Class type= PAIR_OP_TYPES[op][t];
+        checkLengths(new Check(name+"("+type.getName()+"[])") {
+          Object perform(Random rnd) throws Exception {
+            Object a= randomArray(rnd,type,n+64), b= randomArray(rnd,type,n+64);
+            call(name,new Class[] {Object.class,int.class,Object.class,int.class,int.class},
+              new Object[] {a,i(rnd.nextInt(33)),b,i(rnd.nextInt(33)),i(n)});
+            return a;
+          }
+        },seeds);
+        checkLengths(new Check(name+"("+type.getName()+" direct buffers)") {
+          Object perform(Random rnd) throws Exception {
+            Buffer a= directBuffer(type,randomArray(rnd,type,n+64)), b= directBuffer(type,randomArray(rnd,type,n+64));
+            call(name,new Class[] {Buffer.class,int.class,Buffer.class,int.class,int.class},
+              new Object[] {a,i(rnd.nextInt(33)),b,i(rnd.nextInt(33)),i(n)});
+            return toArray(type,a);
+          }
+        },seeds);
+        checkLengths(new Check(name+"("+type.getName()+"[], direct buffer)") {
+          Object perform(Random rnd) throws Exception {
+            Object a= randomArray(rnd,type,n+64);
+            Buffer b= directBuffer(type,randomArray(rnd,type,n+64));
+            call(name,new Class[] {Object.class,int.class,Buffer.class,int.class,int.class},
+              new Object[] {a,i(rnd.nextInt(33)),b,i(rnd.nextInt(33)),i(n)});
+            return a;
+          }
+        },seeds);
+      }
+    }
+    Out.println("min/max/minu/maxu and arithmetic tested");
+  }
+
+  static void testRangeAndSearch(Random seeds) throws Exception {
+    for (int t=0; t<ALL_TYPES.length; t++) {
+      final Class type= ALL_TYPES[t];
+      final boolean floating= type==float.class || type==double.class;
+      checkLengths(new Check("range("+type.getName()+"[])") {
+        Object perform(Random rnd) throws Exception {
+          Object a= randomArray(rnd,type,n+64);
+          return call("range",new Class[] {arrayType(type),int.class,int.class},new Object[] {a,i(rnd.nextInt(33)),i(n)});
+        }
+        String difference(Object expected, Object actual) {
+          if (!floating) return super.difference(expected,actual);
+          // the native sum is calculated in another order, so the last bits may differ
+          double[] e= (double[])expected, a= (double[])actual;
+          double sum= e[Arrays.RANGE_SUM];
+          if (Math.abs(a[Arrays.RANGE_SUM]-sum)<=1e-6+1e-9*Math.abs(sum)) a[Arrays.RANGE_SUM]= sum;
+          return super.difference(e,a);
+        }
+      },seeds);
+      checkLengths(new Check("range("+type.getName()+" direct buffer)") {
+        Object perform(Random rnd) throws Exception {
+          Buffer a= directBuffer(type,randomArray(rnd,type,n+64));
+          double[] r= new double[Arrays.RANGE_LENGTH];
+          Object result= call("range",new Class[] {bufferType(type),int.class,int.class},new Object[] {a,i(rnd.nextInt(33)),i(n)});
+          for (int k=0; k<r.length; k++) r[k]= ((Number)Array.get(result,k)).doubleValue();
+          if (floating) r[Arrays.RANGE_SUM]= 0.0; // tested above
+          return r;
+        }
+      },seeds);
+      checkLengths(new Check("indexOf/lastIndexOf("+type.getName()+"[])") {
+        Object perform(Random rnd) throws Exception {
+          Object a= randomArray(rnd,type,n);
+          Object v= n>0 && rnd.nextBoolean()? Array.get(a,rnd.nextInt(n)): randomValue(rnd,type);
+          Class[] types= {arrayType(type),type,int.class};
+          Object[] result= {
+            call("indexOf",types,new Object[] {a,v,i(rnd.nextInt(n+1))}),
+            call("lastIndexOf",types,new Object[] {a,v,i(rnd.nextInt(n+1)-1)}),
+            floating? call("indexOfNaN",new Class[] {arrayType(type),int.class},new Object[] {a,i(rnd.nextInt(n+1))}): null,
+            floating? call("lastIndexOfNaN",new Class[] {arrayType(type),int.class},new Object[] {a,i(rnd.nextInt(n+1)-1)}): null};
+          return floating? result: new Object[] {result[0],result[1]};
+        }
+      },seeds);
+      checkLengths(new Check("indexOf/lastIndexOf("+type.getName()+" direct buffer)") {
+        Object perform(Random rnd) throws Exception {
+          Object array= randomArray(rnd,type,n+64);
+          Buffer a= directBuffer(type,array);
+          Object v= n>0 && rnd.nextBoolean()? Array.get(array,rnd.nextInt(n)): randomValue(rnd,type);
+          Class[] types= {bufferType(type),int.class,int.class,type};
+          int ofs= rnd.nextInt(33);
+          return new Object[] {
+            call("indexOf",types,new Object[] {a,i(ofs),i(n),v}),
+            call("lastIndexOf",types,new Object[] {a,i(ofs),i(n),v})};
+        }
+      },seeds);
+    }
+    Out.println("range(), indexOf() and lastIndexOf() tested");
+  }
+
+  static void testBits(Random seeds) throws Exception {
+    for (int op=0; op<BITS_OPS.length; op++) {
+      final String name= BITS_OPS[op];
+      checkLengths(new Check(name+"()") {
+        Object perform(Random rnd) throws Exception {
+          long destPos= rnd.nextInt(130), srcPos= rnd.nextInt(130);
+          long[] dest= randomBits(rnd,(int)((destPos+n+63)>>>6)+1), src= randomBits(rnd,(int)((srcPos+n+63)>>>6)+1);
+          call(name,new Class[] {long[].class,long.class,long[].class,long.class,long.class},
+            new Object[] {dest,l(destPos),src,l(srcPos),l(n)});
+          return dest;
+        }
+      },seeds);
+    }
+    checkLengths(new Check("copyBits() inside one array") {
+      Object perform(Random rnd) throws Exception {
+        long destPos= rnd.nextInt(130), srcPos= rnd.nextInt(130);
+        long[] a= randomBits(rnd,(int)((Math.max(destPos,srcPos)+n+63)>>>6)+1);
+        Arrays.copyBits(a,destPos,a,srcPos,n);
+        return a;
+      }
+    },seeds);
+    checkLengths(new Check("cardinality/indexOfBit/lastIndexOfBit()") {
+      Object perform(Random rnd) throws Exception {
+        long from= rnd.nextInt(130);
+        long[] a= randomBits(rnd,(int)((from+n+63)>>>6)+rnd.nextInt(2));
+        long to= Math.min(from+n,(long)a.length<<6);
+        boolean value= rnd.nextBoolean();
+        return new Object[] {
+          l(Arrays.cardinality(a,Math.min(from,to),to)),
+          l(Arrays.indexOfBit(a,from,from+n,value)),
+          l(Arrays.lastIndexOfBit(a,from,from+n,value))};
+      }
+    },seeds);
+    for (int op=0; op<PACK_OPS.length; op++) {
+      for (int t=0; t<ALL_TYPES.length; t++) {
+        final String name= PACK_OPS[op];
+        final Class type= ALL_TYPES[t];
+        checkLengths(new Check(name+"("+type.getName()+"[])") {
+          Object perform(Random rnd) throws Exception {
+            long destPos= rnd.nextInt(130);
+            long[] dest= randomBits(rnd,(int)((destPos+n+63)>>>6)+1);
+            Object src= randomArray(rnd,type,n+64);
+            call(name,new Class[] {long[].class,long.class,arrayType(type),int.class,int.class,thresholdType(type)},
+              new Object[] {dest,l(destPos),src,i(rnd.nextInt(33)),i(n),randomThreshold(rnd,type)});
+            return dest;
+          }
+        },seeds);
+      }
+    }
+    // byte and short elements are unsigned, like in PackedBitArrays
+    long[] bits= new long[1];
+    Arrays.packBitsGreater(bits,0,new byte[] {(byte)0xFF,1,(byte)0x80},0,3,127);
+    Arrays.packBitsLess(bits,3,new short[] {(short)0xFFFF,-1,1},0,3,0x10000);
+    if (bits[0]!=0x3D) throw new AssertionError("\nError in packBitsGreater/Less: unsigned bits "
+      +Long.toBinaryString(bits[0])+" instead of 111101");
+    for (int t=0; t<ALL_TYPES.length; t++) {
+      final Class type= ALL_TYPES[t];
+      checkLengths(new Check("unpackBits/unpackUnitBits/unpackZeroBits("+type.getName()+"[])") {
+        Object perform(Random rnd) throws Exception {
+          long srcPos= rnd.nextInt(130);
+          long[] src= randomBits(rnd,(int)((srcPos+n+63)>>>6)+1);
+          Object[] result= new Object[3];
+          for (int k=0; k<result.length; k++) {
+            Object dest= randomArray(rnd,type,n+64);
+            Object[] args= {dest,i(rnd.nextInt(33)),src,l(srcPos),i(n),randomValue(rnd,type),randomValue(rnd,type)};
+            Class[] types= {arrayType(type),int.class,long[].class,long.class,int.class,type,type};
+            if (k==0) {
+              call("unpackBits",types,args);
+            } else {
+              Object[] a= new Object[6];
+              Class[] ts= new Class[6];
+              System.arraycopy(args,0,a,0,6);
+              System.arraycopy(types,0,ts,0,6);
+              call(k==1? "unpackUnitBits": "unpackZeroBits",ts,a);
+            }
+            result[k]= dest;
+          }
+          return result;
+        }
+      },seeds);
+    }
+    Out.println("bits operations, packing and unpacking tested");
+  }
+
+  static void testSwapAndHistogram(Random seeds) throws Exception {
+    for (int t=0; t<ALL_TYPES.length; t++) {
+      final Class type= ALL_TYPES[t];
+      checkLengths(new Check("swapByteOrder("+type.getName()+"[])") {
+        Object perform(Random rnd) throws Exception {
+          Object a= randomArray(rnd,type,n+64);
+          Arrays.swapByteOrder(a,rnd.nextInt(33),n);
+          return a;
+        }
+      },seeds);
+      checkLengths(new Check("swapByteOrder/copyAndSwapByteOrder("+type.getName()+" direct buffer)") {
+        Object perform(Random rnd) throws Exception {
+          Buffer a= directBuffer(type,randomArray(rnd,type,n+64));
+          Object b= randomArray(rnd,type,n+64), c= randomArray(rnd,type,n+64);
+          Arrays.swapByteOrder(a,rnd.nextInt(33),n);
+          Arrays.copyAndSwapByteOrder(a,rnd.nextInt(33),b,rnd.nextInt(33),n);
+          Arrays.copyAndSwapByteOrder(c,rnd.nextInt(33),a,rnd.nextInt(33),n);
+          return new Object[] {toArray(type,a),b};
+        }
+      },seeds);
+    }
+    for (int t=0; t<HISTOGRAM_TYPES.length; t++) {
+      final Class type= HISTOGRAM_TYPES[t];
+      checkLengths(new Check("histogram("+type.getName()+"[])") {
+        Object perform(Random rnd) throws Exception {
+          Object a= randomArray(rnd,type,n+64);
+          int binShift= rnd.nextInt(3)==0? rnd.nextInt(32): 0;
+          int barsCount= rnd.nextInt(3)==0? rnd.nextInt(300): Math.max(1,(type==byte.class? 256: 65536)>>binShift);
+          long[] bars= new long[barsCount];
+          for (int k=0; k<bars.length; k++) bars[k]= rnd.nextInt(3); // histogram() adds to bars
+          call("histogram",new Class[] {arrayType(type),int.class,int.class,long[].class,int.class},
+            new Object[] {a,i(rnd.nextInt(33)),i(n),bars,i(binShift)});
+          return bars;
+        }
+      },seeds);
+    }
+    Out.println("byte order swapping and histograms tested");
+  }
+
+  static void testMemory(Random seeds) throws Exception {
+    // Off-heap operations have no Java code: they are compared with the same operations of direct buffers
+    for (int op=0; op<MEMORY_OPS.length; op++) {
+      for (int t=0; t<MEMORY_OP_TYPES[op].length; t++) {
+        final String name= MEMORY_OPS[op];
+        final Class type= MEMORY_OP_TYPES[op][t];
+        checkLengths(new Check(name+"Memory("+type.getName()+")") {
+          Object perform(Random rnd) throws Exception {
+            Buffer a= directBuffer(type,randomArray(rnd,type,n+64)), b= directBuffer(type,randomArray(rnd,type,n+64));
+            int aofs= rnd.nextInt(33), bofs= rnd.nextInt(33), size= elementSize(type);
+            Object v= randomValue(rnd,type);
+            long aAddress= Arrays.getDirectBufferAddress(a)+(long)aofs*size;
+            long bAddress= Arrays.getDirectBufferAddress(b)+(long)bofs*size;
+            if (!Arrays.isNative()) {
+              if (name.equals("fill")) {
+                call("fill",new Class[] {bufferType(type),int.class,int.class,type},new Object[] {a,i(aofs),i(aofs+n),v});
+              } else if (name.equals("copy")) {
+                Arrays.copy(b,bofs,a,aofs,n);
+              } else {
+                call(name,new Class[] {Buffer.class,int.class,Buffer.class,int.class,int.class},
+                  new Object[] {a,i(aofs),b,i(bofs),i(n)});
+              }
+            } else {
+              if (name.equals("fill")) {
+                call("fillMemory",new Class[] {long.class,long.class,type},new Object[] {l(aAddress),l(n),v});
+              } else if (name.equals("copy")) {
+                Arrays.copyMemory(bAddress,aAddress,(long)n*size);
+              } else {
+                call(name+"Memory",new Class[] {Class.class,long.class,long.class,long.class},
+                  new Object[] {type,l(aAddress),l(bAddress),l(n)});
+              }
+            }
+            return toArray(type,a);
+          }
+        },seeds);
+      }
+    }
+    Out.println("off-heap memory operations tested");
+  }
+
+  static void testMatrices(Random seeds) throws Exception {
+    for (int t=0; t<FILTER3X3_TYPES.length; t++) {
+      for (int f=Arrays.FILTER3X3_EROSION_BY_SQUARE; f<=Arrays.FILTER3X3_QUICK_GRADIENT_BY_CROSS; f++) {
+        final Class type= FILTER3X3_TYPES[t];
+        final int filter= f;
+        checkMatrices(new Check("filter3x3("+type.getName()+"[], filter "+filter+")") {
+          Object perform(Random rnd) throws Exception {
+            int srcOfs= rnd.nextInt(17), destOfs= rnd.nextInt(17);
+            Object src= randomArray(rnd,type,srcOfs+n+16), dest= randomArray(rnd,type,destOfs+n+16);
+            call("filter3x3",new Class[] {arrayType(type),int.class,arrayType(type),int.class,int.class,int.class,int.class,int.class},
+              new Object[] {dest,i(destOfs),src,i(srcOfs),i(dimX),i(dimY),i(filter),i(rnd.nextInt(9))});
+            return dest;
+          }
+        },seeds);
+      }
+    }
+    for (int t=0; t<RANK_TYPES.length; t++) {
+      final Class type= RANK_TYPES[t];
+      for (int test=0; test<APERTURE_TESTS; test++) {
+        checkMatrices(new Check("percentileByRectangle/meanBetweenPercentilesByRectangle("+type.getName()+"[])") {
+          Object perform(Random rnd) throws Exception {
+            // the Java code sorts every aperture, so large apertures are tested with small matrices only
+            int ax= APERTURES[rnd.nextInt(n<=64? APERTURES.length: APERTURES.length-1)];
+            int ay= APERTURES[rnd.nextInt(n<=64? APERTURES.length: APERTURES.length-1)];
+            int count= ax*ay, from= rnd.nextInt(count), to= from+1+rnd.nextInt(count-from);
+            int srcOfs= rnd.nextInt(17);
+            Object src= randomArray(rnd,type,srcOfs+n+16);
+            Object[] result= {randomArray(rnd,type,n),randomArray(rnd,type,n)};
+            Class[] types= {arrayType(type),int.class,arrayType(type),int.class,int.class,int.class,int.class,int.class,int.class};
+            call("percentileByRectangle",types,new Object[] {result[0],i(0),src,i(srcOfs),i(dimX),i(dimY),i(ax),i(ay),i(from)});
+            Class[] meanTypes= new Class[types.length+1];
+            System.arraycopy(types,0,meanTypes,0,types.length);
+            meanTypes[types.length]= int.class;
+            call("meanBetweenPercentilesByRectangle",meanTypes,
+              new Object[] {result[1],i(0),src,i(srcOfs),i(dimX),i(dimY),i(ax),i(ay),i(from),i(to)});
+            return result;
+          }
+        },seeds);
+      }
+    }
+    for (int t=0; t<ALL_TYPES.length; t++) {
+      final Class type= ALL_TYPES[t];
+      for (int test=0; test<APERTURE_TESTS; test++) {
+        checkMatrices(new Check("erosionByRectangle/dilationByRectangle("+type.getName()+"[])") {
+          Object perform(Random rnd) throws Exception {
+            int ax= APERTURES[rnd.nextInt(APERTURES.length)], ay= APERTURES[rnd.nextInt(APERTURES.length)];
+            int srcOfs= rnd.nextInt(17);
+            Object src= randomArray(rnd,type,srcOfs+n+16);
+            Object[] result= {randomArray(rnd,type,n),randomArray(rnd,type,n)};
+            Class[] types= {arrayType(type),int.class,arrayType(type),int.class,int.class,int.class,int.class,int.class};
+            call("erosionByRectangle",types,new Object[] {result[0],i(0),src,i(srcOfs),i(dimX),i(dimY),i(ax),i(ay)});
+            call("dilationByRectangle",types,new Object[] {result[1],i(0),src,i(srcOfs),i(dimX),i(dimY),i(ax),i(ay)});
+            return result;
+          }
+        },seeds);
+      }
+    }
+    Out.println("filter3x3(), rank filters and morphology tested");
+  }
+
+  static void testIllegalRanges() throws Exception {
+    Arrays.setNative(true);
+    Class[] pairTypes= {Object.class,int.class,Object.class,int.class,int.class};
+    for (int t=0; t<ALL_TYPES.length; t++) {
+      Class type= ALL_TYPES[t];
+      Object a= Array.newInstance(type,100), b= Array.newInstance(type,100);
+      checkIllegalRange("copy",pairTypes,new Object[] {a,i(50),b,i(0),i(51)});
+      checkIllegalRange("copy",pairTypes,new Object[] {a,i(0),b,i(-1),i(10)});
+      checkIllegalRange("min",pairTypes,new Object[] {a,i(0),b,i(99),i(2)});
+      checkIllegalRange("max",pairTypes,new Object[] {a,i(-5),b,i(0),i(10)});
+      checkIllegalRange("minu",pairTypes,new Object[] {a,i(1),b,i(0),i(100)});
+      checkIllegalRange("range",new Class[] {arrayType(type),int.class,int.class},new Object[] {a,i(90),i(11)});
+      checkIllegalRange("copyAndSwapByteOrder",new Class[] {Object.class,int.class,Buffer.class,int.class,int.class},
+        new Object[] {a,i(0),directBuffer(type,b),i(50),i(51)});
+      checkIllegalRange("erosionByRectangle",
+        new Class[] {arrayType(type),int.class,arrayType(type),int.class,int.class,int.class,int.class,int.class},
+        new Object[] {a,i(0),b,i(1),i(10),i(10),i(3),i(3)});
+    }
+    // Oversized len, long enough for the native copying, when the first elements of the ranges differ,
+    // and len so large that aofs+len overflows
+    int m= Arrays.getNativeMinLenCopy(byte.class)+100;
+    byte[] x= new byte[2*m], y= new byte[2*m];
+    y[0]= 1;
+    Class[] byteCopyTypes= {byte[].class,int.class,byte[].class,int.class,int.class};
+    checkIllegalRange("copy",byteCopyTypes,new Object[] {x,i(m),y,i(0),i(m+1)});
+    checkIllegalRange("copy",byteCopyTypes,new Object[] {x,i(10),y,i(0),i(Integer.MAX_VALUE)});
+    for (int t=0; t<SIGNED_TYPES.length; t++) {
+      Class type= SIGNED_TYPES[t];
+      Object a= Array.newInstance(type,100), b= Array.newInstance(type,100);
+      checkIllegalRange("add",pairTypes,new Object[] {a,i(0),b,i(0),i(101)});
+      checkIllegalRange("opposite",pairTypes,new Object[] {a,i(100),b,i(0),i(1)});
+      checkIllegalRange("add",new Class[] {Buffer.class,int.class,Buffer.class,int.class,int.class},
+        new Object[] {directBuffer(type,a),i(0),directBuffer(type,b),i(60),i(41)});
+    }
+    checkIllegalRange("histogram",new Class[] {byte[].class,int.class,int.class,long[].class,int.class},
+      new Object[] {new byte[100],i(50),i(51),new long[256],i(0)});
+    checkIllegalRange("copyBits",new Class[] {long[].class,long.class,long[].class,long.class,long.class},
+      new Object[] {new long[2],l(0),new long[2],l(60),l(70)});
+    Class[] bitSearchTypes= {long[].class,long.class,long.class,boolean.class};
+    checkIllegalRange("indexOfBit",bitSearchTypes,new Object[] {new long[2],l(-1),l(10),Boolean.TRUE});
+    checkIllegalRange("indexOfBit",bitSearchTypes,new Object[] {new long[2],l(-5),l(-10),Boolean.TRUE});
+    checkIllegalRange("lastIndexOfBit",bitSearchTypes,new Object[] {new long[2],l(0),l(129),Boolean.FALSE});
+    checkIllegalRange("packBitsGreater",new Class[] {long[].class,long.class,int[].class,int.class,int.class,int.class},
+      new Object[] {new long[1],l(1),new int[100],i(0),i(64),i(0)});
+    checkIllegalRange("unpackBits",new Class[] {int[].class,int.class,long[].class,long.class,int.class,int.class,int.class},
+      new Object[] {new int[100],i(0),new long[1],l(1),i(64),i(0),i(1)});
+    checkIllegalRange("filter3x3",new Class[] {byte[].class,int.class,byte[].class,int.class,int.class,int.class,int.class,int.class},
+      new Object[] {new byte[11],i(0),new byte[12],i(0),i(3),i(4),i(Arrays.FILTER3X3_AVERAGE_BY_SQUARE),i(0)});
+    checkIllegalRange("percentileByRectangle",
+      new Class[] {short[].class,int.class,short[].class,int.class,int.class,int.class,int.class,int.class,int.class},
+      new Object[] {new short[100],i(0),new short[100],i(0),i(10),i(11),i(3),i(3),i(4)});
+    Out.println("range checks tested");
+  }
+
+  public static void main(String[] args) throws Exception {
+    if (!Arrays.isNative()) {
+      Out.println("Native library was not loaded due to the following reason:\n  "
+        + Arrays.initializationExceptionMessage());
+      return;
+    }
+    long seed= args.length>0? Long.parseLong(args[0]): new Random().nextLong();
+    Out.println("Testing native code ("+Arrays.getNativeKernelsName()+" kernels) against Java code, seed "+seed);
+    // native code is used for any non-empty arrays
+    Arrays.setNativeMinLenFill(0);
+    Arrays.setNativeMinLenPairOp(0);
+    Arrays.setNativeMinLenMatrix(0);
+    Random seeds= new Random(seed);
+    testCopyAndFill(seeds);
+    testPairOps(seeds);
+    testRangeAndSearch(seeds);
+    testBits(seeds);
+    testSwapAndHistogram(seeds);
+    testMemory(seeds);
+    testMatrices(seeds);
+    testIllegalRanges();
+    Out.println(testCount+" tests passed");
+  }
+}